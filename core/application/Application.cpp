@@ -229,7 +229,10 @@ void Application::Start() { // GCOVR_EXCL_START
 
     // runner
     BoundedSenderQueueInterface::SetFeedback(ProcessQueueManager::GetInstance());
-    HttpSink::GetInstance()->Init();
+    if (!HttpSink::GetInstance()->Init()) {
+        // requests are then completed with a network error, and flushers decide whether to retry
+        LOG_ERROR(sLogger, ("failed to init http sink", "no data can be sent over http"));
+    }
     FlusherRunner::GetInstance()->Init();
     ProcessorRunner::GetInstance()->Init();
 
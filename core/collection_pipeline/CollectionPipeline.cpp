@@ -345,15 +345,16 @@ bool CollectionPipeline::Init(CollectionConfig&& config) {
                                                           {METRIC_LABEL_KEY_PIPELINE_NAME, mName},
                                                           {METRIC_LABEL_KEY_LOGSTORE, mContext.GetLogstoreName()}});
     mStartTime = mMetricsRecordRef.CreateIntGauge(METRIC_PIPELINE_START_TIME);
-    mProcessorsInEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENTS_TOTAL);
-    mProcessorsInGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENT_GROUPS_TOTAL);
-    mProcessorsInSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES);
+    mProcessorsInEventsTotal = mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENTS_TOTAL);
+    mProcessorsInGroupsTotal = mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENT_GROUPS_TOTAL);
+    mProcessorsInSizeBytes = mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES);
     mProcessorsTotalProcessTimeMs
-        = mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS);
-    mFlushersInGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL);
-    mFlushersInEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL);
-    mFlushersInSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES);
-    mFlushersTotalPackageTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS);
+        = mMetricsRecordRef.CreateShardedTimeCounter(METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS);
+    mFlushersInGroupsTotal = mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL);
+    mFlushersInEventsTotal = mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL);
+    mFlushersInSizeBytes = mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES);
+    mFlushersTotalPackageTimeMs
+        = mMetricsRecordRef.CreateShardedTimeCounter(METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS);
 
     return true;
 }
@@ -391,15 +392,17 @@ void CollectionPipeline::Process(vector<PipelineEventGroup>& logGroupList, size_
     }
     ADD_COUNTER(mProcessorsInGroupsTotal, logGroupList.size())
 
+    // the sampling decision is shared by all processors, so that a sampled call is profiled end to end
+    bool profile = ProcessorProfiler::ShouldSample();
     auto before = chrono::system_clock::now();
     for (auto& p : mInputs[inputIndex]->GetInnerProcessors()) {
-        p->Process(logGroupList);
+        p->Process(logGroupList, profile);
     }
     for (auto& p : mPipelineInnerProcessorLine) {
-        p->Process(logGroupList);
+        p->Process(logGroupList, profile);
     }
     for (auto& p : mProcessorLine) {
-        p->Process(logGroupList);
+        p->Process(logGroupList, profile);
     }
     ADD_COUNTER(mProcessorsTotalProcessTimeMs, chrono::system_clock::now() - before);
 }
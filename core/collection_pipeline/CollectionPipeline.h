@@ -107,14 +107,14 @@ private:
 
     mutable MetricsRecordRef mMetricsRecordRef;
     IntGaugePtr mStartTime;
-    CounterPtr mProcessorsInEventsTotal;
-    CounterPtr mProcessorsInGroupsTotal;
-    CounterPtr mProcessorsInSizeBytes;
-    TimeCounterPtr mProcessorsTotalProcessTimeMs;
-    CounterPtr mFlushersInGroupsTotal;
-    CounterPtr mFlushersInEventsTotal;
-    CounterPtr mFlushersInSizeBytes;
-    TimeCounterPtr mFlushersTotalPackageTimeMs;
+    ShardedCounterPtr mProcessorsInEventsTotal;
+    ShardedCounterPtr mProcessorsInGroupsTotal;
+    ShardedCounterPtr mProcessorsInSizeBytes;
+    ShardedTimeCounterPtr mProcessorsTotalProcessTimeMs;
+    ShardedCounterPtr mFlushersInGroupsTotal;
+    ShardedCounterPtr mFlushersInEventsTotal;
+    ShardedCounterPtr mFlushersInSizeBytes;
+    ShardedTimeCounterPtr mFlushersTotalPackageTimeMs;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PipelineMock;
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "collection_pipeline/batch/BatchStatus.h"
@@ -104,10 +105,7 @@ public:
         if (mBatch.mEvents.empty()) {
             return;
         }
-        if (mBatch.mExactlyOnceCheckpoint) {
-            UpdateExactlyOnceLogPosition();
-        }
-        mBatch.mSizeBytes = DataSize();
+        Complete();
         res.Add(std::move(mBatch), mTotalEnqueTimeMs);
         Clear();
     }
@@ -116,10 +114,7 @@ public:
         if (mBatch.mEvents.empty()) {
             return;
         }
-        if (mBatch.mExactlyOnceCheckpoint) {
-            UpdateExactlyOnceLogPosition();
-        }
-        mBatch.mSizeBytes = DataSize();
+        Complete();
         res.emplace_back(std::move(mBatch));
         Clear();
     }
@@ -129,15 +124,12 @@ public:
             return;
         }
         res.emplace_back();
-        if (mBatch.mExactlyOnceCheckpoint) {
-            UpdateExactlyOnceLogPosition();
-        }
-        mBatch.mSizeBytes = DataSize();
+        Complete();
         res.back().emplace_back(std::move(mBatch));
         Clear();
     }
 
-    void Reset(const SizedMap& tags,
+    void Reset(const SizedFlatTagMap& tags,
                const std::shared_ptr<SourceBuffer>& sourceBuffer,
                const RangeCheckpointPtr& exactlyOnceCheckpoint,
                StringView packIdPrefix) {
@@ -156,6 +148,8 @@ public:
         }
     }
 
+    void SetBuildColumnarLogs(bool enable) { mBuildColumnarLogs = enable; }
+
     T& GetStatus() { return mStatus; }
 
     bool IsEmpty() { return mBatch.mEvents.empty(); }
@@ -172,9 +166,19 @@ private:
         mTotalEnqueTimeMs = 0;
     }
 
+    void Complete() {
+        if (mBatch.mExactlyOnceCheckpoint) {
+            UpdateExactlyOnceLogPosition();
+        }
+        mBatch.mSizeBytes = DataSize();
+        if (mBuildColumnarLogs) {
+            mBatch.BuildColumnarLogs();
+        }
+    }
+
     void UpdateExactlyOnceLogPosition() {
-        uint32_t offset = mBatch.mEvents.front().Cast<LogEvent>().GetPosition().first;
-        auto lastEventPosition = mBatch.mEvents.back().Cast<LogEvent>().GetPosition();
+        uint32_t offset = std::as_const(mBatch.mEvents.front()).Cast<LogEvent>().GetPosition().first;
+        auto lastEventPosition = std::as_const(mBatch.mEvents.back()).Cast<LogEvent>().GetPosition();
         mBatch.mExactlyOnceCheckpoint->data.set_read_offset(offset);
         mBatch.mExactlyOnceCheckpoint->data.set_read_length(lastEventPosition.first + lastEventPosition.second
                                                             - offset);
@@ -183,6 +187,7 @@ private:
     BatchedEvents mBatch;
     std::unordered_set<SourceBuffer*> mSourceBuffers;
     T mStatus;
+    bool mBuildColumnarLogs = false;
     // if more than 10^6 events are contained in the batch, the value may overflow
     // however, this is almost impossible in practice
     int64_t mTotalEnqueTimeMs = 0;
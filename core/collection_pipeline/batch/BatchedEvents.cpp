@@ -14,6 +14,8 @@
 
 #include "collection_pipeline/batch/BatchedEvents.h"
 
+#include <utility>
+
 #include "models/EventPool.h"
 
 using namespace std;
@@ -29,9 +31,15 @@ void DestroyEvents(vector<PipelineEventPtr>&& events) {
     bool firstEvent = true;
     for (auto& item : events) {
         if (item && item.IsFromEventPool()) {
-            item->Reset();
-            if (firstEvent || item.GetEventPool() != cachedPoolPtr) {
-                cachedPoolPtr = item.GetEventPool();
+            EventPool* pool = item.GetEventPool();
+            // events still shared with other groups are returned to the pool by the last owner
+            auto* e = item.Release();
+            if (e == nullptr) {
+                continue;
+            }
+            e->Reset();
+            if (firstEvent || pool != cachedPoolPtr) {
+                cachedPoolPtr = pool;
                 cachedIt = eventsPoolMap.find(cachedPoolPtr);
                 if (cachedIt == eventsPoolMap.end()) {
                     eventsPoolMap.emplace(cachedPoolPtr, vector<T*>());
@@ -40,7 +48,7 @@ void DestroyEvents(vector<PipelineEventPtr>&& events) {
                 }
                 firstEvent = false;
             }
-            cachedIt->second.emplace_back(static_cast<T*>(item.Release()));
+            cachedIt->second.emplace_back(static_cast<T*>(e));
         }
     }
     for (auto& item : eventsPoolMap) {
@@ -56,7 +64,7 @@ BatchedEvents::~BatchedEvents() {
     if (mEvents.empty() || !mEvents[0]) {
         return;
     }
-    switch (mEvents[0]->GetType()) {
+    switch (as_const(mEvents[0])->GetType()) {
         case PipelineEvent::Type::LOG:
             DestroyEvents<LogEvent>(std::move(mEvents));
             break;
@@ -75,7 +83,7 @@ BatchedEvents::~BatchedEvents() {
 }
 
 BatchedEvents::BatchedEvents(EventsContainer&& events,
-                             SizedMap&& tags,
+                             SizedFlatTagMap&& tags,
                              std::shared_ptr<SourceBuffer>&& sourceBuffer,
                              StringView packIdPrefix,
                              RangeCheckpointPtr&& eoo)
@@ -90,6 +98,16 @@ BatchedEvents::BatchedEvents(EventsContainer&& events,
     }
 }
 
+void BatchedEvents::BuildColumnarLogs() {
+    if (mEvents.empty() || !mEvents[0].Is<LogEvent>()) {
+        return;
+    }
+    auto columnarLogs = make_unique<ColumnarLogs>();
+    if (columnarLogs->Build(mEvents)) {
+        mColumnarLogs = std::move(columnarLogs);
+    }
+}
+
 void BatchedEvents::Clear() {
     mEvents.clear();
     mTags.Clear();
@@ -97,6 +115,7 @@ void BatchedEvents::Clear() {
     mSizeBytes = 0;
     mExactlyOnceCheckpoint.reset();
     mPackIdPrefix = StringView();
+    mColumnarLogs.reset();
 }
 
 } // namespace logtail
@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_set>
 #include <vector>
 
+#include "collection_pipeline/batch/ColumnarLogs.h"
 #include "common/StringView.h"
 #include "models/PipelineEventGroup.h"
 
@@ -26,12 +28,14 @@ namespace logtail {
 
 struct BatchedEvents {
     EventsContainer mEvents;
-    SizedMap mTags;
+    SizedFlatTagMap mTags;
     std::vector<std::shared_ptr<SourceBuffer>> mSourceBuffers;
     size_t mSizeBytes = 0; // only set on completion
     // for flusher_sls only
     RangeCheckpointPtr mExactlyOnceCheckpoint;
     StringView mPackIdPrefix;
+    // optional columnar copy of mEvents, only built for log events when the batch is completed
+    std::unique_ptr<ColumnarLogs> mColumnarLogs;
 
     BatchedEvents() = default;
     ~BatchedEvents();
@@ -40,11 +44,12 @@ struct BatchedEvents {
 
     // for flusher_sls only
     BatchedEvents(EventsContainer&& events,
-                  SizedMap&& tags,
+                  SizedFlatTagMap&& tags,
                   std::shared_ptr<SourceBuffer>&& sourceBuffer,
                   StringView packIdPrefix,
                   RangeCheckpointPtr&& eoo);
 
+    void BuildColumnarLogs();
     void Clear();
 };
 
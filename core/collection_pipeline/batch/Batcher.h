@@ -18,9 +18,12 @@
 
 #include <cstdint>
 
+#include <algorithm>
+#include <chrono>
 #include <map>
 #include <mutex>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "json/json.h"
@@ -32,6 +35,7 @@
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
 #include "common/Flags.h"
 #include "common/ParamExtractor.h"
+#include "common/memory/MemoryAccountant.h"
 #include "models/PipelineEventGroup.h"
 #include "monitor/MetricManager.h"
 #include "monitor/metric_constants/MetricConstants.h"
@@ -87,16 +91,65 @@ public:
                                   ctx.GetRegion());
         }
 
+        bool enableAdaptive = false;
+        if (!GetOptionalBoolParam(config, "EnableAdaptive", enableAdaptive, errorMsg)) {
+            PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                                  ctx.GetAlarm(),
+                                  errorMsg,
+                                  enableAdaptive,
+                                  flusher->Name(),
+                                  ctx.GetConfigName(),
+                                  ctx.GetProjectName(),
+                                  ctx.GetLogstoreName(),
+                                  ctx.GetRegion());
+        }
+        if (enableAdaptive) {
+            AdaptiveFlushStrategyOptions options{
+                minSizeBytes / 4,
+                static_cast<uint32_t>(std::min<uint64_t>(minSizeBytes * 4ULL, strategy.mMaxSizeBytes)),
+                1,
+                std::max(timeoutSecs * 2, 1U)};
+            std::pair<const char*, uint32_t*> limits[] = {
+                {"MinSizeBytesLowerLimit", &options.mMinSizeBytesLowerLimit},
+                {"MinSizeBytesUpperLimit", &options.mMinSizeBytesUpperLimit},
+                {"TimeoutSecsLowerLimit", &options.mTimeoutSecsLowerLimit},
+                {"TimeoutSecsUpperLimit", &options.mTimeoutSecsUpperLimit}};
+            for (auto& limit : limits) {
+                if (!GetOptionalUIntParam(config, limit.first, *limit.second, errorMsg)) {
+                    PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                                          ctx.GetAlarm(),
+                                          errorMsg,
+                                          *limit.second,
+                                          flusher->Name(),
+                                          ctx.GetConfigName(),
+                                          ctx.GetProjectName(),
+                                          ctx.GetLogstoreName(),
+                                          ctx.GetRegion());
+                }
+            }
+            if (options.mMinSizeBytesLowerLimit > options.mMinSizeBytesUpperLimit
+                || options.mTimeoutSecsLowerLimit > options.mTimeoutSecsUpperLimit) {
+                PARAM_WARNING_IGNORE(ctx.GetLogger(),
+                                     ctx.GetAlarm(),
+                                     "lower limit of adaptive batch is larger than the upper limit, adaptive batch is "
+                                     "disabled",
+                                     flusher->Name(),
+                                     ctx.GetConfigName(),
+                                     ctx.GetProjectName(),
+                                     ctx.GetLogstoreName(),
+                                     ctx.GetRegion());
+            } else {
+                mAdaptiveFlushStrategy.emplace(minSizeBytes, timeoutSecs, options);
+                minSizeBytes = mAdaptiveFlushStrategy->GetMinSizeBytes();
+                timeoutSecs = mAdaptiveFlushStrategy->GetTimeoutSecs();
+            }
+        }
+
         if (enableGroupBatch) {
-            uint32_t groupTimeout = timeoutSecs / 2;
-            mGroupFlushStrategy = GroupFlushStrategy(minSizeBytes, groupTimeout);
+            mGroupFlushStrategy = GroupFlushStrategy(minSizeBytes, timeoutSecs / 2);
             mGroupQueue = GroupBatchItem();
-            mEventFlushStrategy.SetTimeoutSecs(timeoutSecs - groupTimeout);
-        } else {
-            mEventFlushStrategy.SetTimeoutSecs(timeoutSecs);
         }
         mEventFlushStrategy.SetMaxSizeBytes(strategy.mMaxSizeBytes);
-        mEventFlushStrategy.SetMinSizeBytes(minSizeBytes);
         mEventFlushStrategy.SetMinCnt(minCnt);
 
         mFlusher = flusher;
@@ -113,25 +166,52 @@ public:
         }
         WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
             mMetricsRecordRef, MetricCategory::METRIC_CATEGORY_COMPONENT, std::move(labels));
-        mInEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_IN_EVENTS_TOTAL);
-        mInGroupDataSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_IN_SIZE_BYTES);
-        mOutEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_OUT_EVENTS_TOTAL);
+        mInEventsTotal = mMetricsRecordRef.CreateShardedCounter(METRIC_COMPONENT_IN_EVENTS_TOTAL);
+        mInGroupDataSizeBytes = mMetricsRecordRef.CreateShardedCounter(METRIC_COMPONENT_IN_SIZE_BYTES);
+        mOutEventsTotal = mMetricsRecordRef.CreateShardedCounter(METRIC_COMPONENT_OUT_EVENTS_TOTAL);
         // mTotalDelayMs = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_TOTAL_DELAY_MS);
         mEventBatchItemsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_EVENT_BATCHES_TOTAL);
         mBufferedGroupsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_BUFFERED_GROUPS_TOTAL);
         mBufferedEventsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL);
         mBufferedDataSizeByte = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES);
-        mTotalAddTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS);
+        mTotalAddTimeMs = mMetricsRecordRef.CreateShardedTimeCounter(METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS);
+        mBufferedMemory = MemoryCharge(MemoryCategory::BATCHER,
+                                       MemoryAccountant::GetInstance()->GetPipelineUsage(ctx.GetConfigName()));
+        mMinSizeBytes = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_MIN_SIZE_BYTES);
+        mTimeoutSecs = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_TIMEOUT_SECS);
+        SetFlushParams(minSizeBytes, timeoutSecs);
 
         return true;
     }
 
+    // should be called right after Init, so that batches of log events carry a columnar copy for the serializer
+    void SetBuildColumnarLogs(bool enable) { mBuildColumnarLogs = enable; }
+
+    // feedback for adaptive batch, ignored if it is not enabled
+    void OnDataCompressed(size_t rawSize, size_t compressedSize) {
+        if (mAdaptiveFlushStrategy) {
+            mAdaptiveFlushStrategy->OnDataCompressed(rawSize, compressedSize);
+        }
+    }
+    void OnSendSucceeded(std::chrono::milliseconds latency) {
+        if (mAdaptiveFlushStrategy) {
+            mAdaptiveFlushStrategy->OnSendSucceeded(latency);
+        }
+    }
+
     // when group level batch is disabled, there should be only 1 element in BatchedEventsList
     void Add(PipelineEventGroup&& g, std::vector<BatchedEventsList>& res) {
         auto before = std::chrono::system_clock::now();
         std::lock_guard<std::mutex> lock(mMux);
+        if (mAdaptiveFlushStrategy) {
+            mAdaptiveFlushStrategy->OnDataArrived(g.DataSize());
+            if (mAdaptiveFlushStrategy->Adjust(std::chrono::steady_clock::now())) {
+                SetFlushParams(mAdaptiveFlushStrategy->GetMinSizeBytes(), mAdaptiveFlushStrategy->GetTimeoutSecs());
+            }
+        }
         size_t key = g.GetTagsHash();
         EventBatchItem<T>& item = mEventQueueMap[key];
+        item.SetBuildColumnarLogs(mBuildColumnarLogs);
         ADD_COUNTER(mInEventsTotal, g.GetEvents().size());
         ADD_COUNTER(mInGroupDataSizeBytes, g.DataSize());
         SET_GAUGE(mEventBatchItemsTotal, mEventQueueMap.size());
@@ -201,11 +281,13 @@ public:
                                                                      mFlusher);
                     ADD_GAUGE(mBufferedGroupsTotal, 1);
                     ADD_GAUGE(mBufferedDataSizeByte, item.DataSize());
+                    mBufferedMemory.Add(item.DataSize());
                 } else if (i == 0) {
                     item.AddSourceBuffer(g.GetSourceBuffer());
                 }
                 ADD_GAUGE(mBufferedEventsTotal, 1);
-                ADD_GAUGE(mBufferedDataSizeByte, e->DataSize());
+                ADD_GAUGE(mBufferedDataSizeByte, std::as_const(e)->DataSize());
+                mBufferedMemory.Add(std::as_const(e)->DataSize());
                 item.Add(std::move(e));
                 if (mEventFlushStrategy.NeedFlushBySize(item.GetStatus())
                     || mEventFlushStrategy.NeedFlushByCnt(item.GetStatus())) {
@@ -294,6 +376,21 @@ public:
 #endif
 
 private:
+    // when group level batch is enabled, the timeout is shared by the event and group queues
+    void SetFlushParams(uint32_t minSizeBytes, uint32_t timeoutSecs) {
+        if (mGroupFlushStrategy) {
+            uint32_t groupTimeout = timeoutSecs / 2;
+            mGroupFlushStrategy->SetMinSizeBytes(minSizeBytes);
+            mGroupFlushStrategy->SetTimeoutSecs(groupTimeout);
+            mEventFlushStrategy.SetTimeoutSecs(timeoutSecs - groupTimeout);
+        } else {
+            mEventFlushStrategy.SetTimeoutSecs(timeoutSecs);
+        }
+        mEventFlushStrategy.SetMinSizeBytes(minSizeBytes);
+        SET_GAUGE(mMinSizeBytes, minSizeBytes);
+        SET_GAUGE(mTimeoutSecs, timeoutSecs);
+    }
+
     void UpdateMetricsOnFlushingEventQueue(const EventBatchItem<T>& item) {
         ADD_COUNTER(mOutEventsTotal, item.EventSize());
         // ADD_COUNTER(mTotalDelayMs,
@@ -305,6 +402,7 @@ private:
         SUB_GAUGE(mBufferedGroupsTotal, 1);
         SUB_GAUGE(mBufferedEventsTotal, item.EventSize());
         SUB_GAUGE(mBufferedDataSizeByte, item.DataSize());
+        mBufferedMemory.Sub(item.DataSize());
     }
 
     void UpdateMetricsOnFlushingGroupQueue() {
@@ -318,6 +416,7 @@ private:
         SUB_GAUGE(mBufferedGroupsTotal, mGroupQueue->GroupSize());
         SUB_GAUGE(mBufferedEventsTotal, mGroupQueue->EventSize());
         SUB_GAUGE(mBufferedDataSizeByte, mGroupQueue->DataSize());
+        mBufferedMemory.Sub(mGroupQueue->DataSize());
     }
 
     std::mutex mMux;
@@ -326,19 +425,25 @@ private:
 
     std::optional<GroupBatchItem> mGroupQueue;
     std::optional<GroupFlushStrategy> mGroupFlushStrategy;
+    std::optional<AdaptiveFlushStrategy> mAdaptiveFlushStrategy;
 
     Flusher* mFlusher = nullptr;
+    bool mBuildColumnarLogs = false;
 
     mutable MetricsRecordRef mMetricsRecordRef;
-    CounterPtr mInEventsTotal;
-    CounterPtr mInGroupDataSizeBytes;
-    CounterPtr mOutEventsTotal;
+    ShardedCounterPtr mInEventsTotal;
+    ShardedCounterPtr mInGroupDataSizeBytes;
+    ShardedCounterPtr mOutEventsTotal;
     // CounterPtr mTotalDelayMs;
     IntGaugePtr mEventBatchItemsTotal;
     IntGaugePtr mBufferedGroupsTotal;
     IntGaugePtr mBufferedEventsTotal;
     IntGaugePtr mBufferedDataSizeByte;
-    TimeCounterPtr mTotalAddTimeMs;
+    ShardedTimeCounterPtr mTotalAddTimeMs;
+    IntGaugePtr mMinSizeBytes;
+    IntGaugePtr mTimeoutSecs;
+    // guarded by mMux
+    MemoryCharge mBufferedMemory;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class BatcherUnittest;
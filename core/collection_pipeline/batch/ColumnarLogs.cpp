@@ -0,0 +1,85 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/batch/ColumnarLogs.h"
+
+#include "models/LogEvent.h"
+
+using namespace std;
+
+namespace logtail {
+
+bool ColumnarLogs::Build(const vector<PipelineEventPtr>& events) {
+    Clear();
+    size_t contentCnt = 0;
+    for (const auto& e : events) {
+        if (!e.Is<LogEvent>()) {
+            return false;
+        }
+        contentCnt += e.Cast<LogEvent>().Size();
+    }
+
+    mTimestamps.reserve(events.size());
+    mTimestampNs.reserve(events.size());
+    mHasTimestampNs.reserve(events.size());
+    mContentOffsets.reserve(events.size() + 1);
+    mKeyIds.reserve(contentCnt);
+    mValues.reserve(contentCnt);
+
+    mContentOffsets.push_back(0);
+    uint32_t prevBegin = 0;
+    for (const auto& item : events) {
+        const auto& e = item.Cast<LogEvent>();
+        uint32_t begin = static_cast<uint32_t>(mValues.size());
+        for (const auto& kv : e) {
+            // logs from the same source usually have the same keys in the same order, so the key at the same position
+            // of the previous log is checked first to avoid hash lookup
+            size_t prevPos = prevBegin + (mValues.size() - begin);
+            if (prevPos < begin && mKeys[mKeyIds[prevPos]] == kv.first) {
+                mKeyIds.push_back(mKeyIds[prevPos]);
+            } else {
+                mKeyIds.push_back(InternKey(kv.first));
+            }
+            mValues.push_back(kv.second);
+        }
+        mTimestamps.push_back(static_cast<uint32_t>(e.GetTimestamp()));
+        auto ns = e.GetTimestampNanosecond();
+        mTimestampNs.push_back(ns ? ns.value() : 0);
+        mHasTimestampNs.push_back(ns ? 1 : 0);
+        mContentOffsets.push_back(static_cast<uint32_t>(mValues.size()));
+        prevBegin = begin;
+    }
+    return true;
+}
+
+void ColumnarLogs::Clear() {
+    mKeys.clear();
+    mKeyIndex.clear();
+    mTimestamps.clear();
+    mTimestampNs.clear();
+    mHasTimestampNs.clear();
+    mContentOffsets.clear();
+    mKeyIds.clear();
+    mValues.clear();
+}
+
+uint32_t ColumnarLogs::InternKey(StringView key) {
+    auto res = mKeyIndex.try_emplace(key, static_cast<uint32_t>(mKeys.size()));
+    if (res.second) {
+        mKeys.push_back(key);
+    }
+    return res.first->second;
+}
+
+} // namespace logtail
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/StringView.h"
+#include "models/PipelineEventPtr.h"
+
+namespace logtail {
+
+// Log events of a batch laid out column by column, so that serializers can run tight loops over contiguous arrays
+// instead of casting each event and chasing pointers for each content.
+//   - contents of log i are in [GetContentBegin(i), GetContentEnd(i)) of the key id and value columns
+//   - keys are interned, i.e., each distinct key is stored once in the key table and referenced by id
+// No string is copied, so all strings refer to the source buffers of the batch and are only valid during its lifetime.
+class ColumnarLogs {
+public:
+    // return false if any event is not a log event, in which case the object is left empty
+    bool Build(const std::vector<PipelineEventPtr>& events);
+    void Clear();
+
+    size_t GetLogCnt() const { return mTimestamps.size(); }
+    uint32_t GetContentBegin(size_t log) const { return mContentOffsets[log]; }
+    uint32_t GetContentEnd(size_t log) const { return mContentOffsets[log + 1]; }
+    bool IsLogEmpty(size_t log) const { return mContentOffsets[log] == mContentOffsets[log + 1]; }
+    uint32_t GetTimestamp(size_t log) const { return mTimestamps[log]; }
+    bool HasTimestampNanosecond(size_t log) const { return mHasTimestampNs[log] != 0; }
+    uint32_t GetTimestampNanosecond(size_t log) const { return mTimestampNs[log]; }
+
+    StringView GetKey(size_t content) const { return mKeys[mKeyIds[content]]; }
+    StringView GetValue(size_t content) const { return mValues[content]; }
+    const std::vector<StringView>& GetKeys() const { return mKeys; }
+    const std::vector<uint32_t>& GetKeyIds() const { return mKeyIds; }
+    const std::vector<StringView>& GetValues() const { return mValues; }
+
+private:
+    struct KeyHash {
+        size_t operator()(StringView s) const { return std::hash<std::string_view>()({s.data(), s.size()}); }
+    };
+
+    uint32_t InternKey(StringView key);
+
+    std::vector<StringView> mKeys;
+    std::unordered_map<StringView, uint32_t, KeyHash> mKeyIndex;
+
+    // log columns, where mContentOffsets has one more element than the others
+    std::vector<uint32_t> mTimestamps;
+    std::vector<uint32_t> mTimestampNs;
+    std::vector<uint8_t> mHasTimestampNs;
+    std::vector<uint32_t> mContentOffsets;
+
+    // content columns
+    std::vector<uint32_t> mKeyIds;
+    std::vector<StringView> mValues;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ColumnarLogsUnittest;
+#endif
+};
+
+} // namespace logtail
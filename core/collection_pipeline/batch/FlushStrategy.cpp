@@ -16,6 +16,18 @@
 
 #include <cstdlib>
 
+#include <algorithm>
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_INT32(adaptive_batch_adjust_interval_secs, "interval for adaptive batching to adjust its parameters", 10);
+DEFINE_FLAG_INT32(adaptive_batch_target_send_latency_ms,
+                  "send latency above which adaptive batching makes batches larger",
+                  1000);
+DEFINE_FLAG_DOUBLE(adaptive_batch_target_compress_ratio,
+                   "compression ratio above which adaptive batching tries larger batches",
+                   0.2);
+
 using namespace std;
 
 namespace logtail {
@@ -34,4 +46,103 @@ bool EventFlushStrategy<SLSEventBatchStatus>::NeedFlushByTime(const SLSEventBatc
         || status.GetCreateTimeMinute() != e->GetTimestamp() / 60;
 }
 
+namespace {
+
+const double kFeedbackWeight = 0.2;
+const double kGrowRatio = 1.25;
+// growth for compression stops unless the ratio drops by 5% at least
+const double kMinCompressImprovement = 0.95;
+
+void UpdateMovingAverage(double& avg, double sample) {
+    avg = avg == 0.0 ? sample : avg * (1 - kFeedbackWeight) + sample * kFeedbackWeight;
+}
+
+} // namespace
+
+AdaptiveFlushStrategy::AdaptiveFlushStrategy(uint32_t minSizeBytes,
+                                             uint32_t timeoutSecs,
+                                             const AdaptiveFlushStrategyOptions& options)
+    : mOptions(options),
+      mMinSizeBytes(clamp(minSizeBytes, options.mMinSizeBytesLowerLimit, options.mMinSizeBytesUpperLimit)),
+      mTimeoutSecs(clamp(timeoutSecs, options.mTimeoutSecsLowerLimit, options.mTimeoutSecsUpperLimit)),
+      mLastAdjustTime(chrono::steady_clock::now()) {
+}
+
+void AdaptiveFlushStrategy::OnDataArrived(size_t size) {
+    lock_guard<mutex> lock(mFeedbackMux);
+    mArrivedBytes += size;
+}
+
+void AdaptiveFlushStrategy::OnDataCompressed(size_t rawSize, size_t compressedSize) {
+    if (rawSize == 0) {
+        return;
+    }
+    lock_guard<mutex> lock(mFeedbackMux);
+    UpdateMovingAverage(mCompressRatio, static_cast<double>(compressedSize) / rawSize);
+}
+
+void AdaptiveFlushStrategy::OnSendSucceeded(chrono::milliseconds latency) {
+    lock_guard<mutex> lock(mFeedbackMux);
+    // 1ms at least, so that a sample is distinguished from no sample
+    UpdateMovingAverage(mSendLatencyMs, max(1.0, static_cast<double>(latency.count())));
+}
+
+bool AdaptiveFlushStrategy::Adjust(chrono::steady_clock::time_point now) {
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - mLastAdjustTime);
+    if (elapsed < chrono::seconds(INT32_FLAG(adaptive_batch_adjust_interval_secs)) || elapsed.count() <= 0) {
+        return false;
+    }
+    mLastAdjustTime = now;
+
+    uint64_t arrivedBytes = 0;
+    double compressRatio = 0.0, sendLatencyMs = 0.0;
+    {
+        lock_guard<mutex> lock(mFeedbackMux);
+        arrivedBytes = mArrivedBytes;
+        mArrivedBytes = 0;
+        compressRatio = mCompressRatio;
+        sendLatencyMs = mSendLatencyMs;
+    }
+
+    double size = mMinSizeBytes;
+    double targetLatencyMs = INT32_FLAG(adaptive_batch_target_send_latency_ms);
+    double targetCompressRatio = DOUBLE_FLAG(adaptive_batch_target_compress_ratio);
+    bool grow = false;
+    if (sendLatencyMs > targetLatencyMs) {
+        grow = true;
+        mCompressRatioBeforeGrowth = 0.0;
+    } else if (compressRatio > targetCompressRatio) {
+        if (mCompressRatioBeforeGrowth == 0.0 || compressRatio < mCompressRatioBeforeGrowth * kMinCompressImprovement) {
+            grow = true;
+            mCompressRatioBeforeGrowth = compressRatio;
+        } else if (compressRatio * kMinCompressImprovement > mCompressRatioBeforeGrowth) {
+            // the data itself compresses worse now, so the ratio seen before growth tells nothing any more
+            mCompressRatioBeforeGrowth = 0.0;
+        }
+    } else {
+        mCompressRatioBeforeGrowth = 0.0;
+    }
+    // fast sending shrinks batches unless they are to grow, including when compression stops improving
+    if (grow) {
+        size *= kGrowRatio;
+    } else if (sendLatencyMs > 0 && sendLatencyMs < targetLatencyMs / 2) {
+        size /= kGrowRatio;
+    }
+    uint32_t minSizeBytes = static_cast<uint32_t>(
+        clamp(size, double(mOptions.mMinSizeBytesLowerLimit), double(mOptions.mMinSizeBytesUpperLimit)));
+
+    uint32_t timeoutSecs = mOptions.mTimeoutSecsUpperLimit;
+    double arrivalRate = arrivedBytes * 1000.0 / elapsed.count();
+    if (arrivalRate > 0) {
+        timeoutSecs = static_cast<uint32_t>(clamp(minSizeBytes / arrivalRate,
+                                                  double(mOptions.mTimeoutSecsLowerLimit),
+                                                  double(mOptions.mTimeoutSecsUpperLimit)));
+    }
+
+    bool changed = minSizeBytes != mMinSizeBytes || timeoutSecs != mTimeoutSecs;
+    mMinSizeBytes = minSizeBytes;
+    mTimeoutSecs = timeoutSecs;
+    return changed;
+}
+
 } // namespace logtail
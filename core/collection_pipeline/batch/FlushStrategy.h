@@ -19,7 +19,9 @@
 #include <cstdint>
 #include <ctime>
 
+#include <chrono>
 #include <limits>
+#include <mutex>
 
 #include "json/json.h"
 
@@ -84,6 +86,54 @@ private:
     uint32_t mTimeoutSecs = 0;
 };
 
+struct AdaptiveFlushStrategyOptions {
+    uint32_t mMinSizeBytesLowerLimit = 0;
+    uint32_t mMinSizeBytesUpperLimit = 0;
+    uint32_t mTimeoutSecsLowerLimit = 0;
+    uint32_t mTimeoutSecsUpperLimit = 0;
+};
+
+// AdaptiveFlushStrategy tunes the min size and timeout of batches within the limits according to the feedback of the
+// queue. The size grows when sending is slow, so that fewer requests are made, or when the compression ratio is poor
+// and still improves with larger batches. It shrinks back when sending is fast and the data is well compressed. The
+// timeout is the time needed to fill a batch of that size at the current arrival rate, so that batches are not cut
+// short when data comes in slowly, and are not held long when it comes in fast.
+//
+// The feedback may come from any thread, while Adjust should be called by the owner of the batches only.
+class AdaptiveFlushStrategy {
+public:
+    AdaptiveFlushStrategy(uint32_t minSizeBytes, uint32_t timeoutSecs, const AdaptiveFlushStrategyOptions& options);
+
+    void OnDataArrived(size_t size);
+    void OnDataCompressed(size_t rawSize, size_t compressedSize);
+    void OnSendSucceeded(std::chrono::milliseconds latency);
+
+    // the parameters are reevaluated once per adjust interval, returns true if they are changed
+    bool Adjust(std::chrono::steady_clock::time_point now);
+
+    uint32_t GetMinSizeBytes() const { return mMinSizeBytes; }
+    uint32_t GetTimeoutSecs() const { return mTimeoutSecs; }
+
+private:
+    AdaptiveFlushStrategyOptions mOptions;
+    uint32_t mMinSizeBytes = 0;
+    uint32_t mTimeoutSecs = 0;
+    std::chrono::steady_clock::time_point mLastAdjustTime;
+    // the compression ratio seen when the size last grew for compression, 0 if compression does not drive the size
+    double mCompressRatioBeforeGrowth = 0.0;
+
+    std::mutex mFeedbackMux;
+    uint64_t mArrivedBytes = 0;
+    // moving averages, 0 if there is no sample yet
+    double mCompressRatio = 0.0;
+    double mSendLatencyMs = 0.0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class AdaptiveFlushStrategyUnittest;
+    friend class BatcherUnittest;
+#endif
+};
+
 template <>
 bool EventFlushStrategy<SLSEventBatchStatus>::NeedFlushByTime(const SLSEventBatchStatus& status,
                                                               const PipelineEventPtr& e);
@@ -26,7 +26,8 @@ void TimeoutFlushManager::UpdateRecord(
     if (it == item.end()) {
         item.try_emplace({index, key}, f, key, timeoutSecs);
     } else {
-        it->second.Update();
+        // the timeout may have been adjusted since the record was created
+        it->second.Update(timeoutSecs);
     }
 }
 
@@ -39,7 +39,10 @@ struct TimeoutRecord {
     TimeoutRecord(Flusher* flusher, size_t key, uint32_t timeoutSecs)
         : mFlusher(flusher), mKey(key), mUpdateTime(time(nullptr)), mTimeoutSecs(timeoutSecs) {}
 
-    void Update() { mUpdateTime = time(nullptr); }
+    void Update(uint32_t timeoutSecs) {
+        mUpdateTime = time(nullptr);
+        mTimeoutSecs = timeoutSecs;
+    }
 };
 
 class TimeoutFlushManager {
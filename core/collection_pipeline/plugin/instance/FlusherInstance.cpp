@@ -32,10 +32,11 @@ bool FlusherInstance::Init(const Json::Value& config,
         return false;
     }
 
-    mInGroupsTotal = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_EVENT_GROUPS_TOTAL);
-    mInEventsTotal = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_EVENTS_TOTAL);
-    mInSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_SIZE_BYTES);
-    mTotalPackageTimeMs = mPlugin->GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_FLUSHER_TOTAL_PACKAGE_TIME_MS);
+    mInGroupsTotal = mPlugin->GetMetricsRecordRef().CreateShardedCounter(METRIC_PLUGIN_IN_EVENT_GROUPS_TOTAL);
+    mInEventsTotal = mPlugin->GetMetricsRecordRef().CreateShardedCounter(METRIC_PLUGIN_IN_EVENTS_TOTAL);
+    mInSizeBytes = mPlugin->GetMetricsRecordRef().CreateShardedCounter(METRIC_PLUGIN_IN_SIZE_BYTES);
+    mTotalPackageTimeMs
+        = mPlugin->GetMetricsRecordRef().CreateShardedTimeCounter(METRIC_PLUGIN_FLUSHER_TOTAL_PACKAGE_TIME_MS);
     return true;
 }
 
@@ -50,10 +50,10 @@ public:
 private:
     std::unique_ptr<Flusher> mPlugin;
 
-    CounterPtr mInGroupsTotal;
-    CounterPtr mInEventsTotal;
-    CounterPtr mInSizeBytes;
-    TimeCounterPtr mTotalPackageTimeMs;
+    ShardedCounterPtr mInGroupsTotal;
+    ShardedCounterPtr mInEventsTotal;
+    ShardedCounterPtr mInSizeBytes;
+    ShardedTimeCounterPtr mTotalPackageTimeMs;
 };
 
 } // namespace logtail
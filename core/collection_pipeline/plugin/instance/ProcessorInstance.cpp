@@ -34,31 +34,60 @@ bool ProcessorInstance::Init(const Json::Value& config, CollectionPipelineContex
     }
 
     // should init plugin first， then could GetMetricsRecordRef from plugin
-    mInEventsTotal = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_EVENTS_TOTAL);
-    mOutEventsTotal = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_EVENTS_TOTAL);
-    mInSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_SIZE_BYTES);
-    mOutSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_SIZE_BYTES);
-    mTotalProcessTimeMs = mPlugin->GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS);
+    mInEventsTotal = mPlugin->GetMetricsRecordRef().CreateShardedCounter(METRIC_PLUGIN_IN_EVENTS_TOTAL);
+    mOutEventsTotal = mPlugin->GetMetricsRecordRef().CreateShardedCounter(METRIC_PLUGIN_OUT_EVENTS_TOTAL);
+    mInSizeBytes = mPlugin->GetMetricsRecordRef().CreateShardedCounter(METRIC_PLUGIN_IN_SIZE_BYTES);
+    mOutSizeBytes = mPlugin->GetMetricsRecordRef().CreateShardedCounter(METRIC_PLUGIN_OUT_SIZE_BYTES);
+    mTotalProcessTimeMs = mPlugin->GetMetricsRecordRef().CreateShardedTimeCounter(METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS);
+
+    if (ProcessorProfiler::IsEnabled()) {
+        mProfiler = make_unique<ProcessorProfiler>(context.GetConfigName() + ";" + Name() + "/" + PluginID(),
+                                                   mPlugin->GetMetricsRecordRef());
+    }
 
     return true;
 }
 
-void ProcessorInstance::Process(vector<PipelineEventGroup>& eventGroupList) {
+void ProcessorInstance::Process(vector<PipelineEventGroup>& eventGroupList, bool profile) {
     if (eventGroupList.empty()) {
         return;
     }
+    ProcessorProfiler::Sample sample;
     for (const auto& eventGroup : eventGroupList) {
         ADD_COUNTER(mInEventsTotal, eventGroup.GetEvents().size());
         ADD_COUNTER(mInSizeBytes, eventGroup.DataSize());
+        sample.mInEventsCnt += eventGroup.GetEvents().size();
+    }
+
+    profile = profile && mProfiler;
+    uint64_t cpuTimeBefore = 0;
+    uint64_t allocatedBefore = 0;
+    if (profile) {
+        sample.mEventGroupsCnt = eventGroupList.size();
+        allocatedBefore = ProcessorProfiler::GetAllocatedBytes(eventGroupList);
+        cpuTimeBefore = ProcessorProfiler::GetThreadCpuTimeUs();
     }
 
     auto before = chrono::system_clock::now();
     mPlugin->Process(eventGroupList);
-    ADD_COUNTER(mTotalProcessTimeMs, chrono::system_clock::now() - before);
+    auto elapsed = chrono::system_clock::now() - before;
+    ADD_COUNTER(mTotalProcessTimeMs, elapsed);
+
+    if (profile) {
+        sample.mCpuTimeUs = ProcessorProfiler::GetThreadCpuTimeUs() - cpuTimeBefore;
+        sample.mWallTimeUs = chrono::duration_cast<chrono::microseconds>(elapsed).count();
+        uint64_t allocatedAfter = ProcessorProfiler::GetAllocatedBytes(eventGroupList);
+        // groups may be dropped by the processor
+        sample.mAllocatedBytes = allocatedAfter > allocatedBefore ? allocatedAfter - allocatedBefore : 0;
+    }
 
     for (const auto& eventGroup : eventGroupList) {
         ADD_COUNTER(mOutEventsTotal, eventGroup.GetEvents().size());
         ADD_COUNTER(mOutSizeBytes, eventGroup.DataSize());
+        sample.mOutEventsCnt += eventGroup.GetEvents().size();
+    }
+    if (profile) {
+        mProfiler->Record(sample);
     }
 }
 
@@ -22,6 +22,7 @@
 
 #include "collection_pipeline/CollectionPipelineContext.h"
 #include "collection_pipeline/plugin/instance/PluginInstance.h"
+#include "collection_pipeline/plugin/instance/ProcessorProfiler.h"
 #include "collection_pipeline/plugin/interface/Processor.h"
 #include "models/PipelineEventGroup.h"
 #include "monitor/MetricManager.h"
@@ -35,19 +36,23 @@ public:
     const std::string& Name() const override { return mPlugin->Name(); };
 
     bool Init(const Json::Value& config, CollectionPipelineContext& context);
-    void Process(std::vector<PipelineEventGroup>& logGroupList);
+    // profile indicates whether the call is sampled by the profiler, see ProcessorProfiler
+    void Process(std::vector<PipelineEventGroup>& logGroupList, bool profile = false);
 
 private:
     std::unique_ptr<Processor> mPlugin;
 
-    CounterPtr mInEventsTotal;
-    CounterPtr mOutEventsTotal;
-    CounterPtr mInSizeBytes;
-    CounterPtr mOutSizeBytes;
-    TimeCounterPtr mTotalProcessTimeMs;
+    ShardedCounterPtr mInEventsTotal;
+    ShardedCounterPtr mOutEventsTotal;
+    ShardedCounterPtr mInSizeBytes;
+    ShardedCounterPtr mOutSizeBytes;
+    ShardedTimeCounterPtr mTotalProcessTimeMs;
+
+    std::unique_ptr<ProcessorProfiler> mProfiler;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorInstanceUnittest;
+    friend class ProcessorProfilerUnittest;
     friend class ProcessorParseRegexNativeUnittest;
     friend class ProcessorParseTimestampNativeUnittest;
     friend class ProcessorParseJsonNativeUnittest;
@@ -0,0 +1,260 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "collection_pipeline/plugin/instance/ProcessorProfiler.h"
+
+#include <ctime>
+
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "app_config/AppConfig.h"
+#include "common/Flags.h"
+#include "logger/Logger.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+// 0 disables profiling, 0.01 samples 1% of the process calls
+DEFINE_FLAG_DOUBLE(processor_profile_sample_rate, "sample rate of processor profiling, 0 means disabled", 0.0);
+DEFINE_FLAG_INT32(processor_profile_publish_interval_sec, "interval of publishing processor latency quantiles", 60);
+DEFINE_FLAG_STRING(processor_profile_folded_stack_file,
+                   "file to dump processor cpu time as folded stacks, relative to the agent data dir if not absolute",
+                   "");
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+mutex& GetProfilersMux() {
+    static mutex sMux;
+    return sMux;
+}
+
+set<ProcessorProfiler*>& GetProfilers() {
+    static set<ProcessorProfiler*> sProfilers;
+    return sProfilers;
+}
+
+// xorshift64*, good enough for sampling decisions and much cheaper than std::mt19937
+uint64_t NextRandom() {
+    static thread_local uint64_t sState
+        = hash<thread::id>{}(this_thread::get_id()) ^ static_cast<uint64_t>(time(nullptr)) ^ 0x9E3779B97F4A7C15ULL;
+    sState ^= sState >> 12;
+    sState ^= sState << 25;
+    sState ^= sState >> 27;
+    return sState * 0x2545F4914F6CDD1DULL;
+}
+
+} // namespace
+
+void LatencyHistogram::Record(uint64_t value) {
+    mBuckets[GetBucketIndex(value)].fetch_add(1, memory_order_relaxed);
+    mCount.fetch_add(1, memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::GetValueAtQuantile(double q) const {
+    uint64_t total = 0;
+    array<uint64_t, kBucketCnt> buckets;
+    for (size_t i = 0; i < kBucketCnt; ++i) {
+        buckets[i] = mBuckets[i].load(memory_order_relaxed);
+        total += buckets[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    q = min(max(q, 0.0), 1.0);
+    uint64_t target = max<uint64_t>(1, static_cast<uint64_t>(q * total + 0.5));
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < kBucketCnt; ++i) {
+        accumulated += buckets[i];
+        if (accumulated >= target) {
+            return GetBucketUpperBound(i);
+        }
+    }
+    return GetMax();
+}
+
+uint64_t LatencyHistogram::GetMax() const {
+    for (size_t i = kBucketCnt; i > 0; --i) {
+        if (mBuckets[i - 1].load(memory_order_relaxed) != 0) {
+            return GetBucketUpperBound(i - 1);
+        }
+    }
+    return 0;
+}
+
+void LatencyHistogram::Reset() {
+    for (auto& bucket : mBuckets) {
+        bucket.store(0, memory_order_relaxed);
+    }
+    mCount.store(0, memory_order_relaxed);
+}
+
+size_t LatencyHistogram::GetBucketIndex(uint64_t value) {
+    if (value < kSubBuckets) {
+        return static_cast<size_t>(value);
+    }
+    size_t shift = 63 - __builtin_clzll(value) - kSubBucketBits;
+    size_t sub = static_cast<size_t>(value >> shift) & (kSubBuckets - 1);
+    return (shift + 1) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::GetBucketUpperBound(size_t index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    size_t shift = index / kSubBuckets - 1;
+    uint64_t lower = static_cast<uint64_t>(kSubBuckets + index % kSubBuckets) << shift;
+    return lower + ((1ULL << shift) - 1);
+}
+
+ProcessorProfiler::ProcessorProfiler(const string& frames, MetricsRecordRef& metricsRecordRef) : mFrames(frames) {
+    mSampledEventGroupsTotal = metricsRecordRef.CreateCounter(METRIC_PLUGIN_PROFILE_SAMPLED_EVENT_GROUPS_TOTAL);
+    mWallTimeUs = metricsRecordRef.CreateCounter(METRIC_PLUGIN_PROFILE_WALL_TIME_US);
+    mCpuTimeUs = metricsRecordRef.CreateCounter(METRIC_PLUGIN_PROFILE_CPU_TIME_US);
+    mAllocatedBytes = metricsRecordRef.CreateCounter(METRIC_PLUGIN_PROFILE_ALLOCATED_BYTES);
+    mInEventsTotal = metricsRecordRef.CreateCounter(METRIC_PLUGIN_PROFILE_IN_EVENTS_TOTAL);
+    mOutEventsTotal = metricsRecordRef.CreateCounter(METRIC_PLUGIN_PROFILE_OUT_EVENTS_TOTAL);
+    mLatencyP50Us = metricsRecordRef.CreateIntGauge(METRIC_PLUGIN_PROFILE_LATENCY_P50_US);
+    mLatencyP90Us = metricsRecordRef.CreateIntGauge(METRIC_PLUGIN_PROFILE_LATENCY_P90_US);
+    mLatencyP99Us = metricsRecordRef.CreateIntGauge(METRIC_PLUGIN_PROFILE_LATENCY_P99_US);
+    mLatencyMaxUs = metricsRecordRef.CreateIntGauge(METRIC_PLUGIN_PROFILE_LATENCY_MAX_US);
+    mLastPublishTime.store(time(nullptr), memory_order_relaxed);
+
+    lock_guard<mutex> lock(GetProfilersMux());
+    GetProfilers().insert(this);
+}
+
+ProcessorProfiler::~ProcessorProfiler() {
+    lock_guard<mutex> lock(GetProfilersMux());
+    GetProfilers().erase(this);
+}
+
+void ProcessorProfiler::Record(const Sample& sample) {
+    ADD_COUNTER(mSampledEventGroupsTotal, sample.mEventGroupsCnt);
+    ADD_COUNTER(mWallTimeUs, sample.mWallTimeUs);
+    ADD_COUNTER(mCpuTimeUs, sample.mCpuTimeUs);
+    ADD_COUNTER(mAllocatedBytes, sample.mAllocatedBytes);
+    ADD_COUNTER(mInEventsTotal, sample.mInEventsCnt);
+    ADD_COUNTER(mOutEventsTotal, sample.mOutEventsCnt);
+    mLatencyUs.Record(sample.mWallTimeUs);
+    mTotalCpuTimeUs.fetch_add(sample.mCpuTimeUs, memory_order_relaxed);
+
+    int64_t now = time(nullptr);
+    int64_t last = mLastPublishTime.load(memory_order_relaxed);
+    // only one of the concurrent recorders wins the publication
+    if (now - last >= INT32_FLAG(processor_profile_publish_interval_sec)
+        && mLastPublishTime.compare_exchange_strong(last, now, memory_order_relaxed)) {
+        PublishLatency();
+    }
+}
+
+void ProcessorProfiler::PublishLatency() {
+    // quantiles are computed over the samples of the last interval only. Samples recorded concurrently with the
+    // reset may be lost, which is acceptable for profiling.
+    SET_GAUGE(mLatencyP50Us, mLatencyUs.GetValueAtQuantile(0.5));
+    SET_GAUGE(mLatencyP90Us, mLatencyUs.GetValueAtQuantile(0.9));
+    SET_GAUGE(mLatencyP99Us, mLatencyUs.GetValueAtQuantile(0.99));
+    SET_GAUGE(mLatencyMaxUs, mLatencyUs.GetMax());
+    mLatencyUs.Reset();
+}
+
+bool ProcessorProfiler::IsEnabled() {
+    return DOUBLE_FLAG(processor_profile_sample_rate) > 0.0;
+}
+
+bool ProcessorProfiler::ShouldSample() {
+    double rate = DOUBLE_FLAG(processor_profile_sample_rate);
+    if (rate <= 0.0) {
+        return false;
+    }
+    if (rate >= 1.0) {
+        return true;
+    }
+    // top 53 bits as a uniform double in [0, 1)
+    return static_cast<double>(NextRandom() >> 11) * (1.0 / 9007199254740992.0) < rate;
+}
+
+uint64_t ProcessorProfiler::GetThreadCpuTimeUs() {
+#if defined(__linux__)
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + static_cast<uint64_t>(ts.tv_nsec) / 1000;
+#else
+    return 0;
+#endif
+}
+
+uint64_t ProcessorProfiler::GetAllocatedBytes(vector<PipelineEventGroup>& groups) {
+    uint64_t res = 0;
+    const SourceBuffer* last = nullptr;
+    for (auto& group : groups) {
+        const auto* buffer = group.GetSourceBuffer().get();
+        // groups split from the same one share the source buffer and are usually adjacent
+        if (buffer == nullptr || buffer == last) {
+            continue;
+        }
+        res += static_cast<uint64_t>(buffer->GetUsedSize());
+        last = buffer;
+    }
+    return res;
+}
+
+bool ProcessorProfiler::DumpFoldedStacks() {
+    const string& file = STRING_FLAG(processor_profile_folded_stack_file);
+    if (file.empty()) {
+        return false;
+    }
+    filesystem::path path(file);
+    if (path.is_relative()) {
+        path = filesystem::path(GetAgentDataDir()) / path;
+    }
+    return DumpFoldedStacks(path.string());
+}
+
+bool ProcessorProfiler::DumpFoldedStacks(const string& path) {
+    // the file is regenerated as a whole, so that readers never see a partial one
+    string tmpPath = path + ".tmp";
+    {
+        ofstream fout(tmpPath, ios::trunc);
+        if (!fout) {
+            LOG_WARNING(sLogger, ("failed to open processor profile file", tmpPath));
+            return false;
+        }
+        lock_guard<mutex> lock(GetProfilersMux());
+        for (const auto* profiler : GetProfilers()) {
+            uint64_t cpuTimeUs = profiler->mTotalCpuTimeUs.load(memory_order_relaxed);
+            if (cpuTimeUs > 0) {
+                fout << profiler->mFrames << " " << cpuTimeUs << "\n";
+            }
+        }
+    }
+    error_code ec;
+    filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        LOG_WARNING(sLogger, ("failed to dump processor profile file", path)("error", ec.message()));
+        return false;
+    }
+    return true;
+}
+
+} // namespace logtail
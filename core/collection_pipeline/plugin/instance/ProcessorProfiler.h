@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "models/PipelineEventGroup.h"
+#include "monitor/MetricManager.h"
+
+namespace logtail {
+
+// HDR-style histogram with log-linear buckets: every power of two is split into kSubBuckets linear buckets, so the
+// relative error of any recorded value is below 1 / kSubBuckets over the whole uint64 range.
+// Recording is lock free and can be done from multiple threads concurrently.
+class LatencyHistogram {
+public:
+    static constexpr size_t kSubBucketBits = 3;
+    static constexpr size_t kSubBuckets = 1 << kSubBucketBits;
+    static constexpr size_t kBucketCnt = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    void Record(uint64_t value);
+    uint64_t GetCount() const { return mCount.load(std::memory_order_relaxed); }
+    // returns the upper bound of the bucket containing the q-th quantile, q in [0, 1]
+    uint64_t GetValueAtQuantile(double q) const;
+    uint64_t GetMax() const;
+    void Reset();
+
+    static size_t GetBucketIndex(uint64_t value);
+    static uint64_t GetBucketUpperBound(size_t index);
+
+private:
+    std::array<std::atomic_uint64_t, kBucketCnt> mBuckets{};
+    std::atomic_uint64_t mCount{0};
+};
+
+// Sampling profiler of a single processor instance.
+// When enabled, CollectionPipeline::Process decides once per call whether to sample, and all processors of the
+// pipeline record their cost for the sampled call. Latency quantiles are published to the plugin metrics record
+// periodically, while the accumulated cpu time can be dumped as folded stacks for flamegraph tools.
+class ProcessorProfiler {
+public:
+    struct Sample {
+        uint64_t mWallTimeUs = 0;
+        uint64_t mCpuTimeUs = 0;
+        uint64_t mAllocatedBytes = 0;
+        uint64_t mInEventsCnt = 0;
+        uint64_t mOutEventsCnt = 0;
+        uint64_t mEventGroupsCnt = 0;
+    };
+
+    // frames is the folded stack of the processor, i.e. "<pipeline>;<processor>"
+    ProcessorProfiler(const std::string& frames, MetricsRecordRef& metricsRecordRef);
+    ~ProcessorProfiler();
+    ProcessorProfiler(const ProcessorProfiler&) = delete;
+    ProcessorProfiler& operator=(const ProcessorProfiler&) = delete;
+
+    void Record(const Sample& sample);
+
+    static bool IsEnabled();
+    static bool ShouldSample();
+    static uint64_t GetThreadCpuTimeUs();
+    // total bytes allocated from the source buffers of the groups
+    static uint64_t GetAllocatedBytes(std::vector<PipelineEventGroup>& groups);
+    // writes the accumulated cpu time of all processors to the file specified by flag, if any
+    static bool DumpFoldedStacks();
+    static bool DumpFoldedStacks(const std::string& path);
+
+private:
+    void PublishLatency();
+
+    std::string mFrames;
+    LatencyHistogram mLatencyUs;
+    std::atomic_uint64_t mTotalCpuTimeUs{0};
+    std::atomic_int64_t mLastPublishTime{0};
+
+    CounterPtr mSampledEventGroupsTotal;
+    CounterPtr mWallTimeUs;
+    CounterPtr mCpuTimeUs;
+    CounterPtr mAllocatedBytes;
+    CounterPtr mInEventsTotal;
+    CounterPtr mOutEventsTotal;
+    IntGaugePtr mLatencyP50Us;
+    IntGaugePtr mLatencyP90Us;
+    IntGaugePtr mLatencyP99Us;
+    IntGaugePtr mLatencyMaxUs;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ProcessorProfilerUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -37,6 +37,7 @@ bool BoundedProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     }
     item->mEnqueTime = chrono::system_clock::now();
     auto size = item->mEventGroup.DataSize();
+    item->mMemoryCharge = MemoryCharge(MemoryCategory::PROCESS_QUEUE, mPipelineMemoryUsage, size);
     mQueue.push_back(std::move(item));
     ChangeStateIfNeededAfterPush();
 
@@ -14,6 +14,22 @@
 
 #include "collection_pipeline/queue/BoundedSenderQueueInterface.h"
 
+#include <filesystem>
+
+#include "app_config/AppConfig.h"
+#include "common/Flags.h"
+#include "common/StringTools.h"
+#include "common/memory/MemoryAccountant.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_BOOL(enable_sender_queue_spill, "move data overflowing sender queues to disk", true);
+DEFINE_FLAG_INT64(sender_queue_spill_threshold_bytes,
+                  "data size of the extra buffer of a sender queue, above which new data is spilled to disk",
+                  16 * 1024 * 1024);
+DEFINE_FLAG_INT64(sender_queue_spill_max_bytes,
+                  "max disk size used by the spill log of a sender queue",
+                  2LL * 1024 * 1024 * 1024);
+
 
 using namespace std;
 
@@ -30,6 +46,8 @@ BoundedSenderQueueInterface::BoundedSenderQueueInterface(
     mFetchRejectedByRateLimiterTimesCnt
         = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_RATE_LIMITER_TIMES_TOTAL);
     mExtraBufferDataSizeBytes = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE_BYTES);
+    mSpilledItemsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_SPILLED_ITEMS_TOTAL);
+    mSpilledDataSizeBytes = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_SPILLED_SIZE_BYTES);
 }
 
 void BoundedSenderQueueInterface::SetFeedback(FeedbackInterface* feedback) {
@@ -40,6 +58,11 @@ void BoundedSenderQueueInterface::SetFeedback(FeedbackInterface* feedback) {
     sFeedback = feedback;
 }
 
+void BoundedSenderQueueInterface::RemoveStaleSpillLogs() {
+    error_code ec;
+    filesystem::remove_all(filesystem::path(GetAgentDataDir()) / "sender_queue_spill", ec);
+}
+
 void BoundedSenderQueueInterface::SetRateLimiter(uint32_t maxRate) {
     if (maxRate > 0) {
         mRateLimiter = RateLimiter(maxRate);
@@ -75,10 +98,95 @@ void BoundedSenderQueueInterface::GiveFeedback() const {
 
 void BoundedSenderQueueInterface::Reset(size_t cap, size_t low, size_t high) {
     deque<unique_ptr<SenderQueueItem>>().swap(mExtraBuffer);
+    mExtraBufferInMemoryBytes = 0;
+    mSpillLog.reset();
+    mSpilledItemsCnt = 0;
+    mSpilledBytes = 0;
+    SET_GAUGE(mExtraBufferSize, 0);
+    SET_GAUGE(mExtraBufferDataSizeBytes, 0);
+    SET_GAUGE(mSpilledItemsTotal, 0);
+    SET_GAUGE(mSpilledDataSizeBytes, 0);
     mRateLimiter.reset();
     mConcurrencyLimiters.clear();
     BoundedQueueInterface::Reset(low, high);
     QueueInterface::Reset(cap);
 }
 
+void BoundedSenderQueueInterface::PushToExtraBuffer(unique_ptr<SenderQueueItem>&& item) {
+    if (NeedSpill() && Spill(*item)) {
+        ++mSpilledItemsCnt;
+        mSpilledBytes += item->mSpillRecord->mSize;
+        SET_GAUGE(mSpilledItemsTotal, mSpilledItemsCnt);
+        SET_GAUGE(mSpilledDataSizeBytes, mSpilledBytes);
+    } else {
+        mExtraBufferInMemoryBytes += item->mData.size();
+        SET_GAUGE(mExtraBufferDataSizeBytes, mExtraBufferInMemoryBytes);
+    }
+    mExtraBuffer.push_back(std::move(item));
+    SET_GAUGE(mExtraBufferSize, mExtraBuffer.size());
+}
+
+unique_ptr<SenderQueueItem> BoundedSenderQueueInterface::PopFromExtraBuffer() {
+    if (mExtraBuffer.empty()) {
+        return nullptr;
+    }
+    auto item = std::move(mExtraBuffer.front());
+    mExtraBuffer.pop_front();
+    SET_GAUGE(mExtraBufferSize, mExtraBuffer.size());
+    if (!item->mSpillRecord) {
+        mExtraBufferInMemoryBytes -= item->mData.size();
+        SET_GAUGE(mExtraBufferDataSizeBytes, mExtraBufferInMemoryBytes);
+        return item;
+    }
+    --mSpilledItemsCnt;
+    mSpilledBytes -= item->mSpillRecord->mSize;
+    SET_GAUGE(mSpilledItemsTotal, mSpilledItemsCnt);
+    SET_GAUGE(mSpilledDataSizeBytes, mSpilledBytes);
+    if (mSpilledItemsCnt == 0) {
+        // the items not loaded yet keep the log alive
+        mSpillLog.reset();
+    }
+    return item;
+}
+
+bool BoundedSenderQueueInterface::NeedSpill() const {
+    if (!BOOL_FLAG(enable_sender_queue_spill)) {
+        return false;
+    }
+    return mExtraBufferInMemoryBytes >= static_cast<size_t>(INT64_FLAG(sender_queue_spill_threshold_bytes))
+        || MemoryAccountant::GetInstance()->ShouldSpill();
+}
+
+bool BoundedSenderQueueInterface::Spill(SenderQueueItem& item) {
+    if (mSpillLog
+        && mSpillLog->GetDiskSize() + item.mData.size()
+            > static_cast<uint64_t>(INT64_FLAG(sender_queue_spill_max_bytes))) {
+        return false;
+    }
+    if (!mSpillLog) {
+        mSpillLog = make_shared<SpillLog>(GetSpillDir());
+    }
+    SpillRecord record;
+    if (!mSpillLog->Append(item.mData, record)) {
+        static int32_t sLastWarningTime = 0;
+        int32_t curTime = time(nullptr);
+        if (curTime - sLastWarningTime > 600) {
+            sLastWarningTime = curTime;
+            LOG_WARNING(sLogger, ("failed to spill data of sender queue", "keep it in memory")("queue key", mKey));
+        }
+        return false;
+    }
+    item.mSpillRecord = record;
+    item.mSpillLog = mSpillLog;
+    string().swap(item.mData);
+    item.mMemoryCharge.Reset();
+    return true;
+}
+
+string BoundedSenderQueueInterface::GetSpillDir() {
+    return (filesystem::path(GetAgentDataDir()) / "sender_queue_spill"
+            / (ToString(mKey) + "_" + ToString(mSpillLogCnt++)))
+        .string();
+}
+
 } // namespace logtail
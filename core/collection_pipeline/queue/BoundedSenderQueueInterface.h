@@ -27,6 +27,7 @@
 #include "collection_pipeline/queue/BoundedQueueInterface.h"
 #include "collection_pipeline/queue/QueueKey.h"
 #include "collection_pipeline/queue/SenderQueueItem.h"
+#include "collection_pipeline/queue/SpillLog.h"
 #include "common/FeedbackInterface.h"
 
 namespace logtail {
@@ -37,6 +38,8 @@ class Flusher;
 class BoundedSenderQueueInterface : public BoundedQueueInterface<std::unique_ptr<SenderQueueItem>> {
 public:
     static void SetFeedback(FeedbackInterface* feedback);
+    // spill logs of the previous process are useless, since the items referring to them are gone
+    static void RemoveStaleSpillLogs();
 
     BoundedSenderQueueInterface(size_t cap,
                                 size_t low,
@@ -70,6 +73,15 @@ protected:
     void GiveFeedback() const override;
     void Reset(size_t cap, size_t low, size_t high);
 
+    // Items overflowing the queue are kept in the extra buffer. Once the data of the extra buffer grows too large, or
+    // the memory pressure is high, the data of new items is moved to the spill log, while the items themselves stay in
+    // the extra buffer to keep the order. The data is read back by the sending thread with LoadSpilledData, and the
+    // spill log is dropped once no spilled item is left in the extra buffer, which removes it after the last spilled
+    // item is loaded.
+    void PushToExtraBuffer(std::unique_ptr<SenderQueueItem>&& item);
+    // returns nullptr if the extra buffer is empty
+    std::unique_ptr<SenderQueueItem> PopFromExtraBuffer();
+
     std::optional<RateLimiter> mRateLimiter;
     std::vector<std::pair<std::shared_ptr<ConcurrencyLimiter>, CounterPtr>> mConcurrencyLimiters;
 
@@ -82,8 +94,24 @@ protected:
 private:
     virtual void PushFromExtraBuffer(std::unique_ptr<SenderQueueItem>&& item) = 0;
 
+    bool NeedSpill() const;
+    bool Spill(SenderQueueItem& item);
+    std::string GetSpillDir();
+
+    // data size of the items in the extra buffer which are not spilled
+    size_t mExtraBufferInMemoryBytes = 0;
+    std::shared_ptr<SpillLog> mSpillLog;
+    // spill logs of the queue may outlive the queue's reference, so each one has a directory of its own
+    size_t mSpillLogCnt = 0;
+    size_t mSpilledItemsCnt = 0;
+    size_t mSpilledBytes = 0;
+
+    IntGaugePtr mSpilledItemsTotal;
+    IntGaugePtr mSpilledDataSizeBytes;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class FlusherUnittest;
+    friend class SenderQueueUnittest;
 #endif
 };
 
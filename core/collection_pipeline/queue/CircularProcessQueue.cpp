@@ -48,6 +48,7 @@ bool CircularProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     }
     item->mEnqueTime = chrono::system_clock::now();
     auto size = item->mEventGroup.DataSize();
+    item->mMemoryCharge = MemoryCharge(MemoryCategory::PROCESS_QUEUE, mPipelineMemoryUsage, size);
     mQueue.push_back(std::move(item));
     mEventCnt += newCnt;
 
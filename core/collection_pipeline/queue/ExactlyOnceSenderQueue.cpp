@@ -57,6 +57,7 @@ bool ExactlyOnceSenderQueue::Push(unique_ptr<SenderQueueItem>&& item) {
             mMetricsRecordRef.CreateCounter(ConcurrencyLimiter::GetLimiterMetricName("logstore")));
         mIsInitialised = true;
     }
+    item->mMemoryCharge = MemoryCharge(MemoryCategory::SENDER_QUEUE, mPipelineMemoryUsage, item->mData.size());
 
     auto ptr = static_cast<SLSSenderQueueItem*>(item.get());
     auto& eo = ptr->mExactlyOnceCheckpoint;
@@ -85,7 +86,7 @@ bool ExactlyOnceSenderQueue::Push(unique_ptr<SenderQueueItem>&& item) {
         }
         if (!eo->IsComplete()) {
             item->mFirstEnqueTime = chrono::system_clock::now();
-            mExtraBuffer.push_back(std::move(item));
+            PushToExtraBuffer(std::move(item));
             return true;
         }
     }
@@ -107,9 +108,8 @@ bool ExactlyOnceSenderQueue::Remove(SenderQueueItem* item) {
     mQueue[eo->index].reset();
     --mSize;
 
-    if (!mExtraBuffer.empty()) {
-        PushFromExtraBuffer(std::move(mExtraBuffer.front()));
-        mExtraBuffer.pop_front();
+    if (auto next = PopFromExtraBuffer()) {
+        PushFromExtraBuffer(std::move(next));
         return true;
     }
     if (ChangeStateIfNeededAfterPop()) {
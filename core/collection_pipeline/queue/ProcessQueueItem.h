@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "collection_pipeline/CollectionPipelineManager.h"
+#include "common/memory/MemoryAccountant.h"
 #include "models/PipelineEventGroup.h"
 
 namespace logtail {
@@ -31,6 +32,8 @@ struct ProcessQueueItem {
     std::shared_ptr<CollectionPipeline> mPipeline; // not null only during pipeline update
     size_t mInputIndex = 0; // index of the input in the pipeline
     std::chrono::system_clock::time_point mEnqueTime;
+    // the group in the queue and during processing
+    MemoryCharge mMemoryCharge;
 
     ProcessQueueItem(PipelineEventGroup&& group, size_t index) : mEventGroup(std::move(group)), mInputIndex(index) {}
 
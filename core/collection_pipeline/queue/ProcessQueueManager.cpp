@@ -19,8 +19,13 @@
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
 #include "common/Flags.h"
+#include "common/StringTools.h"
+#include "monitor/metric_constants/MetricConstants.h"
 
 DEFINE_FLAG_INT32(bounded_process_queue_capacity, "", 5);
+DEFINE_FLAG_BOOL(enable_process_queue_sharding,
+                 "whether each processor thread should own a shard of process queues and steal from others when idle",
+                 false);
 
 DECLARE_FLAG_INT32(process_thread_count);
 
@@ -30,12 +35,16 @@ namespace logtail {
 
 ProcessQueueManager::ProcessQueueManager() : mBoundedQueueParam(INT32_FLAG(bounded_process_queue_capacity)) {
     ResetCurrentQueueIndex();
+    if (BOOL_FLAG(enable_process_queue_sharding)) {
+        InitShards(static_cast<size_t>(INT32_FLAG(process_thread_count)));
+    }
 }
 
 bool ProcessQueueManager::CreateOrUpdateBoundedQueue(QueueKey key,
                                                      uint32_t priority,
                                                      const CollectionPipelineContext& ctx) {
     lock_guard<mutex> lock(mQueueMux);
+    auto shardLock = LockShard(key);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
         if (iter->second.second != QueueType::BOUNDED) {
@@ -52,8 +61,10 @@ bool ProcessQueueManager::CreateOrUpdateBoundedQueue(QueueKey key,
     } else {
         CreateBoundedQueue(key, priority, ctx);
     }
-    if (mCurrentQueueIndex.second == mPriorityQueue[mCurrentQueueIndex.first].end()) {
-        mCurrentQueueIndex.second = mPriorityQueue[mCurrentQueueIndex.first].begin();
+    auto queues = GetPriorityQueue(key);
+    auto& index = GetCurrentQueueIndex(key);
+    if (index.second == queues[index.first].end()) {
+        index.second = queues[index.first].begin();
     }
     return true;
 }
@@ -63,6 +74,7 @@ bool ProcessQueueManager::CreateOrUpdateCircularQueue(QueueKey key,
                                                       size_t capacity,
                                                       const CollectionPipelineContext& ctx) {
     lock_guard<mutex> lock(mQueueMux);
+    auto shardLock = LockShard(key);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
         if (iter->second.second != QueueType::CIRCULAR) {
@@ -80,8 +92,10 @@ bool ProcessQueueManager::CreateOrUpdateCircularQueue(QueueKey key,
     } else {
         CreateCircularQueue(key, priority, capacity, ctx);
     }
-    if (mCurrentQueueIndex.second == mPriorityQueue[mCurrentQueueIndex.first].end()) {
-        mCurrentQueueIndex.second = mPriorityQueue[mCurrentQueueIndex.first].begin();
+    auto queues = GetPriorityQueue(key);
+    auto& index = GetCurrentQueueIndex(key);
+    if (index.second == queues[index.first].end()) {
+        index.second = queues[index.first].begin();
     }
     return true;
 }
@@ -92,6 +106,7 @@ bool ProcessQueueManager::DeleteQueue(QueueKey key) {
     if (iter == mQueues.end()) {
         return false;
     }
+    auto shardLock = LockShard(key);
     DeleteQueueEntity(iter->second.first);
     QueueKeyManager::GetInstance()->RemoveKey(iter->first);
     mQueues.erase(iter);
@@ -102,6 +117,7 @@ bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
     lock_guard<mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
+        auto shardLock = LockShard(key);
         if (iter->second.second == QueueType::BOUNDED) {
             return static_cast<BoundedProcessQueue*>(iter->second.first->get())->IsValidToPush();
         } else {
@@ -116,6 +132,7 @@ QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueue
         lock_guard<mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
+            auto shardLock = LockShard(key);
             if (!(*iter->second.first)->Push(std::move(item))) {
                 return QueueStatus::QUEUE_FULL;
             }
@@ -132,60 +149,18 @@ QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueue
 
 bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>& item, string& configName) {
     configName.clear();
+    if (!mShards.empty()) {
+        return PopItemFromShards(threadNo, item, configName);
+    }
     lock_guard<mutex> lock(mQueueMux);
-    for (size_t i = 0; i <= sMaxPriority; ++i) {
-        ProcessQueueIterator iter;
-        if (mCurrentQueueIndex.first == i) {
-            for (iter = mCurrentQueueIndex.second; iter != mPriorityQueue[i].end(); ++iter) {
-                if (!(*iter)->Pop(item)) {
-                    continue;
-                }
-                configName = (*iter)->GetConfigName();
-                break;
-            }
-            if (configName.empty()) {
-                for (iter = mPriorityQueue[i].begin(); iter != mCurrentQueueIndex.second; ++iter) {
-                    if (!(*iter)->Pop(item)) {
-                        continue;
-                    }
-                    configName = (*iter)->GetConfigName();
-                    break;
-                }
-            }
-        } else {
-            for (iter = mPriorityQueue[i].begin(); iter != mPriorityQueue[i].end(); ++iter) {
-                if (!(*iter)->Pop(item)) {
-                    continue;
-                }
-                configName = (*iter)->GetConfigName();
-                break;
-            }
-        }
-        if (!configName.empty()) {
-            mCurrentQueueIndex.first = i;
-            mCurrentQueueIndex.second = ++iter;
-            if (mCurrentQueueIndex.second == mPriorityQueue[i].end()) {
-                mCurrentQueueIndex.second = mPriorityQueue[i].begin();
-            }
+    for (uint32_t i = 0; i <= sMaxPriority; ++i) {
+        if (PopItemFromPriorityQueue(mPriorityQueue, mCurrentQueueIndex, i, item, configName)) {
             return true;
         }
         // find exactly once queues next
-        {
-            lock_guard<mutex> lock(ExactlyOnceQueueManager::GetInstance()->mProcessQueueMux);
-            for (auto iter = ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[i].begin();
-                 iter != ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[i].end();
-                 ++iter) {
-                // process queue for exactly once can only be assgined to one specific thread
-                if (iter->GetKey() % INT32_FLAG(process_thread_count) != threadNo) {
-                    continue;
-                }
-                if (!iter->Pop(item)) {
-                    continue;
-                }
-                configName = iter->GetConfigName();
-                ResetCurrentQueueIndex();
-                return true;
-            }
+        if (PopItemFromExactlyOnceQueues(threadNo, i, item, configName)) {
+            ResetCurrentQueueIndex();
+            return true;
         }
     }
     ResetCurrentQueueIndex();
@@ -196,10 +171,82 @@ bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>
     return false;
 }
 
+bool ProcessQueueManager::PopItemFromShards(int64_t threadNo, unique_ptr<ProcessQueueItem>& item, string& configName) {
+    // shards are scanned without mQueueMux, so a push into an already scanned shard may trigger in the meantime
+    uint64_t triggerSeq = 0;
+    {
+        lock_guard<mutex> lock(mStateMux);
+        triggerSeq = mTriggerSeq;
+    }
+    size_t shardCnt = mShards.size();
+    size_t ownIdx = static_cast<size_t>(threadNo) % shardCnt;
+    auto& own = *mShards[ownIdx];
+    for (uint32_t i = 0; i <= sMaxPriority; ++i) {
+        {
+            lock_guard<mutex> lock(own.mMux);
+            if (PopItemFromPriorityQueue(own.mPriorityQueue, own.mCurrentQueueIndex, i, item, configName)) {
+                return true;
+            }
+        }
+        // steal from other shards with the same priority before moving to lower priority. A busy shard is skipped,
+        // since its owner thread is popping from it at the moment.
+        for (size_t j = 1; j < shardCnt; ++j) {
+            auto& victim = *mShards[(ownIdx + j) % shardCnt];
+            unique_lock<mutex> lock(victim.mMux, try_to_lock);
+            if (!lock.owns_lock()) {
+                continue;
+            }
+            if (PopItemFromPriorityQueue(victim.mPriorityQueue, victim.mCurrentQueueIndex, i, item, configName)) {
+                ADD_COUNTER(own.mStolenItemsCnt, 1);
+                return true;
+            }
+        }
+        if (PopItemFromExactlyOnceQueues(threadNo, i, item, configName)) {
+            lock_guard<mutex> lock(own.mMux);
+            ResetQueueIndex(own.mPriorityQueue, own.mCurrentQueueIndex);
+            return true;
+        }
+    }
+    {
+        lock_guard<mutex> lock(own.mMux);
+        ResetQueueIndex(own.mPriorityQueue, own.mCurrentQueueIndex);
+    }
+    ADD_COUNTER(own.mIdlePopsCnt, 1);
+    {
+        lock_guard<mutex> lock(mStateMux);
+        if (mTriggerSeq == triggerSeq) {
+            mValidToPop = false;
+        }
+    }
+    return false;
+}
+
+bool ProcessQueueManager::PopItemFromExactlyOnceQueues(int64_t threadNo,
+                                                       uint32_t priority,
+                                                       unique_ptr<ProcessQueueItem>& item,
+                                                       string& configName) {
+    lock_guard<mutex> lock(ExactlyOnceQueueManager::GetInstance()->mProcessQueueMux);
+    for (auto iter = ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[priority].begin();
+         iter != ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[priority].end();
+         ++iter) {
+        // process queue for exactly once can only be assgined to one specific thread
+        if (iter->GetKey() % INT32_FLAG(process_thread_count) != threadNo) {
+            continue;
+        }
+        if (!iter->Pop(item)) {
+            continue;
+        }
+        configName = iter->GetConfigName();
+        return true;
+    }
+    return false;
+}
+
 bool ProcessQueueManager::IsAllQueueEmpty() const {
     {
         lock_guard<mutex> lock(mQueueMux);
         for (const auto& q : mQueues) {
+            auto shardLock = LockShard(q.first);
             if (!(*q.second.first)->Empty()) {
                 return false;
             }
@@ -214,6 +261,7 @@ bool ProcessQueueManager::SetDownStreamQueues(QueueKey key, vector<BoundedSender
     if (iter == mQueues.end()) {
         return false;
     }
+    auto shardLock = LockShard(key);
     (*iter->second.first)->SetDownStreamQueues(std::move(ques));
     return true;
 }
@@ -227,6 +275,7 @@ bool ProcessQueueManager::SetFeedbackInterface(QueueKey key, vector<FeedbackInte
     if (iter->second.second == QueueType::CIRCULAR) {
         return false;
     }
+    auto shardLock = LockShard(key);
     static_cast<BoundedProcessQueue*>(iter->second.first->get())->SetUpStreamFeedbacks(std::move(feedback));
     return true;
 }
@@ -237,6 +286,7 @@ void ProcessQueueManager::DisablePop(const string& configName, bool isPipelineRe
         lock_guard<mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
+            auto shardLock = LockShard(key);
             (*iter->second.first)->DisablePop();
             if (!isPipelineRemoving) {
                 const auto& p = CollectionPipelineManager::GetInstance()->FindConfigByName(configName);
@@ -256,6 +306,7 @@ void ProcessQueueManager::EnablePop(const string& configName) {
         lock_guard<mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
+            auto shardLock = LockShard(key);
             (*iter->second.first)->EnablePop();
         }
     } else {
@@ -278,57 +329,152 @@ void ProcessQueueManager::Trigger() {
     {
         lock_guard<mutex> lock(mStateMux);
         mValidToPop = true;
+        ++mTriggerSeq;
     }
     mCond.notify_one();
 }
 
 void ProcessQueueManager::CreateBoundedQueue(QueueKey key, uint32_t priority, const CollectionPipelineContext& ctx) {
-    mPriorityQueue[priority].emplace_back(make_unique<BoundedProcessQueue>(mBoundedQueueParam.GetCapacity(),
-                                                                           mBoundedQueueParam.GetLowWatermark(),
-                                                                           mBoundedQueueParam.GetHighWatermark(),
-                                                                           key,
-                                                                           priority,
-                                                                           ctx));
-    mQueues[key] = make_pair(prev(mPriorityQueue[priority].end()), QueueType::BOUNDED);
+    auto queues = GetPriorityQueue(key);
+    queues[priority].emplace_back(make_unique<BoundedProcessQueue>(mBoundedQueueParam.GetCapacity(),
+                                                                   mBoundedQueueParam.GetLowWatermark(),
+                                                                   mBoundedQueueParam.GetHighWatermark(),
+                                                                   key,
+                                                                   priority,
+                                                                   ctx));
+    mQueues[key] = make_pair(prev(queues[priority].end()), QueueType::BOUNDED);
 }
 
 void ProcessQueueManager::CreateCircularQueue(QueueKey key,
                                               uint32_t priority,
                                               size_t capacity,
                                               const CollectionPipelineContext& ctx) {
-    mPriorityQueue[priority].emplace_back(make_unique<CircularProcessQueue>(capacity, key, priority, ctx));
-    mQueues[key] = make_pair(prev(mPriorityQueue[priority].end()), QueueType::CIRCULAR);
+    auto queues = GetPriorityQueue(key);
+    queues[priority].emplace_back(make_unique<CircularProcessQueue>(capacity, key, priority, ctx));
+    mQueues[key] = make_pair(prev(queues[priority].end()), QueueType::CIRCULAR);
 }
 
 void ProcessQueueManager::AdjustQueuePriority(const ProcessQueueIterator& iter, uint32_t priority) {
+    auto queues = GetPriorityQueue((*iter)->GetKey());
+    auto& index = GetCurrentQueueIndex((*iter)->GetKey());
     uint32_t oldPriority = (*iter)->GetPriority();
     auto nextQueIter = next(iter);
-    mPriorityQueue[priority].splice(mPriorityQueue[priority].end(), mPriorityQueue[oldPriority], iter);
+    queues[priority].splice(queues[priority].end(), queues[oldPriority], iter);
     (*iter)->SetPriority(priority);
-    if (mCurrentQueueIndex.first == oldPriority && mCurrentQueueIndex.second == iter) {
-        if (nextQueIter == mPriorityQueue[oldPriority].end()) {
-            mCurrentQueueIndex.second = mPriorityQueue[oldPriority].begin();
+    if (index.first == oldPriority && index.second == iter) {
+        if (nextQueIter == queues[oldPriority].end()) {
+            index.second = queues[oldPriority].begin();
         } else {
-            mCurrentQueueIndex.second = nextQueIter;
+            index.second = nextQueIter;
         }
     }
 }
 
 void ProcessQueueManager::DeleteQueueEntity(const ProcessQueueIterator& iter) {
+    auto queues = GetPriorityQueue((*iter)->GetKey());
+    auto& index = GetCurrentQueueIndex((*iter)->GetKey());
     uint32_t priority = (*iter)->GetPriority();
-    auto nextQueIter = mPriorityQueue[priority].erase(iter);
-    if (mCurrentQueueIndex.first == priority && mCurrentQueueIndex.second == iter) {
-        if (nextQueIter == mPriorityQueue[priority].end()) {
-            mCurrentQueueIndex.second = mPriorityQueue[priority].begin();
+    auto nextQueIter = queues[priority].erase(iter);
+    if (index.first == priority && index.second == iter) {
+        if (nextQueIter == queues[priority].end()) {
+            index.second = queues[priority].begin();
         } else {
-            mCurrentQueueIndex.second = nextQueIter;
+            index.second = nextQueIter;
         }
     }
 }
 
 void ProcessQueueManager::ResetCurrentQueueIndex() {
-    mCurrentQueueIndex.first = 0;
-    mCurrentQueueIndex.second = mPriorityQueue[0].begin();
+    ResetQueueIndex(mPriorityQueue, mCurrentQueueIndex);
+}
+
+void ProcessQueueManager::InitShards(size_t shardCnt) {
+    mShards.clear();
+    if (shardCnt <= 1) {
+        // a single shard is equivalent to the non-sharded mode
+        return;
+    }
+    for (size_t i = 0; i < shardCnt; ++i) {
+        auto shard = make_unique<QueueShard>();
+        ResetQueueIndex(shard->mPriorityQueue, shard->mCurrentQueueIndex);
+        WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+            shard->mMetricsRecordRef,
+            MetricCategory::METRIC_CATEGORY_RUNNER,
+            {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_PROCESS_QUEUE_SHARD},
+             {METRIC_LABEL_KEY_THREAD_NO, ToString(i)}});
+        shard->mStolenItemsCnt = shard->mMetricsRecordRef.CreateCounter(METRIC_RUNNER_PROCESS_QUEUE_STOLEN_ITEMS_TOTAL);
+        shard->mIdlePopsCnt = shard->mMetricsRecordRef.CreateCounter(METRIC_RUNNER_PROCESS_QUEUE_IDLE_POPS_TOTAL);
+        mShards.emplace_back(std::move(shard));
+    }
+}
+
+ProcessQueueManager::ProcessQueueList* ProcessQueueManager::GetPriorityQueue(QueueKey key) {
+    if (mShards.empty()) {
+        return mPriorityQueue;
+    }
+    return mShards[static_cast<size_t>(key) % mShards.size()]->mPriorityQueue;
+}
+
+pair<uint32_t, ProcessQueueManager::ProcessQueueIterator>& ProcessQueueManager::GetCurrentQueueIndex(QueueKey key) {
+    if (mShards.empty()) {
+        return mCurrentQueueIndex;
+    }
+    return mShards[static_cast<size_t>(key) % mShards.size()]->mCurrentQueueIndex;
+}
+
+unique_lock<mutex> ProcessQueueManager::LockShard(QueueKey key) const {
+    if (mShards.empty()) {
+        return unique_lock<mutex>();
+    }
+    return unique_lock<mutex>(mShards[static_cast<size_t>(key) % mShards.size()]->mMux);
+}
+
+bool ProcessQueueManager::PopItemFromPriorityQueue(ProcessQueueList* queues,
+                                                   pair<uint32_t, ProcessQueueIterator>& index,
+                                                   uint32_t priority,
+                                                   unique_ptr<ProcessQueueItem>& item,
+                                                   string& configName) {
+    ProcessQueueIterator iter;
+    if (index.first == priority) {
+        for (iter = index.second; iter != queues[priority].end(); ++iter) {
+            if (!(*iter)->Pop(item)) {
+                continue;
+            }
+            configName = (*iter)->GetConfigName();
+            break;
+        }
+        if (configName.empty()) {
+            for (iter = queues[priority].begin(); iter != index.second; ++iter) {
+                if (!(*iter)->Pop(item)) {
+                    continue;
+                }
+                configName = (*iter)->GetConfigName();
+                break;
+            }
+        }
+    } else {
+        for (iter = queues[priority].begin(); iter != queues[priority].end(); ++iter) {
+            if (!(*iter)->Pop(item)) {
+                continue;
+            }
+            configName = (*iter)->GetConfigName();
+            break;
+        }
+    }
+    if (configName.empty()) {
+        return false;
+    }
+    index.first = priority;
+    index.second = ++iter;
+    if (index.second == queues[priority].end()) {
+        index.second = queues[priority].begin();
+    }
+    return true;
+}
+
+void ProcessQueueManager::ResetQueueIndex(ProcessQueueList* queues, pair<uint32_t, ProcessQueueIterator>& index) {
+    index.first = 0;
+    index.second = queues[0].begin();
 }
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -339,6 +485,13 @@ void ProcessQueueManager::Clear() {
         mPriorityQueue[i].clear();
     }
     ResetCurrentQueueIndex();
+    for (auto& shard : mShards) {
+        lock_guard<mutex> shardLock(shard->mMux);
+        for (size_t i = 0; i <= sMaxPriority; ++i) {
+            shard->mPriorityQueue[i].clear();
+        }
+        ResetQueueIndex(shard->mPriorityQueue, shard->mCurrentQueueIndex);
+    }
 }
 #endif
 
@@ -32,6 +32,7 @@
 #include "collection_pipeline/queue/QueueKey.h"
 #include "collection_pipeline/queue/QueueParam.h"
 #include "common/FeedbackInterface.h"
+#include "monitor/MetricManager.h"
 
 namespace logtail {
 
@@ -39,7 +40,8 @@ enum class QueueStatus { OK, QUEUE_FULL, QUEUE_NOT_EXIST };
 
 class ProcessQueueManager : public FeedbackInterface {
 public:
-    using ProcessQueueIterator = std::list<std::unique_ptr<ProcessQueueInterface>>::iterator;
+    using ProcessQueueList = std::list<std::unique_ptr<ProcessQueueInterface>>;
+    using ProcessQueueIterator = ProcessQueueList::iterator;
 
     enum class QueueType { BOUNDED, CIRCULAR };
 
@@ -73,25 +75,60 @@ public:
     void Trigger();
 
 private:
+    // In sharded mode, queue with key k belongs to shard k % shard count, and each processor thread pops from the shard
+    // with the same index first. Shards are protected by their own mutex, so that the pop path never takes mQueueMux.
+    struct QueueShard {
+        std::mutex mMux;
+        ProcessQueueList mPriorityQueue[sMaxPriority + 1];
+        std::pair<uint32_t, ProcessQueueIterator> mCurrentQueueIndex;
+
+        MetricsRecordRef mMetricsRecordRef;
+        CounterPtr mStolenItemsCnt;
+        CounterPtr mIdlePopsCnt;
+    };
+
     ProcessQueueManager();
     ~ProcessQueueManager() = default;
 
+    void InitShards(size_t shardCnt);
+    bool PopItemFromShards(int64_t threadNo, std::unique_ptr<ProcessQueueItem>& item, std::string& configName);
+    bool PopItemFromExactlyOnceQueues(int64_t threadNo,
+                                      uint32_t priority,
+                                      std::unique_ptr<ProcessQueueItem>& item,
+                                      std::string& configName);
+    // the following methods return the global queue lists in non-sharded mode
+    ProcessQueueList* GetPriorityQueue(QueueKey key);
+    std::pair<uint32_t, ProcessQueueIterator>& GetCurrentQueueIndex(QueueKey key);
+    // returns an unlocked lock in non-sharded mode, where mQueueMux already protects everything
+    std::unique_lock<std::mutex> LockShard(QueueKey key) const;
+
     void CreateBoundedQueue(QueueKey key, uint32_t priority, const CollectionPipelineContext& ctx);
     void CreateCircularQueue(QueueKey key, uint32_t priority, size_t capacity, const CollectionPipelineContext& ctx);
     void AdjustQueuePriority(const ProcessQueueIterator& iter, uint32_t priority);
     void DeleteQueueEntity(const ProcessQueueIterator& iter);
     void ResetCurrentQueueIndex();
 
+    static bool PopItemFromPriorityQueue(ProcessQueueList* queues,
+                                         std::pair<uint32_t, ProcessQueueIterator>& index,
+                                         uint32_t priority,
+                                         std::unique_ptr<ProcessQueueItem>& item,
+                                         std::string& configName);
+    static void ResetQueueIndex(ProcessQueueList* queues, std::pair<uint32_t, ProcessQueueIterator>& index);
+
     BoundedQueueParam mBoundedQueueParam;
 
     mutable std::mutex mQueueMux;
     std::unordered_map<QueueKey, std::pair<ProcessQueueIterator, QueueType>> mQueues;
-    std::list<std::unique_ptr<ProcessQueueInterface>> mPriorityQueue[sMaxPriority + 1];
+    ProcessQueueList mPriorityQueue[sMaxPriority + 1];
     std::pair<uint32_t, ProcessQueueIterator> mCurrentQueueIndex;
+    // empty in non-sharded mode
+    std::vector<std::unique_ptr<QueueShard>> mShards;
 
     mutable std::mutex mStateMux;
     mutable std::condition_variable mCond;
     bool mValidToPop = false;
+    // bumped by each Trigger, so that a failed sharded pop does not clear a trigger raised during its scan
+    uint64_t mTriggerSeq = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     void Clear();
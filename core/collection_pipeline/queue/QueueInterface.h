@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <memory>
+
 #include "collection_pipeline/CollectionPipelineContext.h"
 #include "collection_pipeline/queue/QueueKey.h"
+#include "common/memory/MemoryAccountant.h"
 #include "monitor/MetricManager.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
@@ -40,6 +43,9 @@ public:
         mTotalDelayMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_TOTAL_DELAY_MS);
         mQueueSizeTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_SIZE);
         mQueueDataSizeByte = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_SIZE_BYTES);
+        if (!ctx.GetConfigName().empty()) {
+            mPipelineMemoryUsage = MemoryAccountant::GetInstance()->GetPipelineUsage(ctx.GetConfigName());
+        }
     }
     virtual ~QueueInterface() = default;
 
@@ -67,6 +73,9 @@ protected:
     IntGaugePtr mQueueSizeTotal;
     IntGaugePtr mQueueDataSizeByte;
 
+    // items are charged against the pipeline when pushed, and discharged when destructed
+    std::shared_ptr<PipelineMemoryUsage> mPipelineMemoryUsage;
+
 private:
     virtual size_t Size() const = 0;
 };
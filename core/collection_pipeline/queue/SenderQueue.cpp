@@ -33,15 +33,13 @@ SenderQueue::SenderQueue(
 bool SenderQueue::Push(unique_ptr<SenderQueueItem>&& item) {
     item->mFirstEnqueTime = chrono::system_clock::now();
     auto size = item->mData.size();
+    item->mMemoryCharge = MemoryCharge(MemoryCategory::SENDER_QUEUE, mPipelineMemoryUsage, size);
 
     ADD_COUNTER(mInItemsTotal, 1);
     ADD_COUNTER(mInItemDataSizeBytes, size);
 
     if (Full()) {
-        mExtraBuffer.push_back(std::move(item));
-
-        SET_GAUGE(mExtraBufferSize, mExtraBuffer.size());
-        ADD_GAUGE(mExtraBufferDataSizeBytes, size);
+        PushToExtraBuffer(std::move(item));
         return true;
     }
 
@@ -74,7 +72,7 @@ bool SenderQueue::Remove(SenderQueueItem* item) {
     auto index = mRead;
     for (; index < mWrite; ++index) {
         if (mQueue[index % mCapacity].get() == item) {
-            size = item->mData.size();
+            size = item->GetDataSize();
             enQueuTime = item->mFirstEnqueTime;
             mQueue[index % mCapacity].reset();
             break;
@@ -92,13 +90,8 @@ bool SenderQueue::Remove(SenderQueueItem* item) {
     ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - enQueuTime);
     SUB_GAUGE(mQueueDataSizeByte, size);
 
-    if (!mExtraBuffer.empty()) {
-        auto newSize = mExtraBuffer.front()->mData.size();
-        PushFromExtraBuffer(std::move(mExtraBuffer.front()));
-        mExtraBuffer.pop_front();
-
-        SET_GAUGE(mExtraBufferSize, mExtraBuffer.size());
-        SUB_GAUGE(mExtraBufferDataSizeBytes, newSize);
+    if (auto next = PopFromExtraBuffer()) {
+        PushFromExtraBuffer(std::move(next));
         return true;
     }
     if (ChangeStateIfNeededAfterPop()) {
@@ -198,7 +191,7 @@ void SenderQueue::SetPipelineForItems(const std::shared_ptr<CollectionPipeline>&
 }
 
 void SenderQueue::PushFromExtraBuffer(std::unique_ptr<SenderQueueItem>&& item) {
-    auto size = item->mData.size();
+    auto size = item->GetDataSize();
 
     size_t index = mRead;
     for (; index < mWrite; ++index) {
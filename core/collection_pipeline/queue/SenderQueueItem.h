@@ -21,9 +21,12 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "collection_pipeline/queue/QueueKey.h"
+#include "collection_pipeline/queue/SpillLog.h"
+#include "common/memory/MemoryAccountant.h"
 
 namespace logtail {
 
@@ -46,6 +49,11 @@ struct SenderQueueItem {
     std::chrono::system_clock::time_point mFirstEnqueTime;
     std::chrono::system_clock::time_point mLastSendTime;
     uint32_t mTryCnt = 1;
+    // the data waiting to be sent, which is not inherited by clones
+    MemoryCharge mMemoryCharge;
+    // set when the data has been moved to the spill log of the queue, which is not inherited by clones either
+    std::optional<SpillRecord> mSpillRecord;
+    std::shared_ptr<SpillLog> mSpillLog;
 
     SenderQueueItem(std::string&& data,
                     size_t rawSize,
@@ -60,7 +68,11 @@ struct SenderQueueItem {
           mFlusher(flusher),
           mQueueKey(key),
           mStatus(SendingStatus::IDLE) {}
-    virtual ~SenderQueueItem() = default;
+    virtual ~SenderQueueItem() {
+        if (mSpillLog) {
+            mSpillLog->Release(*mSpillRecord);
+        }
+    }
 
     // for Clone only
     SenderQueueItem(const SenderQueueItem& item)
@@ -77,6 +89,24 @@ struct SenderQueueItem {
           mTryCnt(item.mTryCnt) {}
 
     virtual SenderQueueItem* Clone() { return new SenderQueueItem(*this); }
+
+    // the size of the data, no matter whether it has been spilled or not
+    size_t GetDataSize() const { return mSpillRecord ? mSpillRecord->mSize : mData.size(); }
+
+    // Read the spilled data back, which is done by the sending thread rather than under the lock of the queue. The
+    // record is kept on failure, so that the data size is still known.
+    bool LoadSpilledData() {
+        if (!mSpillLog) {
+            return !mSpillRecord;
+        }
+        auto spillLog = std::move(mSpillLog);
+        if (!spillLog->Read(*mSpillRecord, mData)) {
+            return false;
+        }
+        mSpillRecord.reset();
+        mMemoryCharge.Add(mData.size());
+        return true;
+    }
 };
 
 } // namespace logtail
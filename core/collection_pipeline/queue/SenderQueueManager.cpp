@@ -26,6 +26,7 @@ using namespace std;
 namespace logtail {
 
 SenderQueueManager::SenderQueueManager() : mDefaultQueueParam(INT32_FLAG(sender_queue_capacity), 1.0) {
+    BoundedSenderQueueInterface::RemoveStaleSpillLogs();
 }
 
 bool SenderQueueManager::CreateQueue(
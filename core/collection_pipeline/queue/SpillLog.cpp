@@ -0,0 +1,428 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/queue/SpillLog.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <vector>
+
+#include "common/Flags.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT32(spill_log_segment_size_bytes, "size of each segment file of the spill log", 64 * 1024 * 1024);
+DEFINE_FLAG_INT32(spill_log_sync_bytes, "appended bytes of the spill log synced to disk together", 4 * 1024 * 1024);
+DEFINE_FLAG_INT32(spill_log_sync_interval_ms, "max interval for appended data of the spill log to be synced", 1000);
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+const uint32_t kRecordMagic = 0x4C4C5053;
+// magic, size and crc32 of the data
+const size_t kHeaderSize = 3 * sizeof(uint32_t);
+
+uint32_t Crc32(const char* data, size_t size) {
+    return static_cast<uint32_t>(crc32(0L, reinterpret_cast<const Bytef*>(data), static_cast<uInt>(size)));
+}
+
+size_t GetPageSize() {
+#if defined(__linux__)
+    static const size_t sPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return sPageSize;
+#else
+    return 4096;
+#endif
+}
+
+// drop the whole pages within the range from memory, the data stays in the file
+void DropPages(char* addr, size_t begin, size_t end) {
+#if defined(__linux__)
+    size_t page = GetPageSize();
+    begin = begin / page * page;
+    end = end / page * page;
+    if (end > begin) {
+        madvise(addr + begin, end - begin, MADV_DONTNEED);
+    }
+#endif
+}
+
+size_t GetSegmentCapacity(size_t minCapacity) {
+    size_t page = GetPageSize();
+    size_t capacity = max(static_cast<size_t>(INT32_FLAG(spill_log_segment_size_bytes)), minCapacity);
+    return (capacity + page - 1) / page * page;
+}
+
+} // namespace
+
+SpillLog::SpillLog(const string& dir) : mDir(dir), mLastSyncTime(chrono::steady_clock::now()) {
+    mThreadRes = async(launch::async, &SpillLog::Run, this);
+}
+
+SpillLog::~SpillLog() {
+    {
+        lock_guard<mutex> lock(mMux);
+        mStopped = true;
+    }
+    mCV.notify_one();
+    if (mThreadRes.valid()) {
+        mThreadRes.get();
+    }
+    for (auto& item : mSegments) {
+        CloseSegmentFile(item.second->mFile);
+    }
+    CloseSegmentFile(mSpareFile);
+    error_code ec;
+    filesystem::remove_all(mDir, ec);
+}
+
+bool SpillLog::Append(string& data, SpillRecord& record) {
+    if (data.size() > numeric_limits<uint32_t>::max() - kHeaderSize) {
+        return false;
+    }
+    size_t recordSize = kHeaderSize + data.size();
+    {
+        lock_guard<mutex> lock(mMux);
+        if (mFailed || mStopped) {
+            return false;
+        }
+        if (mSegments.empty() || mSegments.rbegin()->second->mAssignedPos + recordSize
+                > mSegments.rbegin()->second->mCapacity) {
+            auto segment = make_unique<Segment>();
+            segment->mCapacity = GetSegmentCapacity(recordSize);
+            mDiskSize += segment->mCapacity;
+            mSegments.emplace(mNextSegmentId++, std::move(segment));
+        }
+        auto& [id, segment] = *mSegments.rbegin();
+        record.mSeq = mNextSeq++;
+        record.mSegmentId = id;
+        record.mOffset = segment->mAssignedPos;
+        record.mSize = static_cast<uint32_t>(data.size());
+        segment->mAssignedPos += recordSize;
+        ++segment->mLiveCnt;
+        mPending.push_back({id, record.mOffset, std::move(data)});
+    }
+    mCV.notify_one();
+    return true;
+}
+
+bool SpillLog::Read(const SpillRecord& record, string& data) {
+    unique_lock<mutex> lock(mMux);
+    auto it = mSegments.find(record.mSegmentId);
+    if (it == mSegments.end() || record.mSeq == 0 || record.mSeq >= mNextSeq) {
+        return false;
+    }
+    auto& segment = *it->second;
+    bool valid = false;
+    if (record.mSeq > mWrittenSeq) {
+        // the data may be being written by the background thread, so it is copied rather than moved
+        auto& write = mPending[record.mSeq - mWrittenSeq - 1];
+        data = write.mData;
+        write.mDone = true;
+        valid = true;
+    } else if (auto unwritten = mUnwritten.find(record.mSeq); unwritten != mUnwritten.end()) {
+        data = std::move(unwritten->second);
+        mUnwritten.erase(unwritten);
+        valid = true;
+    } else if (record.mOffset + kHeaderSize + record.mSize <= segment.mWrittenPos) {
+        // the segment is not closed before all its records are done, so the record is read without the lock
+        const char* addr = segment.mFile.mAddr;
+        size_t end = record.mOffset + kHeaderSize + record.mSize;
+        lock.unlock();
+        const char* src = addr + record.mOffset;
+        uint32_t header[3];
+        memcpy(header, src, kHeaderSize);
+        valid = header[0] == kRecordMagic && header[1] == record.mSize
+            && header[2] == Crc32(src + kHeaderSize, record.mSize);
+        if (valid) {
+            data.assign(src + kHeaderSize, record.mSize);
+        }
+        DropPages(const_cast<char*>(addr), record.mOffset, end);
+        lock.lock();
+    }
+    if (segment.mLiveCnt > 0 && --segment.mLiveCnt == 0) {
+        mHasDoneSegment = true;
+        mCV.notify_one();
+    }
+    return valid;
+}
+
+void SpillLog::Release(const SpillRecord& record) {
+    lock_guard<mutex> lock(mMux);
+    if (record.mSeq > mWrittenSeq && record.mSeq < mNextSeq) {
+        mPending[record.mSeq - mWrittenSeq - 1].mDone = true;
+    } else {
+        mUnwritten.erase(record.mSeq);
+    }
+    auto it = mSegments.find(record.mSegmentId);
+    if (it != mSegments.end() && it->second->mLiveCnt > 0 && --it->second->mLiveCnt == 0) {
+        mHasDoneSegment = true;
+        mCV.notify_one();
+    }
+}
+
+void SpillLog::Sync() {
+    unique_lock<mutex> lock(mMux);
+    uint64_t seq = ++mSyncRequestSeq;
+    mCV.notify_one();
+    mSyncCV.wait(lock, [this, seq]() { return mSyncDoneSeq >= seq || mStopped; });
+}
+
+uint64_t SpillLog::GetDiskSize() const {
+    lock_guard<mutex> lock(mMux);
+    return mDiskSize;
+}
+
+size_t SpillLog::GetSegmentCnt() const {
+    lock_guard<mutex> lock(mMux);
+    return mSegments.size();
+}
+
+void SpillLog::Run() {
+    {
+        error_code ec;
+        filesystem::remove_all(mDir, ec);
+        filesystem::create_directories(mDir, ec);
+        if (ec) {
+            LOG_WARNING(sLogger, ("failed to create spill log dir", mDir)("error", ec.message()));
+        }
+    }
+    unique_lock<mutex> lock(mMux);
+    while (!mStopped) {
+        auto syncInterval = chrono::milliseconds(INT32_FLAG(spill_log_sync_interval_ms));
+        mCV.wait_until(lock, mLastSyncTime + syncInterval, [this]() {
+            return mStopped || !mPending.empty() || mSyncRequestSeq > mSyncDoneSeq || mHasDoneSegment
+                || NeedSpareSegment();
+        });
+        if (mStopped) {
+            break;
+        }
+        // requests made from now on are served by the next round, since more records may be appended meanwhile
+        uint64_t syncSeq = mSyncRequestSeq;
+        WritePending(lock);
+        CloseDoneSegments(lock);
+        if (NeedSpareSegment()) {
+            size_t capacity = GetSegmentCapacity(0);
+            SegmentFile file;
+            lock.unlock();
+            bool res = CreateSegmentFile(capacity, file);
+            lock.lock();
+            if (res) {
+                mSpareFile = file;
+                mDiskSize += capacity;
+            } else {
+                mFailed = true;
+            }
+        }
+        // group commit
+        if (syncSeq > mSyncDoneSeq || mUnsyncedBytes >= static_cast<size_t>(INT32_FLAG(spill_log_sync_bytes))
+            || chrono::steady_clock::now() - mLastSyncTime >= syncInterval) {
+            SyncSegments(lock);
+            mUnsyncedBytes = 0;
+            mLastSyncTime = chrono::steady_clock::now();
+            if (syncSeq > mSyncDoneSeq) {
+                mSyncDoneSeq = syncSeq;
+                mSyncCV.notify_all();
+            }
+        }
+    }
+    mSyncDoneSeq = mSyncRequestSeq;
+    mSyncCV.notify_all();
+}
+
+void SpillLog::WritePending(unique_lock<mutex>& lock) {
+    while (!mPending.empty()) {
+        // references to the elements of the deque stay valid while records are appended
+        auto& write = mPending.front();
+        auto& segment = *mSegments.at(write.mSegmentId);
+        if (segment.mFile.mAddr == nullptr && !mFailed) {
+            if (mSpareFile.mAddr != nullptr && mSpareFile.mCapacity == segment.mCapacity) {
+                segment.mFile = mSpareFile;
+                mSpareFile = SegmentFile();
+                mDiskSize -= segment.mCapacity;
+            } else {
+                size_t capacity = segment.mCapacity;
+                SegmentFile file;
+                lock.unlock();
+                bool res = CreateSegmentFile(capacity, file);
+                lock.lock();
+                if (res) {
+                    segment.mFile = file;
+                } else {
+                    mFailed = true;
+                }
+            }
+        }
+
+        size_t recordSize = kHeaderSize + write.mData.size();
+        if (write.mDone) {
+            // nobody is going to read it
+        } else if (segment.mFile.mAddr == nullptr) {
+            mUnwritten.emplace(mWrittenSeq + 1, std::move(write.mData));
+        } else {
+            char* dst = segment.mFile.mAddr + write.mOffset;
+            const auto& data = write.mData;
+            lock.unlock();
+            uint32_t header[3] = {kRecordMagic, static_cast<uint32_t>(data.size()), Crc32(data.data(), data.size())};
+            memcpy(dst, header, kHeaderSize);
+            memcpy(dst + kHeaderSize, data.data(), data.size());
+            lock.lock();
+            mUnsyncedBytes += recordSize;
+        }
+        segment.mWrittenPos = write.mOffset + recordSize;
+        mPending.pop_front();
+        ++mWrittenSeq;
+    }
+}
+
+void SpillLog::SyncSegments(unique_lock<mutex>& lock) {
+    struct Range {
+        Segment* mSegment;
+        char* mAddr;
+        size_t mBegin;
+        size_t mEnd;
+    };
+    vector<Range> ranges;
+    size_t page = GetPageSize();
+    for (auto& item : mSegments) {
+        auto& segment = *item.second;
+        if (segment.mFile.mAddr != nullptr && segment.mSyncedPos < segment.mWrittenPos) {
+            ranges.push_back(
+                {&segment, segment.mFile.mAddr, segment.mSyncedPos / page * page, segment.mWrittenPos});
+        }
+    }
+    if (ranges.empty()) {
+        return;
+    }
+    // segments are only closed by this thread, so they stay mapped without the lock
+    lock.unlock();
+    for (auto& range : ranges) {
+#if defined(__linux__)
+        if (msync(range.mAddr + range.mBegin, range.mEnd - range.mBegin, MS_SYNC) != 0) {
+            LOG_WARNING(sLogger, ("failed to sync spill log segment", mDir)("errno", errno));
+        }
+#endif
+        DropPages(range.mAddr, range.mBegin, range.mEnd);
+    }
+    lock.lock();
+    for (auto& range : ranges) {
+        range.mSegment->mSyncedPos = max(range.mSegment->mSyncedPos, range.mEnd);
+    }
+}
+
+void SpillLog::CloseDoneSegments(unique_lock<mutex>& lock) {
+    mHasDoneSegment = false;
+    vector<SegmentFile> files;
+    for (auto it = mSegments.begin(); it != mSegments.end();) {
+        auto& segment = *it->second;
+        if (segment.mLiveCnt != 0 || segment.mWrittenPos != segment.mAssignedPos) {
+            ++it;
+            continue;
+        }
+        if (next(it) != mSegments.end()) {
+            files.push_back(segment.mFile);
+            mDiskSize -= segment.mCapacity;
+            it = mSegments.erase(it);
+            continue;
+        }
+        // everything has been read, the segment being appended to is reused from the beginning
+        if (segment.mAssignedPos != 0 && segment.mFile.mAddr != nullptr) {
+            DropPages(segment.mFile.mAddr, 0, segment.mCapacity);
+            segment.mAssignedPos = 0;
+            segment.mWrittenPos = 0;
+            segment.mSyncedPos = 0;
+        }
+        ++it;
+    }
+    if (files.empty()) {
+        return;
+    }
+    lock.unlock();
+    for (auto& file : files) {
+        CloseSegmentFile(file);
+    }
+    lock.lock();
+}
+
+bool SpillLog::NeedSpareSegment() const {
+    if (mFailed || mStopped || mSpareFile.mAddr != nullptr || mSegments.empty()) {
+        return false;
+    }
+    // the next segment is created once half of the one being appended to is used
+    const auto& segment = *mSegments.rbegin()->second;
+    return segment.mAssignedPos * 2 >= segment.mCapacity;
+}
+
+bool SpillLog::CreateSegmentFile(size_t capacity, SegmentFile& file) {
+#if defined(__linux__)
+    auto path = (filesystem::path(mDir) / (to_string(mNextFileId++) + ".seg")).string();
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        LOG_WARNING(sLogger, ("failed to create spill log segment", path)("errno", errno));
+        return false;
+    }
+    // the space is reserved in advance, since writing to a hole of the mapping on a full disk raises SIGBUS
+    int err = posix_fallocate(fd, 0, static_cast<off_t>(capacity));
+    if (err != 0) {
+        LOG_WARNING(sLogger, ("failed to allocate spill log segment", path)("size", capacity)("errno", err));
+        close(fd);
+        unlink(path.c_str());
+        return false;
+    }
+    void* addr = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        LOG_WARNING(sLogger, ("failed to map spill log segment", path)("errno", errno));
+        close(fd);
+        unlink(path.c_str());
+        return false;
+    }
+    file.mPath = path;
+    file.mFd = fd;
+    file.mAddr = static_cast<char*>(addr);
+    file.mCapacity = capacity;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SpillLog::CloseSegmentFile(SegmentFile& file) {
+#if defined(__linux__)
+    if (file.mAddr != nullptr) {
+        munmap(file.mAddr, file.mCapacity);
+        file.mAddr = nullptr;
+    }
+    if (file.mFd >= 0) {
+        close(file.mFd);
+        file.mFd = -1;
+    }
+    if (!file.mPath.empty()) {
+        unlink(file.mPath.c_str());
+        file.mPath.clear();
+    }
+#endif
+}
+
+} // namespace logtail
@@ -0,0 +1,152 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace logtail {
+
+// location of a record in the spill log
+struct SpillRecord {
+    // sequence number of the record in the log, starting from 1
+    uint64_t mSeq = 0;
+    uint64_t mSegmentId = 0;
+    uint64_t mOffset = 0;
+    uint32_t mSize = 0;
+};
+
+// SpillLog is an append-only log on disk made of mmap'd segment files, used to move data out of memory. Each record is
+// framed with its size and crc32.
+//
+// Appending only assigns the record a place in the log and hands the data over to a background thread, which creates
+// segments ahead of time, copies the data into them, and syncs the appended pages in groups once enough bytes or time
+// have accumulated. Synced pages are dropped from memory, so that the resident size stays bounded no matter how much
+// is spilled. Until a record is written, reading it is served from the data handed over.
+//
+// Each record must be either read or released exactly once. A segment is removed by the background thread once all its
+// records are done. The log only lives as long as the items referring to it, so the directory is removed on
+// destruction, and whatever is found in it on construction is left over by a previous process and removed as well.
+//
+// It is thread safe, and no disk I/O is done by the appending thread.
+class SpillLog {
+public:
+    explicit SpillLog(const std::string& dir);
+    ~SpillLog();
+    SpillLog(const SpillLog&) = delete;
+    SpillLog& operator=(const SpillLog&) = delete;
+
+    // the data is moved from on success only, returns false if the log has failed to create its segments
+    bool Append(std::string& data, SpillRecord& record);
+    // read the record back, returns false if the record is missing or corrupted
+    bool Read(const SpillRecord& record, std::string& data);
+    // give up the record without reading it
+    void Release(const SpillRecord& record);
+    // wait until the records appended so far are written and synced
+    void Sync();
+
+    // bytes of the segment files on disk, including those to be created
+    uint64_t GetDiskSize() const;
+    size_t GetSegmentCnt() const;
+
+private:
+    struct SegmentFile {
+        std::string mPath;
+        int mFd = -1;
+        char* mAddr = nullptr;
+        size_t mCapacity = 0;
+    };
+
+    struct Segment {
+        // not created yet if mAddr is nullptr
+        SegmentFile mFile;
+        size_t mCapacity = 0;
+        // bytes assigned to appended records
+        size_t mAssignedPos = 0;
+        // bytes before the position have been written by the background thread
+        size_t mWrittenPos = 0;
+        // bytes before the position have been synced and dropped from memory
+        size_t mSyncedPos = 0;
+        // records neither read nor released
+        size_t mLiveCnt = 0;
+    };
+
+    struct PendingWrite {
+        uint64_t mSegmentId = 0;
+        uint64_t mOffset = 0;
+        std::string mData;
+        // read or released before being written, so it is not needed any more
+        bool mDone = false;
+    };
+
+    void Run();
+    // the data of records whose segment cannot be created is kept in memory
+    void WritePending(std::unique_lock<std::mutex>& lock);
+    void SyncSegments(std::unique_lock<std::mutex>& lock);
+    void CloseDoneSegments(std::unique_lock<std::mutex>& lock);
+    bool NeedSpareSegment() const;
+    bool CreateSegmentFile(size_t capacity, SegmentFile& file);
+    // the segment file is removed as well
+    static void CloseSegmentFile(SegmentFile& file);
+
+    std::string mDir;
+
+    mutable std::mutex mMux;
+    // signals the background thread
+    std::condition_variable mCV;
+    // signals the threads waiting for sync
+    std::condition_variable mSyncCV;
+    // ordered by id, the last one is being appended to
+    std::map<uint64_t, std::unique_ptr<Segment>> mSegments;
+    uint64_t mNextSegmentId = 0;
+    // records appended but not written yet, in order of sequence number
+    std::deque<PendingWrite> mPending;
+    uint64_t mNextSeq = 1;
+    // records with smaller sequence numbers have been taken out of mPending
+    uint64_t mWrittenSeq = 0;
+    // a segment created ahead of time with the default capacity
+    SegmentFile mSpareFile;
+    uint64_t mNextFileId = 0;
+    uint64_t mDiskSize = 0;
+    size_t mUnsyncedBytes = 0;
+    std::chrono::steady_clock::time_point mLastSyncTime;
+    // Sync waits until the latter catches up with its request
+    uint64_t mSyncRequestSeq = 0;
+    uint64_t mSyncDoneSeq = 0;
+    // set when all records of a segment are done
+    bool mHasDoneSegment = false;
+    // set when a segment cannot be created, after which nothing more is appended
+    bool mFailed = false;
+    bool mStopped = false;
+    // data of records which could not be written, kept in memory until read
+    std::unordered_map<uint64_t, std::string> mUnwritten;
+
+    std::future<void> mThreadRes;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class SpillLogUnittest;
+#endif
+};
+
+} // namespace logtail
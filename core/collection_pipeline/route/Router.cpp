@@ -60,22 +60,15 @@ vector<pair<size_t, PipelineEventGroup>> Router::Route(PipelineEventGroup& g) co
 
     vector<pair<size_t, PipelineEventGroup>> res;
     res.reserve(resSz);
-    for (size_t i = 0; i < mAlwaysMatchedFlusherIdx.size(); ++i, --resSz) {
-        if (resSz == 1) {
-            res.emplace_back(mAlwaysMatchedFlusherIdx[i], std::move(g));
-        } else {
-            res.emplace_back(mAlwaysMatchedFlusherIdx[i], g.Copy());
-        }
+    // flushers share the events, which are copied only when modified
+    auto groups = PipelineEventGroup::Share(std::move(g), resSz);
+    size_t idx = 0;
+    for (size_t i = 0; i < mAlwaysMatchedFlusherIdx.size(); ++i) {
+        res.emplace_back(mAlwaysMatchedFlusherIdx[i], std::move(groups[idx++]));
     }
-    for (size_t i = 0; i < dest.size(); ++i, --resSz) {
-        if (resSz == 1) {
-            mConditions[dest[i]].second.GetResult(g);
-            res.emplace_back(dest[i], std::move(g));
-        } else {
-            auto copy = g.Copy();
-            mConditions[dest[i]].second.GetResult(copy);
-            res.emplace_back(dest[i], std::move(copy));
-        }
+    for (size_t i = 0; i < dest.size(); ++i) {
+        mConditions[dest[i]].second.GetResult(groups[idx]);
+        res.emplace_back(dest[i], std::move(groups[idx++]));
     }
     return res;
 }
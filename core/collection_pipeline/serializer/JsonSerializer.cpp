@@ -23,7 +23,7 @@ namespace logtail {
 
 // Helper function to serialize common fields (tags and time)
 template <typename WriterType>
-void SerializeCommonFields(const SizedMap& tags, uint64_t timestamp, WriterType& writer) {
+void SerializeCommonFields(const SizedFlatTagMap& tags, uint64_t timestamp, WriterType& writer) {
     // Serialize tags
     for (const auto& tag : tags.mInner) {
         writer.Key(tag.first.to_string().c_str());
@@ -39,8 +39,10 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
         errorMsg = "empty event group";
         return false;
     }
+    // events may be shared with other flushers, so they must be accessed as const to avoid copies
+    const EventsContainer& events = group.mEvents;
 
-    PipelineEvent::Type eventType = group.mEvents[0]->GetType();
+    PipelineEvent::Type eventType = events[0]->GetType();
     if (eventType == PipelineEvent::Type::NONE) {
         // should not happen
         errorMsg = "unsupported event type in event group";
@@ -61,7 +63,32 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
     // TODO: should support nano second
     switch (eventType) {
         case PipelineEvent::Type::LOG:
-            for (const auto& item : group.mEvents) {
+            if (group.mColumnarLogs) {
+                const auto& logs = *group.mColumnarLogs;
+                const auto& keys = logs.GetKeys();
+                const auto& keyIds = logs.GetKeyIds();
+                const auto& values = logs.GetValues();
+                for (size_t i = 0; i < logs.GetLogCnt(); ++i) {
+                    if (logs.IsLogEmpty(i)) {
+                        continue;
+                    }
+                    resetBuffer();
+
+                    writer.StartObject();
+                    SerializeCommonFields(group.mTags, logs.GetTimestamp(i), writer);
+                    // contents
+                    for (size_t j = logs.GetContentBegin(i); j < logs.GetContentEnd(i); ++j) {
+                        const auto& key = keys[keyIds[j]];
+                        writer.Key(key.data(), static_cast<rapidjson::SizeType>(key.size()));
+                        writer.String(values[j].data(), static_cast<rapidjson::SizeType>(values[j].size()));
+                    }
+                    writer.EndObject();
+                    res.append(jsonBuffer.GetString());
+                    res.append("\n");
+                }
+                break;
+            }
+            for (const auto& item : events) {
                 const auto& e = item.Cast<LogEvent>();
                 if (e.Empty()) {
                     continue;
@@ -82,7 +109,7 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
             break;
         case PipelineEvent::Type::METRIC:
             // TODO: key should support custom key
-            for (const auto& item : group.mEvents) {
+            for (const auto& item : events) {
                 const auto& e = item.Cast<MetricEvent>();
                 if (e.Is<std::monostate>()) {
                     continue;
@@ -122,7 +149,7 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
             }
             break;
         case PipelineEvent::Type::RAW:
-            for (const auto& item : group.mEvents) {
+            for (const auto& item : events) {
                 const auto& e = item.Cast<RawEvent>();
                 if (e.GetContent().empty()) {
                     continue;
@@ -16,8 +16,6 @@
 
 #include <array>
 
-#include "json/json.h"
-
 #include "collection_pipeline/serializer/JsonSerializer.h"
 #include "common/Flags.h"
 #include "common/compression/CompressType.h"
@@ -33,29 +31,6 @@ using namespace std;
 
 namespace logtail {
 
-std::string SerializeSpanLinksToString(const SpanEvent& event) {
-    if (event.GetLinks().empty()) {
-        return "";
-    }
-    Json::Value jsonLinks(Json::arrayValue);
-    for (const auto& link : event.GetLinks()) {
-        jsonLinks.append(link.ToJson());
-    }
-    Json::StreamWriterBuilder writer;
-    return Json::writeString(writer, jsonLinks);
-}
-std::string SerializeSpanEventsToString(const SpanEvent& event) {
-    if (event.GetEvents().empty()) {
-        return "";
-    }
-    Json::Value jsonEvents(Json::arrayValue);
-    for (const auto& event : event.GetEvents()) {
-        jsonEvents.append(event.ToJson());
-    }
-    Json::StreamWriterBuilder writer;
-    return Json::writeString(writer, jsonEvents);
-}
-
 template <>
 bool Serializer<vector<CompressedLogGroup>>::DoSerialize(vector<CompressedLogGroup>&& p,
                                                          std::string& output,
@@ -81,13 +56,55 @@ bool Serializer<vector<CompressedLogGroup>>::DoSerialize(vector<CompressedLogGro
     return res;
 }
 
+static size_t GetColumnarLogsSize(const ColumnarLogs& logs, bool enableNs, vector<size_t>& logSZ) {
+    const auto& keys = logs.GetKeys();
+    const auto& keyIds = logs.GetKeyIds();
+    const auto& values = logs.GetValues();
+    size_t logGroupSZ = 0;
+    for (size_t i = 0; i < logs.GetLogCnt(); ++i) {
+        if (logs.IsLogEmpty(i)) {
+            continue;
+        }
+        size_t contentSZ = 0;
+        for (size_t j = logs.GetContentBegin(i); j < logs.GetContentEnd(i); ++j) {
+            contentSZ += GetLogContentSize(keys[keyIds[j]].size(), values[j].size());
+        }
+        logGroupSZ += GetLogSize(contentSZ, enableNs && logs.HasTimestampNanosecond(i), logSZ[i]);
+    }
+    return logGroupSZ;
+}
+
+static void SerializeColumnarLogs(const ColumnarLogs& logs,
+                                  bool enableNs,
+                                  const vector<size_t>& logSZ,
+                                  LogGroupSerializer& serializer) {
+    const auto& keys = logs.GetKeys();
+    const auto& keyIds = logs.GetKeyIds();
+    const auto& values = logs.GetValues();
+    for (size_t i = 0; i < logs.GetLogCnt(); ++i) {
+        if (logs.IsLogEmpty(i)) {
+            continue;
+        }
+        serializer.StartToAddLog(logSZ[i]);
+        serializer.AddLogTime(logs.GetTimestamp(i));
+        for (size_t j = logs.GetContentBegin(i); j < logs.GetContentEnd(i); ++j) {
+            serializer.AddLogContent(keys[keyIds[j]], values[j]);
+        }
+        if (enableNs && logs.HasTimestampNanosecond(i)) {
+            serializer.AddLogTimeNs(logs.GetTimestampNanosecond(i));
+        }
+    }
+}
+
 bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, string& errorMsg) {
     if (group.mEvents.empty()) {
         errorMsg = "empty event group";
         return false;
     }
+    // events may be shared with other flushers, so they must be accessed as const to avoid copies
+    const EventsContainer& events = group.mEvents;
 
-    PipelineEvent::Type eventType = group.mEvents[0]->GetType();
+    PipelineEvent::Type eventType = events[0]->GetType();
     if (eventType == PipelineEvent::Type::NONE) {
         // should not happen
         errorMsg = "unsupported event type in event group";
@@ -97,14 +114,19 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
     bool enableNs = mFlusher->GetContext().GetGlobalConfig().mEnableTimestampNanosecond;
 
     // caculate serialized logGroup size first, where some critical results can be cached
-    vector<size_t> logSZ(group.mEvents.size());
-    vector<pair<string, size_t>> metricEventContentCache(group.mEvents.size());
-    vector<array<string, 6>> spanEventContentCache(group.mEvents.size());
+    vector<size_t> logSZ(events.size());
+    vector<pair<string, size_t>> metricEventContentCache;
+    // serialized size of attributes, links and events
+    vector<array<size_t, 3>> spanEventContentSZCache;
     size_t logGroupSZ = 0;
     switch (eventType) {
         case PipelineEvent::Type::LOG: {
-            for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<LogEvent>();
+            if (group.mColumnarLogs) {
+                logGroupSZ = GetColumnarLogsSize(*group.mColumnarLogs, enableNs, logSZ);
+                break;
+            }
+            for (size_t i = 0; i < events.size(); ++i) {
+                const auto& e = events[i].Cast<LogEvent>();
                 if (e.Empty()) {
                     continue;
                 }
@@ -117,8 +139,9 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             break;
         }
         case PipelineEvent::Type::METRIC: {
-            for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<MetricEvent>();
+            metricEventContentCache.resize(events.size());
+            for (size_t i = 0; i < events.size(); ++i) {
+                const auto& e = events[i].Cast<MetricEvent>();
                 if (e.GetTimestamp() < 1e9) {
                     LOG_WARNING(sLogger,
                                 ("metric event timestamp is less than 1e9", "discard event")(
@@ -148,8 +171,9 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             break;
         }
         case PipelineEvent::Type::SPAN:
-            for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<SpanEvent>();
+            spanEventContentSZCache.resize(events.size());
+            for (size_t i = 0; i < events.size(); ++i) {
+                const auto& e = events[i].Cast<SpanEvent>();
                 size_t contentSZ = 0;
                 contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_TRACE_ID.size(), e.GetTraceId().size());
                 contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_SPAN_ID.size(), e.GetSpanId().size());
@@ -160,41 +184,28 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
                     += GetLogContentSize(DEFAULT_TRACE_TAG_STATUS_CODE.size(), GetStatusString(e.GetStatus()).size());
                 contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_TRACE_STATE.size(), e.GetTraceState().size());
 
-                // set tags and scope tags
-                Json::Value jsonVal;
-                for (auto it = e.TagsBegin(); it != e.TagsEnd(); ++it) {
-                    jsonVal[it->first.to_string()] = it->second.to_string();
-                }
-                for (auto it = e.ScopeTagsBegin(); it != e.ScopeTagsEnd(); ++it) {
-                    jsonVal[it->first.to_string()] = it->second.to_string();
-                }
-                Json::StreamWriterBuilder writer;
-                std::string attrString = Json::writeString(writer, jsonVal);
-                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_ATTRIBUTES.size(), attrString.size());
-                spanEventContentCache[i][0] = std::move(attrString);
-                auto linkString = SerializeSpanLinksToString(e);
-                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_LINKS.size(), linkString.size());
-                spanEventContentCache[i][1] = std::move(linkString);
-                auto eventString = SerializeSpanEventsToString(e);
-                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_EVENTS.size(), eventString.size());
-                spanEventContentCache[i][2] = std::move(eventString);
+                // json fields are written into the output buffer directly later, only their sizes are needed here
+                auto& jsonSZ = spanEventContentSZCache[i];
+                jsonSZ[0] = GetSpanAttributesSize(e);
+                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_ATTRIBUTES.size(), jsonSZ[0]);
+                jsonSZ[1] = GetSpanLinksSize(e);
+                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_LINKS.size(), jsonSZ[1]);
+                jsonSZ[2] = GetSpanEventsSize(e);
+                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_EVENTS.size(), jsonSZ[2]);
 
                 // time related
-                auto startTsNs = std::to_string(e.GetStartTimeNs());
-                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_START_TIME_NANO.size(), startTsNs.size());
-                spanEventContentCache[i][3] = std::move(startTsNs);
-                auto endTsNs = std::to_string(e.GetEndTimeNs());
-                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_END_TIME_NANO.size(), endTsNs.size());
-                spanEventContentCache[i][4] = std::move(endTsNs);
-                auto durationNs = std::to_string(e.GetEndTimeNs() - e.GetStartTimeNs());
-                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_DURATION.size(), durationNs.size());
-                spanEventContentCache[i][5] = std::move(durationNs);
+                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_START_TIME_NANO.size(),
+                                               GetNumberStringSize(e.GetStartTimeNs()));
+                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_END_TIME_NANO.size(),
+                                               GetNumberStringSize(e.GetEndTimeNs()));
+                contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_DURATION.size(),
+                                               GetNumberStringSize(e.GetEndTimeNs() - e.GetStartTimeNs()));
                 logGroupSZ += GetLogSize(contentSZ, false, logSZ[i]);
             }
             break;
         case PipelineEvent::Type::RAW:
-            for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<RawEvent>();
+            for (size_t i = 0; i < events.size(); ++i) {
+                const auto& e = events[i].Cast<RawEvent>();
                 size_t contentSZ = GetLogContentSize(DEFAULT_CONTENT_KEY.size(), e.GetContent().size());
                 logGroupSZ += GetLogSize(contentSZ, enableNs && e.GetTimestampNanosecond(), logSZ[i]);
             }
@@ -227,8 +238,12 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
     serializer.Prepare(logGroupSZ);
     switch (eventType) {
         case PipelineEvent::Type::LOG:
-            for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<LogEvent>();
+            if (group.mColumnarLogs) {
+                SerializeColumnarLogs(*group.mColumnarLogs, enableNs, logSZ, serializer);
+                break;
+            }
+            for (size_t i = 0; i < events.size(); ++i) {
+                const auto& e = events[i].Cast<LogEvent>();
                 if (e.Empty()) {
                     continue;
                 }
@@ -243,14 +258,13 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             }
             break;
         case PipelineEvent::Type::METRIC:
-            for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                auto& e = group.mEvents[i].Cast<MetricEvent>();
+            for (size_t i = 0; i < events.size(); ++i) {
+                const auto& e = events[i].Cast<MetricEvent>();
                 if (!e.Is<UntypedSingleValue>() || e.GetTimestamp() < 1e9) {
                     continue;
                 }
                 serializer.StartToAddLog(logSZ[i]);
                 serializer.AddLogTime(e.GetTimestamp());
-                e.SortTags();
                 serializer.AddLogContentMetricLabel(e, metricEventContentCache[i].second);
                 serializer.AddLogContentMetricTimeNano(e);
                 serializer.AddLogContent(METRIC_RESERVED_KEY_VALUE, metricEventContentCache[i].first);
@@ -258,8 +272,8 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             }
             break;
         case PipelineEvent::Type::SPAN:
-            for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& spanEvent = group.mEvents[i].Cast<SpanEvent>();
+            for (size_t i = 0; i < events.size(); ++i) {
+                const auto& spanEvent = events[i].Cast<SpanEvent>();
 
                 serializer.StartToAddLog(logSZ[i]);
                 serializer.AddLogTime(spanEvent.GetTimestamp());
@@ -276,22 +290,23 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
                 // trace state
                 serializer.AddLogContent(DEFAULT_TRACE_TAG_TRACE_STATE, spanEvent.GetTraceState());
 
-                serializer.AddLogContent(DEFAULT_TRACE_TAG_ATTRIBUTES, spanEventContentCache[i][0]);
+                serializer.AddLogContentSpanAttributes(spanEvent, spanEventContentSZCache[i][0]);
 
-                serializer.AddLogContent(DEFAULT_TRACE_TAG_LINKS, spanEventContentCache[i][1]);
-                serializer.AddLogContent(DEFAULT_TRACE_TAG_EVENTS, spanEventContentCache[i][2]);
+                serializer.AddLogContentSpanLinks(spanEvent, spanEventContentSZCache[i][1]);
+                serializer.AddLogContentSpanEvents(spanEvent, spanEventContentSZCache[i][2]);
 
                 // start_time
-                serializer.AddLogContent(DEFAULT_TRACE_TAG_START_TIME_NANO, spanEventContentCache[i][3]);
+                serializer.AddLogContent(DEFAULT_TRACE_TAG_START_TIME_NANO, spanEvent.GetStartTimeNs());
                 // end_time
-                serializer.AddLogContent(DEFAULT_TRACE_TAG_END_TIME_NANO, spanEventContentCache[i][4]);
+                serializer.AddLogContent(DEFAULT_TRACE_TAG_END_TIME_NANO, spanEvent.GetEndTimeNs());
                 // duration
-                serializer.AddLogContent(DEFAULT_TRACE_TAG_DURATION, spanEventContentCache[i][5]);
+                serializer.AddLogContent(DEFAULT_TRACE_TAG_DURATION,
+                                         spanEvent.GetEndTimeNs() - spanEvent.GetStartTimeNs());
             }
             break;
         case PipelineEvent::Type::RAW:
-            for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<RawEvent>();
+            for (size_t i = 0; i < events.size(); ++i) {
+                const auto& e = events[i].Cast<RawEvent>();
                 serializer.StartToAddLog(logSZ[i]);
                 serializer.AddLogTime(e.GetTimestamp());
                 serializer.AddLogContent(DEFAULT_CONTENT_KEY, e.GetContent());
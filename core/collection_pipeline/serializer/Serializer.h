@@ -54,13 +54,13 @@ public:
              {METRIC_LABEL_KEY_PIPELINE_NAME, f->GetContext().GetConfigName()},
              {METRIC_LABEL_KEY_COMPONENT_NAME, METRIC_LABEL_VALUE_COMPONENT_NAME_SERIALIZER},
              {METRIC_LABEL_KEY_FLUSHER_PLUGIN_ID, f->GetPluginID()}});
-        mInItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_IN_ITEMS_TOTAL);
-        mInItemSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_IN_SIZE_BYTES);
-        mOutItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_OUT_ITEMS_TOTAL);
-        mOutItemSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_OUT_SIZE_BYTES);
-        mTotalProcessMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_TOTAL_PROCESS_TIME_MS);
-        mDiscardedItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_DISCARDED_ITEMS_TOTAL);
-        mDiscardedItemSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_DISCARDED_SIZE_BYTES);
+        mInItemsTotal = mMetricsRecordRef.CreateShardedCounter(METRIC_COMPONENT_IN_ITEMS_TOTAL);
+        mInItemSizeBytes = mMetricsRecordRef.CreateShardedCounter(METRIC_COMPONENT_IN_SIZE_BYTES);
+        mOutItemsTotal = mMetricsRecordRef.CreateShardedCounter(METRIC_COMPONENT_OUT_ITEMS_TOTAL);
+        mOutItemSizeBytes = mMetricsRecordRef.CreateShardedCounter(METRIC_COMPONENT_OUT_SIZE_BYTES);
+        mTotalProcessMs = mMetricsRecordRef.CreateShardedTimeCounter(METRIC_COMPONENT_TOTAL_PROCESS_TIME_MS);
+        mDiscardedItemsTotal = mMetricsRecordRef.CreateShardedCounter(METRIC_COMPONENT_DISCARDED_ITEMS_TOTAL);
+        mDiscardedItemSizeBytes = mMetricsRecordRef.CreateShardedCounter(METRIC_COMPONENT_DISCARDED_SIZE_BYTES);
     }
     virtual ~Serializer() = default;
 
@@ -88,13 +88,13 @@ protected:
     const Flusher* mFlusher = nullptr;
 
     mutable MetricsRecordRef mMetricsRecordRef;
-    CounterPtr mInItemsTotal;
-    CounterPtr mInItemSizeBytes;
-    CounterPtr mOutItemsTotal;
-    CounterPtr mOutItemSizeBytes;
-    CounterPtr mDiscardedItemsTotal;
-    CounterPtr mDiscardedItemSizeBytes;
-    TimeCounterPtr mTotalProcessMs;
+    ShardedCounterPtr mInItemsTotal;
+    ShardedCounterPtr mInItemSizeBytes;
+    ShardedCounterPtr mOutItemsTotal;
+    ShardedCounterPtr mOutItemSizeBytes;
+    ShardedCounterPtr mDiscardedItemsTotal;
+    ShardedCounterPtr mDiscardedItemSizeBytes;
+    ShardedTimeCounterPtr mTotalProcessMs;
 
 private:
     virtual bool Serialize(T&& p, std::string& res, std::string& errorMsg) = 0;
@@ -0,0 +1,224 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/CharSearch.h"
+
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LOGTAIL_CHAR_SEARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace logtail {
+
+namespace {
+
+using FindFunc = const char* (*)(const char*, const char*, char);
+using FindOfFunc = const char* (*)(const char*, const char*, char, char);
+
+const char* FindFirstCharScalar(const char* begin, const char* end, char c) {
+    for (const char* p = begin; p < end; ++p) {
+        if (*p == c) {
+            return p;
+        }
+    }
+    return end;
+}
+
+const char* FindFirstCharOfScalar(const char* begin, const char* end, char c1, char c2) {
+    for (const char* p = begin; p < end; ++p) {
+        if (*p == c1 || *p == c2) {
+            return p;
+        }
+    }
+    return end;
+}
+
+const char* FindLastCharScalar(const char* begin, const char* end, char c) {
+    for (const char* p = end; p > begin; --p) {
+        if (*(p - 1) == c) {
+            return p - 1;
+        }
+    }
+    return nullptr;
+}
+
+#ifdef LOGTAIL_CHAR_SEARCH_X86
+__attribute__((target("sse2"))) const char* FindFirstCharSSE2(const char* begin, const char* end, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    const char* p = begin;
+    for (; end - p >= 16; p += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return FindFirstCharScalar(p, end, c);
+}
+
+__attribute__((target("sse2"))) const char*
+FindFirstCharOfSSE2(const char* begin, const char* end, char c1, char c2) {
+    const __m128i needle1 = _mm_set1_epi8(c1);
+    const __m128i needle2 = _mm_set1_epi8(c2);
+    const char* p = begin;
+    for (; end - p >= 16; p += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i eq = _mm_or_si128(_mm_cmpeq_epi8(chunk, needle1), _mm_cmpeq_epi8(chunk, needle2));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return FindFirstCharOfScalar(p, end, c1, c2);
+}
+
+__attribute__((target("sse2"))) const char* FindLastCharSSE2(const char* begin, const char* end, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    const char* p = end;
+    for (; p - begin >= 16; p -= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p - 16));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+        if (mask != 0) {
+            return p - 16 + (31 - __builtin_clz(mask));
+        }
+    }
+    return FindLastCharScalar(begin, p, c);
+}
+
+__attribute__((target("avx2"))) const char* FindFirstCharAVX2(const char* begin, const char* end, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    const char* p = begin;
+    for (; end - p >= 32; p += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return FindFirstCharSSE2(p, end, c);
+}
+
+__attribute__((target("avx2"))) const char*
+FindFirstCharOfAVX2(const char* begin, const char* end, char c1, char c2) {
+    const __m256i needle1 = _mm256_set1_epi8(c1);
+    const __m256i needle2 = _mm256_set1_epi8(c2);
+    const char* p = begin;
+    for (; end - p >= 32; p += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i eq = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, needle1), _mm256_cmpeq_epi8(chunk, needle2));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return FindFirstCharOfSSE2(p, end, c1, c2);
+}
+
+__attribute__((target("avx2"))) const char* FindLastCharAVX2(const char* begin, const char* end, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    const char* p = end;
+    for (; p - begin >= 32; p -= 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p - 32));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+        if (mask != 0) {
+            return p - 32 + (31 - __builtin_clz(mask));
+        }
+    }
+    return FindLastCharSSE2(begin, p, c);
+}
+#endif
+
+struct CharSearchDispatcher {
+    CharSearchDispatcher() { Select(Detect()); }
+
+    static CharSearchImpl Detect() {
+#ifdef LOGTAIL_CHAR_SEARCH_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return CharSearchImpl::AVX2;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return CharSearchImpl::SSE2;
+        }
+#endif
+        return CharSearchImpl::SCALAR;
+    }
+
+    void Select(CharSearchImpl impl) {
+        switch (impl) {
+#ifdef LOGTAIL_CHAR_SEARCH_X86
+            case CharSearchImpl::AVX2:
+                mFindFirst = FindFirstCharAVX2;
+                mFindFirstOf = FindFirstCharOfAVX2;
+                mFindLast = FindLastCharAVX2;
+                break;
+            case CharSearchImpl::SSE2:
+                mFindFirst = FindFirstCharSSE2;
+                mFindFirstOf = FindFirstCharOfSSE2;
+                mFindLast = FindLastCharSSE2;
+                break;
+#endif
+            default:
+                impl = CharSearchImpl::SCALAR;
+                mFindFirst = FindFirstCharScalar;
+                mFindFirstOf = FindFirstCharOfScalar;
+                mFindLast = FindLastCharScalar;
+                break;
+        }
+        mImpl = impl;
+    }
+
+    FindFunc mFindFirst = FindFirstCharScalar;
+    FindOfFunc mFindFirstOf = FindFirstCharOfScalar;
+    FindFunc mFindLast = FindLastCharScalar;
+    CharSearchImpl mImpl = CharSearchImpl::SCALAR;
+};
+
+CharSearchDispatcher& GetDispatcher() {
+    static CharSearchDispatcher sDispatcher;
+    return sDispatcher;
+}
+
+} // namespace
+
+const char* FindFirstChar(const char* begin, const char* end, char c) {
+    return GetDispatcher().mFindFirst(begin, end, c);
+}
+
+const char* FindFirstCharOf(const char* begin, const char* end, char c1, char c2) {
+    return GetDispatcher().mFindFirstOf(begin, end, c1, c2);
+}
+
+const char* FindLastChar(const char* begin, const char* end, char c) {
+    return GetDispatcher().mFindLast(begin, end, c);
+}
+
+CharSearchImpl GetCharSearchImpl() {
+    return GetDispatcher().mImpl;
+}
+
+#ifdef APSARA_UNIT_TEST_MAIN
+bool SetCharSearchImpl(CharSearchImpl impl) {
+    auto best = CharSearchDispatcher::Detect();
+    if (static_cast<int>(impl) > static_cast<int>(best)) {
+        return false;
+    }
+    GetDispatcher().Select(impl);
+    return GetDispatcher().mImpl == impl;
+}
+#endif
+
+} // namespace logtail
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace logtail {
+
+// Vectorized single-character search used by the line splitting hot paths.
+// The implementation (AVX2, SSE2 or scalar) is selected once at runtime according to the CPU.
+
+// Returns the position of the first occurrence of c in [begin, end), or end if not found.
+const char* FindFirstChar(const char* begin, const char* end, char c);
+
+// Returns the position of the first occurrence of c1 or c2 in [begin, end), or end if not found.
+const char* FindFirstCharOf(const char* begin, const char* end, char c1, char c2);
+
+// Returns the position of the last occurrence of c in [begin, end), or nullptr if not found.
+const char* FindLastChar(const char* begin, const char* end, char c);
+
+enum class CharSearchImpl { SCALAR, SSE2, AVX2 };
+
+CharSearchImpl GetCharSearchImpl();
+
+#ifdef APSARA_UNIT_TEST_MAIN
+// force a specific implementation, returns false if it is not supported by the CPU
+bool SetCharSearchImpl(CharSearchImpl impl);
+#endif
+
+} // namespace logtail
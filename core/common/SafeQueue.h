@@ -19,6 +19,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 namespace logtail {
 
@@ -32,6 +33,19 @@ public:
         mCond.notify_all();
     }
 
+    // moves all values into the queue with a single lock, values is cleared afterwards
+    void PushAll(std::vector<T>& values) {
+        if (values.empty()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mMux);
+        for (auto& value : values) {
+            mQueue.push(std::move(value));
+        }
+        values.clear();
+        mCond.notify_all();
+    }
+
     bool WaitAndPop(T& value, int64_t ms) {
         std::unique_lock<std::mutex> lock(mMux);
         if (!mCond.wait_for(lock, std::chrono::milliseconds(ms), [this] { return !mQueue.empty(); })) {
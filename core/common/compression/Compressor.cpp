@@ -34,7 +34,7 @@ void Compressor::SetMetricRecordRef(MetricLabels&& labels, DynamicMetricLabels&&
     mDiscardedItemSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_DISCARDED_SIZE_BYTES);
 }
 
-bool Compressor::DoCompress(const string& input, string& output, string& errorMsg) {
+bool Compressor::DoCompress(StringView input, string& output, string& errorMsg) {
     if (mMetricsRecordRef != nullptr) {
         ADD_COUNTER(mInItemsTotal, 1);
         ADD_COUNTER(mInItemSizeBytes, input.size());
@@ -18,6 +18,7 @@
 
 #include <string>
 
+#include "common/StringView.h"
 #include "common/compression/CompressType.h"
 #include "monitor/MetricManager.h"
 
@@ -28,7 +29,8 @@ public:
     Compressor(CompressType type) : mType(type) {}
     virtual ~Compressor() = default;
 
-    bool DoCompress(const std::string& input, std::string& output, std::string& errorMsg);
+    // input can be any part of a buffer, e.g., the output buffer of a serializer, so that no copy is needed
+    bool DoCompress(StringView input, std::string& output, std::string& errorMsg);
 
 #ifdef APSARA_UNIT_TEST_MAIN
     // buffer shoudl be reserved for output before calling this function
@@ -49,7 +51,7 @@ protected:
     TimeCounterPtr mTotalProcessMs;
 
 private:
-    virtual bool Compress(const std::string& input, std::string& output, std::string& errorMsg) = 0;
+    virtual bool Compress(StringView input, std::string& output, std::string& errorMsg) = 0;
 
     CompressType mType = CompressType::NONE;
 
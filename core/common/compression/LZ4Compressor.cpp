@@ -14,6 +14,8 @@
 
 #include "common/compression/LZ4Compressor.h"
 
+#include <memory>
+
 #include "lz4/lz4.h"
 
 #include "common/StringTools.h"
@@ -22,7 +24,14 @@ using namespace std;
 
 namespace logtail {
 
-bool LZ4Compressor::Compress(const string& input, string& output, string& errorMsg) {
+// the compression state (about 16KB) is kept per thread rather than on the stack of every call, since compressors are
+// shared by threads
+static void* GetThreadLZ4State() {
+    static thread_local unique_ptr<char[]> sState(new char[LZ4_sizeofState()]);
+    return sState.get();
+}
+
+bool LZ4Compressor::Compress(StringView input, string& output, string& errorMsg) {
     int encodingSize = LZ4_compressBound(input.size());
     if (encodingSize <= 0) {
         errorMsg = "input size is incorrect";
@@ -30,8 +39,8 @@ bool LZ4Compressor::Compress(const string& input, string& output, string& errorM
     }
     output.resize(static_cast<size_t>(encodingSize));
     try {
-        encodingSize = static_cast<size_t>(
-            LZ4_compress_default(input.c_str(), const_cast<char*>(output.c_str()), input.size(), encodingSize));
+        encodingSize = LZ4_compress_fast_extState(
+            GetThreadLZ4State(), input.data(), const_cast<char*>(output.c_str()), input.size(), encodingSize, 1);
         if (encodingSize <= 0) {
             errorMsg = "error code: " + ToString(encodingSize);
             return false;
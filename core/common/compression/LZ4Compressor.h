@@ -29,7 +29,7 @@ public:
 #endif
 
 private:
-    bool Compress(const std::string& input, std::string& output, std::string& errorMsg) override;
+    bool Compress(StringView input, std::string& output, std::string& errorMsg) override;
 };
 
 } // namespace logtail
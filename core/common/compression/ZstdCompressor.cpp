@@ -14,18 +14,50 @@
 
 #include "common/compression/ZstdCompressor.h"
 
+#include <memory>
+
 #include "zstd/zstd.h"
 
 using namespace std;
 
 namespace logtail {
 
-bool ZstdCompressor::Compress(const string& input, string& output, string& errorMsg) {
+// ZSTD_compress creates and frees a context of hundreds of KB on every call, so a context is kept per thread and reused
+// instead, since compressors are shared by threads
+static ZSTD_CCtx* GetThreadCCtx() {
+    static thread_local unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> sCCtx(ZSTD_createCCtx(), ZSTD_freeCCtx);
+    return sCCtx.get();
+}
+
+void ZstdCompressor::EnableDictionary(const ZstdDictTrainer::Options& options) {
+    mDictTrainer = make_unique<ZstdDictTrainer>(mCompressionLevel, options);
+}
+
+bool ZstdCompressor::Compress(StringView input, string& output, string& errorMsg) {
+    ZSTD_CCtx* cctx = GetThreadCCtx();
+    if (cctx == nullptr) {
+        errorMsg = "failed to create zstd context";
+        return false;
+    }
+    shared_ptr<const ZstdDictionary> dictionary;
+    if (mDictTrainer) {
+        mDictTrainer->AddSample(input);
+        dictionary = mDictTrainer->GetDictionary();
+    }
     size_t encodingSize = ZSTD_compressBound(input.size());
     output.resize(encodingSize);
     try {
-        encodingSize = ZSTD_compress(
-            const_cast<char*>(output.c_str()), encodingSize, input.c_str(), input.size(), mCompressionLevel);
+        if (dictionary) {
+            encodingSize = ZSTD_compress_usingCDict(cctx,
+                                                    const_cast<char*>(output.c_str()),
+                                                    encodingSize,
+                                                    input.data(),
+                                                    input.size(),
+                                                    dictionary->GetCDict());
+        } else {
+            encodingSize = ZSTD_compressCCtx(
+                cctx, const_cast<char*>(output.c_str()), encodingSize, input.data(), input.size(), mCompressionLevel);
+        }
         if (ZSTD_isError(encodingSize)) {
             errorMsg = ZSTD_getErrorName(encodingSize);
             return false;
@@ -40,7 +72,21 @@ bool ZstdCompressor::Compress(const string& input, string& output, string& error
 #ifdef APSARA_UNIT_TEST_MAIN
 bool ZstdCompressor::UnCompress(const string& input, string& output, string& errorMsg) {
     try {
-        size_t length = ZSTD_decompress(const_cast<char*>(output.c_str()), output.size(), input.c_str(), input.size());
+        size_t length = 0;
+        unsigned dictId = ZSTD_getDictID_fromFrame(input.c_str(), input.size());
+        auto dictionary = mDictTrainer ? mDictTrainer->GetDictionary() : nullptr;
+        if (dictId != 0 && dictionary && dictionary->GetId() == dictId) {
+            unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> dctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+            length = ZSTD_decompress_usingDict(dctx.get(),
+                                               const_cast<char*>(output.c_str()),
+                                               output.size(),
+                                               input.c_str(),
+                                               input.size(),
+                                               dictionary->GetContent().data(),
+                                               dictionary->GetContent().size());
+        } else {
+            length = ZSTD_decompress(const_cast<char*>(output.c_str()), output.size(), input.c_str(), input.size());
+        }
         if (ZSTD_isError(length)) {
             errorMsg = ZSTD_getErrorName(length);
             return false;
@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <memory>
+
 #include "common/compression/Compressor.h"
+#include "common/compression/ZstdDictTrainer.h"
 
 namespace logtail {
 
@@ -24,14 +27,22 @@ class ZstdCompressor : public Compressor {
 public:
     explicit ZstdCompressor(CompressType type, int32_t level = 1) : Compressor(type), mCompressionLevel(level) {}
 
+    // compress with dictionaries trained from the inputs once available, see ZstdDictTrainer for the prerequisites
+    void EnableDictionary(const ZstdDictTrainer::Options& options);
+
 #ifdef APSARA_UNIT_TEST_MAIN
     bool UnCompress(const std::string& input, std::string& output, std::string& errorMsg) override;
 #endif
 
 private:
-    bool Compress(const std::string& input, std::string& output, std::string& errorMsg) override;
+    bool Compress(StringView input, std::string& output, std::string& errorMsg) override;
 
     int32_t mCompressionLevel = 1;
+    std::unique_ptr<ZstdDictTrainer> mDictTrainer;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ZstdCompressorUnittest;
+#endif
 };
 
 } // namespace logtail
@@ -0,0 +1,108 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/compression/ZstdDictTrainer.h"
+
+#include <algorithm>
+
+#include "zstd/zdict.h"
+#include "zstd/zstd.h"
+
+#include "logger/Logger.h"
+
+using namespace std;
+
+namespace logtail {
+
+ZstdDictionary::ZstdDictionary(string&& content, int32_t level) : mContent(std::move(content)) {
+    mCDict = ZSTD_createCDict(mContent.data(), mContent.size(), level);
+    mId = ZDICT_getDictID(mContent.data(), mContent.size());
+}
+
+ZstdDictionary::~ZstdDictionary() {
+    ZSTD_freeCDict(mCDict);
+}
+
+void ZstdDictTrainer::AddSample(StringView input) {
+    if (mInputCnt.fetch_add(1, memory_order_relaxed) % mOptions.mSampleRate != 0 || input.empty()) {
+        return;
+    }
+
+    string samples;
+    vector<size_t> sampleSizes;
+    {
+        lock_guard<mutex> lock(mMux);
+        if (mIsTraining) {
+            return;
+        }
+        size_t size = min(input.size(), mOptions.mMaxSampleSize);
+        mSamples.append(input.data(), size);
+        mSampleSizes.push_back(size);
+        if (mSamples.size() < mOptions.mMaxSampleBytes) {
+            return;
+        }
+        if (mDictionary && time(nullptr) - mLastTrainTime < mOptions.mRetrainIntervalSecs) {
+            // not the time to retrain yet, start over so that the samples are always recent ones
+            mSamples.clear();
+            mSampleSizes.clear();
+            return;
+        }
+        mIsTraining = true;
+        samples.swap(mSamples);
+        sampleSizes.swap(mSampleSizes);
+    }
+
+    // training takes a while, so it is done without holding the lock, and inputs are compressed with the previous
+    // dictionary meanwhile
+    Train(samples, sampleSizes);
+
+    lock_guard<mutex> lock(mMux);
+    mIsTraining = false;
+    mLastTrainTime = time(nullptr);
+}
+
+shared_ptr<const ZstdDictionary> ZstdDictTrainer::GetDictionary() const {
+    lock_guard<mutex> lock(mMux);
+    return mDictionary;
+}
+
+bool ZstdDictTrainer::Train(const string& samples, const vector<size_t>& sampleSizes) {
+    string content(mOptions.mDictSize, '\0');
+    size_t size = ZDICT_trainFromBuffer(const_cast<char*>(content.data()),
+                                        content.size(),
+                                        samples.data(),
+                                        sampleSizes.data(),
+                                        static_cast<unsigned>(sampleSizes.size()));
+    if (ZDICT_isError(size)) {
+        LOG_WARNING(sLogger,
+                    ("failed to train zstd dictionary", ZDICT_getErrorName(size))("action", "keep current dictionary")(
+                        "sample cnt", sampleSizes.size())("sample bytes", samples.size()));
+        return false;
+    }
+    content.resize(size);
+    auto dictionary = make_shared<const ZstdDictionary>(std::move(content), mLevel);
+    if (!dictionary->IsValid()) {
+        LOG_WARNING(sLogger, ("failed to create zstd dictionary", "keep current dictionary"));
+        return false;
+    }
+    LOG_INFO(sLogger,
+             ("zstd dictionary trained", "succeeded")("dict id", dictionary->GetId())("dict size", size)(
+                 "sample cnt", sampleSizes.size())("sample bytes", samples.size()));
+
+    lock_guard<mutex> lock(mMux);
+    mDictionary = std::move(dictionary);
+    return true;
+}
+
+} // namespace logtail
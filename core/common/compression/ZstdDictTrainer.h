@@ -0,0 +1,95 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/StringView.h"
+
+struct ZSTD_CDict_s;
+
+namespace logtail {
+
+class ZstdDictionary {
+public:
+    ZstdDictionary(std::string&& content, int32_t level);
+    ~ZstdDictionary();
+    ZstdDictionary(const ZstdDictionary&) = delete;
+    ZstdDictionary& operator=(const ZstdDictionary&) = delete;
+
+    bool IsValid() const { return mCDict != nullptr; }
+    const ZSTD_CDict_s* GetCDict() const { return mCDict; }
+    const std::string& GetContent() const { return mContent; }
+    uint32_t GetId() const { return mId; }
+
+private:
+    std::string mContent;
+    ZSTD_CDict_s* mCDict = nullptr;
+    uint32_t mId = 0;
+};
+
+// Trains zstd dictionaries from samples of recent inputs of a compressor, and retrains periodically to follow changes
+// in the data. A dictionary helps small inputs the most, which have little history of their own to refer to.
+//
+// Data compressed with a dictionary can only be decompressed with the same dictionary, identified by the dictionary id
+// in the frame header, so it should only be used when the receiver has access to the dictionaries.
+class ZstdDictTrainer {
+public:
+    struct Options {
+        size_t mDictSize = 16 * 1024;
+        // samples are collected until there are this many bytes, and then a dictionary is trained from them
+        size_t mMaxSampleBytes = 1024 * 1024;
+        // only the head of a large input is sampled
+        size_t mMaxSampleSize = 16 * 1024;
+        // one in every mSampleRate inputs is sampled
+        uint32_t mSampleRate = 4;
+        int32_t mRetrainIntervalSecs = 3600;
+    };
+
+    ZstdDictTrainer(int32_t level, const Options& options) : mLevel(level), mOptions(options) {}
+
+    // may train a new dictionary in the calling thread once enough samples are collected
+    void AddSample(StringView input);
+    std::shared_ptr<const ZstdDictionary> GetDictionary() const;
+
+private:
+    bool Train(const std::string& samples, const std::vector<size_t>& sampleSizes);
+
+    int32_t mLevel = 1;
+    Options mOptions;
+    std::atomic_uint32_t mInputCnt = 0;
+
+    mutable std::mutex mMux;
+    std::string mSamples;
+    std::vector<size_t> mSampleSizes;
+    bool mIsTraining = false;
+    time_t mLastTrainTime = 0;
+    std::shared_ptr<const ZstdDictionary> mDictionary;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ZstdCompressorUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -15,28 +15,48 @@
 #include "common/http/AsynCurlRunner.h"
 
 #include <chrono>
+#include <functional>
 
+#include "common/Flags.h"
 #include "common/StringTools.h"
 #include "common/http/Curl.h"
 #include "logger/Logger.h"
 
+DEFINE_FLAG_INT32(async_curl_runner_thread_num, "number of workers of async curl runner", 2);
+
 using namespace std;
 
 namespace logtail {
 
+AsynCurlRunner::AsynCurlRunner() {
+    size_t workerCnt = static_cast<size_t>(max(1, INT32_FLAG(async_curl_runner_thread_num)));
+    for (size_t i = 0; i < workerCnt; ++i) {
+        mWorkers.emplace_back(make_unique<Worker>());
+    }
+}
+
 bool AsynCurlRunner::Init() {
     if (mInited) {
         return true;
     }
 
-    mClient = curl_multi_init();
     mIsFlush = false;
-    if (mClient == nullptr) {
-        LOG_ERROR(sLogger, ("failed to init async curl runner", "failed to init curl client"));
-        return false;
+    for (size_t i = 0; i < mWorkers.size(); ++i) {
+        mWorkers[i]->mClient = curl_multi_init();
+        if (mWorkers[i]->mClient == nullptr) {
+            LOG_ERROR(sLogger, ("failed to init async curl runner", "failed to init curl client")("worker", i));
+            for (size_t j = 0; j < i; ++j) {
+                curl_multi_cleanup(mWorkers[j]->mClient);
+                mWorkers[j]->mClient = nullptr;
+            }
+            return false;
+        }
+    }
+    for (auto& worker : mWorkers) {
+        worker->mThreadRes = async(launch::async, &AsynCurlRunner::Run, this, ref(*worker));
     }
-    mThreadRes = async(launch::async, &AsynCurlRunner::Run, this);
     mInited = true;
+    LOG_INFO(sLogger, ("async curl runner", "started")("worker cnt", mWorkers.size()));
     return true;
 }
 
@@ -45,11 +65,16 @@ void AsynCurlRunner::Stop() {
         return;
     }
     mIsFlush = true;
-    future_status s = mThreadRes.wait_for(chrono::seconds(1));
-    if (!mThreadRes.valid()) {
-        return;
+    bool forced = false;
+    for (auto& worker : mWorkers) {
+        if (!worker->mThreadRes.valid()) {
+            continue;
+        }
+        if (worker->mThreadRes.wait_for(chrono::seconds(1)) != future_status::ready) {
+            forced = true;
+        }
     }
-    if (s == future_status::ready) {
+    if (!forced) {
         LOG_INFO(sLogger, ("async curl runner", "stopped successfully"));
     } else {
         LOG_WARNING(sLogger, ("async curl runner", "forced to stopped"));
@@ -58,52 +83,59 @@ void AsynCurlRunner::Stop() {
 }
 
 bool AsynCurlRunner::AddRequest(unique_ptr<AsynHttpRequest>&& request) {
-    mQueue.Push(std::move(request));
+    size_t idx = 0;
+    if (mWorkers.size() > 1) {
+        idx = (hash<string>()(request->mHost) ^ (static_cast<size_t>(request->mPort) * 0x9e3779b97f4a7c15ULL))
+            % mWorkers.size();
+    }
+    mWorkers[idx]->mQueue.Push(std::move(request));
     return true;
 }
 
-void AsynCurlRunner::Run() {
+void AsynCurlRunner::Run(Worker& worker) {
     while (true) {
         unique_ptr<AsynHttpRequest> request;
-        if (mQueue.WaitAndPop(request, 500)) {
+        if (worker.mQueue.WaitAndPop(request, 500)) {
             LOG_DEBUG(
                 sLogger,
                 ("got request from queue, request address", request.get())("try cnt", ToString(request->mTryCnt)));
-            if (!AddRequestToMultiCurlHandler(mClient, std::move(request))) {
+            if (!AddRequestToMultiCurlHandler(worker.mClient, std::move(request))) {
                 continue;
             }
-        } else if (mIsFlush && mQueue.Empty()) {
+        } else if (mIsFlush && worker.mQueue.Empty()) {
             break;
         } else {
             continue;
         }
-        DoRun();
+        DoRun(worker);
     }
-    auto mc = curl_multi_cleanup(mClient);
+    auto mc = curl_multi_cleanup(worker.mClient);
+    worker.mClient = nullptr;
     if (mc != CURLM_OK) {
         LOG_ERROR(sLogger, ("failed to cleanup curl multi handle", "exit anyway")("errMsg", curl_multi_strerror(mc)));
     }
 }
 
-void AsynCurlRunner::DoRun() {
+void AsynCurlRunner::DoRun(Worker& worker) {
+    CURLM* client = worker.mClient;
     CURLMcode mc;
     int runningHandlers = 1;
     while (runningHandlers) {
-        if ((mc = curl_multi_perform(mClient, &runningHandlers)) != CURLM_OK) {
+        if ((mc = curl_multi_perform(client, &runningHandlers)) != CURLM_OK) {
             LOG_ERROR(
                 sLogger,
                 ("failed to call curl_multi_perform", "sleep 100ms and retry")("errMsg", curl_multi_strerror(mc)));
             this_thread::sleep_for(chrono::milliseconds(100));
             continue;
         }
-        HandleCompletedAsynRequests(mClient, runningHandlers);
+        HandleCompletedAsynRequests(client, runningHandlers);
 
         unique_ptr<AsynHttpRequest> request;
-        if (mQueue.TryPop(request)) {
+        if (worker.mQueue.TryPop(request)) {
             LOG_DEBUG(sLogger,
                       ("got item from flusher runner, request address", request.get())("try cnt",
                                                                                        ToString(request->mTryCnt)));
-            if (AddRequestToMultiCurlHandler(mClient, std::move(request))) {
+            if (AddRequestToMultiCurlHandler(client, std::move(request))) {
                 ++runningHandlers;
             }
         }
@@ -112,7 +144,7 @@ void AsynCurlRunner::DoRun() {
             1, 0
         };
         long curlTimeout = -1;
-        if ((mc = curl_multi_timeout(mClient, &curlTimeout)) != CURLM_OK) {
+        if ((mc = curl_multi_timeout(client, &curlTimeout)) != CURLM_OK) {
             LOG_WARNING(
                 sLogger,
                 ("failed to call curl_multi_timeout", "use default timeout 1s")("errMsg", curl_multi_strerror(mc)));
@@ -133,7 +165,7 @@ void AsynCurlRunner::DoRun() {
         FD_ZERO(&fdread);
         FD_ZERO(&fdwrite);
         FD_ZERO(&fdexcep);
-        if ((mc = curl_multi_fdset(mClient, &fdread, &fdwrite, &fdexcep, &maxfd)) != CURLM_OK) {
+        if ((mc = curl_multi_fdset(client, &fdread, &fdwrite, &fdexcep, &maxfd)) != CURLM_OK) {
             LOG_ERROR(sLogger, ("failed to call curl_multi_fdset", "sleep 100ms")("errMsg", curl_multi_strerror(mc)));
         }
         if (maxfd == -1) {
@@ -21,6 +21,7 @@
 #include <future>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "curl/multi.h"
 
@@ -29,6 +30,9 @@
 
 namespace logtail {
 
+// Requests are sharded across several workers, each of which owns a curl multi handle and a thread, so that slow
+// endpoints do not hold up requests to others. Requests to the same host and port always go to the same worker, so
+// that connections can still be reused.
 class AsynCurlRunner {
 public:
     AsynCurlRunner(const AsynCurlRunner&) = delete;
@@ -44,16 +48,19 @@ public:
     bool AddRequest(std::unique_ptr<AsynHttpRequest>&& request);
 
 private:
-    AsynCurlRunner() = default;
-    ~AsynCurlRunner() = default;
+    struct Worker {
+        CURLM* mClient = nullptr;
+        SafeQueue<std::unique_ptr<AsynHttpRequest>> mQueue;
+        std::future<void> mThreadRes;
+    };
 
-    void Run();
-    void DoRun();
+    AsynCurlRunner();
+    ~AsynCurlRunner() = default;
 
-    CURLM* mClient = nullptr;
-    SafeQueue<std::unique_ptr<AsynHttpRequest>> mQueue;
+    void Run(Worker& worker);
+    void DoRun(Worker& worker);
 
-    std::future<void> mThreadRes;
+    std::vector<std::unique_ptr<Worker>> mWorkers;
     std::atomic_bool mIsFlush = false;
     std::atomic_bool mInited = false;
 
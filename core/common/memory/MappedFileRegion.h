@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <memory>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace logtail {
+
+// A private, copy-on-write memory mapping of [offset, offset + size) of a file.
+// Writes are allowed and only affect the touched pages of this mapping, never the file itself. The byte right after
+// the requested range is guaranteed to be addressable, so that callers can terminate the data with '\0' in place.
+//
+// NOTE: accessing a mapping whose underlying file has been truncated raises SIGBUS, so this should only be used on
+// append-only files.
+class MappedFileRegion {
+public:
+    MappedFileRegion(const MappedFileRegion&) = delete;
+    MappedFileRegion& operator=(const MappedFileRegion&) = delete;
+
+    ~MappedFileRegion() {
+#if defined(__linux__)
+        if (mAddr != nullptr) {
+            munmap(mAddr, mMappedSize);
+        }
+#endif
+    }
+
+    // @return nullptr if the range cannot be mapped, e.g. the filesystem does not support mmap.
+    static std::shared_ptr<MappedFileRegion> Create(int fd, int64_t offset, size_t size) {
+#if defined(__linux__)
+        static const int64_t sPageSize = sysconf(_SC_PAGESIZE);
+        if (fd < 0 || offset < 0 || size == 0) {
+            return nullptr;
+        }
+        int64_t alignedOffset = offset - offset % sPageSize;
+        size_t lead = static_cast<size_t>(offset - alignedOffset);
+        // the terminating byte must not fall onto a page entirely beyond the mapped range
+        if ((lead + size) % sPageSize == 0) {
+            return nullptr;
+        }
+        size_t mappedSize = lead + size;
+        void* addr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, alignedOffset);
+        if (addr == MAP_FAILED) {
+            return nullptr;
+        }
+        madvise(addr, mappedSize, MADV_SEQUENTIAL);
+        return std::shared_ptr<MappedFileRegion>(
+            new MappedFileRegion(static_cast<char*>(addr), mappedSize, static_cast<char*>(addr) + lead, size));
+#else
+        return nullptr;
+#endif
+    }
+
+    char* Data() const { return mData; }
+    size_t Size() const { return mSize; }
+
+private:
+    MappedFileRegion(char* addr, size_t mappedSize, char* data, size_t size)
+        : mAddr(addr), mMappedSize(mappedSize), mData(data), mSize(size) {}
+
+    char* mAddr = nullptr;
+    size_t mMappedSize = 0;
+    char* mData = nullptr;
+    size_t mSize = 0;
+};
+
+} // namespace logtail
@@ -0,0 +1,168 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/memory/MemoryAccountant.h"
+
+#include <utility>
+
+#include "common/Flags.h"
+#include "logger/Logger.h"
+#include "monitor/MetricManager.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+DEFINE_FLAG_DOUBLE(memory_pressure_pause_input_ratio,
+                   "ratio of the memory budget used by in-flight data, above which file reading is paused",
+                   0.5);
+DEFINE_FLAG_DOUBLE(memory_pressure_pause_scrape_ratio,
+                   "ratio of the memory budget used by in-flight data, above which prometheus scraping is paused",
+                   0.65);
+DEFINE_FLAG_DOUBLE(memory_pressure_spill_ratio,
+                   "ratio of the memory budget used by in-flight data, above which data to send is spilled to disk",
+                   0.8);
+DEFINE_FLAG_DOUBLE(memory_pressure_recover_ratio,
+                   "a level of memory pressure is left only when the usage drops below its threshold times the ratio",
+                   0.9);
+
+using namespace std;
+
+namespace logtail {
+
+struct PipelineMemoryUsage {
+    explicit PipelineMemoryUsage(const string& configName) {
+        WriteMetrics::GetInstance()->PrepareMetricsRecordRef(mMetricsRecordRef,
+                                                             MetricCategory::METRIC_CATEGORY_PIPELINE,
+                                                             {{METRIC_LABEL_KEY_PIPELINE_NAME, configName}});
+        mUsedBytes = mMetricsRecordRef.CreateIntGauge(METRIC_PIPELINE_MEMORY_USED_BYTES);
+    }
+
+    MetricsRecordRef mMetricsRecordRef;
+    IntGaugePtr mUsedBytes;
+};
+
+MemoryCharge::MemoryCharge(MemoryCategory category, shared_ptr<PipelineMemoryUsage> usage, int64_t bytes)
+    : mCategory(category), mUsage(std::move(usage)) {
+    Add(bytes);
+}
+
+MemoryCharge::MemoryCharge(MemoryCharge&& rhs) noexcept
+    : mCategory(rhs.mCategory), mUsage(std::move(rhs.mUsage)), mBytes(exchange(rhs.mBytes, 0)) {
+}
+
+MemoryCharge& MemoryCharge::operator=(MemoryCharge&& rhs) noexcept {
+    if (this != &rhs) {
+        Reset();
+        mCategory = rhs.mCategory;
+        mUsage = std::move(rhs.mUsage);
+        mBytes = exchange(rhs.mBytes, 0);
+    }
+    return *this;
+}
+
+void MemoryCharge::Add(int64_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    mBytes += bytes;
+    MemoryAccountant::GetInstance()->Charge(mCategory, bytes);
+    if (mUsage) {
+        ADD_GAUGE(mUsage->mUsedBytes, bytes);
+    }
+}
+
+void MemoryCharge::Sub(int64_t bytes) {
+    if (bytes > mBytes) {
+        bytes = mBytes;
+    }
+    if (bytes <= 0) {
+        return;
+    }
+    mBytes -= bytes;
+    MemoryAccountant::GetInstance()->Discharge(mCategory, bytes);
+    if (mUsage) {
+        SUB_GAUGE(mUsage->mUsedBytes, bytes);
+    }
+}
+
+void MemoryCharge::Reset() {
+    Sub(mBytes);
+}
+
+shared_ptr<PipelineMemoryUsage> MemoryAccountant::GetPipelineUsage(const string& configName) {
+    lock_guard<mutex> lock(mPipelineUsageMux);
+    auto& weak = mPipelineUsages[configName];
+    auto usage = weak.lock();
+    if (!usage) {
+        usage = make_shared<PipelineMemoryUsage>(configName);
+        weak = usage;
+    }
+    // clean up the entries of removed pipelines
+    for (auto it = mPipelineUsages.begin(); it != mPipelineUsages.end();) {
+        if (it->second.expired()) {
+            it = mPipelineUsages.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return usage;
+}
+
+MemoryPressureLevel MemoryAccountant::UpdatePressureLevel(int64_t budgetBytes, int64_t rssBytes) {
+    static const array<MemoryPressureLevel, 3> sLevels
+        = {MemoryPressureLevel::PAUSE_INPUT, MemoryPressureLevel::PAUSE_SCRAPE, MemoryPressureLevel::SPILL};
+    const array<double, 3> ratios = {DOUBLE_FLAG(memory_pressure_pause_input_ratio),
+                                     DOUBLE_FLAG(memory_pressure_pause_scrape_ratio),
+                                     DOUBLE_FLAG(memory_pressure_spill_ratio)};
+
+    auto current = GetPressureLevel();
+    auto level = MemoryPressureLevel::NONE;
+    if (budgetBytes > 0) {
+        auto usage = static_cast<double>(GetTotalUsage());
+        for (size_t i = 0; i < sLevels.size(); ++i) {
+            // a level already reached is kept until the usage drops clearly below its threshold, to avoid flapping
+            double threshold = budgetBytes * ratios[i];
+            if (sLevels[i] <= current) {
+                threshold *= DOUBLE_FLAG(memory_pressure_recover_ratio);
+            }
+            if (usage >= threshold) {
+                level = sLevels[i];
+            }
+        }
+        double rssThreshold = static_cast<double>(budgetBytes);
+        if (current >= MemoryPressureLevel::PAUSE_INPUT) {
+            rssThreshold *= DOUBLE_FLAG(memory_pressure_recover_ratio);
+        }
+        if (rssBytes >= rssThreshold && level < MemoryPressureLevel::PAUSE_INPUT) {
+            level = MemoryPressureLevel::PAUSE_INPUT;
+        }
+    }
+    if (level != current) {
+        mLevel.store(level, memory_order_relaxed);
+        LOG_WARNING(sLogger,
+                    ("memory pressure level changed, from", static_cast<int>(current))("to", static_cast<int>(level))(
+                        "accounted memory bytes", GetTotalUsage())("rss bytes", rssBytes)("budget bytes", budgetBytes));
+    }
+    return level;
+}
+
+bool MemoryAccountant::IsRelievableByBackpressure(int64_t budgetBytes, int64_t rssBytes) const {
+    // nothing is throttled, or everything possible is already done
+    auto level = GetPressureLevel();
+    if (level == MemoryPressureLevel::NONE || level >= MemoryPressureLevel::SPILL) {
+        return false;
+    }
+    // throttling only releases the accounted in-flight data
+    return rssBytes - GetTotalUsage() <= budgetBytes;
+}
+
+} // namespace logtail
@@ -0,0 +1,122 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace logtail {
+
+// owners of in-flight data, whose memory is charged against the accountant
+enum class MemoryCategory { SOURCE_BUFFER, PROCESS_QUEUE, BATCHER, SENDER_QUEUE, COUNT };
+
+// levels of backpressure applied as the accounted memory grows, each level includes the actions of the lower ones
+enum class MemoryPressureLevel {
+    NONE,
+    // file reading is paused
+    PAUSE_INPUT,
+    // prometheus scraping is paused
+    PAUSE_SCRAPE,
+    // data waiting to be sent is spilled to disk by the flushers supporting it
+    SPILL,
+};
+
+struct PipelineMemoryUsage;
+
+// An amount of memory charged against the accountant, and the pipeline if given, which is discharged on destruction.
+// It is not thread safe.
+class MemoryCharge {
+public:
+    MemoryCharge() = default;
+    MemoryCharge(MemoryCategory category, std::shared_ptr<PipelineMemoryUsage> usage, int64_t bytes = 0);
+    ~MemoryCharge() { Reset(); }
+    MemoryCharge(MemoryCharge&& rhs) noexcept;
+    MemoryCharge& operator=(MemoryCharge&& rhs) noexcept;
+    MemoryCharge(const MemoryCharge&) = delete;
+    MemoryCharge& operator=(const MemoryCharge&) = delete;
+
+    void Add(int64_t bytes);
+    void Sub(int64_t bytes);
+    void Reset();
+    int64_t GetBytes() const { return mBytes; }
+
+private:
+    MemoryCategory mCategory = MemoryCategory::SOURCE_BUFFER;
+    std::shared_ptr<PipelineMemoryUsage> mUsage;
+    int64_t mBytes = 0;
+};
+
+// MemoryAccountant keeps track of the memory held by in-flight data of the whole process, and turns the usage into
+// a level of backpressure, so that inputs are throttled before the memory limit is reached instead of restarting.
+class MemoryAccountant {
+public:
+    MemoryAccountant(const MemoryAccountant&) = delete;
+    MemoryAccountant& operator=(const MemoryAccountant&) = delete;
+
+    static MemoryAccountant* GetInstance() {
+        static MemoryAccountant instance;
+        return &instance;
+    }
+
+    void Charge(MemoryCategory category, int64_t bytes) {
+        mUsage[static_cast<size_t>(category)].fetch_add(bytes, std::memory_order_relaxed);
+    }
+    void Discharge(MemoryCategory category, int64_t bytes) {
+        mUsage[static_cast<size_t>(category)].fetch_sub(bytes, std::memory_order_relaxed);
+    }
+    int64_t GetUsage(MemoryCategory category) const {
+        return mUsage[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+    }
+    // Groups in process queues and batchers keep their data in source buffers, so only source buffers and sender
+    // queues are summed up to avoid counting the same bytes twice.
+    int64_t GetTotalUsage() const {
+        return GetUsage(MemoryCategory::SOURCE_BUFFER) + GetUsage(MemoryCategory::SENDER_QUEUE);
+    }
+
+    // the usage shared by all components of the pipeline, which is reported as a self-monitor gauge
+    std::shared_ptr<PipelineMemoryUsage> GetPipelineUsage(const std::string& configName);
+
+    // Re-evaluate the level against the budget, should be called periodically. Inputs are paused at least while the
+    // RSS of the process exceeds the budget, even if in-flight data is not the main part of it.
+    MemoryPressureLevel UpdatePressureLevel(int64_t budgetBytes, int64_t rssBytes = 0);
+    MemoryPressureLevel GetPressureLevel() const { return mLevel.load(std::memory_order_relaxed); }
+    bool IsInputPaused() const { return GetPressureLevel() >= MemoryPressureLevel::PAUSE_INPUT; }
+    bool IsScrapePaused() const { return GetPressureLevel() >= MemoryPressureLevel::PAUSE_SCRAPE; }
+    bool ShouldSpill() const { return GetPressureLevel() >= MemoryPressureLevel::SPILL; }
+    // whether the current backpressure can still bring the RSS under the budget by releasing in-flight data
+    bool IsRelievableByBackpressure(int64_t budgetBytes, int64_t rssBytes) const;
+
+private:
+    MemoryAccountant() = default;
+    ~MemoryAccountant() = default;
+
+    std::array<std::atomic<int64_t>, static_cast<size_t>(MemoryCategory::COUNT)> mUsage{};
+    std::atomic<MemoryPressureLevel> mLevel = MemoryPressureLevel::NONE;
+
+    std::mutex mPipelineUsageMux;
+    std::unordered_map<std::string, std::weak_ptr<PipelineMemoryUsage>> mPipelineUsages;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class MemoryAccountantUnittest;
+#endif
+};
+
+} // namespace logtail
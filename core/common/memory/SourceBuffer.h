@@ -18,8 +18,12 @@
 
 #include <list>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "common/StringView.h"
+#include "common/memory/MappedFileRegion.h"
+#include "common/memory/MemoryAccountant.h"
 
 namespace logtail {
 
@@ -51,20 +55,42 @@ public:
         mAllocatedChunks.push_back(mAllocPtr);
         mFreeBytesInChunk = mChunkSize;
         mAllocated = mChunkSize;
+        MemoryAccountant::GetInstance()->Charge(MemoryCategory::SOURCE_BUFFER, mAllocated);
     }
 
     BufferAllocator(const BufferAllocator&) = delete;
     BufferAllocator& operator=(const BufferAllocator&) = delete;
 
-    BufferAllocator(BufferAllocator&&) = default;
-    BufferAllocator& operator=(BufferAllocator&&) = default;
-
-    ~BufferAllocator() {
-        for (size_t i = 0; i < mAllocatedChunks.size(); i++) {
-            delete[] mAllocatedChunks[i];
+    // the moved-from allocator owns no chunk, so that the memory is discharged only once
+    BufferAllocator(BufferAllocator&& rhs) noexcept
+        : mFirstChunkSize(rhs.mFirstChunkSize),
+          mChunkSizeLimit(rhs.mChunkSizeLimit),
+          mAllocatedChunks(std::move(rhs.mAllocatedChunks)),
+          mAllocated(std::exchange(rhs.mAllocated, 0)),
+          mUsed(std::exchange(rhs.mUsed, 0)),
+          mAllocPtr(std::exchange(rhs.mAllocPtr, nullptr)),
+          mFreeBytesInChunk(std::exchange(rhs.mFreeBytesInChunk, 0)),
+          mChunkSize(rhs.mChunkSize) {
+        rhs.mAllocatedChunks.clear();
+    }
+    BufferAllocator& operator=(BufferAllocator&& rhs) noexcept {
+        if (this != &rhs) {
+            Release();
+            mFirstChunkSize = rhs.mFirstChunkSize;
+            mChunkSizeLimit = rhs.mChunkSizeLimit;
+            mAllocatedChunks = std::move(rhs.mAllocatedChunks);
+            rhs.mAllocatedChunks.clear();
+            mAllocated = std::exchange(rhs.mAllocated, 0);
+            mUsed = std::exchange(rhs.mUsed, 0);
+            mAllocPtr = std::exchange(rhs.mAllocPtr, nullptr);
+            mFreeBytesInChunk = std::exchange(rhs.mFreeBytesInChunk, 0);
+            mChunkSize = rhs.mChunkSize;
         }
+        return *this;
     }
 
+    ~BufferAllocator() { Release(); }
+
     void Reset(void) {
         for (size_t i = 1; i < mAllocatedChunks.size(); i++) {
             delete[] mAllocatedChunks[i];
@@ -73,6 +99,7 @@ public:
         mAllocPtr = mAllocatedChunks[0];
         mChunkSize = mFirstChunkSize;
         mFreeBytesInChunk = mChunkSize;
+        MemoryAccountant::GetInstance()->Discharge(MemoryCategory::SOURCE_BUFFER, mAllocated - mChunkSize);
         mAllocated = mChunkSize;
         mUsed = 0;
     }
@@ -109,6 +136,7 @@ private:
             mem = new uint8_t[bytes];
             mAllocatedChunks.push_back(mem);
             mAllocated += bytes;
+            MemoryAccountant::GetInstance()->Charge(MemoryCategory::SOURCE_BUFFER, bytes);
         } else {
             /*
              * Here we intentionally waste some space in the current chunk.
@@ -121,12 +149,22 @@ private:
             mAllocPtr = mem + bytes;
             mFreeBytesInChunk = mChunkSize - bytes;
             mAllocated += mChunkSize;
+            MemoryAccountant::GetInstance()->Charge(MemoryCategory::SOURCE_BUFFER, mChunkSize);
         }
 
         mUsed += bytes;
         return mem;
     }
 
+    void Release() {
+        for (size_t i = 0; i < mAllocatedChunks.size(); i++) {
+            delete[] mAllocatedChunks[i];
+        }
+        mAllocatedChunks.clear();
+        MemoryAccountant::GetInstance()->Discharge(MemoryCategory::SOURCE_BUFFER, mAllocated);
+        mAllocated = 0;
+    }
+
 private:
     uint32_t mFirstChunkSize = 4096;
     uint32_t mChunkSizeLimit = 1024 * 128;
@@ -167,12 +205,19 @@ public:
     StringBuffer CopyString(const std::string& s) { return CopyString(s.data(), s.length()); }
     StringBuffer CopyString(StringView s) { return CopyString(s.data(), s.length()); }
 
+    int64_t GetUsedSize() const { return mAllocator.GetUsedSize(); }
+
+    // keep the mapping alive as long as any event may still refer to it
+    void HoldMappedRegion(std::shared_ptr<MappedFileRegion> region) { mMappedRegions.emplace_back(std::move(region)); }
+
 private:
     BufferAllocator mAllocator;
+    std::vector<std::shared_ptr<MappedFileRegion>> mMappedRegions;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class LogEventUnittest;
     friend class PipelineEventGroupUnittest;
+    friend class LogFileReaderUnittest;
 #endif
 };
 
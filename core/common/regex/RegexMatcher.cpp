@@ -0,0 +1,447 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/regex/RegexMatcher.h"
+
+#include <cctype>
+#include <cstring>
+
+#include "common/CharSearch.h"
+#include "common/Flags.h"
+#include "common/StringTools.h"
+
+DEFINE_FLAG_BOOL(enable_re2_regex_engine, "use re2 instead of boost for compatible regex patterns", true);
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+// escapes whose boost semantics cannot be reproduced by re2, e.g. backreferences, \v (vertical space in boost), \Z
+const char* const kUnsupportedEscapes = "0123456789pPhHvVRXKGZQEceNlLuUgk<>`'";
+
+bool Contains(StringView text, const string& literal) {
+    if (literal.size() > text.size()) {
+        return false;
+    }
+    const char* end = text.data() + text.size() - literal.size() + 1;
+    const char* cur = text.data();
+    while ((cur = FindFirstChar(cur, end, literal[0])) != end) {
+        if (memcmp(cur + 1, literal.data() + 1, literal.size() - 1) == 0) {
+            return true;
+        }
+        ++cur;
+    }
+    return false;
+}
+
+// returns the position after the class starting at pattern[i] == '[', or string::npos if not closed
+size_t SkipCharClass(const string& pattern, size_t i) {
+    ++i;
+    if (i < pattern.size() && pattern[i] == '^') {
+        ++i;
+    }
+    // a leading ] is a literal
+    if (i < pattern.size() && pattern[i] == ']') {
+        ++i;
+    }
+    while (i < pattern.size()) {
+        if (pattern[i] == '\\') {
+            i += 2;
+        } else if (pattern[i] == '[' && i + 1 < pattern.size()
+                   && (pattern[i + 1] == ':' || pattern[i + 1] == '=' || pattern[i + 1] == '.')) {
+            size_t close = pattern.find(string(1, pattern[i + 1]) + "]", i + 2);
+            if (close == string::npos) {
+                return string::npos;
+            }
+            i = close + 2;
+        } else if (pattern[i] == ']') {
+            return i + 1;
+        } else {
+            ++i;
+        }
+    }
+    return string::npos;
+}
+
+// returns the position after the quantifier starting at pattern[i], including lazy or possessive modifiers
+size_t SkipQuantifier(const string& pattern, size_t i) {
+    if (pattern[i] == '{') {
+        size_t close = pattern.find('}', i);
+        if (close == string::npos) {
+            return string::npos;
+        }
+        i = close + 1;
+    } else {
+        ++i;
+    }
+    if (i < pattern.size() && (pattern[i] == '?' || pattern[i] == '+')) {
+        ++i;
+    }
+    return i;
+}
+
+bool IsQuantifier(char c) {
+    return c == '*' || c == '+' || c == '?' || c == '{';
+}
+
+} // namespace
+
+RegexMatcher::RegexMatcher(const string& pattern, Mode mode) : mPattern(pattern), mMode(mode), mBoostRegex(pattern) {
+    ExtractLiterals(mPattern, mRequiredLiteral, mLiteralPrefix);
+    if (!BOOL_FLAG(enable_re2_regex_engine)) {
+        return;
+    }
+    string re2Pattern;
+    if (!TranslateToRE2(mPattern, mMode, re2Pattern)) {
+        return;
+    }
+    auto re2 = make_unique<RE2>(re2Pattern, GetRE2Options());
+    if (!re2->ok()) {
+        // e.g. repetition count too large for re2
+        return;
+    }
+    mRE2 = std::move(re2);
+    mRE2Pattern = std::move(re2Pattern);
+}
+
+bool RegexMatcher::MayMatch(StringView text) const {
+    // matches always start at the beginning of the text in both modes
+    if (!mLiteralPrefix.empty()
+        && (text.size() < mLiteralPrefix.size()
+            || memcmp(text.data(), mLiteralPrefix.data(), mLiteralPrefix.size()) != 0)) {
+        return false;
+    }
+    return mRequiredLiteral.empty() || Contains(text, mRequiredLiteral);
+}
+
+bool RegexMatcher::Match(StringView text, string& exception) const {
+    if (!MayMatch(text)) {
+        return false;
+    }
+    if (mRE2) {
+        return RE2Match(text);
+    }
+    if (mMode == Mode::FULL_MATCH) {
+        return BoostRegexMatch(text.data(), text.size(), mBoostRegex, exception);
+    }
+    return BoostRegexSearch(text.data(), text.size(), mBoostRegex, exception);
+}
+
+bool RegexMatcher::RE2Match(StringView text) const {
+    re2::StringPiece piece(text.data(), text.size());
+    if (mMode == Mode::FULL_MATCH) {
+        return RE2::FullMatch(piece, *mRE2);
+    }
+    // same as boost::match_continuous, the match must start at the beginning of the text
+    return mRE2->Match(piece, 0, text.size(), RE2::ANCHOR_START, nullptr, 0);
+}
+
+const RE2::Options& RegexMatcher::GetRE2Options() {
+    static const RE2::Options sOptions = []() {
+        // bytes are matched as is, and . matches any byte including \n, same as boost
+        RE2::Options options(RE2::Latin1);
+        options.set_dot_nl(true);
+        options.set_never_capture(true);
+        options.set_log_errors(false);
+        return options;
+    }();
+    return sOptions;
+}
+
+bool RegexMatcher::TranslateToRE2(const string& pattern, Mode mode, string& re2Pattern) {
+    re2Pattern.clear();
+    re2Pattern.reserve(pattern.size() + 16);
+
+    size_t i = 0;
+    if (!pattern.empty() && pattern[0] == '^') {
+        // matches always start at the beginning of the text, where ^ at the beginning is always satisfied
+        ++i;
+    }
+    size_t end = pattern.size();
+    if (mode == Mode::FULL_MATCH && end > i && pattern[end - 1] == '$') {
+        // a trailing $ is always satisfied in full match mode, unless it is escaped
+        size_t backslashCnt = 0;
+        for (size_t j = end - 1; j > i && pattern[j - 1] == '\\'; --j) {
+            ++backslashCnt;
+        }
+        if (backslashCnt % 2 == 0) {
+            --end;
+        }
+    }
+
+    int depth = 0;
+    bool inClass = false;
+    size_t classStart = 0;
+    while (i < end) {
+        char c = pattern[i];
+        if (c == '\\') {
+            if (i + 1 >= end) {
+                return false;
+            }
+            char next = pattern[i + 1];
+            if (strchr(kUnsupportedEscapes, next) != nullptr || static_cast<unsigned char>(next) >= 0x80) {
+                return false;
+            }
+            if (next == 's') {
+                // re2 \s does not contain \v
+                re2Pattern += inClass ? "[:space:]" : "[[:space:]]";
+            } else if (next == 'S') {
+                if (inClass) {
+                    return false;
+                }
+                re2Pattern += "[^[:space:]]";
+            } else if (inClass && (next == 'b' || next == 'A' || next == 'z')) {
+                // \b is backspace in boost classes
+                return false;
+            } else {
+                re2Pattern += c;
+                re2Pattern += next;
+            }
+            i += 2;
+            continue;
+        }
+        if (inClass) {
+            if (c == '[' && i + 1 < end && pattern[i + 1] == ':') {
+                size_t close = pattern.find(":]", i + 2);
+                if (close == string::npos || close >= end) {
+                    return false;
+                }
+                re2Pattern.append(pattern, i, close + 2 - i);
+                i = close + 2;
+                continue;
+            }
+            if (c == '[' && i + 1 < end && (pattern[i + 1] == '=' || pattern[i + 1] == '.')) {
+                return false;
+            }
+            // a ] right after [ or [^ is a literal
+            if (c == ']' && i != classStart) {
+                inClass = false;
+            }
+            re2Pattern += c;
+            ++i;
+            continue;
+        }
+        switch (c) {
+            case '[':
+                inClass = true;
+                re2Pattern += c;
+                ++i;
+                if (i < end && pattern[i] == '^') {
+                    re2Pattern += '^';
+                    ++i;
+                }
+                classStart = i;
+                continue;
+            case '(':
+                if (i + 1 < end && pattern[i + 1] == '?') {
+                    // only non capturing groups, no lookarounds, inline flags, atomic groups, etc.
+                    if (i + 2 >= end || pattern[i + 2] != ':') {
+                        return false;
+                    }
+                }
+                ++depth;
+                break;
+            case ')':
+                --depth;
+                if (depth < 0) {
+                    return false;
+                }
+                break;
+            case '^':
+            case '$':
+                // multiline anchors can only be handled at the beginning
+                return false;
+            case '{':
+                // boost treats {,n} as literals, while re2 versions differ
+                if (i + 1 < end && pattern[i + 1] == ',') {
+                    return false;
+                }
+                break;
+            default:
+                break;
+        }
+        re2Pattern += c;
+        ++i;
+    }
+    return !inClass && depth == 0;
+}
+
+void RegexMatcher::ExtractLiterals(const string& pattern, string& requiredLiteral, string& literalPrefix) {
+    requiredLiteral.clear();
+    literalPrefix.clear();
+
+    string run;
+    bool isPrefix = true;
+    auto endRun = [&]() {
+        if (isPrefix) {
+            literalPrefix = run;
+            isPrefix = false;
+        }
+        if (run.size() > requiredLiteral.size()) {
+            requiredLiteral = run;
+        }
+        run.clear();
+    };
+    auto giveUp = [&]() {
+        requiredLiteral.clear();
+        literalPrefix.clear();
+    };
+
+    int depth = 0;
+    size_t i = 0;
+    if (!pattern.empty() && pattern[0] == '^') {
+        ++i;
+    }
+    while (i < pattern.size()) {
+        char c = pattern[i];
+        // whether the current element is a literal char in the top level, which may be appended to the run
+        bool isLiteral = false;
+        char literal = 0;
+        if (c == '\\') {
+            if (i + 1 >= pattern.size()) {
+                giveUp();
+                return;
+            }
+            char next = pattern[i + 1];
+            if (next == 'Q') {
+                giveUp();
+                return;
+            }
+            i += 2;
+            if (isalnum(static_cast<unsigned char>(next))) {
+                // skip the arguments, e.g. \x{41}, \p{L}, \k<name>
+                if (strchr("xpPkgN", next) != nullptr) {
+                    while (i < pattern.size()
+                           && (isalnum(static_cast<unsigned char>(pattern[i]))
+                               || strchr("{}<>'", pattern[i]) != nullptr)) {
+                        ++i;
+                    }
+                } else if (next == 'c' && i < pattern.size()) {
+                    ++i;
+                }
+            } else {
+                isLiteral = depth == 0;
+                literal = next;
+            }
+        } else if (c == '[') {
+            i = SkipCharClass(pattern, i);
+            if (i == string::npos) {
+                giveUp();
+                return;
+            }
+        } else if (c == '(') {
+            if (i + 1 < pattern.size() && pattern[i + 1] == '?' && i + 2 < pattern.size()
+                && isalpha(static_cast<unsigned char>(pattern[i + 2])) && pattern[i + 2] != 'P') {
+                // inline flags, e.g. (?i)
+                giveUp();
+                return;
+            }
+            ++depth;
+            ++i;
+        } else if (c == ')') {
+            if (--depth < 0) {
+                giveUp();
+                return;
+            }
+            ++i;
+        } else if (c == '|') {
+            if (depth == 0) {
+                giveUp();
+                return;
+            }
+            ++i;
+        } else if (IsQuantifier(c)) {
+            // dangling quantifier, e.g. a{b in boost
+            i = SkipQuantifier(pattern, i);
+            if (i == string::npos) {
+                giveUp();
+                return;
+            }
+        } else if (c == '.' || c == '^' || c == '$') {
+            ++i;
+        } else {
+            isLiteral = depth == 0;
+            literal = c;
+            ++i;
+        }
+
+        if (!isLiteral) {
+            endRun();
+            continue;
+        }
+        run += literal;
+        if (i < pattern.size() && IsQuantifier(pattern[i])) {
+            if (pattern[i] != '+') {
+                // the literal is optional
+                run.pop_back();
+            }
+            i = SkipQuantifier(pattern, i);
+            if (i == string::npos) {
+                giveUp();
+                return;
+            }
+            endRun();
+        }
+    }
+    if (depth != 0) {
+        giveUp();
+        return;
+    }
+    endRun();
+}
+
+RegexSetMatcher::RegexSetMatcher(const vector<string>& patterns) {
+    mMatchers.reserve(patterns.size());
+    bool allRE2 = !patterns.empty();
+    for (const auto& pattern : patterns) {
+        mMatchers.emplace_back(pattern, RegexMatcher::Mode::FULL_MATCH);
+        allRE2 = allRE2 && mMatchers.back().GetEngine() == RegexMatcher::Engine::RE2;
+    }
+    if (!allRE2 || mMatchers.size() < 2) {
+        return;
+    }
+    auto set = make_unique<RE2::Set>(RegexMatcher::GetRE2Options(), RE2::ANCHOR_BOTH);
+    for (const auto& matcher : mMatchers) {
+        if (set->Add(matcher.GetRE2Pattern(), nullptr) < 0) {
+            return;
+        }
+    }
+    if (set->Compile()) {
+        mSet = std::move(set);
+    }
+}
+
+bool RegexSetMatcher::MatchAll(StringView text, string& exception) const {
+    for (const auto& matcher : mMatchers) {
+        if (!matcher.MayMatch(text)) {
+            return false;
+        }
+    }
+    if (mSet) {
+        vector<int> matched;
+        return mSet->Match(re2::StringPiece(text.data(), text.size()), &matched) && matched.size() == mMatchers.size();
+    }
+    for (const auto& matcher : mMatchers) {
+        if (!matcher.Match(text, exception)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace logtail
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "boost/regex.hpp"
+#include "re2/re2.h"
+#include "re2/set.h"
+
+#include "common/StringView.h"
+
+namespace logtail {
+
+// Regex matcher with boost perl syntax semantics, which picks the regex engine per pattern.
+//
+// RE2 is used whenever the pattern can be rewritten into an RE2 pattern behaving exactly the same as boost on bytes,
+// e.g. \s is rewritten as [[:space:]] since RE2 excludes \v from \s. Patterns relying on features only boost has
+// (backreferences, lookarounds, inline flags, line anchors in the middle, etc.) keep using boost.
+//
+// Independently of the engine, literals that any match must contain are extracted from the pattern, so that texts
+// lacking them are rejected without running the regex at all.
+class RegexMatcher {
+public:
+    enum class Mode {
+        FULL_MATCH, // same as boost::regex_match
+        PARTIAL_MATCH // same as boost::regex_search with boost::match_continuous, i.e. a prefix of the text matches
+    };
+    enum class Engine { BOOST, RE2 };
+
+    // the pattern should have been validated by IsRegexValid
+    RegexMatcher(const std::string& pattern, Mode mode);
+    RegexMatcher(RegexMatcher&&) = default;
+    RegexMatcher& operator=(RegexMatcher&&) = default;
+
+    bool Match(StringView text, std::string& exception) const;
+    // cheap check with the extracted literals, false means the text can never match
+    bool MayMatch(StringView text) const;
+
+    const std::string& GetPattern() const { return mPattern; }
+    Mode GetMode() const { return mMode; }
+    Engine GetEngine() const { return mRE2 ? Engine::RE2 : Engine::BOOST; }
+    // empty if the pattern is not compatible with RE2
+    const std::string& GetRE2Pattern() const { return mRE2Pattern; }
+    const std::string& GetRequiredLiteral() const { return mRequiredLiteral; }
+    const std::string& GetLiteralPrefix() const { return mLiteralPrefix; }
+
+    static const RE2::Options& GetRE2Options();
+    // Rewrites the boost pattern into an equivalent RE2 pattern to be matched from the beginning of the text, so a
+    // leading ^ is removed.
+    // @return false if no equivalent RE2 pattern is known.
+    static bool TranslateToRE2(const std::string& pattern, Mode mode, std::string& re2Pattern);
+    // Extracts the longest literal any match must contain, and the literal any match must start with. Both are left
+    // empty when unsure.
+    static void ExtractLiterals(const std::string& pattern, std::string& requiredLiteral, std::string& literalPrefix);
+
+private:
+    bool RE2Match(StringView text) const;
+
+    std::string mPattern;
+    Mode mMode;
+    boost::regex mBoostRegex;
+    std::unique_ptr<RE2> mRE2;
+    std::string mRE2Pattern;
+    std::string mRequiredLiteral;
+    std::string mLiteralPrefix;
+};
+
+// Checks whether a text fully matches all the given patterns. When all the patterns are compatible with RE2, they are
+// evaluated in a single pass with RE2::Set.
+class RegexSetMatcher {
+public:
+    explicit RegexSetMatcher(const std::vector<std::string>& patterns);
+
+    bool MatchAll(StringView text, std::string& exception) const;
+
+    size_t Size() const { return mMatchers.size(); }
+    bool IsRE2Set() const { return mSet != nullptr; }
+
+private:
+    std::vector<RegexMatcher> mMatchers;
+    std::unique_ptr<RE2::Set> mSet;
+};
+
+} // namespace logtail
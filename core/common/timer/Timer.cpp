@@ -15,6 +15,7 @@
 #include "common/timer/Timer.h"
 
 #include "logger/Logger.h"
+#include "monitor/metric_constants/MetricConstants.h"
 
 using namespace std;
 
@@ -32,6 +33,22 @@ void Timer::Init() {
         }
         mIsThreadRunning = true;
     }
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_RUNNER,
+        {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_TIMER}});
+    mInItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_ITEMS_TOTAL);
+    mOutItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_OUT_ITEMS_TOTAL);
+    mCancelledItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_TIMER_CANCELLED_ITEMS_TOTAL);
+    mWaitingItemsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_TIMER_WAITING_ITEMS_TOTAL);
+    mLastRunTime = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
+    mTotalLagMs = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_TIMER_TOTAL_LAG_MS);
+    mLagBuckets[0] = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_TIMER_LAG_LE_1MS_TOTAL);
+    mLagBuckets[1] = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_TIMER_LAG_LE_10MS_TOTAL);
+    mLagBuckets[2] = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_TIMER_LAG_LE_100MS_TOTAL);
+    mLagBuckets[3] = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_TIMER_LAG_LE_1S_TOTAL);
+    mLagBuckets[4] = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_TIMER_LAG_GT_1S_TOTAL);
+
     mThreadRes = async(launch::async, &Timer::Run, this);
 }
 
@@ -55,55 +72,103 @@ void Timer::Stop() {
     }
 }
 
-void Timer::PushEvent(unique_ptr<TimerEvent>&& e) {
-    lock_guard<mutex> lock(mQueueMux);
-    if (mQueue.empty() || e->GetExecTime() < mQueue.top()->GetExecTime()) {
-        mQueue.push(std::move(e));
+uint64_t Timer::PushEvent(unique_ptr<TimerEvent>&& e) {
+    bool isEarlier = false;
+    uint64_t id = 0;
+    {
+        lock_guard<mutex> lock(mQueueMux);
+        if (e->GetExecTime() < mNextRunTime) {
+            // later events pushed before the thread wakes up need not notify again
+            mNextRunTime = e->GetExecTime();
+            isEarlier = true;
+        }
+        id = mQueue.Add(std::move(e));
+        SET_GAUGE(mWaitingItemsTotal, mQueue.Size());
+    }
+    ADD_COUNTER(mInItemsTotal, 1);
+    if (isEarlier) {
+        {
+            // set under the lock the waiter checks its predicate with, otherwise the wakeup may be lost
+            lock_guard<mutex> lock(mThreadRunningMux);
+            mHasEarlierEvent = true;
+        }
         mCV.notify_one();
-    } else {
-        mQueue.push(std::move(e));
     }
+    return id;
+}
+
+bool Timer::CancelEvent(uint64_t id) {
+    unique_ptr<TimerEvent> e;
+    {
+        lock_guard<mutex> lock(mQueueMux);
+        e = mQueue.Remove(id);
+        SET_GAUGE(mWaitingItemsTotal, mQueue.Size());
+    }
+    if (!e) {
+        return false;
+    }
+    ADD_COUNTER(mCancelledItemsTotal, 1);
+    return true;
 }
 
 void Timer::Run() {
     LOG_INFO(sLogger, ("timer", "started"));
+    vector<unique_ptr<TimerEvent>> events;
     unique_lock<mutex> threadLock(mThreadRunningMux);
     while (mIsThreadRunning) {
-        unique_lock<mutex> queueLock(mQueueMux);
-        if (mQueue.empty()) {
-            queueLock.unlock();
-            mCV.wait(threadLock, [this]() { return !mIsThreadRunning || !mQueue.empty(); });
-        } else {
-            auto now = chrono::steady_clock::now();
-            while (!mQueue.empty()) {
-                auto& e = mQueue.top();
-                if (now < e->GetExecTime()) {
-                    auto timeout = e->GetExecTime() - now + chrono::milliseconds(1);
-                    queueLock.unlock();
-                    mCV.wait_for(threadLock, timeout);
-                    break;
+        SET_GAUGE(mLastRunTime, time(nullptr));
+        chrono::steady_clock::time_point nextRunTime;
+        {
+            lock_guard<mutex> queueLock(mQueueMux);
+            // all expired events are taken out at once, so that the lock is not acquired for each event
+            mQueue.Advance(chrono::steady_clock::now(), events);
+            nextRunTime = mNextRunTime = mQueue.GetNextTickTime();
+            mHasEarlierEvent = false;
+            SET_GAUGE(mWaitingItemsTotal, mQueue.Size());
+        }
+        if (!events.empty()) {
+            // events may push new events, which requires mThreadRunningMux
+            threadLock.unlock();
+            for (auto& e : events) {
+                RecordLag(chrono::steady_clock::now() - e->GetExecTime());
+                if (!e->IsValid()) {
+                    LOG_INFO(sLogger, ("invalid timer event", "task is cancelled"));
                 } else {
-                    auto e = std::move(const_cast<unique_ptr<TimerEvent>&>(mQueue.top()));
-                    mQueue.pop();
-                    queueLock.unlock();
-                    if (!e->IsValid()) {
-                        LOG_INFO(sLogger, ("invalid timer event", "task is cancelled"));
-                    } else {
-                        e->Execute();
-                    }
-                    queueLock.lock();
+                    e->Execute();
                 }
             }
+            ADD_COUNTER(mOutItemsTotal, events.size());
+            events.clear();
+            threadLock.lock();
+            continue;
+        }
+        auto pred = [this]() { return !mIsThreadRunning || mHasEarlierEvent; };
+        if (nextRunTime == chrono::steady_clock::time_point::max()) {
+            mCV.wait(threadLock, pred);
+        } else {
+            mCV.wait_until(threadLock, nextRunTime, pred);
         }
     }
 }
 
+void Timer::RecordLag(chrono::steady_clock::duration lag) {
+    static const chrono::steady_clock::duration sBounds[] = {
+        chrono::milliseconds(1), chrono::milliseconds(10), chrono::milliseconds(100), chrono::seconds(1)};
+    if (lag < chrono::steady_clock::duration::zero()) {
+        lag = chrono::steady_clock::duration::zero();
+    }
+    ADD_COUNTER(mTotalLagMs, lag);
+    size_t idx = 0;
+    while (idx < sizeof(sBounds) / sizeof(sBounds[0]) && lag > sBounds[idx]) {
+        ++idx;
+    }
+    ADD_COUNTER(mLagBuckets[idx], 1);
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 void Timer::Clear() {
     lock_guard<mutex> lock(mQueueMux);
-    while (!mQueue.empty()) {
-        mQueue.pop();
-    }
+    mQueue.Clear();
 }
 #endif
 
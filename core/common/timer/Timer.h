@@ -16,22 +16,19 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
 
 #include "common/timer/TimerEvent.h"
+#include "common/timer/TimingWheel.h"
+#include "monitor/MetricManager.h"
 
 namespace logtail {
 
-struct TimerEventCompare {
-    bool operator()(const std::unique_ptr<TimerEvent>& lhs, const std::unique_ptr<TimerEvent>& rhs) const {
-        return lhs->GetExecTime() > rhs->GetExecTime();
-    }
-};
-
 class Timer {
 public:
     ~Timer();
@@ -45,7 +42,10 @@ public:
     }
     void Init();
     void Stop();
-    void PushEvent(std::unique_ptr<TimerEvent>&& e);
+    // return the id of the event, which can be passed to CancelEvent
+    uint64_t PushEvent(std::unique_ptr<TimerEvent>&& e);
+    // return false if the event has been executed or cancelled
+    bool CancelEvent(uint64_t id);
 #ifdef APSARA_UNIT_TEST_MAIN
     void Clear();
 #endif
@@ -53,16 +53,30 @@ public:
 private:
     Timer() = default;
     void Run();
+    void RecordLag(std::chrono::steady_clock::duration lag);
 
     mutable std::mutex mQueueMux;
-    std::priority_queue<std::unique_ptr<TimerEvent>, std::vector<std::unique_ptr<TimerEvent>>, TimerEventCompare>
-        mQueue;
+    TimingWheel mQueue;
+    // the time when the thread is going to wake up next time, protected by mQueueMux
+    std::chrono::steady_clock::time_point mNextRunTime = std::chrono::steady_clock::time_point::max();
 
     std::future<void> mThreadRes;
     mutable std::mutex mThreadRunningMux;
     bool mIsThreadRunning = false;
+    // protected by mThreadRunningMux
+    bool mHasEarlierEvent = false;
     mutable std::condition_variable mCV;
 
+    mutable MetricsRecordRef mMetricsRecordRef;
+    CounterPtr mInItemsTotal;
+    CounterPtr mOutItemsTotal;
+    CounterPtr mCancelledItemsTotal;
+    IntGaugePtr mWaitingItemsTotal;
+    IntGaugePtr mLastRunTime;
+    TimeCounterPtr mTotalLagMs;
+    // scheduling lag histogram, each counter holding events with lag in (previous bound, bound]
+    std::array<CounterPtr, 5> mLagBuckets;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class TimerUnittest;
     friend class ScrapeSchedulerUnittest;
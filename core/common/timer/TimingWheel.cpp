@@ -0,0 +1,192 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/timer/TimingWheel.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace logtail {
+
+static constexpr uint64_t kMaxDelta = uint64_t(1) << (TimingWheel::kSlotBits * TimingWheel::kLevelCnt);
+
+uint64_t TimingWheel::Add(unique_ptr<TimerEvent>&& e) {
+    // round up so that no event is executed before its exec time
+    auto elapsed = chrono::ceil<chrono::milliseconds>(e->GetExecTime() - mStartTime).count();
+    uint64_t id = mNextId++;
+    auto& node = mNodes[id];
+    node.mEvent = std::move(e);
+    node.mId = id;
+    // the slot of the current tick has been handled already
+    node.mExpireTick = max(elapsed > 0 ? static_cast<uint64_t>(elapsed) : 0, mCurrentTick + 1);
+    Place(&node);
+    return id;
+}
+
+unique_ptr<TimerEvent> TimingWheel::Remove(uint64_t id) {
+    auto it = mNodes.find(id);
+    if (it == mNodes.end()) {
+        return nullptr;
+    }
+    Unlink(&it->second);
+    auto e = std::move(it->second.mEvent);
+    mNodes.erase(it);
+    return e;
+}
+
+void TimingWheel::Advance(chrono::steady_clock::time_point now, vector<unique_ptr<TimerEvent>>& res) {
+    auto elapsed = chrono::floor<chrono::milliseconds>(now - mStartTime).count();
+    if (elapsed <= 0) {
+        return;
+    }
+    uint64_t nowTick = static_cast<uint64_t>(elapsed);
+    while (true) {
+        // ticks before the next one have nothing to do, so they can be skipped at once
+        uint64_t tick = GetNextTick();
+        if (tick > nowTick) {
+            mCurrentTick = max(mCurrentTick, nowTick);
+            return;
+        }
+        mCurrentTick = tick;
+        for (size_t level = kLevelCnt - 1; level > 0; --level) {
+            if ((mCurrentTick & ((uint64_t(1) << (level * kSlotBits)) - 1)) == 0) {
+                Cascade(level);
+            }
+        }
+        size_t slot = mCurrentTick & (kSlotCnt - 1);
+        Node* node = mSlots[0][slot];
+        mSlots[0][slot] = nullptr;
+        mSlotBitmaps[0] &= ~(uint64_t(1) << slot);
+        while (node != nullptr) {
+            Node* next = node->mNext;
+            res.emplace_back(std::move(node->mEvent));
+            mNodes.erase(node->mId);
+            node = next;
+        }
+    }
+}
+
+chrono::steady_clock::time_point TimingWheel::GetNextTickTime() const {
+    uint64_t tick = GetNextTick();
+    if (tick == kInvalidTick) {
+        return chrono::steady_clock::time_point::max();
+    }
+    return mStartTime + chrono::milliseconds(tick);
+}
+
+void TimingWheel::Clear() {
+    mNodes.clear();
+    for (auto& slots : mSlots) {
+        slots.fill(nullptr);
+    }
+    mSlotBitmaps.fill(0);
+}
+
+uint64_t TimingWheel::GetNextTick() const {
+    uint64_t res = kInvalidTick;
+    for (size_t level = 0; level < kLevelCnt; ++level) {
+        uint64_t bitmap = mSlotBitmaps[level];
+        if (bitmap == 0) {
+            continue;
+        }
+        // find the first non-empty slot after the current one, wrapping around to the current one at last
+        uint64_t cur = mCurrentTick >> (level * kSlotBits);
+        size_t shift = (cur + 1) & (kSlotCnt - 1);
+        uint64_t rotated = shift == 0 ? bitmap : (bitmap >> shift) | (bitmap << (kSlotCnt - shift));
+        uint64_t dist = __builtin_ctzll(rotated) + 1;
+        // for higher levels, this is the tick when the slot is cascaded
+        res = min(res, (cur + dist) << (level * kSlotBits));
+    }
+    return res;
+}
+
+void TimingWheel::Place(Node* node) {
+    uint64_t expireTick = max(node->mExpireTick, mCurrentTick);
+    uint64_t delta = expireTick - mCurrentTick;
+    if (delta >= kMaxDelta) {
+        // out of range, park it at the farthest slot and place it again when cascaded
+        expireTick = mCurrentTick + kMaxDelta - 1;
+        delta = kMaxDelta - 1;
+    }
+    size_t level = 0;
+    while (delta >= (uint64_t(1) << ((level + 1) * kSlotBits))) {
+        ++level;
+    }
+    size_t slot = (expireTick >> (level * kSlotBits)) & (kSlotCnt - 1);
+
+    node->mLevel = static_cast<uint32_t>(level);
+    node->mSlot = static_cast<uint32_t>(slot);
+    node->mPrev = nullptr;
+    node->mNext = mSlots[level][slot];
+    if (node->mNext != nullptr) {
+        node->mNext->mPrev = node;
+    }
+    mSlots[level][slot] = node;
+    mSlotBitmaps[level] |= uint64_t(1) << slot;
+}
+
+void TimingWheel::Unlink(Node* node) {
+    if (node->mPrev != nullptr) {
+        node->mPrev->mNext = node->mNext;
+    } else {
+        mSlots[node->mLevel][node->mSlot] = node->mNext;
+        if (node->mNext == nullptr) {
+            mSlotBitmaps[node->mLevel] &= ~(uint64_t(1) << node->mSlot);
+        }
+    }
+    if (node->mNext != nullptr) {
+        node->mNext->mPrev = node->mPrev;
+    }
+    node->mPrev = nullptr;
+    node->mNext = nullptr;
+}
+
+void TimingWheel::Cascade(size_t level) {
+    size_t slot = (mCurrentTick >> (level * kSlotBits)) & (kSlotCnt - 1);
+    Node* node = mSlots[level][slot];
+    mSlots[level][slot] = nullptr;
+    mSlotBitmaps[level] &= ~(uint64_t(1) << slot);
+    while (node != nullptr) {
+        Node* next = node->mNext;
+        Place(node);
+        node = next;
+    }
+}
+
+#ifdef APSARA_UNIT_TEST_MAIN
+const unique_ptr<TimerEvent>& TimingWheel::Top() const {
+    const Node* res = nullptr;
+    for (const auto& item : mNodes) {
+        if (res == nullptr || item.second.mEvent->GetExecTime() < res->mEvent->GetExecTime()) {
+            res = &item.second;
+        }
+    }
+    return res->mEvent;
+}
+
+void TimingWheel::Pop() {
+    uint64_t id = 0;
+    const TimerEvent* top = Top().get();
+    for (const auto& item : mNodes) {
+        if (item.second.mEvent.get() == top) {
+            id = item.first;
+            break;
+        }
+    }
+    Remove(id);
+}
+#endif
+
+} // namespace logtail
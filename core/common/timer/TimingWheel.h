@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/timer/TimerEvent.h"
+
+namespace logtail {
+
+// Hierarchical timing wheel with millisecond ticks. Level i has 64 slots, each covering 64^i ticks, so that events due
+// within 64^5 ms (about 12 days) are placed directly and later ones are parked at the top level until they come into
+// range. Events in a higher level slot are cascaded to lower levels when the wheel reaches the slot.
+//
+// Adding and removing an event is O(1), and advancing the wheel costs O(expired events + non-empty slots passed),
+// since empty slots are skipped with the per-level occupancy bitmap.
+//
+// Not thread-safe.
+class TimingWheel {
+public:
+    static constexpr size_t kSlotBits = 6;
+    static constexpr size_t kSlotCnt = 1 << kSlotBits;
+    static constexpr size_t kLevelCnt = 5;
+    static constexpr uint64_t kInvalidTick = UINT64_MAX;
+
+    explicit TimingWheel(std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now())
+        : mStartTime(startTime) {}
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    // return the id of the event, which can be used to remove the event before it expires
+    uint64_t Add(std::unique_ptr<TimerEvent>&& e);
+    // return nullptr if the event does not exist, i.e., it has expired or been removed
+    std::unique_ptr<TimerEvent> Remove(uint64_t id);
+    // move all events expired at now into res in order of their ticks
+    void Advance(std::chrono::steady_clock::time_point now, std::vector<std::unique_ptr<TimerEvent>>& res);
+    // return time_point::max() if there is no event
+    std::chrono::steady_clock::time_point GetNextTickTime() const;
+    void Clear();
+
+    size_t Size() const { return mNodes.size(); }
+    bool Empty() const { return mNodes.empty(); }
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    // the earliest event, which is found by iterating all events
+    const std::unique_ptr<TimerEvent>& Top() const;
+    void Pop();
+#endif
+
+private:
+    struct Node {
+        std::unique_ptr<TimerEvent> mEvent;
+        uint64_t mId = 0;
+        uint64_t mExpireTick = 0;
+        uint32_t mLevel = 0;
+        uint32_t mSlot = 0;
+        Node* mPrev = nullptr;
+        Node* mNext = nullptr;
+    };
+
+    uint64_t GetNextTick() const;
+    void Place(Node* node);
+    void Unlink(Node* node);
+    void Cascade(size_t level);
+
+    std::chrono::steady_clock::time_point mStartTime;
+    uint64_t mCurrentTick = 0;
+    uint64_t mNextId = 1;
+    std::unordered_map<uint64_t, Node> mNodes;
+    std::array<std::array<Node*, kSlotCnt>, kLevelCnt> mSlots{};
+    std::array<uint64_t, kLevelCnt> mSlotBitmaps{};
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class TimingWheelUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -26,6 +26,8 @@
 #include "common/magic_enum.hpp"
 #include "ebpf/Config.h"
 #include "ebpf/include/export.h"
+#include "ebpf/type/NetworkObserverEvent.h"
+#include "ebpf/util/RecordRing.h"
 #include "logger/Logger.h"
 #include "monitor/metric_models/ReentrantMetricsRecord.h"
 // #include "plugin/file_security/FileSecurityManager.h"
@@ -165,11 +167,6 @@ void EBPFServer::Init() {
     LOG_DEBUG(sLogger, ("begin to init timer", ""));
     Timer::GetInstance()->Init();
     AsynCurlRunner::GetInstance()->Init();
-    LOG_DEBUG(sLogger, ("begin to start poller", ""));
-    mPoller = async(std::launch::async, &EBPFServer::PollPerfBuffers, this);
-    LOG_DEBUG(sLogger, ("begin to start handler", ""));
-    mHandler = async(std::launch::async, &EBPFServer::HandlerEvents, this);
-    // check env
 
     // mMonitorMgr = std::make_unique<eBPFSelfMonitorMgr>();
     DynamicMetricLabels dynamicLabels;
@@ -184,6 +181,16 @@ void EBPFServer::Init() {
     mLossProcessEventsTotal = mRef.CreateCounter(METRIC_RUNNER_EBPF_LOSS_PROCESS_EVENTS_TOTAL);
     mProcessCacheMissTotal = mRef.CreateCounter(METRIC_RUNNER_EBPF_PROCESS_CACHE_MISS_TOTAL);
     mProcessCacheSize = mRef.CreateIntGauge(METRIC_RUNNER_EBPF_PROCESS_CACHE_SIZE);
+    mEventRingOverflowTotal = mRef.CreateCounter(METRIC_RUNNER_EBPF_EVENT_RING_OVERFLOW_TOTAL);
+    mEventRingOccupancy = mRef.CreateIntGauge(METRIC_RUNNER_EBPF_EVENT_RING_OCCUPANCY);
+    mAppRecordRingOverflowTotal = mRef.CreateCounter(METRIC_RUNNER_EBPF_APP_RECORD_RING_OVERFLOW_TOTAL);
+    mAppRecordRingOccupancy = mRef.CreateIntGauge(METRIC_RUNNER_EBPF_APP_RECORD_RING_OCCUPANCY);
+
+    LOG_DEBUG(sLogger, ("begin to start poller", ""));
+    mPoller = async(std::launch::async, &EBPFServer::PollPerfBuffers, this);
+    LOG_DEBUG(sLogger, ("begin to start handler", ""));
+    mHandler = async(std::launch::async, &EBPFServer::HandlerEvents, this);
+    // check env
 
     mEBPFAdapter->Init();
 
@@ -487,10 +494,17 @@ void EBPFServer::UpdatePluginManager(PluginType type, std::shared_ptr<AbstractMa
 
 void EBPFServer::HandlerEvents() {
     std::vector<std::shared_ptr<CommonEvent>> items(1024);
+    auto& ring = GetCommonEventRing();
+    auto& appRecordRing = GetAppRecordRing();
     while (mRunning) {
         // consume queue
-        size_t count = mDataEventQueue.wait_dequeue_bulk_timed(items.data(), 4096, std::chrono::milliseconds(200));
+        size_t count
+            = mDataEventQueue.wait_dequeue_bulk_timed(items.data(), items.size(), std::chrono::milliseconds(200));
         LOG_DEBUG(sLogger, ("get data events, number", count));
+        ADD_COUNTER(mEventRingOverflowTotal, ring.TakeOverflowCount());
+        SET_GAUGE(mEventRingOccupancy, ring.Occupancy());
+        ADD_COUNTER(mAppRecordRingOverflowTotal, appRecordRing.TakeOverflowCount());
+        SET_GAUGE(mAppRecordRingOccupancy, appRecordRing.Occupancy());
         // handle ....
         if (count == 0) {
             continue;
@@ -132,6 +132,10 @@ private:
     CounterPtr mLossProcessEventsTotal;
     CounterPtr mProcessCacheMissTotal;
     IntGaugePtr mProcessCacheSize;
+    CounterPtr mEventRingOverflowTotal;
+    IntGaugePtr mEventRingOccupancy;
+    CounterPtr mAppRecordRingOverflowTotal;
+    IntGaugePtr mAppRecordRingOccupancy;
 
     // hold some managers ...
     std::shared_ptr<ProcessCacheManager> mProcessCacheManager;
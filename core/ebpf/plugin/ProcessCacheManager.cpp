@@ -33,6 +33,7 @@
 #include "common/StringTools.h"
 #include "common/StringView.h"
 #include "ebpf/type/ProcessEvent.h"
+#include "ebpf/util/RecordRing.h"
 #include "logger/Logger.h"
 #include "monitor/metric_models/ReentrantMetricsRecord.h"
 #include "type/table/BaseElements.h"
@@ -227,10 +228,10 @@ void ProcessCacheManager::RecordExecveEvent(msg_execve_event* eventPtr) {
                   ("push execve event. DecRef pid", eventPtr->cleanup_key.pid)("ktime", eventPtr->cleanup_key.ktime));
     }
     if (mFlushProcessEvent) {
-        auto processEvent = std::make_shared<ProcessEvent>(eventPtr->process.pid,
-                                                           eventPtr->process.ktime,
-                                                           KernelEventType::PROCESS_EXECVE_EVENT,
-                                                           eventPtr->common.ktime);
+        auto processEvent = GetCommonEventRing().MakeShared<ProcessEvent>(eventPtr->process.pid,
+                                                                          eventPtr->process.ktime,
+                                                                          KernelEventType::PROCESS_EXECVE_EVENT,
+                                                                          eventPtr->common.ktime);
         mCommonEventQueue.enqueue(std::move(processEvent));
     }
     mProcessCache.ClearExpiredCache(eventPtr->process.ktime);
@@ -253,12 +254,12 @@ void ProcessCacheManager::RecordExitEvent(msg_exit* eventPtr) {
         LOG_DEBUG(sLogger, ("push exit event. DecRef pid", eventPtr->current.pid)("ktime", eventPtr->current.ktime));
     }
     if (mFlushProcessEvent) {
-        auto event = std::make_shared<ProcessExitEvent>(eventPtr->current.pid,
-                                                        eventPtr->current.ktime,
-                                                        KernelEventType::PROCESS_EXIT_EVENT,
-                                                        eventPtr->common.ktime,
-                                                        eventPtr->info.code,
-                                                        eventPtr->info.tid);
+        auto event = GetCommonEventRing().MakeShared<ProcessExitEvent>(eventPtr->current.pid,
+                                                                       eventPtr->current.ktime,
+                                                                       KernelEventType::PROCESS_EXIT_EVENT,
+                                                                       eventPtr->common.ktime,
+                                                                       eventPtr->info.code,
+                                                                       eventPtr->info.tid);
         if (event) {
             mCommonEventQueue.enqueue(std::move(event));
         }
@@ -276,10 +277,10 @@ void ProcessCacheManager::RecordCloneEvent(msg_clone_event* eventPtr) {
     mProcessCache.AddCache({eventPtr->tgid, eventPtr->ktime}, std::move(cacheValue));
     LOG_DEBUG(sLogger, ("push clone event. AddCache pid", eventPtr->tgid)("ktime", eventPtr->ktime));
     if (mFlushProcessEvent) {
-        auto event = std::make_shared<ProcessEvent>(static_cast<uint32_t>(eventPtr->tgid),
-                                                    static_cast<uint64_t>(eventPtr->ktime),
-                                                    KernelEventType::PROCESS_CLONE_EVENT,
-                                                    static_cast<uint64_t>(eventPtr->common.ktime));
+        auto event = GetCommonEventRing().MakeShared<ProcessEvent>(static_cast<uint32_t>(eventPtr->tgid),
+                                                                   static_cast<uint64_t>(eventPtr->ktime),
+                                                                   KernelEventType::PROCESS_CLONE_EVENT,
+                                                                   static_cast<uint64_t>(eventPtr->common.ktime));
         if (event) {
             mCommonEventQueue.enqueue(std::move(event));
         }
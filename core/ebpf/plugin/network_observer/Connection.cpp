@@ -36,6 +36,12 @@ static constexpr StringView kHttpStr = "http";
 static constexpr StringView kRpc25Str = "25";
 static constexpr StringView kRpc0Str = "0";
 static constexpr StringView kHttpClientStr = "http_client";
+static constexpr StringView kMySQLStr = "mysql";
+static constexpr StringView kMySQLClientStr = "mysql_client";
+static constexpr StringView kRpc60Str = "60";
+static constexpr StringView kRedisStr = "redis";
+static constexpr StringView kRedisClientStr = "redis_client";
+static constexpr StringView kRpc62Str = "62";
 static constexpr StringView kUnknownStr = "unknown";
 static constexpr StringView kZeroAddrStr = "0.0.0.0";
 static constexpr StringView kLoopbackStr = "127.0.0.1";
@@ -136,6 +142,19 @@ void Connection::TryAttachL7Meta(support_role_e role, support_proto_e protocol)
             mTags.SetNoCopy<kCallType>(kHttpStr);
             MarkL7MetaAttached();
         }
+    } else if (mProtocol == support_proto_e::ProtoMySQL || mProtocol == support_proto_e::ProtoRedis) {
+        bool isMySQL = mProtocol == support_proto_e::ProtoMySQL;
+        if (mRole == support_role_e::IsClient) {
+            mTags.SetNoCopy<kRpcType>(isMySQL ? kRpc60Str : kRpc62Str);
+            mTags.SetNoCopy<kCallKind>(isMySQL ? kMySQLClientStr : kRedisClientStr);
+            mTags.SetNoCopy<kCallType>(isMySQL ? kMySQLClientStr : kRedisClientStr);
+            MarkL7MetaAttached();
+        } else if (mRole == support_role_e::IsServer) {
+            mTags.SetNoCopy<kRpcType>(isMySQL ? kRpc60Str : kRpc62Str);
+            mTags.SetNoCopy<kCallKind>(isMySQL ? kMySQLStr : kRedisStr);
+            mTags.SetNoCopy<kCallType>(isMySQL ? kMySQLStr : kRedisStr);
+            MarkL7MetaAttached();
+        }
     }
 }
 
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
 #include <regex>
 #include <string>
@@ -22,6 +23,7 @@
 
 #include "common/Lock.h"
 #include "ebpf/plugin/network_observer/Type.h"
+#include "ebpf/protocol/StreamBuffer.h"
 #include "ebpf/type/NetworkObserverEvent.h"
 #include "ebpf/type/table/AppTable.h"
 #include "ebpf/type/table/StaticDataRow.h"
@@ -155,6 +157,16 @@ public:
 
     void MarkConnDeleted() { mMetaFlags.fetch_or(kSFlagConnDeleted, std::memory_order_release); }
 
+    // only accessed by the thread handling data events
+    ProtocolStreamState& GetStreamState() {
+        if (!mStreamState) {
+            mStreamState = std::make_unique<ProtocolStreamState>();
+        }
+        return *mStreamState;
+    }
+    // waiting records hold the connection, so the state must be released when the connection is deleted
+    void ResetStreamState() { mStreamState.reset(); }
+
 private:
     void updateL4Meta(struct conn_stats_event_t* event);
     // peer pod meta
@@ -212,6 +224,9 @@ private:
 
     ConnStatsData mCurrStats;
 
+    // created on the first data event of protocols needing reassembly
+    std::unique_ptr<ProtocolStreamState> mStreamState;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ConnectionUnittest;
     friend class ConnectionManagerUnittest;
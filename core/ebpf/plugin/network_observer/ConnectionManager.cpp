@@ -51,6 +51,10 @@ std::shared_ptr<Connection> ConnectionManager::getConnection(const ConnId& connI
 }
 
 void ConnectionManager::deleteConnection(const ConnId& connId) {
+    auto it = mConnections.find(connId);
+    if (it != mConnections.end() && it->second) {
+        it->second->ResetStreamState();
+    }
     mConnections.erase(connId);
     mConnectionTotal.fetch_add(-1);
 }
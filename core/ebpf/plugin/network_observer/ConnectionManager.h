@@ -42,7 +42,14 @@ public:
 
     using ConnStatsHandler = std::function<void(std::shared_ptr<AbstractRecord>& record)>;
 
-    ~ConnectionManager() {}
+    ~ConnectionManager() {
+        // records waiting in the stream states hold their connections
+        for (auto& item : mConnections) {
+            if (item.second) {
+                item.second->ResetStreamState();
+            }
+        }
+    }
 
     void AcceptNetCtrlEvent(struct conn_ctrl_event_t* event);
     std::shared_ptr<Connection> AcceptNetDataEvent(struct conn_data_event_t* event);
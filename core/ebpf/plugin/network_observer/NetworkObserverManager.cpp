@@ -124,15 +124,17 @@ NetworkObserverManager::NetworkObserverManager(const std::shared_ptr<ProcessCach
           10240,
           [](std::unique_ptr<AppMetricData>& base, const std::shared_ptr<AbstractRecord>& o) {
               auto* other = static_cast<AbstractAppRecord*>(o.get());
-              int statusCode = other->GetStatusCode();
-              if (statusCode >= 500) {
-                  base->m5xxCount += 1;
-              } else if (statusCode >= 400) {
-                  base->m4xxCount += 1;
-              } else if (statusCode >= 300) {
-                  base->m3xxCount += 1;
-              } else {
-                  base->m2xxCount += 1;
+              if (other->HasStatusCode()) {
+                  int statusCode = other->GetStatusCode();
+                  if (statusCode >= 500) {
+                      base->m5xxCount += 1;
+                  } else if (statusCode >= 400) {
+                      base->m4xxCount += 1;
+                  } else if (statusCode >= 300) {
+                      base->m3xxCount += 1;
+                  } else {
+                      base->m2xxCount += 1;
+                  }
               }
               base->mCount++;
               base->mErrCount += other->IsError();
@@ -507,18 +509,18 @@ bool NetworkObserverManager::ConsumeLogAggregateTree(const std::chrono::steady_c
                     logEvent->SetContentNoCopy(kConnTrackerTable.ColLogKey(i), ctAttrVal[i]);
                 }
                 // set time stamp
-                auto* httpRecord = static_cast<HttpRecord*>(record);
-                auto timeSpec = ConvertKernelTimeToUnixTime(httpRecord->GetStartTimeStamp());
+                auto timeSpec = ConvertKernelTimeToUnixTime(record->GetStartTimeStamp());
                 logEvent->SetTimestamp(timeSpec.tv_sec, timeSpec.tv_nsec);
-                logEvent->SetContent(kLatencyNS.LogKey(), std::to_string(httpRecord->GetLatencyNs()));
-                logEvent->SetContent(kHTTPMethod.LogKey(), httpRecord->GetMethod());
+                logEvent->SetContent(kLatencyNS.LogKey(), std::to_string(record->GetLatencyNs()));
+                logEvent->SetContent(kHTTPMethod.LogKey(), record->GetMethod());
                 logEvent->SetContent(kHTTPPath.LogKey(),
-                                     httpRecord->GetRealPath().size() ? httpRecord->GetRealPath()
-                                                                      : httpRecord->GetPath());
-                logEvent->SetContent(kHTTPVersion.LogKey(), httpRecord->GetProtocolVersion());
-                logEvent->SetContent(kStatusCode.LogKey(), std::to_string(httpRecord->GetStatusCode()));
-                logEvent->SetContent(kHTTPReqBody.LogKey(), httpRecord->GetReqBody());
-                logEvent->SetContent(kHTTPRespBody.LogKey(), httpRecord->GetRespBody());
+                                     record->GetRealPath().size() ? record->GetRealPath() : record->GetPath());
+                logEvent->SetContent(kHTTPVersion.LogKey(), record->GetProtocolVersion());
+                if (record->HasStatusCode()) {
+                    logEvent->SetContent(kStatusCode.LogKey(), std::to_string(record->GetStatusCode()));
+                }
+                logEvent->SetContent(kHTTPReqBody.LogKey(), record->GetReqBody());
+                logEvent->SetContent(kHTTPRespBody.LogKey(), record->GetRespBody());
                 LOG_DEBUG(sLogger, ("add one log, log timestamp", timeSpec.tv_sec)("nano", timeSpec.tv_nsec));
                 needPush = true;
             }
@@ -25,6 +25,7 @@
 #include "ebpf/EBPFServer.h"
 #include "ebpf/type/AggregateEvent.h"
 #include "ebpf/type/table/BaseElements.h"
+#include "ebpf/util/RecordRing.h"
 #include "logger/Logger.h"
 #include "models/PipelineEventGroup.h"
 
@@ -81,17 +82,17 @@ void NetworkSecurityManager::RecordNetworkEvent(tcp_data_t* event) {
         default:
             return;
     }
-    auto evt = std::make_shared<NetworkEvent>(event->key.pid,
-                                              event->key.ktime,
-                                              type,
-                                              event->timestamp,
-                                              event->protocol,
-                                              event->family,
-                                              event->saddr,
-                                              event->daddr,
-                                              event->sport,
-                                              event->dport,
-                                              event->net_ns);
+    auto evt = GetCommonEventRing().MakeShared<NetworkEvent>(event->key.pid,
+                                                             event->key.ktime,
+                                                             type,
+                                                             event->timestamp,
+                                                             event->protocol,
+                                                             event->family,
+                                                             event->saddr,
+                                                             event->daddr,
+                                                             event->sport,
+                                                             event->dport,
+                                                             event->net_ns);
     mCommonEventQueue.enqueue(std::move(evt));
     LOG_DEBUG(sLogger,
               ("[record_network_event] pid", event->key.pid)("ktime", event->key.ktime)("saddr", event->saddr)(
@@ -30,7 +30,7 @@ extern "C" {
 namespace logtail::ebpf {
 
 std::set<support_proto_e> ProtocolParserManager::AvaliableProtocolTypes() const {
-    return {support_proto_e::ProtoHTTP};
+    return {support_proto_e::ProtoHTTP, support_proto_e::ProtoMySQL, support_proto_e::ProtoRedis};
 }
 
 support_proto_e ProtocolStringToEnum(std::string protocol) {
@@ -38,6 +38,12 @@ support_proto_e ProtocolStringToEnum(std::string protocol) {
     if (protocol == "HTTP") {
         return support_proto_e::ProtoHTTP;
     }
+    if (protocol == "MYSQL") {
+        return support_proto_e::ProtoMySQL;
+    }
+    if (protocol == "REDIS") {
+        return support_proto_e::ProtoRedis;
+    }
 
     return support_proto_e::ProtoUnknown;
 }
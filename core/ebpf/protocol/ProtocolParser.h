@@ -24,6 +24,8 @@
 #include "ebpf/type/NetworkObserverEvent.h"
 #include "ebpf/util/sampler/Sampler.h"
 #include "http/HttpParser.h"
+#include "mysql/MySQLParser.h"
+#include "redis/RedisParser.h"
 
 extern "C" {
 #include <coolbpf/net.h>
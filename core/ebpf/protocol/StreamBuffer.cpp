@@ -0,0 +1,59 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ebpf/protocol/StreamBuffer.h"
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_INT32(ebpf_protocol_stream_buffer_max_bytes,
+                  "max bytes of an incomplete message kept for each direction of a connection",
+                  65536);
+
+namespace logtail::ebpf {
+
+std::string_view StreamBuffer::Append(std::string_view data) {
+    if (mPending.empty()) {
+        return data;
+    }
+    mPending.append(data.data(), data.size());
+    return mPending;
+}
+
+bool StreamBuffer::Keep(std::string_view rest) {
+    if (rest.empty()) {
+        Reset();
+        return true;
+    }
+    if (rest.size() > static_cast<size_t>(INT32_FLAG(ebpf_protocol_stream_buffer_max_bytes))) {
+        Reset();
+        return false;
+    }
+    if (!mPending.empty() && rest.data() >= mPending.data() && rest.data() < mPending.data() + mPending.size()) {
+        mPending.erase(0, rest.data() - mPending.data());
+    } else {
+        mPending.assign(rest.data(), rest.size());
+    }
+    return true;
+}
+
+void StreamBuffer::Reset() {
+    // release the memory of large messages
+    if (mPending.capacity() > 4096) {
+        std::string().swap(mPending);
+    } else {
+        mPending.clear();
+    }
+}
+
+} // namespace logtail::ebpf
@@ -0,0 +1,54 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace logtail::ebpf {
+
+class AbstractAppRecord;
+
+// StreamBuffer keeps the bytes of an incomplete message at the end of a data event, which are parsed again together
+// with the data of the next event in the same direction. When nothing is pending, the data of the event is parsed in
+// place without being copied.
+class StreamBuffer {
+public:
+    // return the bytes to parse, i.e., the pending bytes followed by data
+    std::string_view Append(std::string_view data);
+    // keep rest, the unparsed tail of the view returned by Append, for the next event
+    // return false if rest exceeds the limit and is discarded
+    bool Keep(std::string_view rest);
+    void Reset();
+
+    [[nodiscard]] size_t Size() const { return mPending.size(); }
+    [[nodiscard]] bool Empty() const { return mPending.empty(); }
+
+private:
+    std::string mPending;
+};
+
+// ProtocolStreamState is the per-connection reassembly state of protocols whose responses are sent in the order of the
+// requests on a connection, e.g., Redis and MySQL.
+struct ProtocolStreamState {
+    StreamBuffer mReqBuffer;
+    StreamBuffer mRespBuffer;
+    // records whose requests have been parsed and which are waiting for their responses, in order of the requests
+    std::deque<std::shared_ptr<AbstractAppRecord>> mPendingRecords;
+};
+
+} // namespace logtail::ebpf
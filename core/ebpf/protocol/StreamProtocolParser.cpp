@@ -0,0 +1,148 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ebpf/protocol/StreamProtocolParser.h"
+
+#include "common/Flags.h"
+#include "ebpf/plugin/network_observer/Connection.h"
+#include "ebpf/util/TraceId.h"
+#include "logger/Logger.h"
+
+extern "C" {
+#include <coolbpf/net.h>
+}
+
+DEFINE_FLAG_INT32(ebpf_protocol_event_capture_max_bytes,
+                  "max bytes of each direction of a data event captured by the kernel, a direction reaching it is "
+                  "taken as truncated",
+                  8192);
+
+namespace logtail::ebpf {
+
+std::vector<std::shared_ptr<AbstractRecord>>
+AbstractStreamProtocolParser::Parse(struct conn_data_event_t* dataEvent,
+                                    const std::shared_ptr<Connection>& conn,
+                                    const std::shared_ptr<Sampler>& sampler) {
+    return ParseStream(std::string_view(dataEvent->msg, dataEvent->request_len),
+                       std::string_view(dataEvent->msg + dataEvent->request_len, dataEvent->response_len),
+                       dataEvent->start_ts,
+                       dataEvent->end_ts,
+                       conn,
+                       sampler,
+                       dataEvent->request_len >= INT32_FLAG(ebpf_protocol_event_capture_max_bytes),
+                       dataEvent->response_len >= INT32_FLAG(ebpf_protocol_event_capture_max_bytes));
+}
+
+std::vector<std::shared_ptr<AbstractRecord>> AbstractStreamProtocolParser::ParseStream(
+    std::string_view req,
+    std::string_view resp,
+    uint64_t startTs,
+    uint64_t endTs,
+    const std::shared_ptr<Connection>& conn,
+    const std::shared_ptr<Sampler>& sampler,
+    bool reqTruncated,
+    bool respTruncated) {
+    if (!conn) {
+        return {};
+    }
+    auto& state = conn->GetStreamState();
+    auto& pending = state.mPendingRecords;
+
+    auto buf = state.mReqBuffer.Append(req);
+    while (!buf.empty()) {
+        auto spanId = GenerateSpanID();
+        bool sample = sampler != nullptr && sampler->ShouldSample(spanId);
+        std::shared_ptr<AbstractDBRecord> record;
+        auto res = ParseRequest(buf, conn, sample, record);
+        if (res == ParseState::kNeedsMoreData) {
+            break;
+        }
+        if (res == ParseState::kIgnored) {
+            continue;
+        }
+        if (res != ParseState::kSuccess || !record) {
+            // resync from the next event, since the boundary of the next request is unknown
+            LOG_DEBUG(sLogger, ("[StreamProtocolParser]: parse request failed", int(res)));
+            buf = std::string_view();
+            break;
+        }
+        if (!ExpectResponse(*record)) {
+            continue;
+        }
+        record->SetStartTsNs(startTs);
+        if (sample) {
+            record->MarkSample();
+            record->SetSpanId(std::move(spanId));
+        }
+        if (pending.size() >= kMaxPendingRecords) {
+            pending.pop_front();
+        }
+        pending.emplace_back(std::move(record));
+    }
+    // the rest of a truncated request never arrives, and would be joined with the data of the next event otherwise
+    bool reqDropped = reqTruncated && !buf.empty();
+    if (reqDropped) {
+        LOG_DEBUG(sLogger, ("[StreamProtocolParser]: request truncated, discard size", buf.size()));
+        buf = std::string_view();
+    }
+    if (!state.mReqBuffer.Keep(buf)) {
+        LOG_DEBUG(sLogger, ("[StreamProtocolParser]: incomplete request exceeds limit, discard size", buf.size()));
+    }
+
+    std::vector<std::shared_ptr<AbstractRecord>> res;
+    buf = state.mRespBuffer.Append(resp);
+    while (!buf.empty() && !pending.empty()) {
+        auto* record = static_cast<AbstractDBRecord*>(pending.front().get());
+        auto parseRes = ParseResponse(buf, *record);
+        if (parseRes == ParseState::kNeedsMoreData) {
+            break;
+        }
+        if (parseRes != ParseState::kSuccess) {
+            // responses can no longer be matched with requests
+            LOG_DEBUG(sLogger, ("[StreamProtocolParser]: parse response failed", int(parseRes)));
+            pending.clear();
+            buf = std::string_view();
+            break;
+        }
+        record->SetEndTsNs(endTs);
+        if (record->IsError() || record->IsSlow()) {
+            record->MarkSample();
+        }
+        if (record->ShouldSample()) {
+            if (record->mSpanId == std::array<uint64_t, 2>{}) {
+                record->SetSpanId(GenerateSpanID());
+            }
+            record->SetTraceId(GenerateTraceID());
+        }
+        res.emplace_back(std::move(pending.front()));
+        pending.pop_front();
+    }
+    // responses without requests, e.g., the greeting of a MySQL server, are of no use
+    if (pending.empty()) {
+        buf = std::string_view();
+    }
+    // once part of the stream is lost, the waiting requests can no longer be matched with the following responses
+    if (reqDropped || respTruncated) {
+        LOG_DEBUG(sLogger, ("[StreamProtocolParser]: data truncated, discard waiting requests", pending.size()));
+        pending.clear();
+        buf = std::string_view();
+    }
+    if (!state.mRespBuffer.Keep(buf)) {
+        LOG_DEBUG(sLogger, ("[StreamProtocolParser]: incomplete response exceeds limit, discard size", buf.size()));
+        pending.clear();
+    }
+    return res;
+}
+
+} // namespace logtail::ebpf
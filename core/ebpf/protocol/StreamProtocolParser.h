@@ -0,0 +1,68 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "ebpf/protocol/AbstractParser.h"
+#include "ebpf/protocol/ParseState.h"
+#include "ebpf/type/NetworkObserverEvent.h"
+#include "ebpf/util/sampler/Sampler.h"
+
+namespace logtail::ebpf {
+
+// AbstractStreamProtocolParser is the base of parsers for protocols whose responses are sent in the order of the
+// requests on a connection, e.g., Redis and MySQL.
+//
+// The request and response bytes of a data event are appended to those left over by previous events of the
+// connection (see ProtocolStreamState). All complete requests are parsed into records waiting for responses, and each
+// complete response is matched with the earliest waiting record, which is then returned. Incomplete messages at the
+// end are kept for the next event. Parsers only work on views of the data, and copy what is kept in records.
+class AbstractStreamProtocolParser : public AbstractProtocolParser {
+public:
+    static constexpr size_t kMaxPendingRecords = 128;
+    static constexpr size_t kMaxStatementSize = 256;
+
+    std::vector<std::shared_ptr<AbstractRecord>> Parse(struct conn_data_event_t* dataEvent,
+                                                       const std::shared_ptr<Connection>& conn,
+                                                       const std::shared_ptr<Sampler>& sampler = nullptr) override;
+
+    // the same as Parse, with the data of an event given explicitly
+    // the incomplete message at the end of a truncated direction is dropped rather than kept for the next event
+    std::vector<std::shared_ptr<AbstractRecord>> ParseStream(std::string_view req,
+                                                             std::string_view resp,
+                                                             uint64_t startTs,
+                                                             uint64_t endTs,
+                                                             const std::shared_ptr<Connection>& conn,
+                                                             const std::shared_ptr<Sampler>& sampler,
+                                                             bool reqTruncated = false,
+                                                             bool respTruncated = false);
+
+protected:
+    // Parse one request at the beginning of buf, which is removed from buf on kSuccess and kIgnored. record is created
+    // on kSuccess, and the statement should be kept only if sample is true.
+    virtual ParseState ParseRequest(std::string_view& buf,
+                                    const std::shared_ptr<Connection>& conn,
+                                    bool sample,
+                                    std::shared_ptr<AbstractDBRecord>& record)
+        = 0;
+    // Parse one response at the beginning of buf into record, which is removed from buf on kSuccess.
+    virtual ParseState ParseResponse(std::string_view& buf, AbstractDBRecord& record) = 0;
+    virtual bool ExpectResponse(const AbstractDBRecord&) const { return true; }
+};
+
+} // namespace logtail::ebpf
@@ -30,7 +30,7 @@ inline constexpr char kUpgrade[] = "Upgrade";
 std::vector<std::shared_ptr<AbstractRecord>> HTTPProtocolParser::Parse(struct conn_data_event_t* dataEvent,
                                                                        const std::shared_ptr<Connection>& conn,
                                                                        const std::shared_ptr<Sampler>& sampler) {
-    auto record = std::make_shared<HttpRecord>(conn);
+    auto record = GetAppRecordRing().MakeShared<HttpRecord>(conn);
     record->SetEndTsNs(dataEvent->end_ts);
     record->SetStartTsNs(dataEvent->start_ts);
     auto spanId = GenerateSpanID();
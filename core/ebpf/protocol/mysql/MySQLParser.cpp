@@ -0,0 +1,213 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ebpf/protocol/mysql/MySQLParser.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+#include "common/Flags.h"
+
+DECLARE_FLAG_INT32(ebpf_protocol_stream_buffer_max_bytes);
+
+namespace logtail::ebpf {
+
+namespace mysql {
+
+static constexpr uint8_t kComQuit = 0x01;
+static constexpr uint8_t kComInitDB = 0x02;
+static constexpr uint8_t kComQuery = 0x03;
+static constexpr uint8_t kComStmtPrepare = 0x16;
+static constexpr uint8_t kComStmtSendLongData = 0x18;
+static constexpr uint8_t kComStmtClose = 0x19;
+static constexpr uint8_t kErrPacketHeader = 0xff;
+// length of the error code, the sql state marker and the sql state in an ERR packet
+static constexpr size_t kErrCodeSize = 2;
+static constexpr size_t kSQLStateSize = 6;
+
+// commands of the command phase, other codes are regarded as invalid data
+static const std::array<std::string, 0x20> kCommandNames = [] {
+    std::array<std::string, 0x20> names;
+    names[0x01] = "COM_QUIT";
+    names[0x02] = "COM_INIT_DB";
+    names[0x03] = "COM_QUERY";
+    names[0x04] = "COM_FIELD_LIST";
+    names[0x09] = "COM_STATISTICS";
+    names[0x0e] = "COM_PING";
+    names[0x11] = "COM_CHANGE_USER";
+    names[0x16] = "COM_STMT_PREPARE";
+    names[0x17] = "COM_STMT_EXECUTE";
+    names[0x18] = "COM_STMT_SEND_LONG_DATA";
+    names[0x19] = "COM_STMT_CLOSE";
+    names[0x1a] = "COM_STMT_RESET";
+    names[0x1b] = "COM_SET_OPTION";
+    names[0x1c] = "COM_STMT_FETCH";
+    names[0x1f] = "COM_RESET_CONNECTION";
+    return names;
+}();
+
+static uint32_t GetPayloadLength(std::string_view buf) {
+    return static_cast<uint8_t>(buf[0]) | (static_cast<uint8_t>(buf[1]) << 8) | (static_cast<uint8_t>(buf[2]) << 16);
+}
+
+// the payload of the packet at the beginning of buf, which is truncated if the packet is larger than the stream
+// buffer and cannot be reassembled
+static ParseState GetPayload(std::string_view buf, uint32_t len, std::string_view& payload) {
+    if (buf.size() < kPacketHeaderSize + len
+        && kPacketHeaderSize + len <= static_cast<size_t>(INT32_FLAG(ebpf_protocol_stream_buffer_max_bytes))) {
+        return ParseState::kNeedsMoreData;
+    }
+    payload = buf.substr(kPacketHeaderSize, len);
+    return ParseState::kSuccess;
+}
+
+ParseState ParseCommand(std::string_view& buf, MySQLCommand& result) {
+    result = MySQLCommand();
+    if (buf.size() <= kPacketHeaderSize) {
+        return ParseState::kNeedsMoreData;
+    }
+    uint32_t len = GetPayloadLength(buf);
+    if (len == 0) {
+        return ParseState::kInvalid;
+    }
+    std::string_view payload;
+    auto res = GetPayload(buf, len, payload);
+    if (res != ParseState::kSuccess) {
+        return res;
+    }
+    // each command starts a new sequence, other packets belong to the connection phase or LOAD DATA LOCAL
+    if (buf[3] != 0) {
+        buf.remove_prefix(std::min(buf.size(), kPacketHeaderSize + len));
+        return ParseState::kIgnored;
+    }
+    auto code = static_cast<uint8_t>(payload[0]);
+    if (code >= kCommandNames.size() || kCommandNames[code].empty()) {
+        return ParseState::kInvalid;
+    }
+    result.mCode = code;
+    if (code == kComQuery || code == kComStmtPrepare || code == kComInitDB) {
+        result.mSQL = payload.substr(1);
+    }
+    buf.remove_prefix(std::min(buf.size(), kPacketHeaderSize + len));
+    return ParseState::kSuccess;
+}
+
+ParseState ParseResponse(std::string_view& buf, MySQLResponse& result) {
+    result = MySQLResponse();
+    if (buf.size() <= kPacketHeaderSize) {
+        return ParseState::kNeedsMoreData;
+    }
+    uint32_t len = GetPayloadLength(buf);
+    if (len == 0) {
+        return ParseState::kInvalid;
+    }
+    if (static_cast<uint8_t>(buf[kPacketHeaderSize]) == kErrPacketHeader) {
+        std::string_view payload;
+        auto res = GetPayload(buf, len, payload);
+        if (res != ParseState::kSuccess) {
+            return res;
+        }
+        if (payload.size() < 1 + kErrCodeSize) {
+            return ParseState::kInvalid;
+        }
+        result.mIsError = true;
+        result.mErrCode = static_cast<uint8_t>(payload[1]) | (static_cast<uint8_t>(payload[2]) << 8);
+        auto msg = payload.substr(1 + kErrCodeSize);
+        // the sql state is present since protocol 4.1
+        if (msg.size() >= kSQLStateSize && msg[0] == '#') {
+            msg.remove_prefix(kSQLStateSize);
+        }
+        result.mErrMsg = msg;
+    }
+    buf = std::string_view();
+    return ParseState::kSuccess;
+}
+
+std::string GetCommandName(const MySQLCommand& cmd) {
+    if (cmd.mCode != kComQuery && cmd.mCode != kComStmtPrepare) {
+        return cmd.mCode < kCommandNames.size() ? kCommandNames[cmd.mCode] : std::string();
+    }
+    auto sql = cmd.mSQL;
+    while (!sql.empty()) {
+        if (std::isspace(static_cast<unsigned char>(sql[0])) || sql[0] == '(') {
+            sql.remove_prefix(1);
+        } else if (sql.substr(0, 2) == "/*") {
+            auto end = sql.find("*/", 2);
+            sql.remove_prefix(end == std::string_view::npos ? sql.size() : end + 2);
+        } else if (sql[0] == '#' || sql.substr(0, 3) == "-- ") {
+            auto end = sql.find('\n');
+            sql.remove_prefix(end == std::string_view::npos ? sql.size() : end + 1);
+        } else {
+            break;
+        }
+    }
+    std::string name;
+    for (char c : sql) {
+        if (!std::isalpha(static_cast<unsigned char>(c))) {
+            break;
+        }
+        name.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+    }
+    return name.empty() ? kCommandNames[cmd.mCode] : name;
+}
+
+bool ExpectResponse(uint8_t code) {
+    // COM_QUIT closes the connection, and the others never have a response
+    return code != kComQuit && code != kComStmtSendLongData && code != kComStmtClose;
+}
+
+} // namespace mysql
+
+ParseState MySQLProtocolParser::ParseRequest(std::string_view& buf,
+                                             const std::shared_ptr<Connection>& conn,
+                                             bool sample,
+                                             std::shared_ptr<AbstractDBRecord>& record) {
+    mysql::MySQLCommand cmd;
+    auto origin = buf;
+    auto res = mysql::ParseCommand(buf, cmd);
+    if (res != ParseState::kSuccess) {
+        return res;
+    }
+    auto mysqlRecord = GetAppRecordRing().MakeShared<MySQLRecord>(conn);
+    mysqlRecord->SetCommand(mysql::GetCommandName(cmd));
+    mysqlRecord->SetReqSize(origin.size() - buf.size());
+    mysqlRecord->mExpectResponse = mysql::ExpectResponse(cmd.mCode);
+    if (sample) {
+        mysqlRecord->SetStatement(std::string(cmd.mSQL.substr(0, kMaxStatementSize)));
+    }
+    record = std::move(mysqlRecord);
+    return ParseState::kSuccess;
+}
+
+ParseState MySQLProtocolParser::ParseResponse(std::string_view& buf, AbstractDBRecord& record) {
+    mysql::MySQLResponse resp;
+    auto origin = buf;
+    auto res = mysql::ParseResponse(buf, resp);
+    if (res != ParseState::kSuccess) {
+        return res;
+    }
+    record.SetRespSize(origin.size() - buf.size());
+    if (resp.mIsError) {
+        static_cast<MySQLRecord&>(record).mErrCode = resp.mErrCode;
+        record.SetError(std::string(resp.mErrMsg.substr(0, kMaxStatementSize)));
+    }
+    return ParseState::kSuccess;
+}
+
+bool MySQLProtocolParser::ExpectResponse(const AbstractDBRecord& record) const {
+    return static_cast<const MySQLRecord&>(record).mExpectResponse;
+}
+
+} // namespace logtail::ebpf
@@ -0,0 +1,74 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "ebpf/protocol/ParseState.h"
+#include "ebpf/protocol/ParserRegistry.h"
+#include "ebpf/protocol/StreamProtocolParser.h"
+
+namespace logtail::ebpf {
+
+namespace mysql {
+
+constexpr size_t kPacketHeaderSize = 4;
+
+// views into the parsed buffer
+struct MySQLCommand {
+    uint8_t mCode = 0;
+    // the sql of COM_QUERY and COM_STMT_PREPARE, maybe truncated if the packet is larger than the buffer
+    std::string_view mSQL;
+};
+
+struct MySQLResponse {
+    bool mIsError = false;
+    uint16_t mErrCode = 0;
+    std::string_view mErrMsg;
+};
+
+// parse a command packet sent by a client, packets of the connection phase are ignored
+ParseState ParseCommand(std::string_view& buf, MySQLCommand& result);
+
+// parse the response of a command, which takes the whole buffer since the classic protocol has no pipelining, and
+// result sets are only consumed rather than parsed
+ParseState ParseResponse(std::string_view& buf, MySQLResponse& result);
+
+// COM_QUERY and COM_STMT_PREPARE are named by the first keyword of the sql, e.g., SELECT, others by the command
+std::string GetCommandName(const MySQLCommand& cmd);
+
+bool ExpectResponse(uint8_t code);
+
+} // namespace mysql
+
+class MySQLProtocolParser : public AbstractStreamProtocolParser {
+public:
+    std::shared_ptr<AbstractProtocolParser> Create() override { return std::make_shared<MySQLProtocolParser>(); }
+
+protected:
+    ParseState ParseRequest(std::string_view& buf,
+                            const std::shared_ptr<Connection>& conn,
+                            bool sample,
+                            std::shared_ptr<AbstractDBRecord>& record) override;
+    ParseState ParseResponse(std::string_view& buf, AbstractDBRecord& record) override;
+    bool ExpectResponse(const AbstractDBRecord& record) const override;
+};
+
+REGISTER_PROTOCOL_PARSER(support_proto_e::ProtoMySQL, MySQLProtocolParser)
+
+} // namespace logtail::ebpf
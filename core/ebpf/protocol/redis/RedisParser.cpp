@@ -0,0 +1,307 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ebpf/protocol/redis/RedisParser.h"
+
+#include <cctype>
+#include <charconv>
+
+namespace logtail::ebpf {
+
+namespace redis {
+
+// limits of the protocol, anything beyond is regarded as invalid data
+static constexpr int64_t kMaxBulkLen = 512 * 1024 * 1024;
+static constexpr int64_t kMaxAggregateLen = 1 << 20;
+// max length of the header line of an element, i.e., a type byte and a length
+static constexpr size_t kMaxHeaderLen = 32;
+static constexpr size_t kMaxCommandNameLen = 32;
+
+static constexpr std::string_view kCRLF = "\r\n";
+
+static bool ParseInt(std::string_view s, int64_t& res) {
+    if (s.empty()) {
+        return false;
+    }
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), res);
+    return ec == std::errc() && ptr == s.data() + s.size();
+}
+
+// parse the line of a length-prefixed element at the beginning of buf, e.g., $5\r\n, and remove it from buf
+static ParseState ParseLength(std::string_view& buf, int64_t& len) {
+    auto pos = buf.find(kCRLF);
+    if (pos == std::string_view::npos) {
+        return buf.size() > kMaxHeaderLen ? ParseState::kInvalid : ParseState::kNeedsMoreData;
+    }
+    if (!ParseInt(buf.substr(1, pos - 1), len)) {
+        return ParseState::kInvalid;
+    }
+    buf.remove_prefix(pos + kCRLF.size());
+    return ParseState::kSuccess;
+}
+
+// parse the content of a bulk string of len bytes at the beginning of buf, and remove it from buf
+static ParseState ParseBulkContent(std::string_view& buf, int64_t len, std::string_view& content) {
+    if (len < 0 || len > kMaxBulkLen) {
+        return ParseState::kInvalid;
+    }
+    auto size = static_cast<size_t>(len);
+    if (buf.size() < size + kCRLF.size()) {
+        return ParseState::kNeedsMoreData;
+    }
+    if (buf.substr(size, kCRLF.size()) != kCRLF) {
+        return ParseState::kInvalid;
+    }
+    content = buf.substr(0, size);
+    buf.remove_prefix(size + kCRLF.size());
+    return ParseState::kSuccess;
+}
+
+static bool IsValidCommandName(std::string_view name) {
+    if (name.empty() || name.size() > kMaxCommandNameLen) {
+        return false;
+    }
+    for (char c : name) {
+        if (!std::isalpha(static_cast<unsigned char>(c)) && c != '_' && c != '-' && c != '|') {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void AddArg(RedisCommand& result, std::string_view arg) {
+    if (result.mName.empty()) {
+        result.mName = arg;
+        return;
+    }
+    if (result.mArgNum < kMaxKeptArgs) {
+        result.mArgs[result.mArgNum++] = arg;
+    }
+    ++result.mTotalArgNum;
+}
+
+static ParseState ParseInlineCommand(std::string_view& buf, RedisCommand& result) {
+    auto pos = buf.find('\n');
+    if (pos == std::string_view::npos) {
+        return ParseState::kNeedsMoreData;
+    }
+    auto line = buf.substr(0, pos);
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    while (!line.empty()) {
+        auto start = line.find_first_not_of(' ');
+        if (start == std::string_view::npos) {
+            break;
+        }
+        line.remove_prefix(start);
+        auto end = line.find(' ');
+        AddArg(result, line.substr(0, end));
+        line.remove_prefix(end == std::string_view::npos ? line.size() : end);
+    }
+    if (!IsValidCommandName(result.mName)) {
+        return ParseState::kInvalid;
+    }
+    buf.remove_prefix(pos + 1);
+    return ParseState::kSuccess;
+}
+
+ParseState ParseCommand(std::string_view& buf, RedisCommand& result) {
+    result = RedisCommand();
+    if (buf.empty()) {
+        return ParseState::kNeedsMoreData;
+    }
+    if (buf[0] != '*') {
+        return ParseInlineCommand(buf, result);
+    }
+
+    auto rest = buf;
+    int64_t num = 0;
+    auto res = ParseLength(rest, num);
+    if (res != ParseState::kSuccess) {
+        return res;
+    }
+    if (num <= 0 || num > kMaxAggregateLen) {
+        return ParseState::kInvalid;
+    }
+    for (int64_t i = 0; i < num; ++i) {
+        if (rest.empty()) {
+            return ParseState::kNeedsMoreData;
+        }
+        if (rest[0] != '$') {
+            return ParseState::kInvalid;
+        }
+        int64_t len = 0;
+        res = ParseLength(rest, len);
+        if (res != ParseState::kSuccess) {
+            return res;
+        }
+        std::string_view arg;
+        res = ParseBulkContent(rest, len, arg);
+        if (res != ParseState::kSuccess) {
+            return res;
+        }
+        if (i == 0 && !IsValidCommandName(arg)) {
+            return ParseState::kInvalid;
+        }
+        AddArg(result, arg);
+    }
+    buf = rest;
+    return ParseState::kSuccess;
+}
+
+ParseState ParseReply(std::string_view& buf, RedisReply& result) {
+    result = RedisReply();
+    auto rest = buf;
+    // number of elements left to parse, nested aggregates are flattened so that no recursion is needed
+    int64_t remaining = 1;
+    bool top = true;
+    while (remaining > 0) {
+        if (rest.empty()) {
+            return ParseState::kNeedsMoreData;
+        }
+        char type = rest[0];
+        switch (type) {
+            case '+':
+            case '-':
+            case ':':
+            case ',':
+            case '#':
+            case '_':
+            case '(': {
+                // simple types, whose value is the rest of the line
+                auto pos = rest.find(kCRLF);
+                if (pos == std::string_view::npos) {
+                    return ParseState::kNeedsMoreData;
+                }
+                if (type == '-' && top) {
+                    result.mIsError = true;
+                    result.mErrMsg = rest.substr(1, pos - 1);
+                }
+                rest.remove_prefix(pos + kCRLF.size());
+                break;
+            }
+            case '$':
+            case '!':
+            case '=': {
+                int64_t len = 0;
+                auto res = ParseLength(rest, len);
+                if (res != ParseState::kSuccess) {
+                    return res;
+                }
+                // null bulk string of RESP2
+                if (len == -1) {
+                    break;
+                }
+                std::string_view content;
+                res = ParseBulkContent(rest, len, content);
+                if (res != ParseState::kSuccess) {
+                    return res;
+                }
+                if (type == '!' && top) {
+                    result.mIsError = true;
+                    result.mErrMsg = content;
+                }
+                break;
+            }
+            case '*':
+            case '~':
+            case '>':
+            case '%':
+            case '|': {
+                int64_t len = 0;
+                auto res = ParseLength(rest, len);
+                if (res != ParseState::kSuccess) {
+                    return res;
+                }
+                // null array of RESP2
+                if (len == -1) {
+                    break;
+                }
+                if (len < 0 || len > kMaxAggregateLen) {
+                    return ParseState::kInvalid;
+                }
+                // maps and attributes consist of key value pairs
+                remaining += (type == '%' || type == '|') ? len * 2 : len;
+                // attributes are followed by the value they describe
+                if (type == '|') {
+                    ++remaining;
+                }
+                break;
+            }
+            default:
+                return ParseState::kInvalid;
+        }
+        --remaining;
+        top = false;
+        if (remaining > kMaxAggregateLen) {
+            return ParseState::kInvalid;
+        }
+    }
+    buf = rest;
+    return ParseState::kSuccess;
+}
+
+std::string FormatCommand(const RedisCommand& cmd, size_t maxSize) {
+    std::string res(cmd.mName.substr(0, maxSize));
+    for (auto& c : res) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    for (size_t i = 0; i < cmd.mArgNum && res.size() < maxSize; ++i) {
+        res.push_back(' ');
+        res.append(cmd.mArgs[i].substr(0, maxSize - res.size()));
+    }
+    if (res.size() > maxSize) {
+        res.resize(maxSize);
+    }
+    return res;
+}
+
+} // namespace redis
+
+ParseState RedisProtocolParser::ParseRequest(std::string_view& buf,
+                                             const std::shared_ptr<Connection>& conn,
+                                             bool sample,
+                                             std::shared_ptr<AbstractDBRecord>& record) {
+    redis::RedisCommand cmd;
+    auto origin = buf;
+    auto res = redis::ParseCommand(buf, cmd);
+    if (res != ParseState::kSuccess) {
+        return res;
+    }
+    auto redisRecord = GetAppRecordRing().MakeShared<RedisRecord>(conn);
+    redisRecord->SetCommand(redis::FormatCommand(redis::RedisCommand{cmd.mName}, redis::kMaxCommandNameLen));
+    redisRecord->SetReqSize(origin.size() - buf.size());
+    if (sample) {
+        redisRecord->SetStatement(redis::FormatCommand(cmd, kMaxStatementSize));
+    }
+    record = std::move(redisRecord);
+    return ParseState::kSuccess;
+}
+
+ParseState RedisProtocolParser::ParseResponse(std::string_view& buf, AbstractDBRecord& record) {
+    redis::RedisReply reply;
+    auto origin = buf;
+    auto res = redis::ParseReply(buf, reply);
+    if (res != ParseState::kSuccess) {
+        return res;
+    }
+    record.SetRespSize(origin.size() - buf.size());
+    if (reply.mIsError) {
+        record.SetError(std::string(reply.mErrMsg.substr(0, kMaxStatementSize)));
+    }
+    return ParseState::kSuccess;
+}
+
+} // namespace logtail::ebpf
@@ -0,0 +1,72 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "ebpf/protocol/ParseState.h"
+#include "ebpf/protocol/ParserRegistry.h"
+#include "ebpf/protocol/StreamProtocolParser.h"
+
+namespace logtail::ebpf {
+
+namespace redis {
+
+constexpr size_t kMaxKeptArgs = 8;
+
+// views into the parsed buffer
+struct RedisCommand {
+    std::string_view mName;
+    // the first kMaxKeptArgs arguments after the name
+    std::array<std::string_view, kMaxKeptArgs> mArgs;
+    size_t mArgNum = 0;
+    size_t mTotalArgNum = 0;
+};
+
+struct RedisReply {
+    bool mIsError = false;
+    // the message of an error reply
+    std::string_view mErrMsg;
+};
+
+// parse a command sent by a client, which is an array of bulk strings or an inline command
+ParseState ParseCommand(std::string_view& buf, RedisCommand& result);
+
+// parse a reply of RESP2 or RESP3, which may be nested
+ParseState ParseReply(std::string_view& buf, RedisReply& result);
+
+// command name in upper case, followed by arguments separated by space, truncated to maxSize
+std::string FormatCommand(const RedisCommand& cmd, size_t maxSize);
+
+} // namespace redis
+
+class RedisProtocolParser : public AbstractStreamProtocolParser {
+public:
+    std::shared_ptr<AbstractProtocolParser> Create() override { return std::make_shared<RedisProtocolParser>(); }
+
+protected:
+    ParseState ParseRequest(std::string_view& buf,
+                            const std::shared_ptr<Connection>& conn,
+                            bool sample,
+                            std::shared_ptr<AbstractDBRecord>& record) override;
+    ParseState ParseResponse(std::string_view& buf, AbstractDBRecord& record) override;
+};
+
+REGISTER_PROTOCOL_PARSER(support_proto_e::ProtoRedis, RedisProtocolParser)
+
+} // namespace logtail::ebpf
@@ -0,0 +1,36 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ebpf/type/NetworkObserverEvent.h"
+
+#include <algorithm>
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_INT32(ebpf_app_record_ring_capacity,
+                  "max number of app records kept in the ring, more records are allocated on the heap",
+                  8192);
+
+namespace logtail::ebpf {
+
+RecordRing& GetAppRecordRing() {
+    // never destructed since records may outlive any owner during exit
+    static auto* sRing = new RecordRing(static_cast<uint32_t>(std::max(1, INT32_FLAG(ebpf_app_record_ring_capacity))),
+                                        std::max({RecordRing::SlotSizeOf<HttpRecord>(),
+                                                  RecordRing::SlotSizeOf<RedisRecord>(),
+                                                  RecordRing::SlotSizeOf<MySQLRecord>()}));
+    return *sRing;
+}
+
+} // namespace logtail::ebpf
@@ -25,6 +25,7 @@
 #include "ebpf/type/table/HttpTable.h"
 #include "ebpf/type/table/NetTable.h"
 #include "ebpf/type/table/StaticDataRow.h"
+#include "ebpf/util/RecordRing.h"
 #include "logger/Logger.h"
 
 namespace logtail::ebpf {
@@ -123,6 +124,9 @@ public:
     virtual const HeadersMap& GetRespHeaderMap() const = 0;
     virtual const std::string& GetProtocolVersion() const = 0;
     virtual const std::string& GetPath() const = 0;
+    virtual const std::string& GetRealPath() const { return GetPath(); }
+    // whether GetStatusCode returns an HTTP status code, which is counted by status class
+    virtual bool HasStatusCode() const { return true; }
 
     mutable std::array<uint64_t, 4> mTraceId{};
     mutable std::array<uint64_t, 2> mSpanId{};
@@ -167,7 +171,7 @@ public:
     const HeadersMap& GetRespHeaderMap() const override { return mRespHeaderMap; }
     const std::string& GetProtocolVersion() const override { return mProtocolVersion; }
     const std::string& GetPath() const override { return mPath; }
-    const std::string& GetRealPath() const { return mRealPath; }
+    const std::string& GetRealPath() const override { return mRealPath; }
     const std::string& GetSpanName() override { return mPath; }
 
     int mCode = 0;
@@ -185,6 +189,66 @@ public:
     HeadersMap mRespHeaderMap;
 };
 
+inline const HeadersMap kEmptyHeadersMap;
+
+// AbstractDBRecord is the record of a request-response database protocol. The span name is the command, e.g., GET for
+// Redis or SELECT for MySQL, and the request body is the statement, which is only kept for sampled records.
+class AbstractDBRecord : public AbstractAppRecord {
+public:
+    explicit AbstractDBRecord(std::shared_ptr<Connection> connection) : AbstractAppRecord(connection) {}
+    ~AbstractDBRecord() override {}
+
+    void SetCommand(std::string&& command) { mCommand = std::move(command); }
+    void SetStatement(std::string&& statement) { mStatement = std::move(statement); }
+    void SetError(std::string&& errMsg) {
+        mIsError = true;
+        mErrMsg = std::move(errMsg);
+    }
+    void SetReqSize(size_t size) { mReqSize = size; }
+    void SetRespSize(size_t size) { mRespSize = size; }
+
+    bool IsError() const override { return mIsError; }
+    bool IsSlow() const override { return GetLatencyMs() > 500; }
+    int GetStatusCode() const override { return 0; }
+    bool HasStatusCode() const override { return false; }
+    const std::string& GetReqBody() const override { return mStatement; }
+    const std::string& GetRespBody() const override { return mErrMsg; }
+    size_t GetReqBodySize() const override { return mReqSize; }
+    size_t GetRespBodySize() const override { return mRespSize; }
+    const std::string& GetMethod() const override { return mCommand; }
+    const HeadersMap& GetReqHeaderMap() const override { return kEmptyHeadersMap; }
+    const HeadersMap& GetRespHeaderMap() const override { return kEmptyHeadersMap; }
+    const std::string& GetProtocolVersion() const override { return kSpanNameEmpty; }
+    const std::string& GetPath() const override { return kSpanNameEmpty; }
+    const std::string& GetSpanName() override { return mCommand; }
+
+    bool mIsError = false;
+    size_t mReqSize = 0;
+    size_t mRespSize = 0;
+    std::string mCommand;
+    std::string mStatement;
+    std::string mErrMsg;
+};
+
+class RedisRecord : public AbstractDBRecord {
+public:
+    explicit RedisRecord(std::shared_ptr<Connection> connection) : AbstractDBRecord(connection) {}
+    ~RedisRecord() override {}
+};
+
+class MySQLRecord : public AbstractDBRecord {
+public:
+    explicit MySQLRecord(std::shared_ptr<Connection> connection) : AbstractDBRecord(connection) {}
+    ~MySQLRecord() override {}
+
+    // COM_QUIT, COM_STMT_CLOSE and COM_STMT_SEND_LONG_DATA have no response
+    bool mExpectResponse = true;
+    uint16_t mErrCode = 0;
+};
+
+// the ring of the records built by protocol parsers, whose slots fit any of the app records above
+RecordRing& GetAppRecordRing();
+
 class MetricData {
 public:
     virtual ~MetricData() {}
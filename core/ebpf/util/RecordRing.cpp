@@ -0,0 +1,32 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ebpf/util/RecordRing.h"
+
+#include <algorithm>
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_INT32(ebpf_event_ring_capacity,
+                  "max number of kernel events kept in the ring, more events are allocated on the heap",
+                  16384);
+
+namespace logtail::ebpf {
+
+RecordRing& GetCommonEventRing() {
+    static auto* sRing = new RecordRing(static_cast<uint32_t>(std::max(1, INT32_FLAG(ebpf_event_ring_capacity))));
+    return *sRing;
+}
+
+} // namespace logtail::ebpf
@@ -0,0 +1,218 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace logtail::ebpf {
+
+// RecordRing is a fixed-capacity pool of fixed-size slots for records handed from the perf buffer poller to the
+// handler thread. Slots are referred to by index, and free indexes are kept in a bounded MPMC ring of sequenced
+// cells, so acquiring and releasing a slot takes a single CAS in the common case and no heap allocation is involved.
+//
+// MakeShared places the record together with the shared_ptr control block in a slot, which is returned to the ring
+// when the last reference is released, i.e., once aggregation no longer keeps the record. When the ring is exhausted,
+// e.g., during a burst while records are kept by aggregation until the window is flushed, or when the record does not
+// fit into a slot, the record is allocated on the heap as before and counted as an overflow, so that records are never
+// dropped because of the ring.
+class RecordRing {
+public:
+    static constexpr size_t kDefaultSlotSize = 128;
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    // the slot size needed by a record of type T together with the control block of allocate_shared
+    template <typename T>
+    static constexpr size_t SlotSizeOf() {
+        return sizeof(T) + 8 * sizeof(void*);
+    }
+
+    // capacity is rounded up to a power of 2, and slotSize to a multiple of the max alignment
+    explicit RecordRing(uint32_t capacity, size_t slotSize = kDefaultSlotSize) {
+        mCapacity = 2;
+        while (mCapacity < capacity && mCapacity < (1U << 31)) {
+            mCapacity <<= 1;
+        }
+        mMask = mCapacity - 1;
+        mSlotUnits = std::max<size_t>(1, (slotSize + sizeof(Unit) - 1) / sizeof(Unit));
+        mSlots.reset(new Unit[mSlotUnits * mCapacity]);
+        mCells.reset(new Cell[mCapacity]);
+        for (uint32_t i = 0; i < mCapacity; ++i) {
+            mCells[i].mSeq.store(i + 1, std::memory_order_relaxed);
+            mCells[i].mIndex = i;
+        }
+        mEnqueuePos.store(mCapacity, std::memory_order_relaxed);
+        mDequeuePos.store(0, std::memory_order_relaxed);
+    }
+    RecordRing(const RecordRing&) = delete;
+    RecordRing& operator=(const RecordRing&) = delete;
+
+    // return kInvalidIndex if all slots are in use
+    uint32_t Acquire() {
+        uint64_t pos = mDequeuePos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = mCells[pos & mMask];
+            uint64_t seq = cell.mSeq.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+            if (diff == 0) {
+                if (mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    uint32_t idx = cell.mIndex;
+                    cell.mSeq.store(pos + mCapacity, std::memory_order_release);
+                    mInUse.fetch_add(1, std::memory_order_relaxed);
+                    return idx;
+                }
+            } else if (diff < 0) {
+                if (mEnqueuePos.load(std::memory_order_acquire) == pos) {
+                    return kInvalidIndex;
+                }
+                // a release has claimed the cell but not published the index yet
+                std::this_thread::yield();
+                pos = mDequeuePos.load(std::memory_order_relaxed);
+            } else {
+                pos = mDequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void Release(uint32_t idx) {
+        uint64_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = mCells[pos & mMask];
+            uint64_t seq = cell.mSeq.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.mIndex = idx;
+                    cell.mSeq.store(pos + 1, std::memory_order_release);
+                    mInUse.fetch_sub(1, std::memory_order_relaxed);
+                    return;
+                }
+            } else {
+                // there are at most mCapacity indexes, so the ring is never full on release, and the cell is only
+                // being taken by an acquire, which is about to finish
+                if (diff < 0) {
+                    std::this_thread::yield();
+                }
+                pos = mEnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void* Data(uint32_t idx) { return &mSlots[static_cast<size_t>(idx) * mSlotUnits]; }
+
+    // return kInvalidIndex if p does not point to the beginning of a slot of this ring
+    uint32_t IndexOf(const void* p) const {
+        auto addr = reinterpret_cast<uintptr_t>(p);
+        auto begin = reinterpret_cast<uintptr_t>(mSlots.get());
+        if (addr < begin || addr >= begin + SlotSize() * mCapacity || (addr - begin) % SlotSize() != 0) {
+            return kInvalidIndex;
+        }
+        return static_cast<uint32_t>((addr - begin) / SlotSize());
+    }
+
+    // the record is allocated on the heap and counted as an overflow if all slots are in use, or if it does not fit
+    // into a slot
+    template <typename T, typename... Args>
+    std::shared_ptr<T> MakeShared(Args&&... args) {
+        uint32_t idx = Acquire();
+        if (idx == kInvalidIndex) {
+            mOverflowCnt.fetch_add(1, std::memory_order_relaxed);
+        }
+        return std::allocate_shared<T>(SlotAllocator<T>(this, idx), std::forward<Args>(args)...);
+    }
+
+    uint32_t Capacity() const { return mCapacity; }
+    size_t SlotSize() const { return mSlotUnits * sizeof(Unit); }
+    uint32_t Occupancy() const { return mInUse.load(std::memory_order_relaxed); }
+    // return the number of records allocated on the heap since last call
+    uint64_t TakeOverflowCount() { return mOverflowCnt.exchange(0, std::memory_order_relaxed); }
+
+private:
+    using Unit = std::max_align_t;
+
+    struct Cell {
+        std::atomic<uint64_t> mSeq{0};
+        uint32_t mIndex = 0;
+    };
+
+    // Allocator used by allocate_shared, which allocates exactly once for the control block and the record. The slot
+    // is acquired beforehand, and the record falls back to the heap if it does not fit into a slot.
+    template <typename T>
+    struct SlotAllocator {
+        using value_type = T;
+
+        SlotAllocator(RecordRing* ring, uint32_t idx) : mRing(ring), mIndex(idx) {}
+        template <typename U>
+        SlotAllocator(const SlotAllocator<U>& rhs) : mRing(rhs.mRing), mIndex(rhs.mIndex) {}
+
+        T* allocate(size_t n) {
+            if (mIndex != kInvalidIndex && sizeof(T) * n <= mRing->SlotSize() && alignof(T) <= alignof(Unit)) {
+                uint32_t idx = mIndex;
+                mIndex = kInvalidIndex;
+                return static_cast<T*>(mRing->Data(idx));
+            }
+            if (mIndex != kInvalidIndex) {
+                // the overflow has been counted by MakeShared if no slot is acquired
+                mRing->mOverflowCnt.fetch_add(1, std::memory_order_relaxed);
+                mRing->Release(mIndex);
+                mIndex = kInvalidIndex;
+            }
+            return static_cast<T*>(::operator new(sizeof(T) * n));
+        }
+
+        void deallocate(T* p, size_t) {
+            uint32_t idx = mRing->IndexOf(p);
+            if (idx != kInvalidIndex) {
+                mRing->Release(idx);
+            } else {
+                ::operator delete(p);
+            }
+        }
+
+        template <typename U>
+        bool operator==(const SlotAllocator<U>& rhs) const {
+            return mRing == rhs.mRing;
+        }
+        template <typename U>
+        bool operator!=(const SlotAllocator<U>& rhs) const {
+            return mRing != rhs.mRing;
+        }
+
+        RecordRing* mRing;
+        uint32_t mIndex;
+    };
+
+    uint32_t mCapacity = 0;
+    uint32_t mMask = 0;
+    size_t mSlotUnits = 0;
+    std::unique_ptr<Unit[]> mSlots;
+    std::unique_ptr<Cell[]> mCells;
+    alignas(64) std::atomic<uint64_t> mEnqueuePos{0};
+    alignas(64) std::atomic<uint64_t> mDequeuePos{0};
+    alignas(64) std::atomic<uint32_t> mInUse{0};
+    std::atomic<uint64_t> mOverflowCnt{0};
+};
+
+// the ring shared by all kernel events handed to EBPFServer, which is never destructed since events may outlive any
+// owner during exit
+RecordRing& GetCommonEventRing();
+
+} // namespace logtail::ebpf
@@ -103,10 +103,12 @@ void BlockedEventManager::UpdateBlockEvent(
     LOG_DEBUG(sLogger,
               ("Add block event ", pEvent->GetSource())(pEvent->GetObject(),
                                                         pEvent->GetInode())(pEvent->GetConfigName(), hashKey));
+    lock_guard<mutex> lock(mEventMapMux);
     mEventMap[hashKey].Update(logstoreKey, pEvent, curTime);
 }
 
 void BlockedEventManager::GetTimeoutEvent(vector<Event*>& res, int32_t curTime) {
+    lock_guard<mutex> lock(mEventMapMux);
     for (auto iter = mEventMap.begin(); iter != mEventMap.end();) {
         auto& e = iter->second;
         if (e.mEvent != nullptr && e.mInvalidTime + e.mTimeout <= curTime) {
@@ -128,6 +130,10 @@ void BlockedEventManager::GetFeedbackEvent(vector<Event*>& res) {
         lock_guard<mutex> lock(mFeedbackQueueMux);
         keys.swap(mFeedbackQueue);
     }
+    if (keys.empty()) {
+        return;
+    }
+    lock_guard<mutex> lock(mEventMapMux);
     for (auto& key : keys) {
         for (auto iter = mEventMap.begin(); iter != mEventMap.end();) {
             auto& e = iter->second;
@@ -65,7 +65,8 @@ private:
     BlockedEventManager() = default;
     ~BlockedEventManager();
 
-    // only used by LogInput thread
+    // race condition from LogInput thread and file read workers
+    std::mutex mEventMapMux;
     std::unordered_map<int64_t, BlockedEvent> mEventMap;
 
     // race condition from Processor Runner threads and LogInput thread
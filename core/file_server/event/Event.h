@@ -105,7 +105,7 @@ public:
 
     const uint32_t GetCookie() const { return mCookie; }
 
-    int64_t GetHashKey() { return mHashKey; }
+    int64_t GetHashKey() const { return mHashKey; }
 
     const std::string& GetConfigName() const { return mConfigName; }
 
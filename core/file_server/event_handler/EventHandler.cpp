@@ -14,6 +14,7 @@
 
 #include "EventHandler.h"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -24,6 +25,7 @@
 #include "common/RuntimeUtil.h"
 #include "common/StringTools.h"
 #include "common/TimeUtil.h"
+#include "common/memory/MemoryAccountant.h"
 #include "file_server/ConfigManager.h"
 #include "file_server/EventDispatcher.h"
 #include "file_server/FileServer.h"
@@ -296,6 +298,11 @@ ModifyHandler::ModifyHandler(const std::string& configName, const FileDiscoveryC
 }
 
 ModifyHandler::~ModifyHandler() {
+    if (!mReaderArraysInReading.empty()) {
+        LOG_INFO(sLogger,
+                 ("release modify handler with files being read", "results will be discarded")("config", mConfigName)(
+                     "log reader queue cnt", mReaderArraysInReading.size()));
+    }
 }
 
 void ModifyHandler::MakeSpaceForNewReader() {
@@ -319,6 +326,9 @@ void ModifyHandler::MakeSpaceForNewReader() {
 
     for (int i = 0; i < deleteCount; ++i) {
         LogFileReader* pReader = sortReaderArray[i];
+        if (IsReading(pReader->GetReaderArray())) {
+            continue;
+        }
         mDevInodeReaderMap.erase(pReader->GetDevInode());
         LogFileReaderPtrArray& readerArray = *pReader->GetReaderArray();
         for (LogFileReaderPtrArray::iterator iter = readerArray.begin(); iter != readerArray.end(); ++iter) {
@@ -508,6 +518,9 @@ void ModifyHandler::Handle(const Event& event) {
         NameLogFileReaderMap::iterator iter = mNameReaderMap.find(name);
         if (iter != mNameReaderMap.end()) {
             LogFileReaderPtrArray& readerArray = iter->second;
+            if (DeferEventIfReading(&readerArray, event)) {
+                return;
+            }
             // only set when reader array size is 1
             if (readerArray.size() == (size_t)1) {
                 readerArray[0]->SetFileDeleted(true);
@@ -530,8 +543,16 @@ void ModifyHandler::Handle(const Event& event) {
             }
         }
     } else if (event.IsContainerStopped()) {
+        bool deferred = false;
         for (auto& pair : mNameReaderMap) {
             LogFileReaderPtrArray& readerArray = pair.second;
+            // the event will be handled again for all reader queues, so deferring it once is enough
+            if (IsReading(&readerArray)) {
+                if (!deferred) {
+                    deferred = DeferEventIfReading(&readerArray, event);
+                }
+                continue;
+            }
             for (auto& reader : readerArray) {
                 if (reader->GetContainerID() != event.GetContainerID()) {
                     continue;
@@ -583,6 +604,10 @@ void ModifyHandler::Handle(const Event& event) {
                         mRotatorReaderMap.erase(rotateIter);
                         break;
                     case LogFileReader::FileCompareResult_SigSameSizeChange: {
+                        auto arrayIter = mNameReaderMap.find(rotatorReader->GetHostLogPathFile());
+                        if (arrayIter != mNameReaderMap.end() && DeferEventIfReading(&arrayIter->second, event)) {
+                            return;
+                        }
                         rotatorReader->UpdateLogPath(logPath);
                         LogFileReaderPtrArray& readerArray = mNameReaderMap[rotatorReader->GetHostLogPathFile()];
                         // new log
@@ -619,7 +644,14 @@ void ModifyHandler::Handle(const Event& event) {
                 LOG_WARNING(sLogger, ("can not find logreader, may be deleted", logPath));
                 return;
             }
+            if (DeferEventIfReading(readerArrayPtr, event)) {
+                return;
+            }
         } else if (devInodeIter == mDevInodeReaderMap.end()) {
+            auto arrayIter = mNameReaderMap.find(name);
+            if (arrayIter != mNameReaderMap.end() && DeferEventIfReading(&arrayIter->second, event)) {
+                return;
+            }
             FileDiscoveryConfig discoveryConfig = FileServer::GetInstance()->GetFileDiscoveryConfig(mConfigName);
             // double check
             // if event with config name, skip check
@@ -655,6 +687,9 @@ void ModifyHandler::Handle(const Event& event) {
                 return;
             }
         } else {
+            if (DeferEventIfReading(devInodeIter->second->GetReaderArray(), event)) {
+                return;
+            }
             devInodeIter->second->UpdateLogPath(logPath);
             readerArrayPtr = devInodeIter->second->GetReaderArray();
         }
@@ -761,131 +796,15 @@ void ModifyHandler::Handle(const Event& event) {
             }
         }
 
-        bool hasMoreData;
-        do {
-            if (!ProcessQueueManager::GetInstance()->IsValidToPush(reader->GetQueueKey())) {
-                static int32_t s_lastOutPutTime = 0;
-                int32_t curTime = time(NULL);
-                if (curTime - s_lastOutPutTime > 600) {
-                    s_lastOutPutTime = curTime;
-                    LOG_WARNING(sLogger,
-                                ("logprocess queue is full, put modify event to event queue again",
-                                 reader->GetHostLogPath())(reader->GetProject(), reader->GetLogstore()));
-
-                    AlarmManager::GetInstance()->SendAlarm(
-                        PROCESS_QUEUE_BUSY_ALARM,
-                        string("logprocess queue is full, put modify event to event queue again, file:")
-                            + reader->GetHostLogPath(),
-                        reader->GetRegion(),
-                        reader->GetProject(),
-                        reader->GetConfigName(),
-                        reader->GetLogstore());
-                }
-
-                BlockedEventManager::GetInstance()->UpdateBlockEvent(
-                    reader->GetQueueKey(), mConfigName, event, reader->GetDevInode(), curTime);
-                return;
-            }
-            auto logBuffer = make_unique<LogBuffer>();
-            hasMoreData = reader->ReadLog(*logBuffer, &event);
-            int32_t pushRetry = PushLogToProcessor(reader, logBuffer.get());
-            if (!hasMoreData) {
-                if (reader->IsFileDeleted()) {
-                    LOG_INFO(sLogger,
-                             ("close the file", "current file has been read, and is marked deleted")(
-                                 "project", reader->GetProject())("logstore", reader->GetLogstore())(
-                                 "config", mConfigName)("log reader queue name", reader->GetHostLogPath())(
-                                 "file device", reader->GetDevInode().dev)("file inode", reader->GetDevInode().inode)(
-                                 "file size", reader->GetFileSize()));
-                    reader->CloseFilePtr();
-                } else if (reader->IsContainerStopped()) {
-                    // update container info one more time, ensure file is hold by same cotnainer
-                    if (reader->UpdateContainerInfo() && !reader->IsContainerStopped()) {
-                        LOG_INFO(sLogger,
-                                 ("file is reused by a new container", reader->GetContainerID())(
-                                     "project", reader->GetProject())("logstore", reader->GetLogstore())(
-                                     "config", mConfigName)("log reader queue name", reader->GetHostLogPath())(
-                                     "file device", reader->GetDevInode().dev)(
-                                     "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
-                    } else {
-                        // release fd as quick as possible
-                        LOG_INFO(sLogger,
-                                 ("close the file",
-                                  "current file has been read, and the relative container has been stopped")(
-                                     "project", reader->GetProject())("logstore", reader->GetLogstore())(
-                                     "config", mConfigName)("log reader queue name", reader->GetHostLogPath())(
-                                     "file device", reader->GetDevInode().dev)(
-                                     "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
-                        ForceReadLogAndPush(reader);
-                        reader->CloseFilePtr();
-                    }
-                }
-                break;
-            }
-            if (pushRetry >= 5 || GetCurrentTimeInMicroSeconds() - beginTime > mReadFileTimeSlice) {
-                LOG_DEBUG(
-                    sLogger,
-                    ("read log breakout", "file io cost 1 time slice (50ms) or push blocked")("pushRetry", pushRetry)(
-                        "begin time", beginTime)("path", event.GetSource())("file", event.GetObject()));
-                Event* ev = new Event(event);
-                ev->SetConfigName(mConfigName);
-                LogInput::GetInstance()->PushEventQueue(ev);
-                break;
-            }
-
-            // When loginput thread hold on, we should repush this event back.
-            // If we don't repush and this file has no modify event, this reader will never been read.
-            if (LogInput::GetInstance()->IsInterupt()) {
-                if (hasMoreData) {
-                    LOG_INFO(
-                        sLogger,
-                        ("read log interupt but has more data, reason", "log input thread hold on")(
-                            "action", "repush modify event to event queue")("begin time", beginTime)(
-                            "path", event.GetSource())("file", event.GetObject())("inode", reader->GetDevInode().inode)(
-                            "offset", reader->GetLastFilePos())("size", reader->GetFileSize()));
-                } else {
-                    LOG_DEBUG(
-                        sLogger,
-                        ("read log breakout, reason", "log input thread hold on")(
-                            "action", "repush modify event to event queue")("begin time", beginTime)(
-                            "path", event.GetSource())("file", event.GetObject())("inode", reader->GetDevInode().inode)(
-                            "offset", reader->GetLastFilePos())("size", reader->GetFileSize()));
-                }
-                Event* ev = new Event(event);
-                ev->SetConfigName(mConfigName);
-                LogInput::GetInstance()->PushEventQueue(ev);
-                break;
-            }
-        } while (true);
-
-        if (!hasMoreData && readerArrayPtr->size() > (size_t)1) {
-            // when a rotated reader finish its reading, it's unlikely that there will be data again
-            // so release file fd as quick as possible (open again if new data coming)
-            LOG_INFO(sLogger,
-                     ("close the file and move the corresponding reader to the rotator reader pool",
-                      "current file has been read and more files are waiting in the log reader queue")(
-                         "project", reader->GetProject())("logstore", reader->GetLogstore())("config", mConfigName)(
-                         "log reader queue name", reader->GetHostLogPath())("log reader queue size",
-                                                                            readerArrayPtr->size() - 1)(
-                         "file device", reader->GetDevInode().dev)("file inode", reader->GetDevInode().inode)(
-                         "file size", reader->GetFileSize())("rotator reader pool size", mRotatorReaderMap.size() + 1));
-            ForceReadLogAndPush(reader);
-            reader->CloseFilePtr();
-            readerArrayPtr->pop_front();
-            mDevInodeReaderMap.erase(reader->GetDevInode());
-            mRotatorReaderMap[reader->GetDevInode()] = reader;
-            // need to push modify event again, but without dev inode
-            // use head dev + inode
-            Event* ev = new Event(event.GetSource(),
-                                  event.GetObject(),
-                                  event.GetType(),
-                                  event.GetWd(),
-                                  event.GetCookie(),
-                                  (*readerArrayPtr)[0]->GetDevInode().dev,
-                                  (*readerArrayPtr)[0]->GetDevInode().inode);
-            ev->SetConfigName(mConfigName);
-            LogInput::GetInstance()->PushEventQueue(ev);
+        if (FileReadWorkerPool::GetInstance()->IsEnabled()) {
+            mReaderArraysInReading[readerArrayPtr];
+            FileReadWorkerPool::GetInstance()->Submit(
+                make_unique<FileReadTask>(this, mAlive, reader, readerArrayPtr, event, mReadFileTimeSlice));
+            return;
         }
+        uint64_t readBytes = 0;
+        ReadLogStopReason reason = ReadLogUntilStop(reader, event, beginTime, mReadFileTimeSlice, readBytes);
+        OnReadLogStopped(reader, readerArrayPtr, event, reason);
     }
     // if a file is created, and dev inode cannot found(this means it's a new file), create reader for this file, then
     // insert reader into mDevInodeReaderMap
@@ -894,6 +813,10 @@ void ModifyHandler::Handle(const Event& event) {
             return;
         }
         if (devInodeIter == mDevInodeReaderMap.end()) {
+            auto arrayIter = mNameReaderMap.find(name);
+            if (arrayIter != mNameReaderMap.end() && DeferEventIfReading(&arrayIter->second, event)) {
+                return;
+            }
             FileDiscoveryConfig discoveryConfig = FileServer::GetInstance()->GetFileDiscoveryConfig(mConfigName);
             if (discoveryConfig.first
                 && (!event.GetConfigName().empty() || discoveryConfig.first->IsMatch(path, name))) {
@@ -911,6 +834,205 @@ void ModifyHandler::Handle(const Event& event) {
     }
 }
 
+ReadLogStopReason ModifyHandler::ReadLogUntilStop(const LogFileReaderPtr& reader,
+                                                  const Event& event,
+                                                  uint64_t beginTime,
+                                                  uint64_t timeSlice,
+                                                  uint64_t& readBytes) {
+    while (true) {
+        if (!ProcessQueueManager::GetInstance()->IsValidToPush(reader->GetQueueKey())) {
+            return ReadLogStopReason::QUEUE_BLOCKED;
+        }
+        if (MemoryAccountant::GetInstance()->IsInputPaused()) {
+            return ReadLogStopReason::MEMORY_LIMITED;
+        }
+        auto logBuffer = make_unique<LogBuffer>();
+        bool hasMoreData = reader->ReadLog(*logBuffer, &event);
+        readBytes += logBuffer->readLength;
+        int32_t pushRetry = PushLogToProcessor(reader, logBuffer.get());
+        if (!hasMoreData) {
+            return ReadLogStopReason::READ_TO_END;
+        }
+        if (pushRetry >= 5 || GetCurrentTimeInMicroSeconds() - beginTime > timeSlice) {
+            LOG_DEBUG(
+                sLogger,
+                ("read log breakout", "file io cost 1 time slice (50ms) or push blocked")("pushRetry", pushRetry)(
+                    "begin time", beginTime)("path", event.GetSource())("file", event.GetObject()));
+            return ReadLogStopReason::TIME_SLICE_USED;
+        }
+
+        // When loginput thread hold on, we should repush this event back.
+        // If we don't repush and this file has no modify event, this reader will never been read.
+        if (LogInput::GetInstance()->IsInterupt()) {
+            LOG_INFO(sLogger,
+                     ("read log interupt but has more data, reason", "log input thread hold on")(
+                         "action", "repush modify event to event queue")("begin time", beginTime)(
+                         "path", event.GetSource())("file", event.GetObject())("inode", reader->GetDevInode().inode)(
+                         "offset", reader->GetLastFilePos())("size", reader->GetFileSize()));
+            return ReadLogStopReason::INTERRUPTED;
+        }
+    }
+}
+
+void ModifyHandler::OnReadLogStopped(const LogFileReaderPtr& reader,
+                                     LogFileReaderPtrArray* readerArrayPtr,
+                                     const Event& event,
+                                     ReadLogStopReason reason) {
+    switch (reason) {
+        case ReadLogStopReason::QUEUE_BLOCKED: {
+            static int32_t s_lastOutPutTime = 0;
+            int32_t curTime = time(NULL);
+            if (curTime - s_lastOutPutTime > 600) {
+                s_lastOutPutTime = curTime;
+                LOG_WARNING(sLogger,
+                            ("logprocess queue is full, put modify event to event queue again",
+                             reader->GetHostLogPath())(reader->GetProject(), reader->GetLogstore()));
+
+                AlarmManager::GetInstance()->SendAlarm(
+                    PROCESS_QUEUE_BUSY_ALARM,
+                    string("logprocess queue is full, put modify event to event queue again, file:")
+                        + reader->GetHostLogPath(),
+                    reader->GetRegion(),
+                    reader->GetProject(),
+                    reader->GetConfigName(),
+                    reader->GetLogstore());
+            }
+
+            BlockedEventManager::GetInstance()->UpdateBlockEvent(
+                reader->GetQueueKey(), mConfigName, event, reader->GetDevInode(), curTime);
+            return;
+        }
+        case ReadLogStopReason::MEMORY_LIMITED: {
+            // the reading is resumed by the blocked event manager once the timeout expires
+            static int32_t s_lastOutPutTime = 0;
+            int32_t curTime = time(NULL);
+            if (curTime - s_lastOutPutTime > 600) {
+                s_lastOutPutTime = curTime;
+                LOG_WARNING(sLogger,
+                            ("memory pressure is high, put modify event to event queue again",
+                             reader->GetHostLogPath())(reader->GetProject(), reader->GetLogstore()));
+            }
+
+            BlockedEventManager::GetInstance()->UpdateBlockEvent(
+                reader->GetQueueKey(), mConfigName, event, reader->GetDevInode(), curTime);
+            return;
+        }
+        case ReadLogStopReason::TIME_SLICE_USED:
+        case ReadLogStopReason::INTERRUPTED: {
+            Event* ev = new Event(event);
+            ev->SetConfigName(mConfigName);
+            LogInput::GetInstance()->PushEventQueue(ev);
+            return;
+        }
+        case ReadLogStopReason::READ_TO_END:
+            break;
+    }
+
+    if (reader->IsFileDeleted()) {
+        LOG_INFO(sLogger,
+                 ("close the file", "current file has been read, and is marked deleted")(
+                     "project", reader->GetProject())("logstore", reader->GetLogstore())("config", mConfigName)(
+                     "log reader queue name", reader->GetHostLogPath())("file device", reader->GetDevInode().dev)(
+                     "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
+        reader->CloseFilePtr();
+    } else if (reader->IsContainerStopped()) {
+        // update container info one more time, ensure file is hold by same cotnainer
+        if (reader->UpdateContainerInfo() && !reader->IsContainerStopped()) {
+            LOG_INFO(sLogger,
+                     ("file is reused by a new container", reader->GetContainerID())("project", reader->GetProject())(
+                         "logstore", reader->GetLogstore())("config", mConfigName)(
+                         "log reader queue name", reader->GetHostLogPath())("file device", reader->GetDevInode().dev)(
+                         "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
+        } else {
+            // release fd as quick as possible
+            LOG_INFO(sLogger,
+                     ("close the file", "current file has been read, and the relative container has been stopped")(
+                         "project", reader->GetProject())("logstore", reader->GetLogstore())("config", mConfigName)(
+                         "log reader queue name", reader->GetHostLogPath())("file device", reader->GetDevInode().dev)(
+                         "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
+            ForceReadLogAndPush(reader);
+            reader->CloseFilePtr();
+        }
+    }
+
+    if (readerArrayPtr->size() > (size_t)1) {
+        // when a rotated reader finish its reading, it's unlikely that there will be data again
+        // so release file fd as quick as possible (open again if new data coming)
+        LOG_INFO(sLogger,
+                 ("close the file and move the corresponding reader to the rotator reader pool",
+                  "current file has been read and more files are waiting in the log reader queue")(
+                     "project", reader->GetProject())("logstore", reader->GetLogstore())("config", mConfigName)(
+                     "log reader queue name", reader->GetHostLogPath())("log reader queue size",
+                                                                        readerArrayPtr->size() - 1)(
+                     "file device", reader->GetDevInode().dev)("file inode", reader->GetDevInode().inode)(
+                     "file size", reader->GetFileSize())("rotator reader pool size", mRotatorReaderMap.size() + 1));
+        ForceReadLogAndPush(reader);
+        reader->CloseFilePtr();
+        readerArrayPtr->pop_front();
+        mDevInodeReaderMap.erase(reader->GetDevInode());
+        mRotatorReaderMap[reader->GetDevInode()] = reader;
+        // need to push modify event again, but without dev inode
+        // use head dev + inode
+        Event* ev = new Event(event.GetSource(),
+                              event.GetObject(),
+                              event.GetType(),
+                              event.GetWd(),
+                              event.GetCookie(),
+                              (*readerArrayPtr)[0]->GetDevInode().dev,
+                              (*readerArrayPtr)[0]->GetDevInode().inode);
+        ev->SetConfigName(mConfigName);
+        LogInput::GetInstance()->PushEventQueue(ev);
+    }
+}
+
+void ModifyHandler::OnReadTaskFinished(FileReadTask& task) {
+    auto iter = mReaderArraysInReading.find(task.mReaderArray);
+    if (iter == mReaderArraysInReading.end()) {
+        LOG_ERROR(sLogger,
+                  ("unexpected error", "reader queue of the finished read task is not in reading")(
+                      "config", mConfigName)("log reader queue name", task.mReader->GetHostLogPath()));
+        return;
+    }
+    vector<Event> deferredEvents;
+    deferredEvents.swap(iter->second);
+    mReaderArraysInReading.erase(iter);
+
+    // reader queues are left untouched while being read, so the reader should still be the head
+    if (!task.mReaderArray->empty() && (*task.mReaderArray)[0] == task.mReader) {
+        OnReadLogStopped(task.mReader, task.mReaderArray, task.mEvent, task.mStopReason);
+    } else {
+        LOG_WARNING(sLogger,
+                    ("reader is no longer the head of the log reader queue",
+                     "repush modify event to event queue")("config", mConfigName)(
+                        "log reader queue name", task.mReader->GetHostLogPath())("file inode",
+                                                                                 task.mReader->GetDevInode().inode));
+        Event* ev = new Event(task.mEvent);
+        ev->SetConfigName(mConfigName);
+        LogInput::GetInstance()->PushEventQueue(ev);
+    }
+    for (const auto& event : deferredEvents) {
+        LogInput::GetInstance()->PushEventQueue(new Event(event));
+    }
+}
+
+bool ModifyHandler::DeferEventIfReading(const LogFileReaderPtrArray* readerArray, const Event& event) {
+    auto iter = mReaderArraysInReading.find(readerArray);
+    if (iter == mReaderArraysInReading.end()) {
+        return false;
+    }
+    auto& events = iter->second;
+    // modify events keep coming while the file is being read
+    if (event.IsModify()
+        && find_if(events.begin(),
+                   events.end(),
+                   [&event](const Event& e) { return e.IsModify() && e.GetHashKey() == event.GetHashKey(); })
+            != events.end()) {
+        return true;
+    }
+    events.push_back(event);
+    return true;
+}
+
 void ModifyHandler::HandleTimeOut() {
     MakeSpaceForNewReader();
     DeleteTimeoutReader();
@@ -923,6 +1045,10 @@ void ModifyHandler::HandleTimeOut() {
     for (; readerIter != mNameReaderMap.end();) {
         bool actioned = false;
         LogFileReaderPtrArray& readerArray = readerIter->second;
+        if (IsReading(&readerArray)) {
+            ++readerIter;
+            continue;
+        }
         // donot check file delete flag or close ptr when array size > 1
         if (readerArray.size() > 1) {
             LOG_DEBUG(sLogger,
@@ -1007,6 +1133,9 @@ bool ModifyHandler::DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag) {
 }
 
 bool ModifyHandler::IsAllFileRead() {
+    if (!mReaderArraysInReading.empty()) {
+        return false;
+    }
     for (auto it = mNameReaderMap.begin(); it != mNameReaderMap.end(); ++it) {
         if (it->second.size() > 1 || (!it->second.empty() && !it->second[0]->IsReadToEnd())) {
             return false;
@@ -1034,6 +1163,10 @@ void ModifyHandler::DeleteTimeoutReader(int32_t timeoutInterval) {
     NameLogFileReaderMap::iterator readerIter = mNameReaderMap.begin();
     for (; readerIter != mNameReaderMap.end();) {
         LogFileReaderPtrArray& readerArray = readerIter->second;
+        if (IsReading(&readerArray)) {
+            ++readerIter;
+            continue;
+        }
         for (LogFileReaderPtrArray::iterator iter = readerArray.begin(); iter != readerArray.end();) {
             int32_t interval = curTime - ((*iter)->GetLastUpdateTime());
             if (interval > timeoutInterval) {
@@ -1105,7 +1238,8 @@ int32_t ModifyHandler::PushLogToProcessor(LogFileReaderPtr reader, LogBuffer* lo
         while (!ProcessorRunner::GetInstance()->PushQueue(reader->GetQueueKey(), 0, std::move(group))) // 10ms
         {
             ++pushRetry;
-            if (pushRetry % 10 == 0)
+            // events can only be read by LogInput thread
+            if (pushRetry % 10 == 0 && !FileReadWorkerPool::IsInWorkerThread())
                 LogInput::GetInstance()->TryReadEvents(false);
         }
     }
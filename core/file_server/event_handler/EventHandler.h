@@ -19,8 +19,11 @@
 
 #include <deque>
 #include <map>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
+#include "file_server/event_handler/FileReadWorkerPool.h"
 #include "file_server/reader/LogFileReader.h"
 
 namespace logtail {
@@ -63,6 +66,10 @@ private:
     uint64_t mReadFileTimeSlice;
     std::string mConfigName;
     int32_t mLastOverflowErrorTime;
+    // reader queues whose head reader is being read by FileReadWorkerPool, with the events deferred until the read is
+    // finished, so that there is at most one read in flight for each reader queue
+    std::unordered_map<const LogFileReaderPtrArray*, std::vector<Event>> mReaderArraysInReading;
+    std::shared_ptr<bool> mAlive = std::make_shared<bool>(true);
 
     void DeleteTimeoutReader();
     void DeleteTimeoutReader(int32_t timeoutInterval);
@@ -98,7 +105,23 @@ private:
                                             uint32_t exactlyonceConcurrency = 0,
                                             bool forceBeginingFlag = false);
 
-    int32_t PushLogToProcessor(LogFileReaderPtr reader, LogBuffer* logBuffer);
+    static int32_t PushLogToProcessor(LogFileReaderPtr reader, LogBuffer* logBuffer);
+    // reads the file until it is read to end, the time slice is used up, the process queue is full or LogInput is held
+    // on, which is safe to be called by the file read workers
+    static ReadLogStopReason ReadLogUntilStop(const LogFileReaderPtr& reader,
+                                              const Event& event,
+                                              uint64_t beginTime,
+                                              uint64_t timeSlice,
+                                              uint64_t& readBytes);
+    void OnReadLogStopped(const LogFileReaderPtr& reader,
+                          LogFileReaderPtrArray* readerArrayPtr,
+                          const Event& event,
+                          ReadLogStopReason reason);
+    void OnReadTaskFinished(FileReadTask& task);
+    bool IsReading(const LogFileReaderPtrArray* readerArray) const {
+        return mReaderArraysInReading.find(readerArray) != mReaderArraysInReading.end();
+    }
+    bool DeferEventIfReading(const LogFileReaderPtrArray* readerArray, const Event& event);
 
     void ForceReadLogAndPush(LogFileReaderPtr reader);
 
@@ -115,6 +138,8 @@ public:
     bool IsAllFileRead() override;
     const std::string& GetConfigName() const { return mConfigName; }
 
+    friend class FileReadWorkerPool;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ConfigUpdatorUnittest;
     friend class EventDispatcherTest;
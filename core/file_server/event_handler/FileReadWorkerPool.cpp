@@ -0,0 +1,170 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/event_handler/FileReadWorkerPool.h"
+
+#include "common/Flags.h"
+#include "common/HashUtil.h"
+#include "common/StringTools.h"
+#include "common/TimeUtil.h"
+#include "file_server/event_handler/EventHandler.h"
+#include "file_server/event_handler/LogInput.h"
+#include "logger/Logger.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+DEFINE_FLAG_INT32(file_reader_worker_cnt,
+                  "number of threads reading files, 0 means files are read by the event handling thread",
+                  0);
+
+using namespace std;
+
+namespace logtail {
+
+static thread_local bool sIsInWorkerThread = false;
+
+void FileReadWorkerPool::Start(size_t workerCnt) {
+    if (workerCnt == 0 || !mWorkers.empty()) {
+        return;
+    }
+    for (size_t i = 0; i < workerCnt; ++i) {
+        mWorkers.emplace_back(make_unique<Worker>(i));
+        mWorkers.back()->Start();
+    }
+    LOG_INFO(sLogger, ("file read worker pool", "started")("worker cnt", workerCnt));
+}
+
+void FileReadWorkerPool::Stop() {
+    if (mWorkers.empty()) {
+        return;
+    }
+    for (auto& worker : mWorkers) {
+        worker->Stop();
+    }
+    for (auto& worker : mWorkers) {
+        worker->WaitForExit();
+    }
+    // readers of the discarded tasks should be destructed on this thread
+    HandleFinishedTasks();
+    mWorkers.clear();
+    LOG_INFO(sLogger, ("file read worker pool", "stopped successfully"));
+}
+
+void FileReadWorkerPool::Submit(unique_ptr<FileReadTask>&& task) {
+    size_t key = DevInodeHash()(task->mReader->GetDevInode());
+    HashCombine(key, hash<string>()(task->mReader->GetConfigName()));
+    {
+        lock_guard<mutex> lock(mFinishedTasksMux);
+        ++mRunningTaskCnt;
+    }
+    mWorkers[key % mWorkers.size()]->Push(std::move(task));
+}
+
+void FileReadWorkerPool::HandleFinishedTasks() {
+    vector<unique_ptr<FileReadTask>> tasks;
+    {
+        lock_guard<mutex> lock(mFinishedTasksMux);
+        if (mFinishedTasks.empty()) {
+            return;
+        }
+        tasks.swap(mFinishedTasks);
+    }
+    for (auto& task : tasks) {
+        auto alive = task->mHandlerAlive.lock();
+        if (!alive) {
+            LOG_DEBUG(sLogger,
+                      ("discard file read result", "modify handler has been released")(
+                          "file", task->mReader->GetRealLogPath()));
+            continue;
+        }
+        task->mHandler->OnReadTaskFinished(*task);
+    }
+}
+
+void FileReadWorkerPool::WaitAllTasksFinished() {
+    {
+        unique_lock<mutex> lock(mFinishedTasksMux);
+        mFinishedTasksCV.wait(lock, [this] { return mRunningTaskCnt == 0; });
+    }
+    HandleFinishedTasks();
+}
+
+bool FileReadWorkerPool::IsInWorkerThread() {
+    return sIsInWorkerThread;
+}
+
+void FileReadWorkerPool::OnTaskFinished(unique_ptr<FileReadTask>&& task) {
+    {
+        lock_guard<mutex> lock(mFinishedTasksMux);
+        mFinishedTasks.emplace_back(std::move(task));
+        --mRunningTaskCnt;
+    }
+    mFinishedTasksCV.notify_all();
+    LogInput::GetInstance()->Trigger();
+}
+
+void FileReadWorkerPool::Worker::Start() {
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_RUNNER,
+        {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_FILE_READER},
+         {METRIC_LABEL_KEY_THREAD_NO, ToString(mId)}});
+    mInItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_ITEMS_TOTAL);
+    mInSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_SIZE_BYTES);
+    mTotalDelayMs = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_TOTAL_DELAY_MS);
+    mWaitingItemsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_FILE_READER_WAITING_ITEMS_TOTAL);
+    mLastRunTime = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
+
+    mIsFlush = false;
+    mThreadRes = async(launch::async, &Worker::Run, this);
+}
+
+void FileReadWorkerPool::Worker::WaitForExit() {
+    if (mThreadRes.valid()) {
+        mThreadRes.wait();
+    }
+}
+
+void FileReadWorkerPool::Worker::Push(unique_ptr<FileReadTask>&& task) {
+    mQueue.Push(std::move(task));
+    SET_GAUGE(mWaitingItemsTotal, mQueue.Size());
+}
+
+void FileReadWorkerPool::Worker::Run() {
+    LOG_INFO(sLogger, ("file read worker", "started")("worker", mId));
+    sIsInWorkerThread = true;
+    while (true) {
+        SET_GAUGE(mLastRunTime, time(nullptr));
+        unique_ptr<FileReadTask> task;
+        if (!mQueue.WaitAndPop(task, 500)) {
+            if (mIsFlush) {
+                break;
+            }
+            continue;
+        }
+        SET_GAUGE(mWaitingItemsTotal, mQueue.Size());
+        ADD_COUNTER(mInItemsTotal, 1);
+
+        auto before = chrono::system_clock::now();
+        uint64_t readBytes = 0;
+        task->mStopReason = ModifyHandler::ReadLogUntilStop(
+            task->mReader, task->mEvent, GetCurrentTimeInMicroSeconds(), task->mTimeSlice, readBytes);
+        ADD_COUNTER(mInSizeBytes, readBytes);
+        ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - before);
+
+        FileReadWorkerPool::GetInstance()->OnTaskFinished(std::move(task));
+    }
+    LOG_INFO(sLogger, ("file read worker", "stopped")("worker", mId));
+}
+
+} // namespace logtail
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/SafeQueue.h"
+#include "file_server/event/Event.h"
+#include "file_server/reader/LogFileReader.h"
+#include "monitor/MetricManager.h"
+
+namespace logtail {
+
+class ModifyHandler;
+
+enum class ReadLogStopReason { READ_TO_END, QUEUE_BLOCKED, MEMORY_LIMITED, TIME_SLICE_USED, INTERRUPTED };
+
+struct FileReadTask {
+    FileReadTask(ModifyHandler* handler,
+                 const std::shared_ptr<bool>& handlerAlive,
+                 const LogFileReaderPtr& reader,
+                 LogFileReaderPtrArray* readerArray,
+                 const Event& event,
+                 uint64_t timeSlice)
+        : mHandler(handler),
+          mHandlerAlive(handlerAlive),
+          mReader(reader),
+          mReaderArray(readerArray),
+          mEvent(event),
+          mTimeSlice(timeSlice) {}
+
+    ModifyHandler* mHandler = nullptr;
+    // expires once the handler is destructed, in which case the result is discarded
+    std::weak_ptr<bool> mHandlerAlive;
+    LogFileReaderPtr mReader;
+    LogFileReaderPtrArray* mReaderArray = nullptr;
+    Event mEvent;
+    uint64_t mTimeSlice = 0;
+
+    ReadLogStopReason mStopReason = ReadLogStopReason::READ_TO_END;
+};
+
+// Reads files on file_reader_worker_cnt threads instead of the LogInput thread.
+//
+// Only reading the file and pushing the data to the process queue happen in the workers. Event discovery, reader
+// lookup and whatever follows the read (closing files, rotation, repushing events) stay on the LogInput thread, which
+// collects the finished tasks, so that the reader maps of the handlers are never accessed concurrently. Handlers
+// submit at most one task per reader queue at a time, and tasks of the same file always go to the same worker.
+class FileReadWorkerPool {
+public:
+    FileReadWorkerPool(const FileReadWorkerPool&) = delete;
+    FileReadWorkerPool& operator=(const FileReadWorkerPool&) = delete;
+
+    static FileReadWorkerPool* GetInstance() {
+        static FileReadWorkerPool instance;
+        return &instance;
+    }
+
+    // should only be called once, does nothing if workerCnt is 0
+    void Start(size_t workerCnt);
+    // should only be called after LogInput thread has exited
+    void Stop();
+    bool IsEnabled() const { return !mWorkers.empty(); }
+
+    void Submit(std::unique_ptr<FileReadTask>&& task);
+    // hand the finished tasks back to their handlers, should only be called by the LogInput thread or when it is held
+    void HandleFinishedTasks();
+    // wait until all submitted tasks are finished, and then handle them
+    void WaitAllTasksFinished();
+
+    // whether the current thread is one of the workers, which should not touch the event queue of LogInput
+    static bool IsInWorkerThread();
+
+private:
+    class Worker {
+    public:
+        explicit Worker(size_t id) : mId(id) {}
+
+        void Start();
+        void Stop() { mIsFlush = true; }
+        void WaitForExit();
+        void Push(std::unique_ptr<FileReadTask>&& task);
+
+    private:
+        void Run();
+
+        size_t mId = 0;
+        SafeQueue<std::unique_ptr<FileReadTask>> mQueue;
+        std::future<void> mThreadRes;
+        std::atomic_bool mIsFlush = false;
+
+        mutable MetricsRecordRef mMetricsRecordRef;
+        CounterPtr mInItemsTotal;
+        CounterPtr mInSizeBytes;
+        TimeCounterPtr mTotalDelayMs;
+        IntGaugePtr mWaitingItemsTotal;
+        IntGaugePtr mLastRunTime;
+    };
+
+    FileReadWorkerPool() = default;
+    ~FileReadWorkerPool() = default;
+
+    void OnTaskFinished(std::unique_ptr<FileReadTask>&& task);
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+
+    std::mutex mFinishedTasksMux;
+    std::condition_variable mFinishedTasksCV;
+    std::vector<std::unique_ptr<FileReadTask>> mFinishedTasks;
+    size_t mRunningTaskCnt = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ModifyHandlerUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -30,6 +30,7 @@
 #include "file_server/FileServer.h"
 #include "file_server/event/BlockEventManager.h"
 #include "file_server/event_handler/EventHandler.h"
+#include "file_server/event_handler/FileReadWorkerPool.h"
 #include "file_server/event_handler/HistoryFileImporter.h"
 #include "file_server/polling/PollingCache.h"
 #include "file_server/polling/PollingDirFile.h"
@@ -43,6 +44,8 @@
 
 using namespace std;
 
+DECLARE_FLAG_INT32(file_reader_worker_cnt);
+
 DEFINE_FLAG_INT32(check_symbolic_link_interval, "seconds", 120);
 DEFINE_FLAG_INT32(check_base_dir_interval, "seconds", 60);
 DEFINE_FLAG_INT32(check_timeout_interval, "seconds", 600);
@@ -91,6 +94,9 @@ void LogInput::Start() {
     mEnableFileIncludedByMultiConfigs = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(
         METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG);
 
+    if (INT32_FLAG(file_reader_worker_cnt) > 0) {
+        FileReadWorkerPool::GetInstance()->Start(INT32_FLAG(file_reader_worker_cnt));
+    }
     mThreadRes = async(launch::async, &LogInput::ProcessLoop, this);
 }
 
@@ -109,11 +115,16 @@ void LogInput::HoldOn() {
             return;
         }
         mThreadRes.wait(); // should we set a timeout here? what it network outrage for an hour?
+        FileReadWorkerPool::GetInstance()->Stop();
         LOG_INFO(sLogger, ("input event handle daemon", "stopped successfully"));
     } else {
         LOG_INFO(sLogger, ("input event handle daemon pause", "starts"));
         mInteruptFlag = true;
         mAccessMainThreadRWL.lock();
+        // files being read by the workers should be finished before checkpoints are dumped or configs are updated
+        if (FileReadWorkerPool::GetInstance()->IsEnabled()) {
+            FileReadWorkerPool::GetInstance()->WaitAllTasksFinished();
+        }
         LOG_INFO(sLogger, ("input event handle daemon pause", "succeeded"));
     }
 }
@@ -156,23 +167,27 @@ void LogInput::TryReadEvents(bool forceRead) {
 void LogInput::FlowControl() {
     const static int32_t FLOW_CONTROL_SLEEP_MICROSECONDS = 20 * 1000; // 20ms
     const static int32_t MAX_SLEEP_COUNT = 50; // 1s
-    static int32_t sleepCount = 10;
-    static int32_t lastCheckTime = 0;
+    // may be called by file read workers concurrently
+    static atomic_int sSleepCount{10};
+    static atomic_int sLastCheckTime{0};
+    bool isInWorkerThread = FileReadWorkerPool::IsInWorkerThread();
+    int32_t sleepCount = sSleepCount;
     int32_t i = 0;
     while (i < sleepCount) {
         if (mInteruptFlag)
             return;
         usleep(FLOW_CONTROL_SLEEP_MICROSECONDS);
         ++i;
-        if (i % 5 == 0)
+        if (i % 5 == 0 && !isInWorkerThread)
             TryReadEvents(true);
     }
 
     if (mInteruptFlag)
         return;
     int32_t curTime = time(NULL);
-    if (curTime - lastCheckTime >= 1) {
-        lastCheckTime = curTime;
+    int32_t lastCheckTime = sLastCheckTime;
+    if (curTime - lastCheckTime >= 1 && sLastCheckTime.compare_exchange_strong(lastCheckTime, curTime)) {
+        sleepCount = sSleepCount;
         double cpuUsageLevel = LogtailMonitor::GetInstance()->GetRealtimeCpuLevel();
         if (cpuUsageLevel >= 1.5) {
             sleepCount += 5;
@@ -198,6 +213,7 @@ void LogInput::FlowControl() {
             if (sleepCount < 0)
                 sleepCount = 0;
         }
+        sSleepCount = sleepCount;
         LOG_DEBUG(sLogger, ("cpuUsageLevel", cpuUsageLevel)("sleepCount", sleepCount));
     }
 }
@@ -377,6 +393,9 @@ void LogInput::ProcessLoop() {
     while (true) {
         ReadLock lock(mAccessMainThreadRWL);
         TryReadEvents(false);
+        if (FileReadWorkerPool::GetInstance()->IsEnabled()) {
+            FileReadWorkerPool::GetInstance()->HandleFinishedTasks();
+        }
         Event* ev = PopEventQueue();
         if (ev != NULL) {
             ++mEventProcessCount;
@@ -456,6 +475,9 @@ void LogInput::ProcessLoop() {
 
         if (Application::GetInstance()->IsExiting()
             && (!BOOL_FLAG(enable_full_drain_mode) || EventDispatcher::GetInstance()->IsAllFileRead())) {
+            if (FileReadWorkerPool::GetInstance()->IsEnabled()) {
+                FileReadWorkerPool::GetInstance()->WaitAllTasksFinished();
+            }
             break;
         }
     }
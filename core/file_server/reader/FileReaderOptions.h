@@ -39,6 +39,9 @@ struct FileReaderOptions {
     uint32_t mReadDelayAlertThresholdBytes;
     uint32_t mCloseUnusedReaderIntervalSec;
     uint32_t mRotatorQueueSize;
+    // map append-only files into memory instead of reading them into a buffer, UTF8 only. Incompatible with
+    // copytruncate rotation and other truncating writers, since events referencing a truncated mapping raise SIGBUS.
+    bool mEnableMmapRead = false;
 
     FileReaderOptions();
 
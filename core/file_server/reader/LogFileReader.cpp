@@ -41,6 +41,7 @@
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
+#include "common/CharSearch.h"
 #include "common/ErrorUtil.h"
 #include "common/FileSystemUtil.h"
 #include "common/Flags.h"
@@ -74,6 +75,7 @@ DEFINE_FLAG_INT32(skip_first_modify_time, "second ", 5 * 60);
 DEFINE_FLAG_INT32(max_reader_open_files, "max fd count that reader can open max", 100000);
 DEFINE_FLAG_INT32(truncate_pos_skip_bytes, "skip more xx bytes when truncate", 0);
 DEFINE_FLAG_INT32(max_fix_pos_bytes, "", 128 * 1024);
+DEFINE_FLAG_INT32(mmap_read_min_bytes, "only read by mmap when at least so many bytes are to be read", 64 * 1024);
 DEFINE_FLAG_INT32(force_release_deleted_file_fd_timeout,
                   "force release fd if file is deleted after specified seconds, no matter read to end or not",
                   -1);
@@ -1306,6 +1308,7 @@ bool LogFileReader::CheckFileSignatureAndOffset(bool isOpenOnUpdate) {
                      ("Check file truncate by signature, read from begin",
                       mHostLogPath)("project", GetProject())("logstore", GetLogstore())("config", GetConfigName()));
             mLastFilePos = 0;
+            mMmapReadDisabled = true;
             if (mEOOption) {
                 updatePrimaryCheckpointSignature();
             }
@@ -1331,6 +1334,7 @@ bool LogFileReader::CheckFileSignatureAndOffset(bool isOpenOnUpdate) {
                                                GetLogstore());
 
         mLastFilePos = endSize;
+        mMmapReadDisabled = true;
         // when we use truncate_pos_skip_bytes, if truncate stop and log start to append, logtail will drop less data or
         // collect more data this just work around for ant's demand
         if (INT32_FLAG(truncate_pos_skip_bytes) > 0 && mLastFilePos > (INT32_FLAG(truncate_pos_skip_bytes) + 1024)) {
@@ -1553,17 +1557,24 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
         if (READ_BYTE < lastCacheSize) {
             READ_BYTE = lastCacheSize; // this should not happen, just avoid READ_BYTE >= 0 theoratically
         }
-        StringBuffer stringMemory
-            = logBuffer.sourcebuffer->AllocateStringBuffer(READ_BYTE); // allocate modifiable buffer
-        if (lastCacheSize) {
-            READ_BYTE -= lastCacheSize; // reserve space to copy from cache if needed
-        }
         TruncateInfo* truncateInfo = nullptr;
         int64_t lastReadPos = GetLastReadPos();
-        nbytes = READ_BYTE
-            ? ReadFile(mLogFileOp, stringMemory.data + lastCacheSize, READ_BYTE, lastReadPos, &truncateInfo)
-            : 0UL;
-        stringBuffer = stringMemory.data;
+        // cache is part of the mapped range, so neither read buffer nor copy is needed
+        stringBuffer = MapFile(logBuffer, READ_BYTE);
+        const bool mapped = stringBuffer != nullptr;
+        if (mapped) {
+            nbytes = READ_BYTE - lastCacheSize;
+        } else {
+            StringBuffer stringMemory
+                = logBuffer.sourcebuffer->AllocateStringBuffer(READ_BYTE); // allocate modifiable buffer
+            if (lastCacheSize) {
+                READ_BYTE -= lastCacheSize; // reserve space to copy from cache if needed
+            }
+            nbytes = READ_BYTE
+                ? ReadFile(mLogFileOp, stringMemory.data + lastCacheSize, READ_BYTE, lastReadPos, &truncateInfo)
+                : 0UL;
+            stringBuffer = stringMemory.data;
+        }
         bool allowRollback = true;
         // Only when there is no new log and not try rollback, then force read
         if (!tryRollback && nbytes == 0) {
@@ -1574,7 +1585,9 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
             return;
         }
         if (lastCacheSize) {
-            memcpy(stringBuffer, mCache.data(), lastCacheSize); // copy from cache
+            if (!mapped) {
+                memcpy(stringBuffer, mCache.data(), lastCacheSize); // copy from cache
+            }
             nbytes += lastCacheSize;
         }
         // Ignore \n if last is force read
@@ -1739,9 +1752,12 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
     gbkBuffer[readCharCount] = '\0';
 
     vector<long> lineFeedPos = {-1}; // elements point to the last char of each line
-    for (long idx = 0; idx < long(readCharCount - 1); ++idx) {
-        if (gbkBuffer[idx] == '\n')
-            lineFeedPos.push_back(idx);
+    if (readCharCount > 1) {
+        const char* searchEnd = gbkBuffer + readCharCount - 1;
+        for (const char* p = FindFirstChar(gbkBuffer, searchEnd, '\n'); p != searchEnd;
+             p = FindFirstChar(p + 1, searchEnd, '\n')) {
+            lineFeedPos.push_back(p - gbkBuffer);
+        }
     }
     lineFeedPos.push_back(readCharCount - 1);
 
@@ -1871,6 +1887,41 @@ LogFileReader::ReadFile(LogFileOperator& op, void* buf, size_t size, int64_t& of
     return nbytes;
 }
 
+char* LogFileReader::MapFile(LogBuffer& logBuffer, size_t size) {
+    if (!mReaderConfig.first->mEnableMmapRead || mMmapReadDisabled
+        || size < static_cast<size_t>(INT32_FLAG(mmap_read_min_bytes))) {
+        return nullptr;
+    }
+    // the file may have shrunk since the size was checked, which would make the mapping raise SIGBUS
+    int64_t fileSize = mLogFileOp.GetFileSize();
+    if (fileSize < 0 || fileSize < mLastFilePos + static_cast<int64_t>(size)) {
+        return nullptr;
+    }
+    errno = 0;
+    auto region = MappedFileRegion::Create(mLogFileOp.GetFd(), mLastFilePos, size);
+    if (!region) {
+        if (errno == ENODEV || errno == EACCES || errno == EINVAL) {
+            LOG_INFO(sLogger,
+                     ("mmap is not supported for file, fall back to pread", mHostLogPath)("errno", errno)(
+                         "project", GetProject())("logstore", GetLogstore())("config", GetConfigName()));
+            mMmapReadDisabled = true;
+        }
+        return nullptr;
+    }
+    // content in the cache must be identical to the file, otherwise the file has been overwritten
+    if (!mCache.empty() && memcmp(region->Data(), mCache.data(), mCache.size()) != 0) {
+        LOG_INFO(sLogger,
+                 ("file content changed under cache, fall back to pread", mHostLogPath)("project", GetProject())(
+                     "logstore", GetLogstore())("config", GetConfigName()));
+        mMmapReadDisabled = true;
+        return nullptr;
+    }
+    // events reference the mapping until they are sent, so the file must not be truncated in the meantime
+    char* data = region->Data();
+    logBuffer.sourcebuffer->HoldMappedRegion(std::move(region));
+    return data;
+}
+
 LogFileReader::FileCompareResult LogFileReader::CompareToFile(const string& filePath) {
     LogFileOperator logFileOp;
     logFileOp.Open(filePath.c_str());
@@ -2158,10 +2209,10 @@ LineInfo RawTextParser::GetLastLine(StringView buffer,
         return LineInfo(StringView(), 0, 0, 0, false, 0);
     }
 
-    for (int32_t begin = end; begin > 0; --begin) {
-        if (buffer[begin - 1] == '\n') {
-            return LineInfo(StringView(buffer.data() + begin, end - begin), begin, end, 1, true, 0);
-        }
+    const char* lineFeed = FindLastChar(buffer.data(), buffer.data() + end, '\n');
+    if (lineFeed != nullptr) {
+        int32_t begin = lineFeed - buffer.data() + 1;
+        return LineInfo(StringView(buffer.data() + begin, end - begin), begin, end, 1, true, 0);
     }
     return LineInfo(StringView(buffer.data(), end), 0, end, 1, true, 0);
 }
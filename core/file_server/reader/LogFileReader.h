@@ -461,6 +461,9 @@ protected:
 
     size_t
     ReadFile(LogFileOperator& logFileOp, void* buf, size_t size, int64_t& offset, TruncateInfo** truncateInfo = NULL);
+    // map [mLastFilePos, mLastFilePos + size) into logBuffer's source buffer, nullptr is returned if pread should be
+    // used instead
+    char* MapFile(LogBuffer& logBuffer, size_t size);
     static int32_t ParseTime(const char* buffer, const std::string& timeFormat);
     void SetFilePosBackwardToFixedPos(LogFileOperator& logFileOp);
 
@@ -496,6 +499,9 @@ protected:
     // boost::regex* mLogEndRegPtr;
     // int mReaderFlushTimeout;
     bool mLastForceRead = false;
+    // set once mmap is not applicable to the file, e.g. it has been truncated or the filesystem does not support mmap.
+    // Regions mapped before the truncation is detected are still referenced by events, so this does not prevent SIGBUS.
+    bool mMmapReadDisabled = false;
     // FileEncoding mFileEncoding;
     // bool mDiscardUnmatch;
     // LogType mLogType;
@@ -0,0 +1,123 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "go_pipeline/FlatLogGroupBatch.h"
+
+#include "common/Flags.h"
+#include "common/HashUtil.h"
+#include "common/StringTools.h"
+#include "constants/TagConstants.h"
+#include "models/LogEvent.h"
+
+DECLARE_FLAG_INT32(max_send_log_group_size);
+
+using namespace std;
+
+namespace logtail {
+
+bool FlatLogGroupBatch::Add(const PipelineEventGroup& group,
+                            bool enableNanosecond,
+                            const string& logstore,
+                            const string& packId,
+                            string& errorMsg) {
+    for (const auto& e : group.GetEvents()) {
+        if (!e.Is<LogEvent>()) {
+            errorMsg = "unsupported event type in event group";
+            return false;
+        }
+    }
+
+    size_t groupsSize = mGroups.size(), logsSize = mLogs.size(), pairsSize = mPairs.size(), arenaSize = mArena.size();
+    size_t dataSize = GetDataSize();
+
+    // keep the same pack id as ProcessLogGroup
+    AppendString(ToHexString(HashString(packId)), mGroups);
+    StringView topic;
+    uint32_t tagBegin = static_cast<uint32_t>(mPairs.size() / kPairWords);
+    for (const auto& tag : group.GetTags()) {
+        if (tag.first == LOG_RESERVED_KEY_TOPIC) {
+            topic = tag.second;
+        } else {
+            AppendString(tag.first, mPairs);
+            AppendString(tag.second, mPairs);
+        }
+    }
+    uint32_t tagCnt = static_cast<uint32_t>(mPairs.size() / kPairWords) - tagBegin;
+    AppendString(topic, mGroups);
+    AppendString(logstore, mGroups);
+    mGroups.push_back(tagBegin);
+    mGroups.push_back(tagCnt);
+    mGroups.push_back(static_cast<uint32_t>(mLogs.size() / kLogWords));
+    mGroups.push_back(static_cast<uint32_t>(group.GetEvents().size()));
+
+    for (const auto& e : group.GetEvents()) {
+        const auto& logEvent = e.Cast<LogEvent>();
+        uint32_t contentBegin = static_cast<uint32_t>(mPairs.size() / kPairWords);
+        for (const auto& kv : logEvent) {
+            AppendString(kv.first, mPairs);
+            AppendString(kv.second, mPairs);
+        }
+        mLogs.push_back(static_cast<uint32_t>(logEvent.GetTimestamp()));
+        if (enableNanosecond && logEvent.GetTimestampNanosecond()) {
+            mLogs.push_back(logEvent.GetTimestampNanosecond().value());
+            mLogs.push_back(1);
+        } else {
+            mLogs.push_back(0);
+            mLogs.push_back(0);
+        }
+        mLogs.push_back(contentBegin);
+        mLogs.push_back(static_cast<uint32_t>(mPairs.size() / kPairWords) - contentBegin);
+    }
+
+    size_t size = GetDataSize() - dataSize;
+    if (static_cast<int32_t>(size) > INT32_FLAG(max_send_log_group_size)) {
+        mGroups.resize(groupsSize);
+        mLogs.resize(logsSize);
+        mPairs.resize(pairsSize);
+        mArena.resize(arenaSize);
+        errorMsg = "log group exceeds size limit\tgroup size: " + ToString(size)
+            + "\tsize limit: " + ToString(INT32_FLAG(max_send_log_group_size));
+        return false;
+    }
+    return true;
+}
+
+void FlatLogGroupBatch::Finalize() {
+    mMeta.clear();
+    mMeta.reserve(kHeaderWords + mGroups.size() + mLogs.size() + mPairs.size());
+    mMeta.push_back(kMagic);
+    mMeta.push_back(kVersion);
+    mMeta.push_back(static_cast<uint32_t>(GetGroupCnt()));
+    mMeta.push_back(static_cast<uint32_t>(GetLogCnt()));
+    mMeta.push_back(static_cast<uint32_t>(mPairs.size() / kPairWords));
+    mMeta.insert(mMeta.end(), mGroups.begin(), mGroups.end());
+    mMeta.insert(mMeta.end(), mLogs.begin(), mLogs.end());
+    mMeta.insert(mMeta.end(), mPairs.begin(), mPairs.end());
+}
+
+void FlatLogGroupBatch::Clear() {
+    mGroups.clear();
+    mLogs.clear();
+    mPairs.clear();
+    mArena.clear();
+    mMeta.clear();
+}
+
+void FlatLogGroupBatch::AppendString(StringView s, vector<uint32_t>& table) {
+    table.push_back(static_cast<uint32_t>(mArena.size()));
+    table.push_back(static_cast<uint32_t>(s.size()));
+    mArena.append(s.data(), s.size());
+}
+
+} // namespace logtail
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
+#include "common/StringView.h"
+#include "models/PipelineEventGroup.h"
+
+namespace logtail {
+
+// Log event groups encoded in a flat layout for Go pipelines, which can be read by Go directly without decoding
+// protobuf. Multiple groups can be put in one batch, so that they can be handed over in a single cgo call.
+//
+// A batch consists of two buffers: an arena holding all strings back to back, and a meta buffer of little-endian
+// uint32 words made up of the following tables, where strings are referenced by (offset, length) in the arena:
+//   header: magic, version, group cnt, log cnt, pair cnt
+//   groups: pack id, topic, category (6 words), tag begin, tag cnt, log begin, log cnt
+//   logs:   time, time ns, whether time ns is set, content begin, content cnt
+//   pairs:  key, value (4 words), shared by group tags and log contents
+// "begin" fields are indexes of the first row in the corresponding table.
+class FlatLogGroupBatch {
+public:
+    static constexpr uint32_t kMagic = 0x474C4C46; // "FLLG"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kHeaderWords = 5;
+    static constexpr size_t kGroupWords = 10;
+    static constexpr size_t kLogWords = 5;
+    static constexpr size_t kPairWords = 4;
+
+    // the group is left out of the batch if it cannot be encoded, i.e., it contains non-log events or is too large
+    bool Add(const PipelineEventGroup& group,
+             bool enableNanosecond,
+             const std::string& logstore,
+             const std::string& packId,
+             std::string& errorMsg);
+    // should be called before GetMeta, and no more group should be added afterwards
+    void Finalize();
+    void Clear();
+
+    const std::vector<uint32_t>& GetMeta() const { return mMeta; }
+    const std::string& GetArena() const { return mArena; }
+    size_t GetGroupCnt() const { return mGroups.size() / kGroupWords; }
+    size_t GetLogCnt() const { return mLogs.size() / kLogWords; }
+    size_t GetDataSize() const {
+        return mArena.size() + (kHeaderWords + mGroups.size() + mLogs.size() + mPairs.size()) * sizeof(uint32_t);
+    }
+    bool IsEmpty() const { return mGroups.empty(); }
+
+private:
+    void AppendString(StringView s, std::vector<uint32_t>& table);
+
+    std::vector<uint32_t> mGroups;
+    std::vector<uint32_t> mLogs;
+    std::vector<uint32_t> mPairs;
+    std::string mArena;
+    std::vector<uint32_t> mMeta;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FlatLogGroupBatchUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -56,6 +56,7 @@ LogtailPlugin::LogtailPlugin() {
     mStopFun = NULL;
     mStartFun = NULL;
     mLoadGlobalConfigFun = NULL;
+    mProcessLogGroupsFun = NULL;
     mPluginValid = false;
     mPluginAlarmConfig.mLogstore = "logtail_alarm";
     mPluginAlarmConfig.mAliuid = STRING_FLAG(logtail_profile_aliuid);
@@ -452,6 +453,13 @@ bool LogtailPlugin::LoadPluginBase() {
             LOG_ERROR(sLogger, ("load ProcessLogGroup error, Message", error));
             return mPluginValid;
         }
+        // C++批量传递扁平格式数据到golang插件，旧版本插件不支持
+        mProcessLogGroupsFun = (ProcessLogGroupsFun)loader.LoadMethod("ProcessLogGroups", error);
+        if (!error.empty()) {
+            LOG_INFO(sLogger, ("ProcessLogGroups not supported by go plugin, use ProcessLogGroup instead", error));
+            mProcessLogGroupsFun = NULL;
+            error.clear();
+        }
         // 获取golang部分指标信息
         mGetGoMetricsFun = (GetGoMetricsFun)loader.LoadMethod("GetGoMetrics", error);
         if (!error.empty()) {
@@ -549,6 +557,31 @@ void LogtailPlugin::ProcessLogGroup(const std::string& configName,
 #endif
 }
 
+void LogtailPlugin::ProcessLogGroups(const std::string& configName, const FlatLogGroupBatch& batch) {
+#ifndef APSARA_UNIT_TEST_MAIN
+    if (batch.IsEmpty() || !IsProcessLogGroupsSupported()) {
+        return;
+    }
+    std::string realConfigName = configName + "/2";
+    GoString goConfigName;
+    GoSlice goMeta;
+    GoSlice goArena;
+    goConfigName.n = realConfigName.size();
+    goConfigName.p = realConfigName.c_str();
+    goMeta.len = goMeta.cap = batch.GetMeta().size() * sizeof(uint32_t);
+    goMeta.data = (void*)batch.GetMeta().data();
+    goArena.len = goArena.cap = batch.GetArena().size();
+    goArena.data = (void*)batch.GetArena().data();
+    GoInt rst = mProcessLogGroupsFun(goConfigName, goMeta, goArena);
+    if (rst != (GoInt)0) {
+        LOG_WARNING(sLogger,
+                    ("process log groups error", configName)("result", rst)("group cnt", batch.GetGroupCnt()));
+    }
+#else
+    LogtailPluginMock::GetInstance()->ProcessLogGroups(configName, batch);
+#endif
+}
+
 void LogtailPlugin::GetGoMetrics(std::vector<std::map<std::string, std::string>>& metircsList,
                                  const string& metricType) {
     if (mGetGoMetricsFun != nullptr) {
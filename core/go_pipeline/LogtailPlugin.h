@@ -29,6 +29,7 @@
 
 #include "json/json.h"
 
+#include "go_pipeline/FlatLogGroupBatch.h"
 #include "plugin/flusher/sls/FlusherSLS.h"
 #include "protobuf/sls/sls_logs.pb.h"
 
@@ -143,6 +144,7 @@ typedef GoInt (*InitPluginBaseFun)();
 typedef GoInt (*InitPluginBaseV2Fun)(GoString cfg);
 typedef GoInt (*ProcessLogsFun)(GoString c, GoSlice l, GoString p, GoString t, GoSlice tags);
 typedef GoInt (*ProcessLogGroupFun)(GoString c, GoSlice l, GoString p);
+typedef GoInt (*ProcessLogGroupsFun)(GoString c, GoSlice meta, GoSlice arena);
 typedef struct innerContainerMeta* (*GetContainerMetaFun)(GoString containerID);
 typedef InnerPluginMetrics* (*GetGoMetricsFun)(GoString metricType);
 
@@ -230,6 +232,11 @@ public:
 
     void ProcessLogGroup(const std::string& configName, const std::string& logGroup, const std::string& packId);
 
+    // whether the plugin lib accepts log groups in flat layout, which is not the case for older versions
+    bool IsProcessLogGroupsSupported() const { return mPluginValid && mProcessLogGroupsFun != NULL; }
+    // hand over all groups in the batch in one call, the batch should be finalized
+    void ProcessLogGroups(const std::string& configName, const logtail::FlatLogGroupBatch& batch);
+
     static int IsValidToSend(long long logstoreKey);
 
     static int SendPb(const char* configName,
@@ -274,6 +281,7 @@ private:
     logtail::FlusherSLS mPluginContainerConfig;
     ProcessLogsFun mProcessLogsFun;
     ProcessLogGroupFun mProcessLogGroupFun;
+    ProcessLogGroupsFun mProcessLogGroupsFun;
     GetContainerMetaFun mGetContainerMetaFun;
     GetGoMetricsFun mGetGoMetricsFun;
 
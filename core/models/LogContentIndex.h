@@ -0,0 +1,189 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <functional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common/StringView.h"
+
+namespace logtail {
+
+using LogContent = std::pair<StringView, StringView>;
+using ContentsContainer = std::vector<std::pair<LogContent, bool>>;
+
+// Key -> position index over LogEvent::mContents.
+//
+// Most events carry only a handful of fields, for which a linear scan over a contiguous array of positions is faster
+// than any tree or hash lookup. Once the number of indexed keys exceeds kLinearScanThreshold, the same storage is
+// rebuilt into an open-addressing hash table (linear probing, backward-shift deletion), so no per-key node is ever
+// allocated. Only positions are stored here; keys are always read back from the contents container, which must be
+// passed in by the caller.
+class LogContentIndex {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    static constexpr size_t kLinearScanThreshold = 16;
+
+    size_t Find(StringView key, const ContentsContainer& contents) const {
+        if (!mHashed) {
+            for (auto pos : mSlots) {
+                if (contents[pos].first.first == key) {
+                    return pos;
+                }
+            }
+            return npos;
+        }
+        size_t mask = mSlots.size() - 1;
+        for (size_t i = Hash(key) & mask; mSlots[i] != kEmptySlot; i = (i + 1) & mask) {
+            if (contents[mSlots[i]].first.first == key) {
+                return mSlots[i];
+            }
+        }
+        return npos;
+    }
+
+    // Returns the position already associated with key if any, otherwise associates key with pos and returns pos.
+    // The second element tells whether a new association has been made.
+    std::pair<size_t, bool> Insert(StringView key, size_t pos, const ContentsContainer& contents) {
+        if (!mHashed) {
+            for (auto p : mSlots) {
+                if (contents[p].first.first == key) {
+                    return {p, false};
+                }
+            }
+            if (mSlots.size() < kLinearScanThreshold) {
+                mSlots.push_back(static_cast<uint32_t>(pos));
+                ++mSize;
+                return {pos, true};
+            }
+            Rehash(kLinearScanThreshold * 4, contents);
+        } else if ((mSize + 1) * 2 > mSlots.size()) {
+            Rehash(mSlots.size() * 2, contents);
+        }
+        size_t mask = mSlots.size() - 1;
+        size_t i = Hash(key) & mask;
+        for (; mSlots[i] != kEmptySlot; i = (i + 1) & mask) {
+            if (contents[mSlots[i]].first.first == key) {
+                return {mSlots[i], false};
+            }
+        }
+        mSlots[i] = static_cast<uint32_t>(pos);
+        ++mSize;
+        return {pos, true};
+    }
+
+    // Associates key with pos, overriding any existing association.
+    void Assign(StringView key, size_t pos, const ContentsContainer& contents) {
+        auto rst = Insert(key, pos, contents);
+        if (!rst.second) {
+            Replace(rst.first, pos);
+        }
+    }
+
+    // Returns the position previously associated with key, or npos if key is not indexed.
+    size_t Erase(StringView key, const ContentsContainer& contents) {
+        if (!mHashed) {
+            for (auto it = mSlots.begin(); it != mSlots.end(); ++it) {
+                if (contents[*it].first.first == key) {
+                    size_t pos = *it;
+                    mSlots.erase(it);
+                    --mSize;
+                    return pos;
+                }
+            }
+            return npos;
+        }
+        size_t mask = mSlots.size() - 1;
+        size_t i = Hash(key) & mask;
+        for (; mSlots[i] != kEmptySlot; i = (i + 1) & mask) {
+            if (contents[mSlots[i]].first.first == key) {
+                break;
+            }
+        }
+        if (mSlots[i] == kEmptySlot) {
+            return npos;
+        }
+        size_t pos = mSlots[i];
+        // backward-shift deletion keeps probe sequences intact without tombstones
+        size_t hole = i;
+        for (size_t j = (i + 1) & mask; mSlots[j] != kEmptySlot; j = (j + 1) & mask) {
+            size_t home = Hash(contents[mSlots[j]].first.first) & mask;
+            if (((j - home) & mask) >= ((j - hole) & mask)) {
+                mSlots[hole] = mSlots[j];
+                hole = j;
+            }
+        }
+        mSlots[hole] = kEmptySlot;
+        --mSize;
+        return pos;
+    }
+
+    // capacity is retained so that pooled events do not reallocate on reuse
+    void Clear() {
+        mSlots.clear();
+        mHashed = false;
+        mSize = 0;
+    }
+
+    bool Empty() const { return mSize == 0; }
+    size_t Size() const { return mSize; }
+
+private:
+    static constexpr uint32_t kEmptySlot = static_cast<uint32_t>(-1);
+
+    static size_t Hash(StringView key) {
+        return std::hash<std::string_view>()(std::string_view(key.data(), key.size()));
+    }
+
+    void Replace(size_t oldPos, size_t newPos) {
+        for (auto& slot : mSlots) {
+            if (slot == oldPos) {
+                slot = static_cast<uint32_t>(newPos);
+                return;
+            }
+        }
+    }
+
+    void Rehash(size_t capacity, const ContentsContainer& contents) {
+        std::vector<uint32_t> old;
+        old.swap(mSlots);
+        mSlots.assign(capacity, kEmptySlot);
+        mHashed = true;
+        size_t mask = capacity - 1;
+        for (auto pos : old) {
+            if (pos == kEmptySlot) {
+                continue;
+            }
+            size_t i = Hash(contents[pos].first.first) & mask;
+            while (mSlots[i] != kEmptySlot) {
+                i = (i + 1) & mask;
+            }
+            mSlots[i] = pos;
+        }
+    }
+
+    // in linear mode: dense array of positions; in hashed mode: power-of-two sized open-addressing table
+    std::vector<uint32_t> mSlots;
+    size_t mSize = 0;
+    bool mHashed = false;
+};
+
+} // namespace logtail
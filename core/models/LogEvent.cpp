@@ -30,22 +30,22 @@ unique_ptr<PipelineEvent> LogEvent::Copy() const {
 void LogEvent::Reset() {
     PipelineEvent::Reset();
     mContents.clear();
-    mIndex.clear();
+    mIndex.Clear();
     mAllocatedContentSize = 0;
     mFileOffset = 0;
     mRawSize = 0;
 }
 
 StringView LogEvent::GetContent(StringView key) const {
-    auto it = mIndex.find(key);
-    if (it != mIndex.end()) {
-        return mContents[it->second].first.second;
+    auto pos = mIndex.Find(key, mContents);
+    if (pos != LogContentIndex::npos) {
+        return mContents[pos].first.second;
     }
     return gEmptyStringView;
 }
 
 bool LogEvent::HasContent(StringView key) const {
-    return mIndex.find(key) != mIndex.end();
+    return mIndex.Find(key, mContents) != LogContentIndex::npos;
 }
 
 void LogEvent::SetContent(StringView key, StringView val) {
@@ -65,10 +65,9 @@ void LogEvent::SetContentNoCopy(const StringBuffer& key, const StringBuffer& val
 }
 
 void LogEvent::SetContentNoCopy(StringView key, StringView val) {
-    auto rst = mIndex.insert(make_pair(key, mContents.size()));
+    auto rst = mIndex.Insert(key, mContents.size(), mContents);
     if (!rst.second) {
-        auto& it = rst.first;
-        auto& field = mContents[it->second].first;
+        auto& field = mContents[rst.first].first;
         mAllocatedContentSize += key.size() + val.size() - field.first.size() - field.second.size();
         field = make_pair(key, val);
     } else {
@@ -78,12 +77,11 @@ void LogEvent::SetContentNoCopy(StringView key, StringView val) {
 }
 
 void LogEvent::DelContent(StringView key) {
-    auto it = mIndex.find(key);
-    if (it != mIndex.end()) {
-        auto& field = mContents[it->second].first;
+    auto pos = mIndex.Erase(key, mContents);
+    if (pos != LogContentIndex::npos) {
+        auto& field = mContents[pos].first;
         mAllocatedContentSize -= field.first.size() + field.second.size();
-        mContents[it->second].second = false;
-        mIndex.erase(it);
+        mContents[pos].second = false;
     }
 }
 
@@ -93,17 +91,17 @@ void LogEvent::SetLevel(const std::string& level) {
 }
 
 LogEvent::ContentIterator LogEvent::FindContent(StringView key) {
-    auto it = mIndex.find(key);
-    if (it != mIndex.end()) {
-        return ContentIterator(mContents.begin() + it->second, mContents);
+    auto pos = mIndex.Find(key, mContents);
+    if (pos != LogContentIndex::npos) {
+        return ContentIterator(mContents.begin() + pos, mContents);
     }
     return ContentIterator(mContents.end(), mContents);
 }
 
 LogEvent::ConstContentIterator LogEvent::FindContent(StringView key) const {
-    auto it = mIndex.find(key);
-    if (it != mIndex.end()) {
-        return ConstContentIterator(mContents.begin() + it->second, mContents);
+    auto pos = mIndex.Find(key, mContents);
+    if (pos != LogContentIndex::npos) {
+        return ConstContentIterator(mContents.begin() + pos, mContents);
     }
     return ConstContentIterator(mContents.end(), mContents);
 }
@@ -144,7 +142,7 @@ LogEvent::ConstContentIterator LogEvent::cend() const {
 void LogEvent::AppendContentNoCopy(StringView key, StringView val) {
     mAllocatedContentSize += key.size() + val.size();
     mContents.emplace_back(make_pair(key, val), true);
-    mIndex[key] = mContents.size() - 1;
+    mIndex.Assign(key, mContents.size() - 1, mContents);
 }
 
 size_t LogEvent::DataSize() const {
@@ -16,13 +16,11 @@
 
 #pragma once
 
+#include "models/LogContentIndex.h"
 #include "models/PipelineEvent.h"
 
 namespace logtail {
 
-using LogContent = std::pair<StringView, StringView>;
-using ContentsContainer = std::vector<std::pair<LogContent, bool>>;
-
 template <class T, class F>
 class BaseContentIterator {
     friend class LogEvent;
@@ -92,8 +90,8 @@ public:
     StringView GetLevel() const { return mLevel; }
     void SetLevel(const std::string& level);
 
-    bool Empty() const { return mIndex.empty(); }
-    size_t Size() const { return mIndex.size(); }
+    bool Empty() const { return mIndex.Empty(); }
+    size_t Size() const { return mIndex.Size(); }
 
     ContentIterator begin();
     ContentIterator end();
@@ -121,7 +119,7 @@ private:
     // information for backward compatability.
     ContentsContainer mContents;
     size_t mAllocatedContentSize = 0;
-    std::map<StringView, size_t> mIndex;
+    LogContentIndex mIndex;
     uint64_t mFileOffset = 0;
     uint64_t mRawSize = 0;
     StringView mLevel;
@@ -16,6 +16,8 @@
 
 #include "models/PipelineEventGroup.h"
 
+#include <string_view>
+#include <utility>
 #ifdef APSARA_UNIT_TEST_MAIN
 #include <sstream>
 #endif
@@ -40,9 +42,15 @@ void DestroyEvents(vector<PipelineEventPtr>&& events) {
     bool firstEvent = true;
     for (auto& item : events) {
         if (item && item.IsFromEventPool()) {
-            item->Reset();
-            if (firstEvent || item.GetEventPool() != cachedPoolPtr) {
-                cachedPoolPtr = item.GetEventPool();
+            EventPool* pool = item.GetEventPool();
+            // events still shared with other groups are returned to the pool by the last owner
+            auto* e = item.Release();
+            if (e == nullptr) {
+                continue;
+            }
+            e->Reset();
+            if (firstEvent || pool != cachedPoolPtr) {
+                cachedPoolPtr = pool;
                 cachedIt = eventsPoolMap.find(cachedPoolPtr);
                 if (cachedIt == eventsPoolMap.end()) {
                     eventsPoolMap.emplace(cachedPoolPtr, vector<T*>());
@@ -51,7 +59,7 @@ void DestroyEvents(vector<PipelineEventPtr>&& events) {
                 }
                 firstEvent = false;
             }
-            cachedIt->second.emplace_back(static_cast<T*>(item.Release()));
+            cachedIt->second.emplace_back(static_cast<T*>(e));
         }
     }
     for (auto& item : eventsPoolMap) {
@@ -67,17 +75,19 @@ PipelineEventGroup::PipelineEventGroup(PipelineEventGroup&& rhs) noexcept
     : mMetadata(std::move(rhs.mMetadata)),
       mTags(std::move(rhs.mTags)),
       mEvents(std::move(rhs.mEvents)),
-      mSourceBuffer(std::move(rhs.mSourceBuffer)) {
-    for (auto& item : mEvents) {
-        item->ResetPipelineEventGroup(this);
-    }
+      mSourceBuffer(std::move(rhs.mSourceBuffer)),
+      mSharedOrigin(std::move(rhs.mSharedOrigin)),
+      mTagsHash(rhs.mTagsHash),
+      mTagsHashValid(rhs.mTagsHashValid) {
+    rhs.mTagsHashValid = false;
+    ResetEventsGroup();
 }
 
 PipelineEventGroup::~PipelineEventGroup() {
     if (mEvents.empty() || !mEvents[0]) {
         return;
     }
-    switch (mEvents[0]->GetType()) {
+    switch (as_const(mEvents[0])->GetType()) {
         case PipelineEvent::Type::LOG:
             DestroyEvents<LogEvent>(std::move(mEvents));
             break;
@@ -101,9 +111,11 @@ PipelineEventGroup& PipelineEventGroup::operator=(PipelineEventGroup&& rhs) noex
         mTags = std::move(rhs.mTags);
         mEvents = std::move(rhs.mEvents);
         mSourceBuffer = std::move(rhs.mSourceBuffer);
-        for (auto& item : mEvents) {
-            item->ResetPipelineEventGroup(this);
-        }
+        mSharedOrigin = std::move(rhs.mSharedOrigin);
+        mTagsHash = rhs.mTagsHash;
+        mTagsHashValid = rhs.mTagsHashValid;
+        rhs.mTagsHashValid = false;
+        ResetEventsGroup();
     }
     return *this;
 }
@@ -113,6 +125,8 @@ PipelineEventGroup PipelineEventGroup::Copy() const {
     res.mMetadata = mMetadata;
     res.mTags = mTags;
     res.mExactlyOnceCheckpoint = mExactlyOnceCheckpoint;
+    res.mTagsHash = mTagsHash;
+    res.mTagsHashValid = mTagsHashValid;
     for (auto& event : mEvents) {
         res.mEvents.emplace_back(event.Copy());
         res.mEvents.back()->ResetPipelineEventGroup(&res);
@@ -120,6 +134,44 @@ PipelineEventGroup PipelineEventGroup::Copy() const {
     return res;
 }
 
+vector<PipelineEventGroup> PipelineEventGroup::Share(PipelineEventGroup&& g, size_t n) {
+    vector<PipelineEventGroup> res;
+    res.reserve(n);
+    if (n == 1) {
+        res.emplace_back(std::move(g));
+        return res;
+    }
+    if (n == 0) {
+        return res;
+    }
+    // the shared events keep pointing to the origin, which is not moved any more and lives as long as any of the
+    // groups, so that the source buffer can always be reached from the events
+    auto origin = make_shared<PipelineEventGroup>(std::move(g));
+    for (size_t i = 0; i < n; ++i) {
+        auto& group = res.emplace_back(origin->mSourceBuffer);
+        group.mMetadata = origin->mMetadata;
+        group.mTags = origin->mTags;
+        group.mExactlyOnceCheckpoint = origin->mExactlyOnceCheckpoint;
+        group.mTagsHash = origin->mTagsHash;
+        group.mTagsHashValid = origin->mTagsHashValid;
+        group.mEvents.reserve(origin->mEvents.size());
+        for (const auto& event : origin->mEvents) {
+            group.mEvents.emplace_back(event.Share());
+        }
+        group.mSharedOrigin = origin;
+    }
+    return res;
+}
+
+void PipelineEventGroup::ResetEventsGroup() {
+    for (auto& item : mEvents) {
+        // shared events point to the origin group
+        if (item && !item.IsShared()) {
+            item->ResetPipelineEventGroup(this);
+        }
+    }
+}
+
 unique_ptr<LogEvent> PipelineEventGroup::CreateLogEvent(bool fromPool, EventPool* pool) {
     LogEvent* e = nullptr;
     if (fromPool) {
@@ -249,22 +301,27 @@ void PipelineEventGroup::SetMetadataNoCopy(EventGroupMetaKey key, const StringBu
 }
 
 bool PipelineEventGroup::HasMetadata(EventGroupMetaKey key) const {
-    return mMetadata.find(key) != mMetadata.end();
+    return mMetadata.Has(key);
 }
 void PipelineEventGroup::SetMetadataNoCopy(EventGroupMetaKey key, StringView val) {
-    mMetadata[key] = val;
+    mMetadata.Set(key, val);
+    if (key == EventGroupMetaKey::SOURCE_ID) {
+        mTagsHashValid = false;
+    }
 }
 
 StringView PipelineEventGroup::GetMetadata(EventGroupMetaKey key) const {
-    auto it = mMetadata.find(key);
-    if (it != mMetadata.end()) {
-        return it->second;
+    if (mMetadata.Has(key)) {
+        return mMetadata.Get(key);
     }
     return gEmptyStringView;
 }
 
 void PipelineEventGroup::DelMetadata(EventGroupMetaKey key) {
-    mMetadata.erase(key);
+    mMetadata.Erase(key);
+    if (key == EventGroupMetaKey::SOURCE_ID) {
+        mTagsHashValid = false;
+    }
 }
 
 void PipelineEventGroup::SetTag(StringView key, StringView val) {
@@ -289,6 +346,7 @@ bool PipelineEventGroup::HasTag(StringView key) const {
 
 void PipelineEventGroup::SetTagNoCopy(StringView key, StringView val) {
     mTags.Insert(key, val);
+    mTagsHashValid = false;
 }
 
 StringView PipelineEventGroup::GetTag(StringView key) const {
@@ -301,15 +359,23 @@ StringView PipelineEventGroup::GetTag(StringView key) const {
 
 void PipelineEventGroup::DelTag(StringView key) {
     mTags.Erase(key);
+    mTagsHashValid = false;
 }
 
 size_t PipelineEventGroup::GetTagsHash() const {
+    if (mTagsHashValid) {
+        return mTagsHash;
+    }
+    // hash<string_view> yields the same value as hash<string> for the same content, so no copy is needed
+    auto hashView = [](StringView s) { return hash<string_view>{}(string_view(s.data(), s.size())); };
     size_t seed = 0;
     for (const auto& item : mTags.mInner) {
-        HashCombine(seed, hash<string>{}(item.first.to_string()));
-        HashCombine(seed, hash<string>{}(item.second.to_string()));
+        HashCombine(seed, hashView(item.first));
+        HashCombine(seed, hashView(item.second));
     }
-    HashCombine(seed, hash<string>{}(GetMetadata(EventGroupMetaKey::SOURCE_ID).to_string()));
+    HashCombine(seed, hashView(GetMetadata(EventGroupMetaKey::SOURCE_ID)));
+    mTagsHash = seed;
+    mTagsHashValid = true;
     return seed;
 }
 
@@ -388,10 +454,13 @@ EventGroupMetaKey StringToEventGroupMetaKey(const string& key) {
 
 Json::Value PipelineEventGroup::ToJson(bool enableEventMeta) const {
     Json::Value root;
-    if (!mMetadata.empty()) {
+    if (!mMetadata.Empty()) {
         Json::Value metadata;
-        for (const auto& meta : mMetadata) {
-            metadata[EventGroupMetaKeyToString(meta.first)] = EventGroupMetaValueToString(meta.second.to_string());
+        for (size_t i = 0; i < kEventGroupMetaKeyCount; ++i) {
+            auto key = static_cast<EventGroupMetaKey>(i);
+            if (mMetadata.Has(key)) {
+                metadata[EventGroupMetaKeyToString(key)] = EventGroupMetaValueToString(mMetadata.Get(key).to_string());
+            }
         }
         root["metadata"] = metadata;
     }
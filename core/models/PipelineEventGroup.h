@@ -16,13 +16,17 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "checkpoint/RangeCheckpoint.h"
 #include "common/memory/SourceBuffer.h"
 #include "constants/Constants.h"
 #include "models/PipelineEventPtr.h"
+#include "models/SizedContainer.h"
 
 namespace logtail {
 class EventPool;
@@ -63,11 +67,42 @@ enum class EventGroupMetaKey {
     INTERNAL_DATA_TARGET_REGION,
     INTERNAL_DATA_TYPE,
 
-    SOURCE_ID
+    SOURCE_ID // must be the last one, see kEventGroupMetaKeyCount
 };
 
-using GroupMetadata = std::map<EventGroupMetaKey, StringView>;
-using GroupTags = std::map<StringView, StringView>;
+constexpr size_t kEventGroupMetaKeyCount = static_cast<size_t>(EventGroupMetaKey::SOURCE_ID) + 1;
+
+// Metadata keys form a small closed set, so values are stored in a fixed array indexed by key instead of a tree.
+class GroupMetadata {
+public:
+    bool Has(EventGroupMetaKey key) const { return (mMask & Bit(key)) != 0; }
+    StringView Get(EventGroupMetaKey key) const { return Has(key) ? mValues[Index(key)] : StringView(); }
+    void Set(EventGroupMetaKey key, StringView val) {
+        mValues[Index(key)] = val;
+        mMask |= Bit(key);
+    }
+    void Erase(EventGroupMetaKey key) {
+        mValues[Index(key)] = StringView();
+        mMask &= ~Bit(key);
+    }
+    bool Empty() const { return mMask == 0; }
+    size_t Size() const { return __builtin_popcount(mMask); }
+    void Clear() {
+        mValues.fill(StringView());
+        mMask = 0;
+    }
+
+private:
+    static_assert(kEventGroupMetaKeyCount <= 32, "metadata presence mask is too narrow");
+
+    static size_t Index(EventGroupMetaKey key) { return static_cast<size_t>(key); }
+    static uint32_t Bit(EventGroupMetaKey key) { return 1U << Index(key); }
+
+    std::array<StringView, kEventGroupMetaKeyCount> mValues;
+    uint32_t mMask = 0;
+};
+
+using GroupTags = FlatTagMap;
 
 // DeepCopy is required if we want to support no-linear topology
 // We cannot just use default copy constructor as it won't deep copy PipelineEvent pointed in Events vector.
@@ -82,6 +117,9 @@ public:
     PipelineEventGroup& operator=(PipelineEventGroup&&) noexcept;
 
     PipelineEventGroup Copy() const;
+    // Returns n groups sharing the events of g instead of copying them. Each group has its own tags and metadata, while
+    // an event is copied only when it is modified through one of the groups, see PipelineEventPtr.
+    static std::vector<PipelineEventGroup> Share(PipelineEventGroup&& g, size_t n);
 
     std::unique_ptr<LogEvent> CreateLogEvent(bool fromPool = false, EventPool* pool = nullptr);
     std::unique_ptr<MetricEvent> CreateMetricEvent(bool fromPool = false, EventPool* pool = nullptr);
@@ -107,7 +145,10 @@ public:
     bool HasMetadata(EventGroupMetaKey key) const;
     void SetMetadataNoCopy(EventGroupMetaKey key, StringView val);
     void DelMetadata(EventGroupMetaKey key);
-    void SetAllMetadata(const GroupMetadata& other) { mMetadata = other; }
+    void SetAllMetadata(const GroupMetadata& other) {
+        mMetadata = other;
+        mTagsHashValid = false;
+    }
 
     void SetTag(StringView key, StringView val);
     void SetTag(const std::string& key, const std::string& val);
@@ -115,11 +156,16 @@ public:
     void SetTagNoCopy(const StringBuffer& key, const StringBuffer& val);
     StringView GetTag(StringView key) const;
     const GroupTags& GetTags() const { return mTags.mInner; };
-    SizedMap& GetSizedTags() { return mTags; };
+    // the caller may modify the tags through the returned reference, so the cached tags hash is dropped
+    SizedFlatTagMap& GetSizedTags() {
+        mTagsHashValid = false;
+        return mTags;
+    };
     bool HasTag(StringView key) const;
     void SetTagNoCopy(StringView key, StringView val);
     void DelTag(StringView key);
 
+    // hash of all tags and the source id, cached until either of them changes
     size_t GetTagsHash() const;
 
     void SetExactlyOnceCheckpoint(const RangeCheckpointPtr& checkpoint) { mExactlyOnceCheckpoint = checkpoint; }
@@ -137,11 +183,17 @@ public:
 #endif
 
 private:
+    void ResetEventsGroup();
+
     GroupMetadata mMetadata; // Used to generate tag/log. Will not output.
-    SizedMap mTags; // custom tags to output
+    SizedFlatTagMap mTags; // custom tags to output
     EventsContainer mEvents;
     std::shared_ptr<SourceBuffer> mSourceBuffer;
     RangeCheckpointPtr mExactlyOnceCheckpoint;
+    // holder of the events shared with other groups, see Share
+    std::shared_ptr<const PipelineEventGroup> mSharedOrigin;
+    mutable size_t mTagsHash = 0;
+    mutable bool mTagsHashValid = false;
 };
 
 } // namespace logtail
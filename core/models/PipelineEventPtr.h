@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <typeinfo>
 
@@ -29,13 +30,35 @@ namespace logtail {
 class EventPool;
 
 // only movable
+//
+// An event may be shared by several pointers (see Share), e.g., when a group is routed to multiple flushers. A shared
+// event is immutable: non-const access through any of the pointers first replaces the event with a private copy, so
+// only the events actually modified are copied. Read-only users should access shared events through const pointers.
 class PipelineEventPtr {
 public:
     PipelineEventPtr() = default;
     PipelineEventPtr(PipelineEvent* ptr, bool fromPool, EventPool* pool)
-        : mData(std::unique_ptr<PipelineEvent>(ptr)), mFromEventPool(fromPool), mEventPool(pool) {}
+        : mData(ptr), mFromEventPool(fromPool), mEventPool(pool) {}
     PipelineEventPtr(std::unique_ptr<PipelineEvent>&& ptr, bool fromPool, EventPool* pool)
-        : mData(std::move(ptr)), mFromEventPool(fromPool), mEventPool(pool) {}
+        : mData(ptr.release()), mFromEventPool(fromPool), mEventPool(pool) {}
+    ~PipelineEventPtr() { Unref(); }
+    PipelineEventPtr(PipelineEventPtr&& rhs) noexcept
+        : mData(rhs.mData), mRefs(rhs.mRefs), mFromEventPool(rhs.mFromEventPool), mEventPool(rhs.mEventPool) {
+        rhs.mData = nullptr;
+        rhs.mRefs = nullptr;
+    }
+    PipelineEventPtr& operator=(PipelineEventPtr&& rhs) noexcept {
+        if (this != &rhs) {
+            Unref();
+            mData = rhs.mData;
+            mRefs = rhs.mRefs;
+            mFromEventPool = rhs.mFromEventPool;
+            mEventPool = rhs.mEventPool;
+            rhs.mData = nullptr;
+            rhs.mRefs = nullptr;
+        }
+        return *this;
+    }
 
     template <typename T>
     bool Is() const {
@@ -55,32 +78,92 @@ public:
     }
     template <typename T>
     T& Cast() {
-        return *static_cast<T*>(mData.get());
+        Detach();
+        return *static_cast<T*>(mData);
     }
     template <typename T>
     const T& Cast() const {
-        return *static_cast<const T*>(mData.get());
+        return *static_cast<const T*>(mData);
     }
     template <typename T>
     T* Get() {
-        return Is<T>() ? static_cast<T*>(mData.get()) : nullptr;
+        if (!Is<T>()) {
+            return nullptr;
+        }
+        Detach();
+        return static_cast<T*>(mData);
     }
     template <typename T>
     const T* Get() const {
-        return Is<T>() ? static_cast<const T*>(mData.get()) : nullptr;
+        return Is<T>() ? static_cast<const T*>(mData) : nullptr;
+    }
+    // Returns the event if this is its last pointer, and the caller takes the ownership. Otherwise, the pointer only
+    // drops its reference and nullptr is returned.
+    PipelineEvent* Release() {
+        PipelineEvent* res = mData;
+        if (mRefs != nullptr) {
+            if (mRefs->fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                res = nullptr;
+            } else {
+                delete mRefs;
+            }
+            mRefs = nullptr;
+        }
+        mData = nullptr;
+        return res;
     }
-    PipelineEvent* Release() { return mData.release(); }
 
-    operator bool() const { return static_cast<bool>(mData); }
-    PipelineEvent* operator->() { return mData.operator->(); }
-    const PipelineEvent* operator->() const { return mData.operator->(); }
+    operator bool() const { return mData != nullptr; }
+    PipelineEvent* operator->() {
+        Detach();
+        return mData;
+    }
+    const PipelineEvent* operator->() const { return mData; }
 
     PipelineEventPtr Copy() const { return PipelineEventPtr(mData->Copy(), mFromEventPool, mEventPool); }
+    // Returns another pointer to the same event. Sharing must be done before the pointers are handed to other threads.
+    PipelineEventPtr Share() const {
+        if (mRefs == nullptr) {
+            mRefs = new std::atomic<uint32_t>(1);
+        }
+        mRefs->fetch_add(1, std::memory_order_relaxed);
+        PipelineEventPtr res(mData, mFromEventPool, mEventPool);
+        res.mRefs = mRefs;
+        return res;
+    }
+    bool IsShared() const { return mRefs != nullptr && mRefs->load(std::memory_order_acquire) > 1; }
     bool IsFromEventPool() const { return mFromEventPool; }
     EventPool* GetEventPool() const { return mEventPool; }
 
 private:
-    std::unique_ptr<PipelineEvent> mData;
+    // replace a shared event with a private copy
+    void Detach() {
+        if (mRefs == nullptr) {
+            return;
+        }
+        if (mRefs->load(std::memory_order_acquire) > 1) {
+            auto copy = mData->Copy();
+            if (mRefs->fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                // the copy is not from the pool, whatever the shared event is
+                mData = copy.release();
+                mFromEventPool = false;
+                mEventPool = nullptr;
+                mRefs = nullptr;
+                return;
+            }
+            // other pointers are released in the meantime, so the event is private now
+        }
+        delete mRefs;
+        mRefs = nullptr;
+    }
+
+    void Unref() {
+        PipelineEvent* data = Release();
+        delete data;
+    }
+
+    PipelineEvent* mData = nullptr;
+    mutable std::atomic<uint32_t>* mRefs = nullptr;
     bool mFromEventPool = false;
     EventPool* mEventPool = nullptr; // null means using processor runner threaded pool
 };
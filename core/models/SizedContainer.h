@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
+#include <utility>
 #include <vector>
 
 #include "common/StringView.h"
@@ -59,6 +61,96 @@ private:
     size_t mAllocatedSize = 0;
 };
 
+// Map-like container backed by a flat vector sorted by key.
+// Event groups carry only a handful of tags, for which binary search over contiguous memory is cheaper than a tree,
+// and the whole container costs a single allocation instead of one node per tag.
+class FlatTagMap {
+public:
+    using value_type = std::pair<StringView, StringView>;
+    using iterator = std::vector<value_type>::iterator;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    iterator begin() { return mData.begin(); }
+    iterator end() { return mData.end(); }
+    const_iterator begin() const { return mData.begin(); }
+    const_iterator end() const { return mData.end(); }
+
+    size_t size() const { return mData.size(); }
+    bool empty() const { return mData.empty(); }
+    void clear() { mData.clear(); }
+    void reserve(size_t size) { mData.reserve(size); }
+
+    iterator find(StringView key) {
+        auto it = LowerBound(key);
+        return it != mData.end() && it->first == key ? it : mData.end();
+    }
+    const_iterator find(StringView key) const { return const_cast<FlatTagMap*>(this)->find(key); }
+    size_t count(StringView key) const { return find(key) != end() ? 1 : 0; }
+
+    StringView& operator[](StringView key) {
+        auto it = LowerBound(key);
+        if (it == mData.end() || it->first != key) {
+            it = mData.emplace(it, key, StringView());
+        }
+        return it->second;
+    }
+
+    iterator erase(const_iterator it) { return mData.erase(it); }
+    size_t erase(StringView key) {
+        auto it = find(key);
+        if (it == mData.end()) {
+            return 0;
+        }
+        mData.erase(it);
+        return 1;
+    }
+
+    bool operator==(const FlatTagMap& rhs) const { return mData == rhs.mData; }
+    bool operator!=(const FlatTagMap& rhs) const { return !(*this == rhs); }
+
+private:
+    iterator LowerBound(StringView key) {
+        return std::lower_bound(
+            mData.begin(), mData.end(), key, [](const value_type& item, StringView k) { return item.first < k; });
+    }
+
+    std::vector<value_type> mData;
+};
+
+class SizedFlatTagMap {
+public:
+    void Insert(StringView key, StringView val) {
+        auto iter = mInner.find(key);
+        if (iter != mInner.end()) {
+            mAllocatedSize += val.size() - iter->second.size();
+            iter->second = val;
+        } else {
+            mAllocatedSize += key.size() + val.size();
+            mInner[key] = val;
+        }
+    }
+
+    void Erase(StringView key) {
+        auto iter = mInner.find(key);
+        if (iter != mInner.end()) {
+            mAllocatedSize -= iter->first.size() + iter->second.size();
+            mInner.erase(iter);
+        }
+    }
+
+    size_t DataSize() const { return sizeof(decltype(mInner)) + mAllocatedSize; }
+
+    void Clear() {
+        mInner.clear();
+        mAllocatedSize = 0;
+    }
+
+    FlatTagMap mInner;
+
+private:
+    size_t mAllocatedSize = 0;
+};
+
 class SizedVectorTags {
     friend class ProcessorPromRelabelMetricNative;
 
@@ -34,6 +34,7 @@
 #include "common/RuntimeUtil.h"
 #include "common/StringTools.h"
 #include "common/TimeUtil.h"
+#include "common/memory/MemoryAccountant.h"
 #include "common/version.h"
 #include "constants/Constants.h"
 #include "file_server/event_handler/LogInput.h"
@@ -53,6 +54,9 @@ using namespace std;
 using namespace sls_logs;
 
 DEFINE_FLAG_BOOL(logtail_dump_monitor_info, "enable to dump Logtail monitor info (CPU, mem)", false);
+DEFINE_FLAG_BOOL(enable_memory_backpressure,
+                 "throttle inputs instead of restarting when the memory usage exceeds the soft limit",
+                 true);
 DECLARE_FLAG_BOOL(check_profile_region);
 
 namespace logtail {
@@ -182,6 +186,13 @@ void LogtailMonitor::Monitor() {
                 LoongCollectorMonitor::GetInstance()->SetAgentMemory(mMemStat.mRss);
                 CalCpuStat(curCpuStat, mCpuStat);
                 LoongCollectorMonitor::GetInstance()->SetAgentCpu(mCpuStat.mCpuUsage);
+                // the memory limit and rss are in MB
+                auto level = MemoryAccountant::GetInstance()->UpdatePressureLevel(
+                    static_cast<int64_t>(AppConfig::GetInstance()->GetMemUsageUpLimit()) * 1024 * 1024,
+                    mMemStat.mRss * 1024 * 1024);
+                LoongCollectorMonitor::GetInstance()->SetAgentAccountedMemory(
+                    MemoryAccountant::GetInstance()->GetTotalUsage());
+                LoongCollectorMonitor::GetInstance()->SetAgentMemoryPressureLevel(static_cast<uint64_t>(level));
                 if (CheckHardMemLimit()) {
                     LOG_ERROR(sLogger,
                               ("Resource used by program exceeds hard limit",
@@ -208,13 +219,22 @@ void LogtailMonitor::Monitor() {
                 // Returning true means too much violations, so we have to prepare to restart
                 // logtail to release resource.
                 // Mainly for controlling memory because we have no idea to descrease memory usage.
-                if (CheckSoftCpuLimit() || CheckSoftMemLimit()) {
+                // With memory backpressure, inputs are throttled by the memory accountant instead, unless throttling
+                // cannot release enough memory any more.
+                bool memExceeded = CheckSoftMemLimit();
+                if (CheckSoftCpuLimit() || (memExceeded && !IsMemRelievableByBackpressure())) {
                     LOG_ERROR(sLogger,
                               ("Resource used by program exceeds upper limit for some time",
                                "prepare restart Logtail")("cpu_usage", mCpuStat.mCpuUsage)("mem_rss", mMemStat.mRss));
                     mShouldSuicide.store(true);
                     break;
                 }
+                if (memExceeded) {
+                    LOG_WARNING(sLogger,
+                                ("Memory used by program exceeds upper limit for some time",
+                                 "rely on memory backpressure")("mem_rss", mMemStat.mRss)(
+                                    "accounted memory bytes", MemoryAccountant::GetInstance()->GetTotalUsage()));
+                }
 
                 if (IsHostIpChanged()) {
                     mShouldSuicide.store(true);
@@ -370,6 +390,15 @@ bool LogtailMonitor::CheckSoftMemLimit() {
     return false;
 }
 
+bool LogtailMonitor::IsMemRelievableByBackpressure() const {
+    if (!BOOL_FLAG(enable_memory_backpressure)) {
+        return false;
+    }
+    return MemoryAccountant::GetInstance()->IsRelievableByBackpressure(
+        static_cast<int64_t>(AppConfig::GetInstance()->GetMemUsageUpLimit()) * 1024 * 1024,
+        mMemStat.mRss * 1024 * 1024);
+}
+
 bool LogtailMonitor::CheckHardMemLimit() {
     return mMemStat.mRss > 5 * AppConfig::GetInstance()->GetMemUsageUpLimit();
 }
@@ -624,6 +653,8 @@ void LoongCollectorMonitor::Init() {
     // init value
     mAgentCpu = mMetricsRecordRef.CreateDoubleGauge(METRIC_AGENT_CPU);
     mAgentMemory = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY);
+    mAgentAccountedMemory = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_ACCOUNTED_BYTES);
+    mAgentMemoryPressureLevel = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_PRESSURE_LEVEL);
     mAgentGoMemory = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_GO);
     mAgentGoRoutinesTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_GO_ROUTINES_TOTAL);
     mAgentOpenFdTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_OPEN_FD_TOTAL);
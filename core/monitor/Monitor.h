@@ -115,6 +115,10 @@ private:
     // CheckSoftMemLimit checks if the memory usage exceeds limit.
     // @return true if the memory usage exceeds limit continuously.
     bool CheckSoftMemLimit();
+    // IsMemRelievableByBackpressure checks if memory backpressure can still bring the memory usage under limit.
+    // @return false if nothing is throttled, the most severe level is reached, or the memory not accounted for alone
+    // exceeds limit.
+    bool IsMemRelievableByBackpressure() const;
 
     bool CheckHardMemLimit();
 
@@ -197,6 +201,8 @@ public:
 
     void SetAgentCpu(double cpu) { SET_GAUGE(mAgentCpu, cpu); }
     void SetAgentMemory(uint64_t mem) { SET_GAUGE(mAgentMemory, mem); }
+    void SetAgentAccountedMemory(uint64_t mem) { SET_GAUGE(mAgentAccountedMemory, mem); }
+    void SetAgentMemoryPressureLevel(uint64_t level) { SET_GAUGE(mAgentMemoryPressureLevel, level); }
     void SetAgentGoMemory(uint64_t mem) { SET_GAUGE(mAgentGoMemory, mem); }
     void SetAgentGoRoutinesTotal(uint64_t total) { SET_GAUGE(mAgentGoRoutinesTotal, total); }
     void SetAgentOpenFdTotal(uint64_t total) {
@@ -236,6 +242,8 @@ private:
 
     DoubleGaugePtr mAgentCpu;
     IntGaugePtr mAgentMemory;
+    IntGaugePtr mAgentAccountedMemory;
+    IntGaugePtr mAgentMemoryPressureLevel;
     IntGaugePtr mAgentGoMemory;
     IntGaugePtr mAgentGoRoutinesTotal;
     IntGaugePtr mAgentOpenFdTotal;
@@ -18,6 +18,7 @@
 
 #include "MetricConstants.h"
 #include "Monitor.h"
+#include "collection_pipeline/plugin/instance/ProcessorProfiler.h"
 #include "runner/ProcessorRunner.h"
 
 using namespace std;
@@ -102,6 +103,7 @@ void SelfMonitorServer::RemoveMetricPipeline() {
 
 void SelfMonitorServer::SendMetrics() {
     ReadMetrics::GetInstance()->UpdateMetrics();
+    ProcessorProfiler::DumpFoldedStacks();
 
     ReadLock lock(mMetricPipelineLock);
     if (mMetricPipelineCtx == nullptr || mSelfMonitorMetricRules == nullptr) {
@@ -36,6 +36,8 @@ const string METRIC_AGENT_GO_ROUTINES_TOTAL = "go_routines_total";
 const string METRIC_AGENT_INSTANCE_CONFIG_TOTAL = "instance_config_total"; // Not Implemented
 const string METRIC_AGENT_MEMORY = "memory_used_mb";
 const string METRIC_AGENT_MEMORY_GO = "go_memory_used_mb";
+const string METRIC_AGENT_MEMORY_ACCOUNTED_BYTES = "accounted_memory_bytes";
+const string METRIC_AGENT_MEMORY_PRESSURE_LEVEL = "memory_pressure_level";
 const string METRIC_AGENT_OPEN_FD_TOTAL = "open_fd_total";
 const string METRIC_AGENT_PIPELINE_CONFIG_TOTAL = "pipeline_config_total";
 
@@ -62,6 +62,8 @@ const string METRIC_COMPONENT_BATCHER_BUFFERED_GROUPS_TOTAL = "buffered_groups_t
 const string METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL = "buffered_events_total";
 const string METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES = "buffered_size_bytes";
 const string METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS = "total_add_time_ms";
+const string METRIC_COMPONENT_BATCHER_MIN_SIZE_BYTES = "min_size_bytes";
+const string METRIC_COMPONENT_BATCHER_TIMEOUT_SECS = "timeout_secs";
 
 /**********************************************************
  *   queue
@@ -71,6 +73,8 @@ const string METRIC_COMPONENT_QUEUE_SIZE_BYTES = "queue_size_bytes";
 const string METRIC_COMPONENT_QUEUE_VALID_TO_PUSH_FLAG = "valid_to_push_status";
 const string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE = "extra_buffer_size";
 const string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE_BYTES = "extra_buffer_size_bytes";
+const string METRIC_COMPONENT_QUEUE_SPILLED_ITEMS_TOTAL = "spilled_items_total";
+const string METRIC_COMPONENT_QUEUE_SPILLED_SIZE_BYTES = "spilled_size_bytes";
 const string& METRIC_COMPONENT_QUEUE_DISCARDED_EVENTS_TOTAL = METRIC_DISCARDED_EVENTS_TOTAL;
 
 const string METRIC_COMPONENT_QUEUE_FETCHED_ITEMS_TOTAL = "fetched_items_total";
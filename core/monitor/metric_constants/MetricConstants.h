@@ -40,6 +40,8 @@ extern const std::string METRIC_AGENT_GO_ROUTINES_TOTAL;
 extern const std::string METRIC_AGENT_INSTANCE_CONFIG_TOTAL;
 extern const std::string METRIC_AGENT_MEMORY;
 extern const std::string METRIC_AGENT_MEMORY_GO;
+extern const std::string METRIC_AGENT_MEMORY_ACCOUNTED_BYTES;
+extern const std::string METRIC_AGENT_MEMORY_PRESSURE_LEVEL;
 extern const std::string METRIC_AGENT_OPEN_FD_TOTAL;
 extern const std::string METRIC_AGENT_PIPELINE_CONFIG_TOTAL;
 
@@ -62,6 +64,7 @@ extern const std::string METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL;
 extern const std::string METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES;
 extern const std::string METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS;
 extern const std::string METRIC_PIPELINE_START_TIME;
+extern const std::string METRIC_PIPELINE_MEMORY_USED_BYTES;
 
 //////////////////////////////////////////////////////////////////////////
 // plugin
@@ -81,6 +84,20 @@ extern const std::string& METRIC_PLUGIN_OUT_SIZE_BYTES;
 extern const std::string& METRIC_PLUGIN_TOTAL_DELAY_MS;
 extern const std::string& METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS;
 
+/**********************************************************
+ *   processor profile
+ **********************************************************/
+extern const std::string METRIC_PLUGIN_PROFILE_SAMPLED_EVENT_GROUPS_TOTAL;
+extern const std::string METRIC_PLUGIN_PROFILE_WALL_TIME_US;
+extern const std::string METRIC_PLUGIN_PROFILE_CPU_TIME_US;
+extern const std::string METRIC_PLUGIN_PROFILE_ALLOCATED_BYTES;
+extern const std::string METRIC_PLUGIN_PROFILE_IN_EVENTS_TOTAL;
+extern const std::string METRIC_PLUGIN_PROFILE_OUT_EVENTS_TOTAL;
+extern const std::string METRIC_PLUGIN_PROFILE_LATENCY_P50_US;
+extern const std::string METRIC_PLUGIN_PROFILE_LATENCY_P90_US;
+extern const std::string METRIC_PLUGIN_PROFILE_LATENCY_P99_US;
+extern const std::string METRIC_PLUGIN_PROFILE_LATENCY_MAX_US;
+
 /**********************************************************
  *   input_file
  *   input_container_stdio
@@ -107,6 +124,8 @@ extern const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TARGETS;
 extern const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TOTAL;
 extern const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TIME_MS;
 extern const std::string METRIC_PLUGIN_PROM_SCRAPE_TIME_MS;
+extern const std::string METRIC_PLUGIN_PROM_SCRAPE_LATENCY_MS;
+extern const std::string METRIC_PLUGIN_PROM_SCRAPE_LAG_MS;
 extern const std::string METRIC_PLUGIN_PROM_SCRAPE_DELAY_TOTAL;
 
 /**********************************************************
@@ -254,6 +273,8 @@ extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_GROUPS_TOTAL;
 extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL;
 extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES;
 extern const std::string METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS;
+extern const std::string METRIC_COMPONENT_BATCHER_MIN_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_BATCHER_TIMEOUT_SECS;
 
 /**********************************************************
  *   queue
@@ -263,6 +284,8 @@ extern const std::string METRIC_COMPONENT_QUEUE_SIZE_BYTES;
 extern const std::string METRIC_COMPONENT_QUEUE_VALID_TO_PUSH_FLAG;
 extern const std::string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE;
 extern const std::string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_QUEUE_SPILLED_ITEMS_TOTAL;
+extern const std::string METRIC_COMPONENT_QUEUE_SPILLED_SIZE_BYTES;
 extern const std::string& METRIC_COMPONENT_QUEUE_DISCARDED_EVENTS_TOTAL;
 
 extern const std::string METRIC_COMPONENT_QUEUE_FETCHED_ITEMS_TOTAL;
@@ -283,12 +306,15 @@ extern const std::string METRIC_LABEL_KEY_THREAD_NO;
 
 // label values
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_SERVER;
+extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_READER;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_FLUSHER;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_HTTP_SINK;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESSOR;
+extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESS_QUEUE_SHARD;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_PROMETHEUS;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_EBPF_SERVER;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_K8S_METADATA;
+extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_TIMER;
 
 // metric keys
 extern const std::string& METRIC_RUNNER_IN_EVENTS_TOTAL;
@@ -318,6 +344,12 @@ extern const std::string METRIC_RUNNER_SINK_SEND_CONCURRENCY;
 extern const std::string METRIC_RUNNER_FLUSHER_IN_RAW_SIZE_BYTES;
 extern const std::string METRIC_RUNNER_FLUSHER_WAITING_ITEMS_TOTAL;
 
+/**********************************************************
+ *   process queue shard
+ **********************************************************/
+extern const std::string METRIC_RUNNER_PROCESS_QUEUE_STOLEN_ITEMS_TOTAL;
+extern const std::string METRIC_RUNNER_PROCESS_QUEUE_IDLE_POPS_TOTAL;
+
 /**********************************************************
  *   file server
  **********************************************************/
@@ -328,6 +360,11 @@ extern const std::string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE;
 
+/**********************************************************
+ *   file reader
+ **********************************************************/
+extern const std::string METRIC_RUNNER_FILE_READER_WAITING_ITEMS_TOTAL;
+
 /**********************************************************
  *   ebpf server
  **********************************************************/
@@ -335,6 +372,10 @@ extern const std::string METRIC_RUNNER_EBPF_POLL_PROCESS_EVENTS_TOTAL;
 extern const std::string METRIC_RUNNER_EBPF_LOSS_PROCESS_EVENTS_TOTAL;
 extern const std::string METRIC_RUNNER_EBPF_PROCESS_CACHE_MISS_TOTAL;
 extern const std::string METRIC_RUNNER_EBPF_PROCESS_CACHE_SIZE;
+extern const std::string METRIC_RUNNER_EBPF_EVENT_RING_OVERFLOW_TOTAL;
+extern const std::string METRIC_RUNNER_EBPF_EVENT_RING_OCCUPANCY;
+extern const std::string METRIC_RUNNER_EBPF_APP_RECORD_RING_OVERFLOW_TOTAL;
+extern const std::string METRIC_RUNNER_EBPF_APP_RECORD_RING_OCCUPANCY;
 
 /**********************************************************
  *   k8s metadata
@@ -345,4 +386,16 @@ extern const std::string METRIC_RUNNER_METADATA_EXTERNAL_IP_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_METADATA_REQUEST_REMOTE_TOTAL;
 extern const std::string METRIC_RUNNER_METADATA_REQUEST_REMOTE_FAILED_TOTAL;
 
+/**********************************************************
+ *   timer
+ **********************************************************/
+extern const std::string METRIC_RUNNER_TIMER_CANCELLED_ITEMS_TOTAL;
+extern const std::string METRIC_RUNNER_TIMER_WAITING_ITEMS_TOTAL;
+extern const std::string METRIC_RUNNER_TIMER_TOTAL_LAG_MS;
+extern const std::string METRIC_RUNNER_TIMER_LAG_LE_1MS_TOTAL;
+extern const std::string METRIC_RUNNER_TIMER_LAG_LE_10MS_TOTAL;
+extern const std::string METRIC_RUNNER_TIMER_LAG_LE_100MS_TOTAL;
+extern const std::string METRIC_RUNNER_TIMER_LAG_LE_1S_TOTAL;
+extern const std::string METRIC_RUNNER_TIMER_LAG_GT_1S_TOTAL;
+
 } // namespace logtail
@@ -33,5 +33,6 @@ const string METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL = "flusher_in_event_
 const string METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES = "flusher_in_size_bytes";
 const string METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS = "flusher_total_package_time_ms";
 const string METRIC_PIPELINE_START_TIME = "start_time";
+const string METRIC_PIPELINE_MEMORY_USED_BYTES = "memory_used_bytes";
 
 } // namespace logtail
@@ -33,6 +33,20 @@ const string& METRIC_PLUGIN_OUT_SIZE_BYTES = METRIC_OUT_SIZE_BYTES;
 const string& METRIC_PLUGIN_TOTAL_DELAY_MS = METRIC_TOTAL_DELAY_MS;
 const string& METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS = METRIC_TOTAL_PROCESS_TIME_MS;
 
+/**********************************************************
+ *   processor profile
+ **********************************************************/
+const string METRIC_PLUGIN_PROFILE_SAMPLED_EVENT_GROUPS_TOTAL = "profile_sampled_event_groups_total";
+const string METRIC_PLUGIN_PROFILE_WALL_TIME_US = "profile_wall_time_us";
+const string METRIC_PLUGIN_PROFILE_CPU_TIME_US = "profile_cpu_time_us";
+const string METRIC_PLUGIN_PROFILE_ALLOCATED_BYTES = "profile_allocated_bytes";
+const string METRIC_PLUGIN_PROFILE_IN_EVENTS_TOTAL = "profile_in_events_total";
+const string METRIC_PLUGIN_PROFILE_OUT_EVENTS_TOTAL = "profile_out_events_total";
+const string METRIC_PLUGIN_PROFILE_LATENCY_P50_US = "profile_latency_p50_us";
+const string METRIC_PLUGIN_PROFILE_LATENCY_P90_US = "profile_latency_p90_us";
+const string METRIC_PLUGIN_PROFILE_LATENCY_P99_US = "profile_latency_p99_us";
+const string METRIC_PLUGIN_PROFILE_LATENCY_MAX_US = "profile_latency_max_us";
+
 /**********************************************************
  *   input_file
  *   input_container_stdio
@@ -59,6 +73,8 @@ const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TARGETS = "prom_subscribe_targets
 const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TOTAL = "prom_subscribe_total";
 const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TIME_MS = "prom_subscribe_time_ms";
 const std::string METRIC_PLUGIN_PROM_SCRAPE_TIME_MS = "prom_scrape_time_ms";
+const std::string METRIC_PLUGIN_PROM_SCRAPE_LATENCY_MS = "prom_scrape_latency_ms";
+const std::string METRIC_PLUGIN_PROM_SCRAPE_LAG_MS = "prom_scrape_lag_ms";
 const std::string METRIC_PLUGIN_PROM_SCRAPE_DELAY_TOTAL = "prom_scrape_delay_total";
 
 /**********************************************************
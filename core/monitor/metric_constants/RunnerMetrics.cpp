@@ -25,12 +25,15 @@ const string METRIC_LABEL_KEY_THREAD_NO = "thread_no";
 
 // label values
 const string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_SERVER = "file_server";
+const string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_READER = "file_reader";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_FLUSHER = "flusher_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_HTTP_SINK = "http_sink";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESSOR = "processor_runner";
+const string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESS_QUEUE_SHARD = "process_queue_shard";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_PROMETHEUS = "prometheus_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_EBPF_SERVER = "ebpf_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_K8S_METADATA = "k8s_metadata_runner";
+const string METRIC_LABEL_VALUE_RUNNER_NAME_TIMER = "timer";
 
 // metric keys
 const string& METRIC_RUNNER_IN_EVENTS_TOTAL = METRIC_IN_EVENTS_TOTAL;
@@ -60,6 +63,12 @@ const string METRIC_RUNNER_SINK_SEND_CONCURRENCY = "send_concurrency";
 const string METRIC_RUNNER_FLUSHER_IN_RAW_SIZE_BYTES = "in_raw_size_bytes";
 const string METRIC_RUNNER_FLUSHER_WAITING_ITEMS_TOTAL = "waiting_items_total";
 
+/**********************************************************
+ *   process queue shard
+ **********************************************************/
+const string METRIC_RUNNER_PROCESS_QUEUE_STOLEN_ITEMS_TOTAL = "stolen_items_total";
+const string METRIC_RUNNER_PROCESS_QUEUE_IDLE_POPS_TOTAL = "idle_pops_total";
+
 /**********************************************************
  *   file server
  **********************************************************/
@@ -70,6 +79,11 @@ const string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE = "polling_modify_cach
 const string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE = "polling_dir_cache_size";
 const string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE = "polling_file_cache_size";
 
+/**********************************************************
+ *   file reader
+ **********************************************************/
+const string METRIC_RUNNER_FILE_READER_WAITING_ITEMS_TOTAL = "waiting_items_total";
+
 /**********************************************************
  *   ebpf server
  **********************************************************/
@@ -77,6 +91,10 @@ const string METRIC_RUNNER_EBPF_POLL_PROCESS_EVENTS_TOTAL = "poll_process_events
 const string METRIC_RUNNER_EBPF_LOSS_PROCESS_EVENTS_TOTAL = "loss_process_events_total";
 const string METRIC_RUNNER_EBPF_PROCESS_CACHE_MISS_TOTAL = "process_cache_miss_total";
 const string METRIC_RUNNER_EBPF_PROCESS_CACHE_SIZE = "process_cache_size";
+const string METRIC_RUNNER_EBPF_EVENT_RING_OVERFLOW_TOTAL = "event_ring_overflow_total";
+const string METRIC_RUNNER_EBPF_EVENT_RING_OCCUPANCY = "event_ring_occupancy";
+const string METRIC_RUNNER_EBPF_APP_RECORD_RING_OVERFLOW_TOTAL = "app_record_ring_overflow_total";
+const string METRIC_RUNNER_EBPF_APP_RECORD_RING_OCCUPANCY = "app_record_ring_occupancy";
 
 /**********************************************************
  *   k8s metadata
@@ -87,5 +105,17 @@ const string METRIC_RUNNER_METADATA_EXTERNAL_IP_CACHE_SIZE = "external_ip_cache_
 const string METRIC_RUNNER_METADATA_REQUEST_REMOTE_TOTAL = "request_metadata_server_total";
 const string METRIC_RUNNER_METADATA_REQUEST_REMOTE_FAILED_TOTAL = "request_metadata_server_failed_total";
 
+/**********************************************************
+ *   timer
+ **********************************************************/
+const string METRIC_RUNNER_TIMER_CANCELLED_ITEMS_TOTAL = "cancelled_items_total";
+const string METRIC_RUNNER_TIMER_WAITING_ITEMS_TOTAL = "waiting_items_total";
+const string METRIC_RUNNER_TIMER_TOTAL_LAG_MS = "total_schedule_lag_ms";
+const string METRIC_RUNNER_TIMER_LAG_LE_1MS_TOTAL = "schedule_lag_le_1ms_total";
+const string METRIC_RUNNER_TIMER_LAG_LE_10MS_TOTAL = "schedule_lag_le_10ms_total";
+const string METRIC_RUNNER_TIMER_LAG_LE_100MS_TOTAL = "schedule_lag_le_100ms_total";
+const string METRIC_RUNNER_TIMER_LAG_LE_1S_TOTAL = "schedule_lag_le_1s_total";
+const string METRIC_RUNNER_TIMER_LAG_GT_1S_TOTAL = "schedule_lag_gt_1s_total";
+
 
 } // namespace logtail
@@ -54,6 +54,18 @@ DoubleGaugePtr MetricsRecord::CreateDoubleGauge(const std::string& name) {
     return gaugePtr;
 }
 
+ShardedCounterPtr MetricsRecord::CreateShardedCounter(const std::string& name) {
+    ShardedCounterPtr counterPtr = std::make_shared<ShardedCounter>(name);
+    mShardedCounters.emplace_back(counterPtr);
+    return counterPtr;
+}
+
+ShardedTimeCounterPtr MetricsRecord::CreateShardedTimeCounter(const std::string& name) {
+    ShardedTimeCounterPtr counterPtr = std::make_shared<ShardedTimeCounter>(name);
+    mShardedTimeCounters.emplace_back(counterPtr);
+    return counterPtr;
+}
+
 void MetricsRecord::MarkDeleted() {
     mDeleted = true;
 }
@@ -100,6 +112,14 @@ MetricsRecord* MetricsRecord::Collect() {
         TimeCounterPtr newPtr(item->Collect());
         metrics->mTimeCounters.emplace_back(newPtr);
     }
+    for (auto& item : mShardedCounters) {
+        CounterPtr newPtr(item->Collect());
+        metrics->mCounters.emplace_back(newPtr);
+    }
+    for (auto& item : mShardedTimeCounters) {
+        TimeCounterPtr newPtr(item->Collect());
+        metrics->mTimeCounters.emplace_back(newPtr);
+    }
     for (auto& item : mIntGauges) {
         IntGaugePtr newPtr(item->Collect());
         metrics->mIntGauges.emplace_back(newPtr);
@@ -157,6 +177,14 @@ DoubleGaugePtr MetricsRecordRef::CreateDoubleGauge(const std::string& name) {
     return mMetrics->CreateDoubleGauge(name);
 }
 
+ShardedCounterPtr MetricsRecordRef::CreateShardedCounter(const std::string& name) {
+    return mMetrics->CreateShardedCounter(name);
+}
+
+ShardedTimeCounterPtr MetricsRecordRef::CreateShardedTimeCounter(const std::string& name) {
+    return mMetrics->CreateShardedTimeCounter(name);
+}
+
 const MetricsRecord* MetricsRecordRef::operator->() const {
     return mMetrics;
 }
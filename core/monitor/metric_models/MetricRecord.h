@@ -39,6 +39,9 @@ private:
     std::vector<TimeCounterPtr> mTimeCounters;
     std::vector<IntGaugePtr> mIntGauges;
     std::vector<DoubleGaugePtr> mDoubleGauges;
+    // merged into mCounters and mTimeCounters of the collected record
+    std::vector<ShardedCounterPtr> mShardedCounters;
+    std::vector<ShardedTimeCounterPtr> mShardedTimeCounters;
 
     std::atomic_bool mDeleted;
     MetricsRecord* mNext = nullptr;
@@ -59,6 +62,8 @@ public:
     TimeCounterPtr CreateTimeCounter(const std::string& name);
     IntGaugePtr CreateIntGauge(const std::string& name);
     DoubleGaugePtr CreateDoubleGauge(const std::string& name);
+    ShardedCounterPtr CreateShardedCounter(const std::string& name);
+    ShardedTimeCounterPtr CreateShardedTimeCounter(const std::string& name);
     MetricsRecord* Collect();
     void SetNext(MetricsRecord* next);
     MetricsRecord* GetNext() const;
@@ -87,6 +92,9 @@ public:
     TimeCounterPtr CreateTimeCounter(const std::string& name);
     IntGaugePtr CreateIntGauge(const std::string& name);
     DoubleGaugePtr CreateDoubleGauge(const std::string& name);
+    // for counters updated concurrently by multiple threads on the hot path
+    ShardedCounterPtr CreateShardedCounter(const std::string& name);
+    ShardedTimeCounterPtr CreateShardedTimeCounter(const std::string& name);
     const MetricsRecord* operator->() const;
     // this is not thread-safe, and should be only used before WriteMetrics::CommitMetricsRecordRef
     void AddLabels(MetricLabels&& labels);
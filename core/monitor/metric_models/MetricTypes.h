@@ -23,6 +23,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace logtail {
@@ -56,6 +57,71 @@ public:
     TimeCounter* Collect() { return new TimeCounter(mName, mVal.exchange(0)); }
 };
 
+// Counter updated by many threads on the hot path. Each thread adds to its own cache-line padded shard, so that
+// threads do not contend on the same cache line, and the shards are only summed up when the counter is collected.
+class ShardedCounter {
+public:
+    ShardedCounter(const std::string& name) : mName(name), mShardCnt(GetShardCnt()), mShards(new Shard[mShardCnt]) {}
+
+    uint64_t GetValue() const {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < mShardCnt; ++i) {
+            sum += mShards[i].mVal.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+    const std::string& GetName() const { return mName; }
+    void Add(uint64_t val) {
+        mShards[GetThreadIndex() & (mShardCnt - 1)].mVal.fetch_add(val, std::memory_order_relaxed);
+    }
+    Counter* Collect() { return new Counter(mName, CollectValue()); }
+
+protected:
+    struct alignas(64) Shard {
+        std::atomic_uint64_t mVal{0};
+    };
+
+    uint64_t CollectValue() {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < mShardCnt; ++i) {
+            sum += mShards[i].mVal.exchange(0, std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    // power of 2 no less than the number of cores, capped at 16
+    static size_t GetShardCnt() {
+        static const size_t sCnt = [] {
+            size_t cnt = 1;
+            while (cnt < std::thread::hardware_concurrency() && cnt < 16) {
+                cnt <<= 1;
+            }
+            return cnt;
+        }();
+        return sCnt;
+    }
+
+    // assigned round-robin on first use, so that threads started together land on different shards
+    static size_t GetThreadIndex() {
+        static std::atomic_size_t sNextIndex{0};
+        thread_local size_t sIndex = sNextIndex.fetch_add(1, std::memory_order_relaxed);
+        return sIndex;
+    }
+
+    std::string mName;
+    size_t mShardCnt = 1;
+    std::unique_ptr<Shard[]> mShards;
+};
+
+// input: nanosecond, output: milisecond
+class ShardedTimeCounter : public ShardedCounter {
+public:
+    ShardedTimeCounter(const std::string& name) : ShardedCounter(name) {}
+    uint64_t GetValue() const { return ShardedCounter::GetValue() / 1000000; }
+    void Add(std::chrono::nanoseconds val) { ShardedCounter::Add(val.count()); }
+    TimeCounter* Collect() { return new TimeCounter(mName, CollectValue()); }
+};
+
 template <typename T>
 class Gauge {
 public:
@@ -84,6 +150,8 @@ public:
 
 using CounterPtr = std::shared_ptr<Counter>;
 using TimeCounterPtr = std::shared_ptr<TimeCounter>;
+using ShardedCounterPtr = std::shared_ptr<ShardedCounter>;
+using ShardedTimeCounterPtr = std::shared_ptr<ShardedTimeCounter>;
 using IntGaugePtr = std::shared_ptr<IntGauge>;
 using DoubleGaugePtr = std::shared_ptr<Gauge<double>>;
 
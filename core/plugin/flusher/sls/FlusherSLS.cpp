@@ -61,6 +61,9 @@ DEFINE_FLAG_BOOL(enable_metricstore_channel, "only works for metrics data for en
 DEFINE_FLAG_INT32(max_send_log_group_size, "bytes", 10 * 1024 * 1024);
 DEFINE_FLAG_DOUBLE(sls_serialize_size_expansion_ratio, "", 1.2);
 DEFINE_FLAG_INT32(sls_request_dscp, "set dscp for sls request, from 0 to 63", -1);
+DEFINE_FLAG_BOOL(sls_serialize_columnar_logs,
+                 "build columnar copy of log batches on completion for faster serialization",
+                 false);
 
 DECLARE_FLAG_BOOL(send_prefer_real_ip);
 
@@ -510,6 +513,7 @@ bool FlusherSLS::Init(const Json::Value& config, Json::Value& optionalGoPipeline
         // enable group batch
         return false;
     }
+    mBatcher.SetBuildColumnarLogs(BOOL_FLAG(sls_serialize_columnar_logs));
 
     // CompressType
     if (BOOL_FLAG(sls_client_send_compress)) {
@@ -717,6 +721,7 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
         GetRegionConcurrencyLimiter(mRegion)->OnSuccess(curSystemTime);
         GetProjectConcurrencyLimiter(mProject)->OnSuccess(curSystemTime);
         GetLogstoreConcurrencyLimiter(mProject, mLogstore)->OnSuccess(curSystemTime);
+        mBatcher.OnSendSucceeded(chrono::duration_cast<chrono::milliseconds>(curSystemTime - item->mLastSendTime));
         SenderQueueManager::GetInstance()->DecreaseConcurrencyLimiterInSendingCnt(item->mQueueKey);
         ADD_COUNTER(mSuccessCnt, 1);
         DealSenderQueueItemAfterSend(item, false);
@@ -1061,6 +1066,7 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
                 allSucceeded = false;
                 continue;
             }
+            mBatcher.OnDataCompressed(serializedData.size(), compressedData.size());
         } else {
             compressedData = serializedData;
         }
@@ -106,8 +106,8 @@ bool CommonParserOptions::ShouldEraseEvent(bool parseSuccess,
         }
         size_t size = sourceEvent.Size();
         // "__file_offset__"
-        auto offsetKey = metadata.find(EventGroupMetaKey::LOG_FILE_OFFSET_KEY);
-        if (size == 1 && (offsetKey != metadata.end() && sourceEvent.cbegin()->first == offsetKey->second)) {
+        if (size == 1 && metadata.Has(EventGroupMetaKey::LOG_FILE_OFFSET_KEY)
+            && sourceEvent.cbegin()->first == metadata.Get(EventGroupMetaKey::LOG_FILE_OFFSET_KEY)) {
             return true;
         } else if (size == 2 && sourceEvent.HasContent(ProcessorParseContainerLogNative::containerTimeKey)
                    && sourceEvent.HasContent(ProcessorParseContainerLogNative::containerSourceKey)) {
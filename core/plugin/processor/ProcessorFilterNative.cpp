@@ -16,6 +16,7 @@
 
 #include "plugin/processor/ProcessorFilterNative.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "common/ParamExtractor.h"
@@ -83,7 +84,6 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                mContext->GetLogstoreName(),
                                mContext->GetRegion());
         } else if (!filterKeys.empty()) {
-            std::vector<boost::regex> regs;
             for (const auto& reg : filterRegs) {
                 if (!IsRegexValid(reg)) {
                     PARAM_ERROR_RETURN(mContext->GetLogger(),
@@ -95,11 +95,8 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                        mContext->GetLogstoreName(),
                                        mContext->GetRegion());
                 }
-                regs.emplace_back(reg);
             }
-            mFilterRule = std::make_shared<LogFilterRule>();
-            mFilterRule->FilterKeys = filterKeys;
-            mFilterRule->FilterRegs = regs;
+            mFilterRule = CreateFilterRule(filterKeys, filterRegs);
             mFilterMode = Mode::RULE_MODE;
         }
     }
@@ -117,8 +114,7 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                mContext->GetLogstoreName(),
                                mContext->GetRegion());
         } else if (!mInclude.empty()) {
-            std::vector<std::string> keys;
-            std::vector<boost::regex> regs;
+            std::vector<std::string> keys, regs;
             for (auto& include : mInclude) {
                 if (!IsRegexValid(include.second)) {
                     PARAM_ERROR_RETURN(mContext->GetLogger(),
@@ -131,11 +127,9 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                        mContext->GetRegion());
                 }
                 keys.emplace_back(include.first);
-                regs.emplace_back(boost::regex(include.second));
+                regs.emplace_back(include.second);
             }
-            mFilterRule = std::make_shared<LogFilterRule>();
-            mFilterRule->FilterKeys = keys;
-            mFilterRule->FilterRegs = regs;
+            mFilterRule = CreateFilterRule(keys, regs);
             mFilterMode = Mode::RULE_MODE;
         }
     }
@@ -257,14 +251,14 @@ bool ProcessorFilterNative::FilterFilterRule(LogEvent& sourceEvent, const LogFil
 
 bool ProcessorFilterNative::IsMatched(const LogEvent& contents, const LogFilterRule& rule) {
     const std::vector<std::string>& keys = rule.FilterKeys;
-    const std::vector<boost::regex> regs = rule.FilterRegs;
+    const std::vector<RegexSetMatcher>& regs = rule.FilterRegs;
     std::string exception;
     for (uint32_t i = 0; i < keys.size(); ++i) {
         const auto& content = contents.FindContent(keys[i]);
         if (content == contents.end()) {
             return false;
         }
-        if (!BoostRegexMatch(content->second.data(), content->second.size(), regs[i], exception)) {
+        if (!regs[i].MatchAll(content->second, exception)) {
             if (!exception.empty()) {
                 LOG_ERROR(GetContext().GetLogger(), ("regex_match in Filter fail", exception));
                 if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
@@ -282,6 +276,28 @@ bool ProcessorFilterNative::IsMatched(const LogEvent& contents, const LogFilterR
     return true;
 }
 
+std::shared_ptr<ProcessorFilterNative::LogFilterRule>
+ProcessorFilterNative::CreateFilterRule(const std::vector<std::string>& keys, const std::vector<std::string>& regs) {
+    // regexes of the same key are grouped, so that they can be evaluated in a single pass
+    std::vector<std::string> uniqueKeys;
+    std::vector<std::vector<std::string>> keyRegs;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        size_t idx = std::find(uniqueKeys.begin(), uniqueKeys.end(), keys[i]) - uniqueKeys.begin();
+        if (idx == uniqueKeys.size()) {
+            uniqueKeys.emplace_back(keys[i]);
+            keyRegs.emplace_back();
+        }
+        keyRegs[idx].emplace_back(regs[i]);
+    }
+    auto rule = std::make_shared<LogFilterRule>();
+    rule->FilterKeys = std::move(uniqueKeys);
+    rule->FilterRegs.reserve(keyRegs.size());
+    for (const auto& item : keyRegs) {
+        rule->FilterRegs.emplace_back(item);
+    }
+    return rule;
+}
+
 static const char UTF8_BYTE_PREFIX = 0x80;
 static const char UTF8_BYTE_MASK = 0xc0;
 
@@ -463,7 +479,7 @@ bool RegexFilterValueNode::Match(const LogEvent& contents, const CollectionPipel
     }
 
     std::string exception;
-    bool result = BoostRegexMatch(content->second.data(), content->second.size(), reg, exception);
+    bool result = reg.Match(content->second, exception);
     if (!result && !exception.empty() && AppConfig::GetInstance()->IsLogParseAlarmValid()) {
         LOG_ERROR(mContext.GetLogger(), ("regex_match in Filter fail", exception));
         if (mContext.GetAlarm().IsLowLevelAlarmValid()) {
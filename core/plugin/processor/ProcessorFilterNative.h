@@ -16,10 +16,9 @@
 
 #pragma once
 
-#include "boost/regex.hpp"
-
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/plugin/interface/Processor.h"
+#include "common/regex/RegexMatcher.h"
 #include "models/LogEvent.h"
 
 namespace logtail {
@@ -68,7 +67,7 @@ private:
 class RegexFilterValueNode : public BaseFilterNode {
 public:
     RegexFilterValueNode(const std::string& key, const std::string& exp)
-        : BaseFilterNode(VALUE_NODE), key(key), reg(exp) {}
+        : BaseFilterNode(VALUE_NODE), key(key), reg(exp, RegexMatcher::Mode::FULL_MATCH) {}
 
     virtual ~RegexFilterValueNode() {}
 
@@ -77,7 +76,7 @@ public:
 
 private:
     std::string key;
-    boost::regex reg;
+    RegexMatcher reg;
 };
 
 // UnaryFilterOperatorNode
@@ -120,7 +119,8 @@ private:
 
     struct LogFilterRule {
         std::vector<std::string> FilterKeys;
-        std::vector<boost::regex> FilterRegs;
+        // all regexes of the same key are matched together
+        std::vector<RegexSetMatcher> FilterRegs;
     };
 
     bool ProcessEvent(PipelineEventPtr& e);
@@ -131,6 +131,8 @@ private:
     // Filter logs through FilterRule
     bool FilterFilterRule(LogEvent& sourceEvent, const LogFilterRule* filterRule);
     bool IsMatched(const LogEvent& contents, const LogFilterRule& rule);
+    static std::shared_ptr<LogFilterRule> CreateFilterRule(const std::vector<std::string>& keys,
+                                                           const std::vector<std::string>& regs);
 
     bool noneUtf8(StringView& strSrc, bool modify);
     bool CheckNoneUtf8(const StringView& strSrc);
@@ -17,7 +17,9 @@
 #include "plugin/processor/inner/ProcessorParseContainerLogNative.h"
 
 #include <codecvt>
+#include <cstring>
 
+#include "common/CharSearch.h"
 #include "common/JsonUtil.h"
 #include "common/ParamExtractor.h"
 #include "models/LogEvent.h"
@@ -180,7 +182,7 @@ bool ProcessorParseContainerLogNative::ParseContainerdTextLogLine(LogEvent& sour
 
     // 寻找第一个分隔符位置 时间 _time_
     StringView timeValue;
-    const char* pch1 = std::find(contentValue.begin(), contentValue.end(), CONTAINERD_DELIMITER);
+    const char* pch1 = FindFirstChar(contentValue.begin(), contentValue.end(), CONTAINERD_DELIMITER);
     if (pch1 == contentValue.end()) {
         std::ostringstream errorMsgStream;
         errorMsgStream << "time field cannot be found in log line."
@@ -192,7 +194,7 @@ bool ProcessorParseContainerLogNative::ParseContainerdTextLogLine(LogEvent& sour
 
     // 寻找第二个分隔符位置 容器标签 _source_
     StringView sourceValue;
-    const char* pch2 = std::find(pch1 + 1, contentValue.end(), CONTAINERD_DELIMITER);
+    const char* pch2 = FindFirstChar(pch1 + 1, contentValue.end(), CONTAINERD_DELIMITER);
     if (pch2 == contentValue.end()) {
         std::ostringstream errorMsgStream;
         errorMsgStream << "source field cannot be found in log line."
@@ -231,9 +233,9 @@ bool ProcessorParseContainerLogNative::ParseContainerdTextLogLine(LogEvent& sour
         return true;
     }
 
-    // 寻找第三个分隔符位置
-    const char* pch3 = std::find(pch2 + 1, contentValue.end(), CONTAINERD_DELIMITER);
-    if (pch3 == contentValue.end() || pch3 != pch2 + 2) {
+    // 第三个分隔符只能紧跟在标签之后，无需搜索
+    const char* pch3 = pch2 + 2;
+    if (pch3 >= contentValue.end() || *pch3 != CONTAINERD_DELIMITER) {
         // case: 2021-08-25T07:00:00.000000000Z stdout P
         // case: 2021-08-25T07:00:00.000000000Z stdout PP 1
         StringView content = StringView(pch2 + 1, contentValue.end() - pch2 - 1);
@@ -293,70 +295,135 @@ static int32_t parseLogType(char* buffer, int32_t idx, int32_t size, DockerLogTy
 
 std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert;
 
+// the value is unescaped in place, runs without escapes are located with simd and moved as a whole
 static int32_t parseValue(char* buffer, int32_t idx, int32_t size, DockerLogType logType, int32_t& endIndex) {
-    while (idx < size && buffer[idx] != '\"') {
-        if (buffer[idx] == '\\') {
-            if (logType != DockerLogType::Log) {
-                return -1;
-            }
-            ++idx; // skip escape char
-            if (idx >= size) {
-                return -1;
-            }
-            switch (buffer[idx]) {
-                case '\"':
-                    buffer[endIndex++] = '\"';
-                    break;
-                case '\\':
-                    buffer[endIndex++] = '\\';
-                    break;
-                case '/':
-                    buffer[endIndex++] = '/';
-                    break;
-                case 'b':
-                    buffer[endIndex++] = '\b';
-                    break;
-                case 'f':
-                    buffer[endIndex++] = '\f';
-                    break;
-                case 'n':
-                    buffer[endIndex++] = '\n';
-                    break;
-                case 'r':
-                    buffer[endIndex++] = '\r';
-                    break;
-                case 't':
-                    buffer[endIndex++] = '\t';
-                    break;
-                default:
-                    if (idx + 4 < size && buffer[idx] == 'u') {
-                        std::string unicode_seq;
-                        unicode_seq.append(buffer + idx + 1, 4);
-                        char32_t unicode_char = std::stoul(unicode_seq, nullptr, 16);
-                        std::string res = convert.to_bytes(unicode_char);
-                        for (size_t i = 0; i < res.size(); ++i) {
-                            buffer[endIndex++] = res[i];
-                        }
-                        idx += 4;
-                    } else {
-                        buffer[endIndex++] = '\\';
-                        buffer[endIndex++] = buffer[idx];
+    while (idx < size) {
+        int32_t next = FindFirstCharOf(buffer + idx, buffer + size, '\"', '\\') - buffer;
+        if (endIndex != idx) {
+            memmove(buffer + endIndex, buffer + idx, next - idx);
+        }
+        endIndex += next - idx;
+        idx = next;
+        if (idx >= size || buffer[idx] == '\"') {
+            break;
+        }
+        if (logType != DockerLogType::Log) {
+            return -1;
+        }
+        ++idx; // skip escape char
+        if (idx >= size) {
+            return -1;
+        }
+        switch (buffer[idx]) {
+            case '\"':
+                buffer[endIndex++] = '\"';
+                break;
+            case '\\':
+                buffer[endIndex++] = '\\';
+                break;
+            case '/':
+                buffer[endIndex++] = '/';
+                break;
+            case 'b':
+                buffer[endIndex++] = '\b';
+                break;
+            case 'f':
+                buffer[endIndex++] = '\f';
+                break;
+            case 'n':
+                buffer[endIndex++] = '\n';
+                break;
+            case 'r':
+                buffer[endIndex++] = '\r';
+                break;
+            case 't':
+                buffer[endIndex++] = '\t';
+                break;
+            default:
+                if (idx + 4 < size && buffer[idx] == 'u') {
+                    std::string unicode_seq;
+                    unicode_seq.append(buffer + idx + 1, 4);
+                    char32_t unicode_char = std::stoul(unicode_seq, nullptr, 16);
+                    std::string res = convert.to_bytes(unicode_char);
+                    for (size_t i = 0; i < res.size(); ++i) {
+                        buffer[endIndex++] = res[i];
                     }
-                    break;
-            }
-        } else {
-            buffer[endIndex++] = buffer[idx];
+                    idx += 4;
+                } else {
+                    buffer[endIndex++] = '\\';
+                    buffer[endIndex++] = buffer[idx];
+                }
+                break;
         }
         ++idx;
     }
     return idx;
 }
 
+enum class DockerLogShape { MATCHED, MISMATCHED, INVALID };
+
+static const char kDockerLogPrefix[] = "{\"log\":\"";
+static const char kDockerStreamKey[] = "\",\"stream\":\"";
+static const char kDockerTimeKey[] = "\",\"time\":\"";
+static const int32_t kDockerLogPrefixSize = sizeof(kDockerLogPrefix) - 1;
+static const int32_t kDockerStreamKeySize = sizeof(kDockerStreamKey) - 1;
+static const int32_t kDockerTimeKeySize = sizeof(kDockerTimeKey) - 1;
+
+// Docker always writes the fields in the same order without spaces, so the stream and time are located backwards
+// from the end, and only the log value is scanned. The buffer is not modified unless the shape is matched, so that
+// the generic parser can take over the mismatched ones.
+static DockerLogShape parseDockerLogOfDefaultShape(char* buffer, int32_t size, DockerLog& dockerLog) {
+    if (size < kDockerLogPrefixSize + kDockerStreamKeySize + kDockerTimeKeySize + 2
+        || memcmp(buffer, kDockerLogPrefix, kDockerLogPrefixSize) != 0 || buffer[size - 2] != '\"'
+        || buffer[size - 1] != '}') {
+        return DockerLogShape::MISMATCHED;
+    }
+    const char* logBegin = buffer + kDockerLogPrefixSize;
+    const char* timeEnd = buffer + size - 2;
+    const char* timeQuote = FindLastChar(logBegin, timeEnd, '\"');
+    if (timeQuote == nullptr || timeQuote - logBegin < kDockerTimeKeySize - 1
+        || memcmp(timeQuote - kDockerTimeKeySize + 1, kDockerTimeKey, kDockerTimeKeySize) != 0) {
+        return DockerLogShape::MISMATCHED;
+    }
+    const char* streamEnd = timeQuote - kDockerTimeKeySize + 1;
+    const char* streamQuote = FindLastChar(logBegin, streamEnd, '\"');
+    if (streamQuote == nullptr || streamQuote - logBegin < kDockerStreamKeySize - 1
+        || memcmp(streamQuote - kDockerStreamKeySize + 1, kDockerStreamKey, kDockerStreamKeySize) != 0) {
+        return DockerLogShape::MISMATCHED;
+    }
+    // escapes are only allowed in the log
+    if (FindFirstChar(streamQuote + 1, streamEnd, '\\') != streamEnd
+        || FindFirstChar(timeQuote + 1, timeEnd, '\\') != timeEnd) {
+        return DockerLogShape::MISMATCHED;
+    }
+    int32_t logEnd = streamQuote - kDockerStreamKeySize + 1 - buffer;
+
+    int32_t endIndex = kDockerLogPrefixSize;
+    int32_t idx = parseValue(buffer, kDockerLogPrefixSize, size, DockerLogType::Log, endIndex);
+    if (idx != logEnd) {
+        // the log is closed somewhere else, which makes more than 3 fields or a broken one, and the generic parser
+        // would fail as well
+        return DockerLogShape::INVALID;
+    }
+    dockerLog.log = StringView(logBegin, endIndex - kDockerLogPrefixSize);
+    dockerLog.stream = StringView(streamQuote + 1, streamEnd - streamQuote - 1);
+    dockerLog.time = StringView(timeQuote + 1, timeEnd - timeQuote - 1);
+    return DockerLogShape::MATCHED;
+}
+
 // buffer: {"log":"Hello, World!","stream":"stdout","time":"2021-12-01T00:00:00.000Z"}
 bool ProcessorParseContainerLogNative::ParseDockerLog(char* buffer, int32_t size, DockerLog& dockerLog) {
     if (size == 0 || buffer[0] != '{' || buffer[size - 1] != '}') {
         return false;
     }
+    switch (parseDockerLogOfDefaultShape(buffer, size, dockerLog)) {
+        case DockerLogShape::MATCHED:
+            return true;
+        case DockerLogShape::INVALID:
+            return false;
+        default:
+            break;
+    }
     int logTypeCnt = 0;
     int32_t endIndex = 0;
     int32_t idx = 1; // skip '{'
@@ -16,6 +16,7 @@
 
 #include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
 
+#include "common/CharSearch.h"
 #include "common/ParamExtractor.h"
 #include "models/LogEvent.h"
 
@@ -165,12 +166,8 @@ StringView ProcessorSplitLogStringNative::GetNextLine(StringView log, size_t beg
         return StringView();
     }
 
-    for (size_t end = begin; end < log.size(); ++end) {
-        if (log[end] == mSplitChar) {
-            return StringView(log.data() + begin, end - begin);
-        }
-    }
-    return StringView(log.data() + begin, log.size() - begin);
+    const char* end = FindFirstChar(log.data() + begin, log.data() + log.size(), mSplitChar);
+    return StringView(log.data() + begin, end - log.data() - begin);
 }
 
 } // namespace logtail
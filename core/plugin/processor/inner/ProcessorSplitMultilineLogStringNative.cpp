@@ -18,8 +18,6 @@
 
 #include <string>
 
-#include "boost/regex.hpp"
-
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
 #include "common/ParamExtractor.h"
@@ -70,13 +68,13 @@ bool ProcessorSplitMultilineLogStringNative::Init(const Json::Value& config) {
 
     for (int i = 0; i < AppConfig::GetInstance()->GetProcessThreadCount(); ++i) {
         if (!mMultiline.mStartPattern.empty()) {
-            mStartPatternReg.emplace_back(mMultiline.mStartPattern);
+            mStartPatternReg.emplace_back(mMultiline.mStartPattern, RegexMatcher::Mode::PARTIAL_MATCH);
         }
         if (!mMultiline.mContinuePattern.empty()) {
-            mContinuePatternReg.emplace_back(mMultiline.mContinuePattern);
+            mContinuePatternReg.emplace_back(mMultiline.mContinuePattern, RegexMatcher::Mode::PARTIAL_MATCH);
         }
         if (!mMultiline.mEndPattern.empty()) {
-            mEndPatternReg.emplace_back(mMultiline.mEndPattern);
+            mEndPatternReg.emplace_back(mMultiline.mEndPattern, RegexMatcher::Mode::PARTIAL_MATCH);
         }
     }
 
@@ -176,17 +174,12 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         ++(*inputLines);
         if (!isPartialLog) {
             // it is impossible to enter this state if only end pattern is given
-            boost::regex regex;
-            if (HasStartPattern()) {
-                regex = GetStartPatternReg();
-            } else {
-                regex = GetContinuePatternReg();
-            }
-            if (BoostRegexSearch(content.data(), content.size(), regex, exception)) {
+            const RegexMatcher& regex = HasStartPattern() ? GetStartPatternReg() : GetContinuePatternReg();
+            if (regex.Match(content, exception)) {
                 multiStartIndex = content.data();
                 isPartialLog = true;
             } else if (HasEndPattern() && !HasStartPattern() && HasContinuePattern()
-                       && BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                       && GetEndPatternReg().Match(content, exception)) {
                 // case: continue + end
                 CreateNewEvent(content, isLastLog, sourceKey, sourceEvent, logGroup, newEvents);
                 multiStartIndex = content.data() + content.size() + 1;
@@ -198,7 +191,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         } else {
             // case: start + continue or continue + end
             if (HasContinuePattern()
-                && BoostRegexSearch(content.data(), content.size(), GetContinuePatternReg(), exception)) {
+                && GetContinuePatternReg().Match(content, exception)) {
                 begin += content.size() + 1;
                 continue;
             }
@@ -207,7 +200,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                 if (HasContinuePattern()) {
                     // current line is not matched against the continue pattern, so the end pattern will decide
                     // if the current log is a match or not
-                    if (BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                    if (GetEndPatternReg().Match(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -229,7 +222,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                     isPartialLog = false;
                 } else {
                     // case: start + end or end
-                    if (BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                    if (GetEndPatternReg().Match(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -250,7 +243,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
             } else {
                 if (!HasContinuePattern()) {
                     // case: start
-                    if (BoostRegexSearch(content.data(), content.size(), GetStartPatternReg(), exception)) {
+                    if (GetStartPatternReg().Match(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() - 1 - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -270,7 +263,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                                    logGroup,
                                    newEvents);
                     ADD_COUNTER(mMatchedEventsTotal, 1);
-                    if (!BoostRegexSearch(content.data(), content.size(), GetStartPatternReg(), exception)) {
+                    if (!GetStartPatternReg().Match(content, exception)) {
                         // when no end pattern is given, the only chance to enter unmatched state is when both
                         // start and continue pattern are given, and the current line is not matched against the
                         // start pattern
@@ -393,15 +386,15 @@ StringView ProcessorSplitMultilineLogStringNative::GetNextLine(StringView log, s
     return StringView(log.data() + begin, log.size() - begin);
 }
 
-const boost::regex& ProcessorSplitMultilineLogStringNative::GetStartPatternReg() const {
+const RegexMatcher& ProcessorSplitMultilineLogStringNative::GetStartPatternReg() const {
     return mStartPatternReg[ProcessorRunner::GetThreadNo()];
 }
 
-const boost::regex& ProcessorSplitMultilineLogStringNative::GetContinuePatternReg() const {
+const RegexMatcher& ProcessorSplitMultilineLogStringNative::GetContinuePatternReg() const {
     return mContinuePatternReg[ProcessorRunner::GetThreadNo()];
 }
 
-const boost::regex& ProcessorSplitMultilineLogStringNative::GetEndPatternReg() const {
+const RegexMatcher& ProcessorSplitMultilineLogStringNative::GetEndPatternReg() const {
     return mEndPatternReg[ProcessorRunner::GetThreadNo()];
 }
 
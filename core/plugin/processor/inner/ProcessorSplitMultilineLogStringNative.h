@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "collection_pipeline/plugin/interface/Processor.h"
+#include "common/regex/RegexMatcher.h"
 #include "constants/Constants.h"
 #include "file_server/MultilineOptions.h"
 #include "plugin/processor/CommonParserOptions.h"
@@ -68,15 +69,15 @@ private:
     bool HasStartPattern() const { return !mStartPatternReg.empty(); }
     bool HasContinuePattern() const { return !mContinuePatternReg.empty(); }
     bool HasEndPattern() const { return !mEndPatternReg.empty(); }
-    const boost::regex& GetStartPatternReg() const;
-    const boost::regex& GetContinuePatternReg() const;
-    const boost::regex& GetEndPatternReg() const;
+    const RegexMatcher& GetStartPatternReg() const;
+    const RegexMatcher& GetContinuePatternReg() const;
+    const RegexMatcher& GetEndPatternReg() const;
 
     // boost::regex object shared by multi-thread leads to performance degradation. Therefore, each thread should be
-    // allocated a different copy.
-    std::vector<boost::regex> mStartPatternReg;
-    std::vector<boost::regex> mContinuePatternReg;
-    std::vector<boost::regex> mEndPatternReg;
+    // allocated a different copy. This also keeps the dfa cache of re2 private to each thread.
+    std::vector<RegexMatcher> mStartPatternReg;
+    std::vector<RegexMatcher> mContinuePatternReg;
+    std::vector<RegexMatcher> mEndPatternReg;
 
     CounterPtr mMatchedEventsTotal;
     CounterPtr mMatchedLinesTotal;
@@ -140,14 +140,16 @@ uint64_t GetRandSleepMilliSec(const std::string& key, uint64_t intervalSeconds,
 
     // Scale the normalized hash to milliseconds
     auto randSleep = static_cast<uint64_t>(std::ceil(intervalSeconds * 1000.0 * normalizedH));
+    return GetSleepMilliSecToOffset(randSleep, intervalSeconds, currentMilliSeconds);
+}
 
-    // calculate sleep window start offset, apply random sleep
+uint64_t GetSleepMilliSecToOffset(uint64_t offsetMilliSec, uint64_t intervalSeconds, uint64_t currentMilliSeconds) {
+    // calculate sleep window start offset, apply sleep
     uint64_t sleepOffset = currentMilliSeconds % (intervalSeconds * 1000ULL);
-    if (randSleep < sleepOffset) {
-        randSleep += intervalSeconds * 1000ULL;
+    if (offsetMilliSec < sleepOffset) {
+        offsetMilliSec += intervalSeconds * 1000ULL;
     }
-    randSleep -= sleepOffset;
-    return randSleep;
+    return offsetMilliSec - sleepOffset;
 }
 
 namespace prom {
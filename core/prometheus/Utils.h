@@ -20,6 +20,8 @@ void SplitStringView(const std::string& s, char delimiter, std::vector<StringVie
 bool IsNumber(const std::string& str);
 
 uint64_t GetRandSleepMilliSec(const std::string& key, uint64_t intervalSeconds, uint64_t currentMilliSeconds);
+// return the time to sleep until the given offset within the current or next interval window
+uint64_t GetSleepMilliSecToOffset(uint64_t offsetMilliSec, uint64_t intervalSeconds, uint64_t currentMilliSeconds);
 
 namespace prom {
 std::string NetworkCodeToState(NetworkCode code);
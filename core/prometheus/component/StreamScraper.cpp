@@ -1,6 +1,7 @@
 #include "prometheus/component/StreamScraper.h"
 
 #include <cstddef>
+#include <cstring>
 
 #include <memory>
 #include <string>
@@ -11,6 +12,7 @@
 #include "Logger.h"
 #include "collection_pipeline/queue/ProcessQueueItem.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "common/CharSearch.h"
 #include "common/StringTools.h"
 #include "models/PipelineEventGroup.h"
 #include "prometheus/Utils.h"
@@ -54,20 +56,21 @@ size_t StreamScraper::MetricWriteCallback(char* buffer, size_t size, size_t nmem
 
     auto* body = static_cast<StreamScraper*>(data);
 
-    size_t begin = 0;
-    for (size_t end = begin; end < sizes; ++end) {
-        if (buffer[end] == '\n') {
-            if (begin == 0 && !body->mCache.empty()) {
-                body->mCache.append(buffer, end);
-                body->AddEvent(body->mCache.data(), body->mCache.size());
-                body->mCache.clear();
-            } else if (begin != end) {
-                body->AddEvent(buffer + begin, end - begin);
-            }
-            begin = end + 1;
+    // complete lines in the chunk, together with the incomplete line cached from the previous chunk, are copied to
+    // the source buffer at once, and events refer to them without further copy
+    const char* lastLineEnd = FindLastChar(buffer, buffer + sizes, '\n');
+    if (lastLineEnd != nullptr) {
+        size_t len = lastLineEnd - buffer;
+        StringBuffer sb = body->mEventGroup.GetSourceBuffer()->AllocateStringBuffer(body->mCache.size() + len);
+        if (!body->mCache.empty()) {
+            memcpy(sb.data, body->mCache.data(), body->mCache.size());
+            body->mCache.clear();
         }
+        memcpy(sb.data + sb.size - len, buffer, len);
+        body->AddEvents(StringView(sb.data, sb.size));
     }
 
+    size_t begin = lastLineEnd == nullptr ? 0 : lastLineEnd - buffer + 1;
     if (begin < sizes) {
         body->mCache.append(buffer + begin, sizes - begin);
         // limit the last line cache size to prom_max_sample_length bytes
@@ -87,18 +90,30 @@ size_t StreamScraper::MetricWriteCallback(char* buffer, size_t size, size_t nmem
     return sizes;
 }
 
-void StreamScraper::AddEvent(const char* line, size_t len) {
-    if (IsValidMetric(StringView(line, len))) {
+void StreamScraper::AddEvents(StringView lines) {
+    const char* begin = lines.data();
+    const char* end = lines.data() + lines.size();
+    while (begin < end) {
+        const char* lineEnd = FindFirstChar(begin, end, '\n');
+        if (lineEnd != begin) {
+            AddEvent(StringView(begin, lineEnd - begin));
+        }
+        begin = lineEnd + 1;
+    }
+}
+
+void StreamScraper::AddEvent(StringView line) {
+    if (IsValidMetric(line)) {
         auto* e = mEventGroup.AddRawEvent(true, mEventPool);
-        auto sb = mEventGroup.GetSourceBuffer()->CopyString(line, len);
-        e->SetContentNoCopy(sb);
+        e->SetContentNoCopy(line);
         mScrapeSamplesScraped++;
     }
 }
 
 void StreamScraper::FlushCache() {
     if (!mCache.empty()) {
-        AddEvent(mCache.data(), mCache.size());
+        auto sb = mEventGroup.GetSourceBuffer()->CopyString(mCache);
+        AddEvent(StringView(sb.data, sb.size));
         mCache.clear();
     }
 }
@@ -34,7 +34,9 @@ public:
     uint64_t mStreamIndex = 0;
 
 private:
-    void AddEvent(const char* line, size_t len);
+    // lines must be kept in the source buffer of the current event group
+    void AddEvents(StringView lines);
+    void AddEvent(StringView line);
     void PushEventGroup(PipelineEventGroup&&) const;
     void SetTargetLabels(PipelineEventGroup& eGroup) const;
     std::string GetId();
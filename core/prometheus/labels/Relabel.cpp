@@ -28,6 +28,7 @@
 #include "common/StringTools.h"
 #include "logger/Logger.h"
 #include "prometheus/Constants.h"
+#include "prometheus/labels/RelabelProgram.h"
 
 using namespace std;
 
@@ -264,6 +265,8 @@ bool RelabelConfigList::Init(const Json::Value& relabelConfigs) {
             return false;
         }
     }
+    mProgram = std::make_shared<RelabelProgram>();
+    mProgram->Compile(mRelabelConfigs);
     return true;
 }
 
@@ -277,6 +280,9 @@ bool RelabelConfigList::Process(Labels& l) const {
 }
 
 bool RelabelConfigList::Process(MetricEvent& event) const {
+    if (mProgram) {
+        return mProgram->Process(event);
+    }
     Labels labels;
     labels.Reset(&event);
     return Process(labels);
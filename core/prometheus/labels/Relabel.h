@@ -18,6 +18,7 @@
 #include <json/json.h>
 
 #include <boost/regex.hpp>
+#include <memory>
 #include <string>
 
 #include "prometheus/labels/Labels.h"
@@ -71,6 +72,8 @@ public:
 private:
 };
 
+class RelabelProgram;
+
 class RelabelConfigList {
 public:
     bool Init(const Json::Value& relabelConfigs);
@@ -81,6 +84,8 @@ public:
 
 private:
     std::vector<RelabelConfig> mRelabelConfigs;
+    // compiled from mRelabelConfigs for processing metric events
+    std::shared_ptr<RelabelProgram> mProgram;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class RelabelConfigUnittest;
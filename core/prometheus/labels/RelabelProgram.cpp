@@ -0,0 +1,296 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "prometheus/labels/RelabelProgram.h"
+
+#include <openssl/md5.h>
+
+#include <algorithm>
+#include <cctype>
+
+#include "common/Flags.h"
+#include "logger/Logger.h"
+#include "prometheus/Constants.h"
+
+DEFINE_FLAG_INT32(prom_relabel_regex_cache_size, "max number of regex results cached for each relabel rule", 1024);
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+using LabelPair = pair<StringView, StringView>;
+
+bool LabelKeyLess(const LabelPair& l, StringView key) {
+    return l.first < key;
+}
+
+// Sorted flat view of the tags of a metric event. Modifications are applied to both the view and the event, so that
+// the order of tags in the event is kept as if the tags were modified directly.
+class FlatLabels {
+public:
+    void Reset(MetricEvent& event) {
+        mEvent = &event;
+        mItems.assign(event.TagsBegin(), event.TagsEnd());
+        sort(mItems.begin(), mItems.end(), [](const LabelPair& l, const LabelPair& r) { return l.first < r.first; });
+    }
+
+    StringView Get(StringView key) const {
+        auto it = lower_bound(mItems.begin(), mItems.end(), key, LabelKeyLess);
+        if (it != mItems.end() && it->first == key) {
+            return it->second;
+        }
+        return StringView();
+    }
+
+    // key and val must live as long as the event
+    void Set(StringView key, StringView val) {
+        mEvent->SetTagNoCopy(key, val);
+        auto it = lower_bound(mItems.begin(), mItems.end(), key, LabelKeyLess);
+        if (it != mItems.end() && it->first == key) {
+            it->second = val;
+        } else {
+            mItems.emplace(it, key, val);
+        }
+    }
+
+    void Del(StringView key) {
+        auto it = lower_bound(mItems.begin(), mItems.end(), key, LabelKeyLess);
+        if (it != mItems.end() && it->first == key) {
+            mEvent->DelTag(key);
+            mItems.erase(it);
+        }
+    }
+
+    const vector<LabelPair>& Items() const { return mItems; }
+
+    StringView Copy(StringView s) const {
+        auto sb = mEvent->GetSourceBuffer()->CopyString(s);
+        return StringView(sb.data, sb.size);
+    }
+
+private:
+    MetricEvent* mEvent = nullptr;
+    vector<LabelPair> mItems;
+};
+
+bool IsMatchAll(const boost::regex& regex) {
+    static const vector<string> sMatchAllPatterns = {".*", "(.*)", "^.*$", "^(.*)$", "().*"};
+    return find(sMatchAllPatterns.begin(), sMatchAllPatterns.end(), regex.str()) != sMatchAllPatterns.end();
+}
+
+} // namespace
+
+void RelabelProgram::Compile(const vector<RelabelConfig>& configs) {
+    mInstructions.clear();
+    size_t cacheSize = static_cast<size_t>(max(0, INT32_FLAG(prom_relabel_regex_cache_size)));
+    for (const auto& config : configs) {
+        if (config.mAction == Action::UNDEFINED) {
+            LOG_ERROR(sLogger, ("relabel: unknown relabel action type", ActionToString(config.mAction)));
+            continue;
+        }
+        // keep everything is a no-op
+        if (config.mAction == Action::KEEP && IsMatchAll(config.mRegex)) {
+            continue;
+        }
+        Instruction inst;
+        inst.mAction = config.mAction;
+        inst.mSourceLabels = config.mSourceLabels;
+        inst.mSeparator = config.mSeparator;
+        inst.mRegex = config.mRegex;
+        inst.mTargetLabel = config.mTargetLabel;
+        inst.mReplacement = config.mReplacement;
+        inst.mModulus = config.mModulus;
+        inst.mMatchList.assign(config.mMatchList.begin(), config.mMatchList.end());
+        switch (config.mAction) {
+            case Action::KEEP:
+            case Action::DROP:
+            case Action::REPLACE:
+            case Action::LABELMAP:
+            case Action::LABELDROP:
+            case Action::LABELKEEP:
+                inst.mCache = make_shared<RelabelRegexCache>(cacheSize);
+                break;
+            default:
+                break;
+        }
+        mInstructions.emplace_back(std::move(inst));
+        // drop everything, the following rules are never reached
+        if (config.mAction == Action::DROP && IsMatchAll(config.mRegex)) {
+            break;
+        }
+    }
+}
+
+bool RelabelProgram::Process(MetricEvent& event) const {
+    static thread_local FlatLabels sLabels;
+    static thread_local string sConcatBuffer;
+    static thread_local vector<LabelPair> sItems;
+
+    event.SetTagNoCopy(StringView(prometheus::NAME), event.GetName());
+    sLabels.Reset(event);
+
+    for (const auto& inst : mInstructions) {
+        StringView val;
+        if (inst.mSourceLabels.size() == 1) {
+            val = sLabels.Get(inst.mSourceLabels[0]);
+        } else if (!inst.mSourceLabels.empty()) {
+            sConcatBuffer.clear();
+            for (size_t i = 0; i < inst.mSourceLabels.size(); ++i) {
+                if (i != 0) {
+                    sConcatBuffer.append(inst.mSeparator);
+                }
+                auto v = sLabels.Get(inst.mSourceLabels[i]);
+                sConcatBuffer.append(v.data(), v.size());
+            }
+            val = StringView(sConcatBuffer);
+        }
+
+        switch (inst.mAction) {
+            case Action::DROP:
+            case Action::KEEP: {
+                bool matched = false;
+                inst.mCache->Visit(
+                    val,
+                    [&](RelabelRegexCache::Result& res) {
+                        res.mMatched = boost::regex_match(val.begin(), val.end(), inst.mRegex);
+                    },
+                    [&](const RelabelRegexCache::Result& res) { matched = res.mMatched; });
+                if (matched == (inst.mAction == Action::DROP)) {
+                    return false;
+                }
+                break;
+            }
+            case Action::DROPEQUAL: {
+                if (sLabels.Get(inst.mTargetLabel) == val) {
+                    return false;
+                }
+                break;
+            }
+            case Action::KEEPEQUAL: {
+                if (sLabels.Get(inst.mTargetLabel) != val) {
+                    return false;
+                }
+                break;
+            }
+            case Action::REPLACE: {
+                inst.mCache->Visit(
+                    val,
+                    [&](RelabelRegexCache::Result& res) {
+                        string input = val.to_string();
+                        res.mMatched = boost::regex_search(input, inst.mRegex);
+                        // If there is no match no replacement must take place.
+                        if (!res.mMatched) {
+                            return;
+                        }
+                        res.mTarget
+                            = boost::regex_replace(input, inst.mRegex, inst.mTargetLabel, boost::format_first_only);
+                        res.mReplacement
+                            = boost::regex_replace(input, inst.mRegex, inst.mReplacement, boost::format_first_only);
+                    },
+                    [&](const RelabelRegexCache::Result& res) {
+                        if (!res.mMatched) {
+                            return;
+                        }
+                        if (res.mReplacement.empty()) {
+                            sLabels.Del(res.mTarget);
+                            return;
+                        }
+                        sLabels.Set(sLabels.Copy(res.mTarget), sLabels.Copy(res.mReplacement));
+                    });
+                break;
+            }
+            case Action::LOWERCASE:
+            case Action::UPPERCASE: {
+                auto res = sLabels.Copy(val);
+                auto* data = const_cast<char*>(res.data());
+                for (size_t i = 0; i < res.size(); ++i) {
+                    auto c = static_cast<unsigned char>(data[i]);
+                    data[i] = static_cast<char>(inst.mAction == Action::LOWERCASE ? tolower(c) : toupper(c));
+                }
+                sLabels.Set(sLabels.Copy(inst.mTargetLabel), res);
+                break;
+            }
+            case Action::HASHMOD: {
+                uint8_t digest[MD5_DIGEST_LENGTH];
+                MD5(reinterpret_cast<const uint8_t*>(val.data()), val.size(), digest);
+                // Use only the last 8 bytes of the hash to give the same result as earlier versions of this code.
+                uint64_t hashVal = 0;
+                for (int i = 8; i < MD5_DIGEST_LENGTH; ++i) {
+                    hashVal = (hashVal << 8) | digest[i];
+                }
+                uint64_t mod = hashVal % inst.mModulus;
+                sLabels.Set(sLabels.Copy(inst.mTargetLabel), sLabels.Copy(to_string(mod)));
+                break;
+            }
+            case Action::LABELMAP: {
+                // labels may be added during iteration
+                sItems = sLabels.Items();
+                for (const auto& [key, value] : sItems) {
+                    inst.mCache->Visit(
+                        key,
+                        [&](RelabelRegexCache::Result& res) {
+                            string input = key.to_string();
+                            res.mMatched = boost::regex_match(input, inst.mRegex);
+                            if (res.mMatched) {
+                                res.mTarget = boost::regex_replace(
+                                    input, inst.mRegex, inst.mReplacement, boost::match_default | boost::format_all);
+                            }
+                        },
+                        [&](const RelabelRegexCache::Result& res) {
+                            if (res.mMatched) {
+                                sLabels.Set(sLabels.Copy(res.mTarget), value);
+                            }
+                        });
+                }
+                break;
+            }
+            case Action::LABELDROP:
+            case Action::LABELKEEP: {
+                sItems = sLabels.Items();
+                for (const auto& item : sItems) {
+                    const auto& key = item.first;
+                    bool matched = false;
+                    inst.mCache->Visit(
+                        key,
+                        [&](RelabelRegexCache::Result& res) {
+                            res.mMatched = boost::regex_match(key.begin(), key.end(), inst.mRegex);
+                        },
+                        [&](const RelabelRegexCache::Result& res) { matched = res.mMatched; });
+                    if (matched == (inst.mAction == Action::LABELDROP)) {
+                        sLabels.Del(key);
+                    }
+                }
+                break;
+            }
+            case Action::DROPMETRIC: {
+                if (binary_search(inst.mMatchList.begin(),
+                                  inst.mMatchList.end(),
+                                  val,
+                                  [](const auto& l, const auto& r) {
+                                      return string_view(l.data(), l.size()) < string_view(r.data(), r.size());
+                                  })) {
+                    return false;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+} // namespace logtail
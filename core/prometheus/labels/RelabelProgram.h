@@ -0,0 +1,150 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <boost/regex.hpp>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/StringView.h"
+#include "models/MetricEvent.h"
+#include "prometheus/labels/Relabel.h"
+
+namespace logtail {
+
+// LRU cache of regex results keyed by the input value, shared by all threads processing with the same rule. Keys are
+// spread over shards with their own locks, and regexes are evaluated outside the locks.
+class RelabelRegexCache {
+public:
+    struct Result {
+        bool mMatched = false;
+        // the target label for replace, or the new label name for labelmap
+        std::string mTarget;
+        std::string mReplacement;
+    };
+
+    explicit RelabelRegexCache(size_t capacity)
+        : mShards(std::min(capacity, kMaxShardCnt)),
+          mShardCapacity(mShards.empty() ? 0 : (capacity + mShards.size() - 1) / mShards.size()) {}
+
+    // compute is called to fill the result on cache miss without any lock held, and use is called with the result
+    // under the lock of its shard
+    template <typename Compute, typename Use>
+    void Visit(StringView key, const Compute& compute, const Use& use) {
+        if (mShards.empty()) {
+            Result res;
+            compute(res);
+            use(res);
+            return;
+        }
+        std::string_view k(key.data(), key.size());
+        auto& shard = mShards[std::hash<std::string_view>()(k) % mShards.size()];
+        {
+            std::lock_guard<std::mutex> lock(shard.mMux);
+            auto it = shard.mIndex.find(k);
+            if (it != shard.mIndex.end()) {
+                shard.mEntries.splice(shard.mEntries.begin(), shard.mEntries, it->second);
+                use(it->second->second);
+                return;
+            }
+        }
+        Result res;
+        compute(res);
+        std::lock_guard<std::mutex> lock(shard.mMux);
+        auto it = shard.mIndex.find(k);
+        if (it != shard.mIndex.end()) {
+            // filled by another thread in the meantime
+            use(it->second->second);
+            return;
+        }
+        if (shard.mEntries.size() >= mShardCapacity) {
+            shard.mIndex.erase(shard.mEntries.back().first);
+            shard.mEntries.pop_back();
+        }
+        shard.mEntries.emplace_front(key.to_string(), std::move(res));
+        shard.mIndex.emplace(shard.mEntries.front().first, shard.mEntries.begin());
+        use(shard.mEntries.front().second);
+    }
+
+    size_t Size() const {
+        size_t size = 0;
+        for (auto& shard : mShards) {
+            std::lock_guard<std::mutex> lock(shard.mMux);
+            size += shard.mEntries.size();
+        }
+        return size;
+    }
+
+private:
+    static constexpr size_t kMaxShardCnt = 16;
+
+    struct Shard {
+        mutable std::mutex mMux;
+        // keys in the index refer to the strings in the list, whose nodes are never moved
+        std::list<std::pair<std::string, Result>> mEntries;
+        std::unordered_map<std::string_view, std::list<std::pair<std::string, Result>>::iterator> mIndex;
+    };
+
+    std::vector<Shard> mShards;
+    size_t mShardCapacity;
+};
+
+// RelabelProgram is the relabel config list compiled for processing metric events sample by sample.
+// Compared with running each RelabelConfig over Labels, it
+//   - works on a sorted flat vector of string views over the tags of the event, so that no label is copied and lookups
+//     are binary searches,
+//   - caches regex results for each rule by input value, which repeat heavily across samples,
+//   - folds keep and drop rules whose regex matches everything, and stops at the first rule dropping the sample.
+// Strings written to the event are copied into its source buffer.
+class RelabelProgram {
+public:
+    void Compile(const std::vector<RelabelConfig>& configs);
+    bool Process(MetricEvent& event) const;
+
+    [[nodiscard]] bool Empty() const { return mInstructions.empty(); }
+
+private:
+    struct Instruction {
+        Action mAction = Action::UNDEFINED;
+        std::vector<std::string> mSourceLabels;
+        std::string mSeparator;
+        boost::regex mRegex;
+        std::string mTargetLabel;
+        std::string mReplacement;
+        uint64_t mModulus = 0;
+        // sorted
+        std::vector<std::string> mMatchList;
+        std::shared_ptr<RelabelRegexCache> mCache;
+    };
+
+    std::vector<Instruction> mInstructions;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class RelabelConfigUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -17,8 +17,11 @@
 #include "prometheus/labels/TextParser.h"
 
 #include <cmath>
+#include <cstring>
 
+#include <array>
 #include <string>
+#include <string_view>
 
 #include "common/StringTools.h"
 #include "common/StringView.h"
@@ -31,12 +34,98 @@ using namespace std;
 
 namespace logtail {
 
-bool IsValidNumberChar(char c) {
-    static const unordered_set<char> sValidChars
-        = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '.', '-', '+', 'e', 'E', 'I',
-           'N', 'F', 'T', 'Y', 'i', 'n', 'f', 't', 'y', 'X', 'x', 'N', 'n', 'A', 'a'};
-    return sValidChars.count(c);
-};
+namespace {
+
+constexpr std::array<bool, 256> BuildNumberCharTable() {
+    std::array<bool, 256> table{};
+    for (char c : std::string_view("0123456789.-+eEINFTYinftyXxAa")) {
+        table[static_cast<unsigned char>(c)] = true;
+    }
+    return table;
+}
+
+constexpr std::array<bool, 256> kNumberChars = BuildNumberCharTable();
+
+inline bool IsValidNumberChar(char c) {
+    return kNumberChars[static_cast<unsigned char>(c)];
+}
+
+constexpr double kExactPowersOf10[]
+    = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Parses plain decimal numbers without allocation. When the significant digits fit in 53 bits and the power of 10 is
+// exactly representable, a single multiplication or division gives the correctly rounded result (Clinger's fast
+// path). Anything else, e.g. Inf, NaN or very long numbers, falls back to strtod.
+bool ParseDouble(StringView str, double& value) {
+    const char* p = str.data();
+    const char* end = str.data() + str.size();
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    uint64_t mantissa = 0;
+    int significantDigits = 0;
+    int exp10 = 0;
+    bool hasDigit = false;
+    bool inFraction = false;
+    for (; p < end; ++p) {
+        if (*p >= '0' && *p <= '9') {
+            hasDigit = true;
+            if (mantissa == 0 && *p == '0') {
+                // leading zeros are not significant
+            } else if (++significantDigits > 19) {
+                break;
+            } else {
+                mantissa = mantissa * 10 + (*p - '0');
+            }
+            if (inFraction) {
+                --exp10;
+            }
+        } else if (*p == '.' && !inFraction) {
+            inFraction = true;
+        } else {
+            break;
+        }
+    }
+    if (hasDigit && p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExp = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExp = *p == '-';
+            ++p;
+        }
+        int exp = 0;
+        const char* expBegin = p;
+        for (; p < end && *p >= '0' && *p <= '9' && exp < 10000; ++p) {
+            exp = exp * 10 + (*p - '0');
+        }
+        if (p == expBegin) {
+            hasDigit = false;
+        }
+        exp10 += negativeExp ? -exp : exp;
+    }
+    if (hasDigit && p == end && mantissa <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22) {
+        value = static_cast<double>(mantissa);
+        value = exp10 < 0 ? value / kExactPowersOf10[-exp10] : value * kExactPowersOf10[exp10];
+        if (negative) {
+            value = -value;
+        }
+        return true;
+    }
+
+    // strtod requires a null terminated string
+    char buf[64];
+    if (str.size() < sizeof(buf)) {
+        memcpy(buf, str.data(), str.size());
+        buf[str.size()] = '\0';
+        return StringTo(buf, buf + str.size(), value);
+    }
+    return StringTo(str.to_string(), value);
+}
+
+} // namespace
 
 TextParser::TextParser(bool honorTimestamps) : mHonorTimestamps(honorTimestamps) {
 }
@@ -159,58 +248,56 @@ void TextParser::HandleEqualSign(MetricEvent& metricEvent) {
 void TextParser::HandleLabelValue(MetricEvent& metricEvent) {
     // left quote has been consumed
     // LableValue supports escape char
-    bool escaped = false;
     auto lPos = mPos;
-    while (mPos < mLine.size() && mLine[mPos] != '"') {
-        if (mLine[mPos] != '\\') {
-            if (escaped) {
-                mEscapedLabelValue.push_back(mLine[mPos]);
-            }
-            ++mPos;
-            ++mTokenLength;
-        } else {
-            if (escaped == false) {
-                // first meet escape char
-                escaped = true;
-                mEscapedLabelValue = mLine.substr(lPos, mPos - lPos).to_string();
+    while (mPos < mLine.size() && mLine[mPos] != '"' && mLine[mPos] != '\\') {
+        ++mPos;
+    }
+    if (mPos < mLine.size() && mLine[mPos] == '"') {
+        metricEvent.SetTagNoCopy(mLabelName, mLine.substr(lPos, mPos - lPos));
+    } else {
+        // the unescaped value is never longer than the raw one, so it is written into the source buffer directly
+        auto valueEnd = mPos;
+        while (valueEnd < mLine.size() && mLine[valueEnd] != '"') {
+            valueEnd += mLine[valueEnd] == '\\' ? 2 : 1;
+        }
+        if (valueEnd >= mLine.size()) {
+            HandleError("unexpected end of input in label value");
+            return;
+        }
+        StringBuffer sb = metricEvent.GetSourceBuffer()->AllocateStringBuffer(valueEnd - lPos);
+        memcpy(sb.data, mLine.data() + lPos, mPos - lPos);
+        size_t size = mPos - lPos;
+        while (mPos < valueEnd) {
+            if (mLine[mPos] != '\\') {
+                sb.data[size++] = mLine[mPos++];
+                continue;
             }
-            if (mPos + 1 < mLine.size()) {
-                // check next char, if it is valid escape char, we can consume two chars and push one escaped char
-                // if not, we need to push the two chars
-                // valid escape char: \", \\, \n
-                switch (mLine[lPos + 1]) {
-                    case '\\':
-                    case '\"':
-                        mEscapedLabelValue.push_back(mLine[mPos + 1]);
-                        break;
-                    case 'n':
-                        mEscapedLabelValue.push_back('\n');
-                        break;
-                    default:
-                        mEscapedLabelValue.push_back('\\');
-                        mEscapedLabelValue.push_back(mLine[mPos + 1]);
-                        break;
-                }
-                mPos += 2;
-            } else {
-                mEscapedLabelValue.push_back(mLine[mPos + 1]);
-                ++mPos;
+            // check next char, if it is valid escape char, we can consume two chars and push one escaped char
+            // if not, we need to push the two chars
+            // valid escape char: \", \\, \n
+            switch (mLine[mPos + 1]) {
+                case '\\':
+                case '\"':
+                    sb.data[size++] = mLine[mPos + 1];
+                    break;
+                case 'n':
+                    sb.data[size++] = '\n';
+                    break;
+                default:
+                    sb.data[size++] = '\\';
+                    sb.data[size++] = mLine[mPos + 1];
+                    break;
             }
+            mPos += 2;
         }
+        sb.data[size] = '\0';
+        metricEvent.SetTagNoCopy(mLabelName, StringView(sb.data, size));
     }
 
     if (mPos == mLine.size()) {
         HandleError("unexpected end of input in label value");
         return;
     }
-
-    if (!escaped) {
-        metricEvent.SetTagNoCopy(mLabelName, mLine.substr(mPos - mTokenLength, mTokenLength));
-    } else {
-        metricEvent.SetTag(mLabelName.to_string(), mEscapedLabelValue);
-        mEscapedLabelValue.clear();
-    }
-    mTokenLength = 0;
     ++mPos;
     SkipLeadingWhitespace();
     if (mPos < mLine.size() && (mLine[mPos] == ',' || mLine[mPos] == '}')) {
@@ -250,14 +337,11 @@ void TextParser::HandleSampleValue(MetricEvent& metricEvent) {
     }
 
     auto tmpSampleValue = mLine.substr(mPos - mTokenLength, mTokenLength);
-    mDoubleStr = tmpSampleValue.to_string();
-
-    if (!StringTo(mDoubleStr, mSampleValue)) {
+    if (!ParseDouble(tmpSampleValue, mSampleValue)) {
         HandleError("invalid sample value");
         mTokenLength = 0;
         return;
     }
-    mDoubleStr.clear();
 
     metricEvent.SetValue<UntypedSingleValue>(mSampleValue);
     mTokenLength = 0;
@@ -288,14 +372,12 @@ void TextParser::HandleTimestamp(MetricEvent& metricEvent) {
         mState = TextState::Done;
         return;
     }
-    mDoubleStr = tmpTimestamp.to_string();
     double milliTimestamp = 0;
-    if (!StringTo(mDoubleStr, milliTimestamp)) {
+    if (!ParseDouble(tmpTimestamp, milliTimestamp)) {
         HandleError("invalid timestamp");
         mTokenLength = 0;
         return;
     }
-    mDoubleStr.clear();
 
     if (milliTimestamp > 1ULL << 63) {
         HandleError("timestamp overflow");
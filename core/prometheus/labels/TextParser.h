@@ -56,11 +56,10 @@ private:
     StringView mLine;
     std::size_t mPos{0};
 
+    // label names and values refer to the line, or to the source buffer of the event if unescaping is needed
     StringView mLabelName;
-    std::string mEscapedLabelValue;
     double mSampleValue{0.0};
     std::size_t mTokenLength{0};
-    std::string mDoubleStr;
 
     bool mHonorTimestamps{true};
     time_t mDefaultTimestamp{0};
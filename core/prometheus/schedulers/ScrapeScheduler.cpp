@@ -28,6 +28,7 @@
 #include "common/StringTools.h"
 #include "common/TimeUtil.h"
 #include "common/http/Constant.h"
+#include "common/memory/MemoryAccountant.h"
 #include "common/timer/HttpRequestTimerEvent.h"
 #include "logger/Logger.h"
 #include "prometheus/Constants.h"
@@ -63,7 +64,7 @@ ScrapeScheduler::ScrapeScheduler(std::shared_ptr<ScrapeConfig> scrapeConfigPtr,
     mInterval = scrapeIntervalSeconds;
 }
 
-void ScrapeScheduler::OnMetricResult(HttpResponse& response, uint64_t) {
+void ScrapeScheduler::OnMetricResult(HttpResponse& response, uint64_t sendTimestampMilliSec) {
     static double sRate = 0.001;
     auto now = GetCurrentTimeInMilliSeconds();
     auto scrapeTimestampMilliSec
@@ -74,6 +75,14 @@ void ScrapeScheduler::OnMetricResult(HttpResponse& response, uint64_t) {
     mSelfMonitor->AddCounter(METRIC_PLUGIN_OUT_EVENTS_TOTAL, response.GetStatusCode());
     mSelfMonitor->AddCounter(METRIC_PLUGIN_OUT_SIZE_BYTES, response.GetStatusCode(), streamScraper->mRawSize);
     mSelfMonitor->AddCounter(METRIC_PLUGIN_PROM_SCRAPE_TIME_MS, response.GetStatusCode(), scrapeDurationMilliSeconds);
+    // scrape time = lag (from the scheduled time to the request being sent) + latency (of the request itself)
+    if (sendTimestampMilliSec >= static_cast<uint64_t>(scrapeTimestampMilliSec) && sendTimestampMilliSec <= now) {
+        mSelfMonitor->AddCounter(METRIC_PLUGIN_PROM_SCRAPE_LAG_MS,
+                                 response.GetStatusCode(),
+                                 sendTimestampMilliSec - scrapeTimestampMilliSec);
+        mSelfMonitor->AddCounter(
+            METRIC_PLUGIN_PROM_SCRAPE_LATENCY_MS, response.GetStatusCode(), now - sendTimestampMilliSec);
+    }
 
     const auto& networkStatus = response.GetNetworkStatus();
     string scrapeState;
@@ -142,7 +151,8 @@ void ScrapeScheduler::ScheduleNext() {
         return true;
     });
     isContextValidFuture->AddDoneCallback([this]() -> bool {
-        if (ProcessQueueManager::GetInstance()->IsValidToPush(mQueueKey)) {
+        if (ProcessQueueManager::GetInstance()->IsValidToPush(mQueueKey)
+            && !MemoryAccountant::GetInstance()->IsScrapePaused()) {
             return true;
         }
         this->DelayExecTime(1);
@@ -164,8 +174,7 @@ void ScrapeScheduler::ScheduleNext() {
         mIsContextValidFuture = isContextValidFuture;
     }
 
-    auto event = BuildScrapeTimerEvent(GetNextExecTime());
-    Timer::GetInstance()->PushEvent(std::move(event));
+    PushScrapeTimerEvent(GetNextExecTime());
 }
 
 void ScrapeScheduler::ScrapeOnce(std::chrono::steady_clock::time_point execTime) {
@@ -175,8 +184,13 @@ void ScrapeScheduler::ScrapeOnce(std::chrono::steady_clock::time_point execTime)
         return true;
     });
     mFuture = future;
-    auto event = BuildScrapeTimerEvent(execTime);
-    Timer::GetInstance()->PushEvent(std::move(event));
+    PushScrapeTimerEvent(execTime);
+}
+
+void ScrapeScheduler::PushScrapeTimerEvent(std::chrono::steady_clock::time_point execTime) {
+    auto id = Timer::GetInstance()->PushEvent(BuildScrapeTimerEvent(execTime));
+    WriteLock lock(mLock);
+    mTimerEventId = id;
 }
 
 std::unique_ptr<TimerEvent> ScrapeScheduler::BuildScrapeTimerEvent(std::chrono::steady_clock::time_point execTime) {
@@ -217,9 +231,16 @@ void ScrapeScheduler::Cancel() {
     if (mIsContextValidFuture != nullptr) {
         mIsContextValidFuture->Cancel();
     }
+    uint64_t timerEventId = 0;
     {
         WriteLock lock(mLock);
         mValidState = false;
+        timerEventId = mTimerEventId;
+        mTimerEventId = 0;
+    }
+    // release the pending request at once instead of waiting for it to expire
+    if (timerEventId != 0) {
+        Timer::GetInstance()->CancelEvent(timerEventId);
     }
 }
 
@@ -231,7 +252,9 @@ void ScrapeScheduler::InitSelfMonitor(const MetricLabels& defaultLabels) {
     static const std::unordered_map<std::string, MetricType> sScrapeMetricKeys
         = {{METRIC_PLUGIN_OUT_EVENTS_TOTAL, MetricType::METRIC_TYPE_COUNTER},
            {METRIC_PLUGIN_OUT_SIZE_BYTES, MetricType::METRIC_TYPE_COUNTER},
-           {METRIC_PLUGIN_PROM_SCRAPE_TIME_MS, MetricType::METRIC_TYPE_COUNTER}};
+           {METRIC_PLUGIN_PROM_SCRAPE_TIME_MS, MetricType::METRIC_TYPE_COUNTER},
+           {METRIC_PLUGIN_PROM_SCRAPE_LAG_MS, MetricType::METRIC_TYPE_COUNTER},
+           {METRIC_PLUGIN_PROM_SCRAPE_LATENCY_MS, MetricType::METRIC_TYPE_COUNTER}};
 
     mSelfMonitor->InitMetricManager(sScrapeMetricKeys, labels);
 
@@ -72,6 +72,7 @@ public:
 
 private:
     std::unique_ptr<TimerEvent> BuildScrapeTimerEvent(std::chrono::steady_clock::time_point execTime);
+    void PushScrapeTimerEvent(std::chrono::steady_clock::time_point execTime);
 
     std::shared_ptr<ScrapeConfig> mScrapeConfigPtr;
     std::atomic_int mExecDelayCount = 0;
@@ -81,6 +82,8 @@ private:
     std::string mMetricsPath;
     std::string mScheme;
     uint64_t mScrapeTimeoutSeconds;
+    // id of the pending timer event, protected by mLock
+    uint64_t mTimerEventId = 0;
 
     // pipeline
     QueueKey mQueueKey;
@@ -0,0 +1,90 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "prometheus/schedulers/ScrapeSlotAllocator.h"
+
+#include <algorithm>
+
+#include "xxhash/xxhash.h"
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_INT32(prom_scrape_slot_width_ms, "width of scrape slots within the scrape interval", 100);
+
+using namespace std;
+
+namespace logtail {
+
+// a slot can hold at most 1.25 times the average number of targets before targets overflow to the next slots
+static constexpr size_t kLoadFactorNumerator = 5;
+static constexpr size_t kLoadFactorDenominator = 4;
+
+uint64_t ScrapeSlotAllocator::Allocate(const string& id, uint64_t intervalSeconds) {
+    uint64_t intervalMs = max<uint64_t>(intervalSeconds * 1000ULL, 1);
+    lock_guard<mutex> lock(mMux);
+    auto it = mAssignments.find(id);
+    if (it != mAssignments.end()) {
+        if (it->second.mIntervalMs == intervalMs) {
+            return it->second.mOffsetMs;
+        }
+        ReleaseLocked(id);
+    }
+
+    auto& wheel = mWheels[intervalMs];
+    if (wheel.mLoads.empty()) {
+        uint64_t slotWidth = static_cast<uint64_t>(max(1, INT32_FLAG(prom_scrape_slot_width_ms)));
+        wheel.mLoads.resize(max<uint64_t>(intervalMs / slotWidth, 1));
+    }
+    size_t slotCnt = wheel.mLoads.size();
+    // ceil((n + 1) * 1.25 / slotCnt), which guarantees that there is at least one slot below the capacity
+    size_t capacity = ((wheel.mTargetCnt + 1) * kLoadFactorNumerator + slotCnt * kLoadFactorDenominator - 1)
+        / (slotCnt * kLoadFactorDenominator);
+    capacity = max<size_t>(capacity, 1);
+
+    uint64_t h = XXH64(id.data(), id.size(), 0);
+    size_t slot = h % slotCnt;
+    while (wheel.mLoads[slot] >= capacity) {
+        slot = (slot + 1) % slotCnt;
+    }
+    ++wheel.mLoads[slot];
+    ++wheel.mTargetCnt;
+
+    uint64_t slotBegin = slot * intervalMs / slotCnt;
+    uint64_t slotEnd = (slot + 1) * intervalMs / slotCnt;
+    uint64_t offset = slotBegin + (h >> 32) % max<uint64_t>(slotEnd - slotBegin, 1);
+    mAssignments[id] = {intervalMs, slot, offset};
+    return offset;
+}
+
+void ScrapeSlotAllocator::Release(const string& id) {
+    lock_guard<mutex> lock(mMux);
+    ReleaseLocked(id);
+}
+
+void ScrapeSlotAllocator::ReleaseLocked(const string& id) {
+    auto it = mAssignments.find(id);
+    if (it == mAssignments.end()) {
+        return;
+    }
+    auto wheelIt = mWheels.find(it->second.mIntervalMs);
+    if (wheelIt != mWheels.end()) {
+        --wheelIt->second.mLoads[it->second.mSlot];
+        if (--wheelIt->second.mTargetCnt == 0) {
+            mWheels.erase(wheelIt);
+        }
+    }
+    mAssignments.erase(it);
+}
+
+} // namespace logtail
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace logtail {
+
+// Assigns each scrape target an offset within its scrape interval, so that targets with the same interval are spread
+// evenly over the interval instead of piling up wherever their hashes happen to cluster.
+//
+// The interval is divided into slots of about prom_scrape_slot_width_ms. A target prefers the slot its hash falls in,
+// and probes the following slots only when the preferred one already holds more than its fair share of targets
+// (bounded-load consistent hashing). The offset within the slot is also derived from the hash. A target placed in its
+// preferred slot gets the same offset on every collector, while a target moved by the bound depends on which targets
+// were allocated before it, so its offset may differ after a restart or on another collector.
+class ScrapeSlotAllocator {
+public:
+    ScrapeSlotAllocator(const ScrapeSlotAllocator&) = delete;
+    ScrapeSlotAllocator& operator=(const ScrapeSlotAllocator&) = delete;
+
+    static ScrapeSlotAllocator* GetInstance() {
+        static ScrapeSlotAllocator instance;
+        return &instance;
+    }
+
+    // return the offset in milliseconds within the interval, which is the same for repeated calls with the same target
+    uint64_t Allocate(const std::string& id, uint64_t intervalSeconds);
+    void Release(const std::string& id);
+
+private:
+    struct SlotWheel {
+        std::vector<uint32_t> mLoads;
+        size_t mTargetCnt = 0;
+    };
+
+    struct Assignment {
+        uint64_t mIntervalMs = 0;
+        size_t mSlot = 0;
+        uint64_t mOffsetMs = 0;
+    };
+
+    ScrapeSlotAllocator() = default;
+    ~ScrapeSlotAllocator() = default;
+
+    void ReleaseLocked(const std::string& id);
+
+    std::mutex mMux;
+    std::map<uint64_t, SlotWheel> mWheels;
+    std::unordered_map<std::string, Assignment> mAssignments;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ScrapeSlotAllocatorUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -37,6 +37,7 @@
 #include "prometheus/async/PromFuture.h"
 #include "prometheus/async/PromHttpRequest.h"
 #include "prometheus/schedulers/ScrapeScheduler.h"
+#include "prometheus/schedulers/ScrapeSlotAllocator.h"
 
 using namespace std;
 
@@ -106,6 +107,7 @@ void TargetSubscriberScheduler::UpdateScrapeScheduler(
         for (auto& k : toRemove) {
             mScrapeSchedulerMap[k]->Cancel();
             mScrapeSchedulerMap.erase(k);
+            ScrapeSlotAllocator::GetInstance()->Release(k);
         }
 
         // save new scrape work
@@ -115,9 +117,14 @@ void TargetSubscriberScheduler::UpdateScrapeScheduler(
             if (mScrapeSchedulerMap.find(k) == mScrapeSchedulerMap.end()) {
                 added++;
                 mScrapeSchedulerMap[k] = v;
+                // spread targets evenly over the interval
                 auto tmpCurrentMilliSeconds = GetCurrentTimeInMilliSeconds();
+                auto offsetMilliSec
+                    = ScrapeSlotAllocator::GetInstance()->Allocate(v->GetId(), v->GetScrapeIntervalSeconds());
                 auto tmpRandSleepMilliSec
-                    = GetRandSleepMilliSec(v->GetId(), v->GetScrapeIntervalSeconds(), tmpCurrentMilliSeconds);
+                    = GetSleepMilliSecToOffset(offsetMilliSec, v->GetScrapeIntervalSeconds(), tmpCurrentMilliSeconds);
+                v->SetFirstExecTime(chrono::steady_clock::now() + chrono::milliseconds(tmpRandSleepMilliSec),
+                                    chrono::system_clock::now() + chrono::milliseconds(tmpRandSleepMilliSec));
 
                 // zero-cost upgrade
                 if ((mUnRegisterMs > 0
@@ -325,12 +332,6 @@ TargetSubscriberScheduler::BuildScrapeSchedulerSet(std::vector<PromTargetInfo>&
                                                                  targetInfo);
 
         scrapeScheduler->SetComponent(mEventPool);
-
-        auto randSleepMilliSec
-            = GetRandSleepMilliSec(scrapeScheduler->GetId(), scrapeIntervalSeconds, GetCurrentTimeInMilliSeconds());
-        auto firstExecTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(randSleepMilliSec);
-        auto firstScrapeTIme = std::chrono::system_clock::now() + std::chrono::milliseconds(randSleepMilliSec);
-        scrapeScheduler->SetFirstExecTime(firstExecTime, firstScrapeTIme);
         scrapeScheduler->InitSelfMonitor(mDefaultLabels);
 
         scrapeSchedulerMap[scrapeScheduler->GetId()] = scrapeScheduler;
@@ -453,6 +454,7 @@ void TargetSubscriberScheduler::CancelAllScrapeScheduler() {
     ReadLock lock(mRWLock);
     for (const auto& [k, v] : mScrapeSchedulerMap) {
         v->Cancel();
+        ScrapeSlotAllocator::GetInstance()->Release(k);
     }
 }
 
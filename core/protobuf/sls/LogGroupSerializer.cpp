@@ -14,7 +14,9 @@
 
 #include "protobuf/sls/LogGroupSerializer.h"
 
-#include "common/TimeUtil.h"
+#include <algorithm>
+
+#include "constants/SpanConstants.h"
 
 using namespace std;
 
@@ -97,6 +99,212 @@ static inline void fixed32_pack(uint32_t value, string& output) {
     }
 }
 
+namespace {
+
+// counts the bytes a writer would produce, so that the same code is used for size calculation and serialization
+class SizeCounter {
+public:
+    void Append(const char*, size_t size) { mSize += size; }
+    void Push(char) { ++mSize; }
+    size_t Size() const { return mSize; }
+
+private:
+    size_t mSize = 0;
+};
+
+class StringAppender {
+public:
+    explicit StringAppender(string& res) : mRes(res) {}
+    void Append(const char* data, size_t size) { mRes.append(data, size); }
+    void Push(char c) { mRes.push_back(c); }
+
+private:
+    string& mRes;
+};
+
+template <typename Writer>
+void WriteNumber(uint64_t value, Writer& writer) {
+    char buf[20];
+    size_t pos = sizeof(buf);
+    do {
+        buf[--pos] = '0' + value % 10;
+        value /= 10;
+    } while (value != 0);
+    writer.Append(buf + pos, sizeof(buf) - pos);
+}
+
+template <typename Writer>
+void WriteFixedWidthNumber(uint64_t value, size_t width, Writer& writer) {
+    char buf[20];
+    size_t pos = width;
+    while (pos > 0) {
+        buf[--pos] = '0' + value % 10;
+        value /= 10;
+    }
+    writer.Append(buf, width);
+}
+
+// only '"', '\\' and control characters are escaped, other bytes (including utf8) are written as is
+template <typename Writer>
+void WriteJsonString(StringView value, Writer& writer) {
+    static const char sHexDigits[] = "0123456789abcdef";
+    writer.Push('"');
+    const char* pending = value.data();
+    const char* end = value.data() + value.size();
+    for (const char* p = pending; p != end; ++p) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        writer.Append(pending, p - pending);
+        pending = p + 1;
+        writer.Push('\\');
+        switch (c) {
+            case '"':
+                writer.Push('"');
+                break;
+            case '\\':
+                writer.Push('\\');
+                break;
+            case '\b':
+                writer.Push('b');
+                break;
+            case '\f':
+                writer.Push('f');
+                break;
+            case '\n':
+                writer.Push('n');
+                break;
+            case '\r':
+                writer.Push('r');
+                break;
+            case '\t':
+                writer.Push('t');
+                break;
+            default:
+                writer.Append("u00", 3);
+                writer.Push(sHexDigits[c >> 4]);
+                writer.Push(sHexDigits[c & 0xF]);
+                break;
+        }
+    }
+    writer.Append(pending, end - pending);
+    writer.Push('"');
+}
+
+template <typename Writer>
+void WriteJsonMember(StringView key, StringView value, Writer& writer) {
+    WriteJsonString(key, writer);
+    writer.Push(':');
+    WriteJsonString(value, writer);
+}
+
+template <typename Writer>
+void WriteJsonTags(map<StringView, StringView>::const_iterator begin,
+                   map<StringView, StringView>::const_iterator end,
+                   Writer& writer) {
+    writer.Push('{');
+    for (auto it = begin; it != end; ++it) {
+        if (it != begin) {
+            writer.Push(',');
+        }
+        WriteJsonMember(it->first, it->second, writer);
+    }
+    writer.Push('}');
+}
+
+// keys are written in ascending order, as jsoncpp does
+template <typename Writer>
+void WriteSpanAttributes(const SpanEvent& e, Writer& writer) {
+    if (e.TagsSize() == 0 && e.ScopeTagsSize() == 0) {
+        // keep compatible with the serialization of an empty Json::Value
+        writer.Append("null", 4);
+        return;
+    }
+    writer.Push('{');
+    auto tag = e.TagsBegin();
+    auto scopeTag = e.ScopeTagsBegin();
+    bool first = true;
+    while (tag != e.TagsEnd() || scopeTag != e.ScopeTagsEnd()) {
+        map<StringView, StringView>::const_iterator cur;
+        if (scopeTag == e.ScopeTagsEnd() || (tag != e.TagsEnd() && tag->first < scopeTag->first)) {
+            cur = tag++;
+        } else {
+            if (tag != e.TagsEnd() && tag->first == scopeTag->first) {
+                // scope tag overrides tag with the same key
+                ++tag;
+            }
+            cur = scopeTag++;
+        }
+        if (!first) {
+            writer.Push(',');
+        }
+        first = false;
+        WriteJsonMember(cur->first, cur->second, writer);
+    }
+    writer.Push('}');
+}
+
+template <typename Writer>
+void WriteSpanLinks(const SpanEvent& e, Writer& writer) {
+    if (e.GetLinks().empty()) {
+        return;
+    }
+    writer.Push('[');
+    for (size_t i = 0; i < e.GetLinks().size(); ++i) {
+        const auto& link = e.GetLinks()[i];
+        if (i != 0) {
+            writer.Push(',');
+        }
+        writer.Push('{');
+        if (link.TagsSize() > 0) {
+            WriteJsonString(DEFAULT_TRACE_TAG_ATTRIBUTES, writer);
+            writer.Push(':');
+            WriteJsonTags(link.TagsBegin(), link.TagsEnd(), writer);
+            writer.Push(',');
+        }
+        WriteJsonMember(DEFAULT_TRACE_TAG_SPAN_ID, link.GetSpanId(), writer);
+        writer.Push(',');
+        WriteJsonMember(DEFAULT_TRACE_TAG_TRACE_ID, link.GetTraceId(), writer);
+        if (!link.GetTraceState().empty()) {
+            writer.Push(',');
+            WriteJsonMember(DEFAULT_TRACE_TAG_TRACE_STATE, link.GetTraceState(), writer);
+        }
+        writer.Push('}');
+    }
+    writer.Push(']');
+}
+
+template <typename Writer>
+void WriteSpanEvents(const SpanEvent& e, Writer& writer) {
+    if (e.GetEvents().empty()) {
+        return;
+    }
+    writer.Push('[');
+    for (size_t i = 0; i < e.GetEvents().size(); ++i) {
+        const auto& event = e.GetEvents()[i];
+        if (i != 0) {
+            writer.Push(',');
+        }
+        writer.Push('{');
+        if (event.TagsSize() > 0) {
+            WriteJsonString(DEFAULT_TRACE_TAG_ATTRIBUTES, writer);
+            writer.Push(':');
+            WriteJsonTags(event.TagsBegin(), event.TagsEnd(), writer);
+            writer.Push(',');
+        }
+        WriteJsonMember(DEFAULT_TRACE_TAG_SPAN_EVENT_NAME, event.GetName(), writer);
+        writer.Push(',');
+        WriteJsonString(DEFAULT_TRACE_TAG_TIMESTAMP, writer);
+        writer.Push(':');
+        WriteNumber(event.GetTimestampNs(), writer);
+        writer.Push('}');
+    }
+    writer.Push(']');
+}
+
+} // namespace
+
 void LogGroupSerializer::Prepare(size_t size) {
     mRes.clear();
     mRes.reserve(size);
@@ -120,19 +328,7 @@ void LogGroupSerializer::AddLogTime(uint32_t logTime) {
 }
 
 void LogGroupSerializer::AddLogContent(StringView key, StringView value) {
-    // Contents
-    // field = 2, wire_type = 2
-    mRes.push_back(0x12);
-    uint32_pack(GetStringSize(key.size()) + GetStringSize(value.size()), mRes);
-    // Key
-    // field = 1, wire_type = 2
-    mRes.push_back(0x0A);
-    uint32_pack(key.size(), mRes);
-    mRes.append(key.data(), key.size());
-    // Value
-    // field = 2, wire_type = 2
-    mRes.push_back(0x12);
-    uint32_pack(value.size(), mRes);
+    StartToAddLogContent(key, value.size());
     mRes.append(value.data(), value.size());
 }
 
@@ -182,6 +378,22 @@ void LogGroupSerializer::AddString(StringView value) {
     mRes.append(value.data(), value.size());
 }
 
+void LogGroupSerializer::StartToAddLogContent(StringView key, size_t valueSZ) {
+    // Contents
+    // field = 2, wire_type = 2
+    mRes.push_back(0x12);
+    uint32_pack(GetStringSize(key.size()) + GetStringSize(valueSZ), mRes);
+    // Key
+    // field = 1, wire_type = 2
+    mRes.push_back(0x0A);
+    uint32_pack(key.size(), mRes);
+    mRes.append(key.data(), key.size());
+    // Value, whose content should be appended by the caller
+    // field = 2, wire_type = 2
+    mRes.push_back(0x12);
+    uint32_pack(valueSZ, mRes);
+}
+
 void LogGroupSerializer::AddLogContentMetricLabel(const MetricEvent& e, size_t valueSZ) {
     // Contents
     mRes.push_back(0x12);
@@ -194,14 +406,29 @@ void LogGroupSerializer::AddLogContentMetricLabel(const MetricEvent& e, size_t v
     mRes.push_back(0x12);
     uint32_pack(valueSZ, mRes);
     bool hasPrev = false;
-    for (auto it = e.TagsBegin(); it != e.TagsEnd(); ++it) {
+    auto addLabel = [&](const pair<StringView, StringView>& tag) {
         if (hasPrev) {
             mRes.append(METRIC_LABELS_SEPARATOR);
         }
         hasPrev = true;
-        mRes.append(it->first.data(), it->first.size());
+        mRes.append(tag.first.data(), tag.first.size());
         mRes.append(METRIC_LABELS_KEY_VALUE_SEPARATOR);
-        mRes.append(it->second.data(), it->second.size());
+        mRes.append(tag.second.data(), tag.second.size());
+    };
+    if (is_sorted(e.TagsBegin(), e.TagsEnd())) {
+        for (auto it = e.TagsBegin(); it != e.TagsEnd(); ++it) {
+            addLabel(*it);
+        }
+        return;
+    }
+    vector<const pair<StringView, StringView>*> tags;
+    tags.reserve(e.TagsSize());
+    for (auto it = e.TagsBegin(); it != e.TagsEnd(); ++it) {
+        tags.push_back(&*it);
+    }
+    sort(tags.begin(), tags.end(), [](const auto* lhs, const auto* rhs) { return *lhs < *rhs; });
+    for (const auto* tag : tags) {
+        addLabel(*tag);
     }
 }
 
@@ -217,13 +444,37 @@ void LogGroupSerializer::AddLogContentMetricTimeNano(const MetricEvent& e) {
     // Value
     mRes.push_back(0x12);
     uint32_pack(valueSZ, mRes);
-    // TODO: avoid copy
-    mRes.append(to_string(e.GetTimestamp()));
+    StringAppender writer(mRes);
+    WriteNumber(static_cast<uint64_t>(e.GetTimestamp()), writer);
     if (e.GetTimestampNanosecond()) {
-        mRes.append(NumberToDigitString(e.GetTimestampNanosecond().value(), 9));
+        WriteFixedWidthNumber(e.GetTimestampNanosecond().value(), 9, writer);
     }
 }
 
+void LogGroupSerializer::AddLogContent(StringView key, uint64_t value) {
+    StartToAddLogContent(key, GetNumberStringSize(value));
+    StringAppender writer(mRes);
+    WriteNumber(value, writer);
+}
+
+void LogGroupSerializer::AddLogContentSpanAttributes(const SpanEvent& e, size_t valueSZ) {
+    StartToAddLogContent(DEFAULT_TRACE_TAG_ATTRIBUTES, valueSZ);
+    StringAppender writer(mRes);
+    WriteSpanAttributes(e, writer);
+}
+
+void LogGroupSerializer::AddLogContentSpanLinks(const SpanEvent& e, size_t valueSZ) {
+    StartToAddLogContent(DEFAULT_TRACE_TAG_LINKS, valueSZ);
+    StringAppender writer(mRes);
+    WriteSpanLinks(e, writer);
+}
+
+void LogGroupSerializer::AddLogContentSpanEvents(const SpanEvent& e, size_t valueSZ) {
+    StartToAddLogContent(DEFAULT_TRACE_TAG_EVENTS, valueSZ);
+    StringAppender writer(mRes);
+    WriteSpanEvents(e, writer);
+}
+
 size_t GetLogContentSize(size_t keySZ, size_t valueSZ) {
     size_t res = 0;
     res += GetStringSize(keySZ) + GetStringSize(valueSZ);
@@ -269,4 +520,31 @@ size_t GetMetricLabelSize(const MetricEvent& e) {
     return valueSZ;
 }
 
+size_t GetNumberStringSize(uint64_t value) {
+    size_t res = 1;
+    while (value >= 10) {
+        value /= 10;
+        ++res;
+    }
+    return res;
+}
+
+size_t GetSpanAttributesSize(const SpanEvent& e) {
+    SizeCounter counter;
+    WriteSpanAttributes(e, counter);
+    return counter.Size();
+}
+
+size_t GetSpanLinksSize(const SpanEvent& e) {
+    SizeCounter counter;
+    WriteSpanLinks(e, counter);
+    return counter.Size();
+}
+
+size_t GetSpanEventsSize(const SpanEvent& e) {
+    SizeCounter counter;
+    WriteSpanEvents(e, counter);
+    return counter.Size();
+}
+
 } // namespace logtail
@@ -22,6 +22,7 @@
 
 #include "common/StringView.h"
 #include "models/MetricEvent.h"
+#include "models/SpanEvent.h"
 
 namespace logtail {
 
@@ -47,11 +48,19 @@ public:
     void AddLogTag(StringView key, StringView value);
     std::string& GetResult() { return mRes; }
 
+    // labels are written in the order of their keys, without sorting the tags of the event, which may be shared
     void AddLogContentMetricLabel(const MetricEvent& e, size_t valueSZ);
     void AddLogContentMetricTimeNano(const MetricEvent& e);
 
+    // the following methods write the value in place, so no intermediate string is needed
+    void AddLogContent(StringView key, uint64_t value);
+    void AddLogContentSpanAttributes(const SpanEvent& e, size_t valueSZ);
+    void AddLogContentSpanLinks(const SpanEvent& e, size_t valueSZ);
+    void AddLogContentSpanEvents(const SpanEvent& e, size_t valueSZ);
+
 private:
     void AddString(StringView value);
+    void StartToAddLogContent(StringView key, size_t valueSZ);
 
     std::string mRes;
 };
@@ -63,4 +72,11 @@ size_t GetLogTagSize(size_t keySZ, size_t valueSZ);
 
 size_t GetMetricLabelSize(const MetricEvent& e);
 
+size_t GetNumberStringSize(uint64_t value);
+// span attributes are serialized as a json object, with scope tags overriding tags with the same key
+size_t GetSpanAttributesSize(const SpanEvent& e);
+// span links and events are serialized as json arrays, or empty string if there is none
+size_t GetSpanLinksSize(const SpanEvent& e);
+size_t GetSpanEventsSize(const SpanEvent& e);
+
 } // namespace logtail
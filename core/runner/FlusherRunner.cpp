@@ -14,6 +14,8 @@
 
 #include "runner/FlusherRunner.h"
 
+#include <algorithm>
+
 #include "app_config/AppConfig.h"
 #include "application/Application.h"
 #include "collection_pipeline/plugin/interface/HttpFlusher.h"
@@ -29,6 +31,7 @@
 #include "runner/sink/http/HttpSink.h"
 
 DEFINE_FLAG_INT32(flusher_runner_exit_timeout_sec, "", 60);
+DEFINE_FLAG_INT32(flusher_runner_http_batch_size, "max number of requests handed to http sink at once", 64);
 
 DECLARE_FLAG_INT32(discard_send_fail_interval);
 
@@ -110,9 +113,19 @@ void FlusherRunner::DecreaseHttpSendingCnt() {
 }
 
 void FlusherRunner::PushToHttpSink(SenderQueueItem* item, bool withLimit) {
+    vector<unique_ptr<HttpSinkRequest>> requests;
+    PushToHttpSink(item, requests, withLimit);
+    FlushHttpSinkRequests(requests);
+}
+
+void FlusherRunner::PushToHttpSink(SenderQueueItem* item,
+                                   vector<unique_ptr<HttpSinkRequest>>& requests,
+                                   bool withLimit) {
     // TODO: use semaphore instead
     while (withLimit && !Application::GetInstance()->IsExiting()
            && GetSendingBufferCount() >= AppConfig::GetInstance()->GetSendRequestGlobalConcurrency()) {
+        // pending requests are counted as sending, so they must be sent before waiting
+        FlushHttpSinkRequests(requests);
         this_thread::sleep_for(chrono::milliseconds(10));
     }
 
@@ -143,10 +156,17 @@ void FlusherRunner::PushToHttpSink(SenderQueueItem* item, bool withLimit) {
               ("send item to http sink, item address", item)("config-flusher-dst",
                                                              QueueKeyManager::GetInstance()->GetName(item->mQueueKey))(
                   "sending cnt", ToString(mHttpSendingCnt.load() + 1)));
-    HttpSink::GetInstance()->AddRequest(std::move(req));
+    requests.emplace_back(std::move(req));
     ++mHttpSendingCnt;
 }
 
+void FlusherRunner::FlushHttpSinkRequests(vector<unique_ptr<HttpSinkRequest>>& requests) {
+    if (requests.empty()) {
+        return;
+    }
+    HttpSink::GetInstance()->AddRequests(requests);
+}
+
 void FlusherRunner::Run() {
     LOG_INFO(sLogger, ("flusher runner", "started"));
     while (true) {
@@ -158,6 +178,7 @@ void FlusherRunner::Run() {
             ? -1
             : AppConfig::GetInstance()->GetSendRequestGlobalConcurrency();
         SenderQueueManager::GetInstance()->GetAvailableItems(items, limit);
+        LoadSpilledData(items);
         if (items.empty()) {
             SenderQueueManager::GetInstance()->Wait(1000);
         } else {
@@ -170,6 +191,7 @@ void FlusherRunner::Run() {
             ADD_GAUGE(mWaitingItemsTotal, items.size());
         }
 
+        vector<unique_ptr<HttpSinkRequest>> requests;
         for (auto itr = items.begin(); itr != items.end(); ++itr) {
             LOG_TRACE(
                 sLogger,
@@ -181,14 +203,20 @@ void FlusherRunner::Run() {
 
             // TODO: use rate limiter instead
             if (!Application::GetInstance()->IsExiting() && mEnableRateLimiter) {
+                // the flow control may sleep, so pending requests should not wait for it
+                FlushHttpSinkRequests(requests);
                 RateLimiter::FlowControl((*itr)->mRawSize, mSendLastTime, mSendLastByte, true);
             }
 
-            Dispatch(*itr);
+            Dispatch(*itr, requests);
+            if (requests.size() >= static_cast<size_t>(INT32_FLAG(flusher_runner_http_batch_size))) {
+                FlushHttpSinkRequests(requests);
+            }
             SUB_GAUGE(mWaitingItemsTotal, 1);
             ADD_COUNTER(mOutItemsTotal, 1);
             ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - curTime);
         }
+        FlushHttpSinkRequests(requests);
 
         if (mIsFlush && SenderQueueManager::GetInstance()->IsAllQueueEmpty()) {
             break;
@@ -196,7 +224,34 @@ void FlusherRunner::Run() {
     }
 }
 
+void FlusherRunner::LoadSpilledData(vector<SenderQueueItem*>& items) {
+    // items fetched are marked as sending, so they are accessed without the lock of the sender queues
+    auto it = remove_if(items.begin(), items.end(), [](SenderQueueItem* item) {
+        if (item->LoadSpilledData()) {
+            return false;
+        }
+        LOG_ERROR(sLogger,
+                  ("failed to read spilled data of sender queue", "record is missing or corrupted")(
+                      "action", "discard data")("config-flusher-dst",
+                                                QueueKeyManager::GetInstance()->GetName(item->mQueueKey))(
+                      "size", item->GetDataSize()));
+        AlarmManager::GetInstance()->SendAlarm(DISCARD_DATA_ALARM,
+                                               "failed to read spilled data of sender queue: record is missing or "
+                                               "corrupted\taction: discard data\tsize: "
+                                                   + ToString(item->GetDataSize()));
+        SenderQueueManager::GetInstance()->RemoveItem(item->mQueueKey, item);
+        return true;
+    });
+    items.erase(it, items.end());
+}
+
 void FlusherRunner::Dispatch(SenderQueueItem* item) {
+    vector<unique_ptr<HttpSinkRequest>> requests;
+    Dispatch(item, requests);
+    FlushHttpSinkRequests(requests);
+}
+
+void FlusherRunner::Dispatch(SenderQueueItem* item, vector<unique_ptr<HttpSinkRequest>>& requests) {
     switch (item->mFlusher->GetSinkType()) {
         case SinkType::HTTP:
             // TODO: make it common for all http flushers
@@ -205,7 +260,7 @@ void FlusherRunner::Dispatch(SenderQueueItem* item) {
                 DiskBufferWriter::GetInstance()->PushToDiskBuffer(item, 3);
                 SenderQueueManager::GetInstance()->RemoveItem(item->mQueueKey, item);
             } else {
-                PushToHttpSink(item);
+                PushToHttpSink(item, requests);
             }
             break;
         default:
@@ -20,11 +20,14 @@
 
 #include <atomic>
 #include <future>
+#include <memory>
+#include <vector>
 
 #include "collection_pipeline/plugin/interface/Flusher.h"
 #include "collection_pipeline/queue/SenderQueueItem.h"
 #include "monitor/MetricManager.h"
 #include "runner/sink/SinkType.h"
+#include "runner/sink/http/HttpSinkRequest.h"
 
 namespace logtail {
 
@@ -53,7 +56,15 @@ private:
     ~FlusherRunner() = default;
 
     void Run();
+    // items whose spilled data cannot be read back are removed from their queues and from items
+    void LoadSpilledData(std::vector<SenderQueueItem*>& items);
     void Dispatch(SenderQueueItem* item);
+    // http requests are appended to requests instead of being sent to http sink immediately
+    void Dispatch(SenderQueueItem* item, std::vector<std::unique_ptr<HttpSinkRequest>>& requests);
+    void PushToHttpSink(SenderQueueItem* item,
+                        std::vector<std::unique_ptr<HttpSinkRequest>>& requests,
+                        bool withLimit = true);
+    void FlushHttpSinkRequests(std::vector<std::unique_ptr<HttpSinkRequest>>& requests);
     bool LoadModuleConfig(bool isInit);
     void UpdateSendFlowControl();
 
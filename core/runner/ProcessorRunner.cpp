@@ -27,6 +27,11 @@
 
 DEFINE_FLAG_INT32(default_flush_merged_buffer_interval, "default flush merged buffer, seconds", 1);
 DEFINE_FLAG_INT32(processor_runner_exit_timeout_sec, "", 60);
+DEFINE_FLAG_INT32(go_pipeline_batch_max_size_bytes,
+                  "max size of log groups handed over to a go pipeline in one call",
+                  256 * 1024);
+DEFINE_FLAG_INT32(go_pipeline_batch_max_items, "max number of process queue items in one go pipeline batch", 64);
+DEFINE_FLAG_INT32(go_pipeline_batch_timeout_ms, "max time log groups wait before handed over to go pipeline", 100);
 
 DECLARE_FLAG_INT32(max_send_log_group_size);
 
@@ -102,17 +107,23 @@ void ProcessorRunner::Run(uint32_t threadNo) {
     sLastRunTime = sMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
 
     static int32_t lastFlushBatchTime = 0;
+    GoPipelineBatchMap goPipelineBatches;
     while (true) {
         int32_t curTime = time(nullptr);
         if (threadNo == 0 && curTime - lastFlushBatchTime >= INT32_FLAG(default_flush_merged_buffer_interval)) {
             TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
             lastFlushBatchTime = curTime;
         }
+        if (!goPipelineBatches.empty()) {
+            SendGoPipelineBatches(goPipelineBatches, false);
+        }
 
         SET_GAUGE(sLastRunTime, curTime);
         unique_ptr<ProcessQueueItem> item;
         string configName;
         if (!ProcessQueueManager::GetInstance()->PopItem(threadNo, item, configName)) {
+            // nothing more to batch, so do not hold the data any longer
+            SendGoPipelineBatches(goPipelineBatches, true);
             if (mIsFlush && ProcessQueueManager::GetInstance()->IsAllQueueEmpty()) {
                 break;
             }
@@ -156,6 +167,12 @@ void ProcessorRunner::Run(uint32_t threadNo) {
             // TODO:
             // 1. allow all event types to be sent to Go pipelines
             // 2. use event group protobuf instead
+            if (isLog && LogtailPlugin::GetInstance()->IsProcessLogGroupsSupported()) {
+                // in process cnt of the item is released once the batch is sent
+                AddToGoPipelineBatch(goPipelineBatches, pipeline, eventGroupList);
+                gThreadedEventPool.CheckGC();
+                continue;
+            }
             if (isLog) {
                 for (auto& group : eventGroupList) {
                     string res, errorMsg;
@@ -164,17 +181,7 @@ void ProcessorRunner::Run(uint32_t threadNo) {
                                    pipeline->GetContext().GetLogstoreName(),
                                    res,
                                    errorMsg)) {
-                        LOG_WARNING(pipeline->GetContext().GetLogger(),
-                                    ("failed to serialize event group",
-                                     errorMsg)("action", "discard data")("config", configName));
-                        pipeline->GetContext().GetAlarm().SendAlarm(SERIALIZE_FAIL_ALARM,
-                                                                    "failed to serialize event group: " + errorMsg
-                                                                        + "\taction: discard data\tconfig: "
-                                                                        + configName,
-                                                                    pipeline->GetContext().GetRegion(),
-                                                                    pipeline->GetContext().GetProjectName(),
-                                                                    configName,
-                                                                    pipeline->GetContext().GetLogstoreName());
+                        OnSerializeFailed(pipeline->GetContext(), errorMsg);
                         continue;
                     }
                     LogtailPlugin::GetInstance()->ProcessLogGroup(
@@ -192,6 +199,75 @@ void ProcessorRunner::Run(uint32_t threadNo) {
     }
 }
 
+void ProcessorRunner::AddToGoPipelineBatch(GoPipelineBatchMap& batches,
+                                           const shared_ptr<CollectionPipeline>& pipeline,
+                                           vector<PipelineEventGroup>& groups) {
+    const auto& ctx = pipeline->GetContext();
+    auto& batch = batches[ctx.GetConfigName()];
+    if (batch.mPipeline != pipeline) {
+        // the pipeline has been updated, data from the old one should be sent first
+        SendGoPipelineBatch(batch);
+        batch.mPipeline = pipeline;
+        batch.mCreateTime = chrono::steady_clock::now();
+    }
+    for (const auto& group : groups) {
+        string errorMsg;
+        if (!batch.mBatch.Add(group,
+                              ctx.GetGlobalConfig().mEnableTimestampNanosecond,
+                              ctx.GetLogstoreName(),
+                              group.GetMetadata(EventGroupMetaKey::SOURCE_ID).to_string(),
+                              errorMsg)) {
+            OnSerializeFailed(ctx, errorMsg);
+        }
+    }
+    ++batch.mItemCnt;
+    if (batch.mBatch.GetDataSize() >= static_cast<size_t>(INT32_FLAG(go_pipeline_batch_max_size_bytes))
+        || batch.mItemCnt >= static_cast<size_t>(INT32_FLAG(go_pipeline_batch_max_items))) {
+        SendGoPipelineBatch(batch);
+        batches.erase(ctx.GetConfigName());
+    }
+}
+
+void ProcessorRunner::SendGoPipelineBatches(GoPipelineBatchMap& batches, bool force) {
+    auto now = chrono::steady_clock::now();
+    for (auto it = batches.begin(); it != batches.end();) {
+        if (force || now - it->second.mCreateTime >= chrono::milliseconds(INT32_FLAG(go_pipeline_batch_timeout_ms))) {
+            SendGoPipelineBatch(it->second);
+            it = batches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ProcessorRunner::SendGoPipelineBatch(GoPipelineBatch& batch) {
+    if (!batch.mPipeline) {
+        return;
+    }
+    if (!batch.mBatch.IsEmpty()) {
+        batch.mBatch.Finalize();
+        LogtailPlugin::GetInstance()->ProcessLogGroups(batch.mPipeline->GetContext().GetConfigName(), batch.mBatch);
+        batch.mBatch.Clear();
+    }
+    for (size_t i = 0; i < batch.mItemCnt; ++i) {
+        batch.mPipeline->SubInProcessCnt();
+    }
+    batch.mItemCnt = 0;
+    batch.mPipeline.reset();
+}
+
+void ProcessorRunner::OnSerializeFailed(const CollectionPipelineContext& ctx, const string& errorMsg) {
+    LOG_WARNING(ctx.GetLogger(),
+                ("failed to serialize event group", errorMsg)("action", "discard data")("config", ctx.GetConfigName()));
+    ctx.GetAlarm().SendAlarm(SERIALIZE_FAIL_ALARM,
+                             "failed to serialize event group: " + errorMsg
+                                 + "\taction: discard data\tconfig: " + ctx.GetConfigName(),
+                             ctx.GetRegion(),
+                             ctx.GetProjectName(),
+                             ctx.GetConfigName(),
+                             ctx.GetLogstoreName());
+}
+
 bool ProcessorRunner::Serialize(
     const PipelineEventGroup& group, bool enableNanosecond, const string& logstore, string& res, string& errorMsg) {
     sls_logs::LogGroup logGroup;
@@ -19,16 +19,23 @@
 #include <cstdint>
 
 #include <atomic>
+#include <chrono>
 #include <future>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "collection_pipeline/queue/QueueKey.h"
+#include "go_pipeline/FlatLogGroupBatch.h"
 #include "models/PipelineEventGroup.h"
 #include "monitor/MetricManager.h"
 
 namespace logtail {
 
+class CollectionPipeline;
+class CollectionPipelineContext;
+
 class ProcessorRunner {
 public:
     ProcessorRunner(const ProcessorRunner&) = delete;
@@ -46,11 +53,29 @@ public:
     bool PushQueue(QueueKey key, size_t inputIndex, PipelineEventGroup&& group, uint32_t retryTimes = 1);
 
 private:
+    // log groups waiting to be handed over to the Go pipeline of a config in one call
+    struct GoPipelineBatch {
+        std::shared_ptr<CollectionPipeline> mPipeline;
+        FlatLogGroupBatch mBatch;
+        // items whose in process cnt is not released until the batch is sent
+        size_t mItemCnt = 0;
+        std::chrono::steady_clock::time_point mCreateTime;
+    };
+    using GoPipelineBatchMap = std::unordered_map<std::string, GoPipelineBatch>;
+
     ProcessorRunner();
     ~ProcessorRunner() = default;
 
     void Run(uint32_t threadNo);
 
+    void AddToGoPipelineBatch(GoPipelineBatchMap& batches,
+                              const std::shared_ptr<CollectionPipeline>& pipeline,
+                              std::vector<PipelineEventGroup>& groups);
+    // sends all batches when force is true, otherwise only those that have waited long enough
+    void SendGoPipelineBatches(GoPipelineBatchMap& batches, bool force);
+    void SendGoPipelineBatch(GoPipelineBatch& batch);
+    void OnSerializeFailed(const CollectionPipelineContext& ctx, const std::string& errorMsg);
+
     bool Serialize(const PipelineEventGroup& group,
                    bool enableNanosecond,
                    const std::string& logstore,
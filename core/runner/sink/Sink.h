@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "common/SafeQueue.h"
 
@@ -28,11 +29,14 @@ public:
     virtual bool Init() = 0;
     virtual void Stop() = 0;
 
-    bool AddRequest(std::unique_ptr<T>&& request) {
+    virtual bool AddRequest(std::unique_ptr<T>&& request) {
         mQueue.Push(std::move(request));
         return true;
     }
 
+    // requests are moved out, and the vector is cleared afterwards
+    virtual void AddRequests(std::vector<std::unique_ptr<T>>& requests) { mQueue.PushAll(requests); }
+
 protected:
     SafeQueue<std::unique_ptr<T>> mQueue;
 };
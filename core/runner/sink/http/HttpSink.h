@@ -16,19 +16,17 @@
 
 #pragma once
 
-#include <atomic>
-#include <condition_variable>
-#include <future>
-#include <mutex>
+#include <memory>
+#include <vector>
 
-#include "curl/multi.h"
-
-#include "monitor/MetricManager.h"
 #include "runner/sink/Sink.h"
 #include "runner/sink/http/HttpSinkRequest.h"
+#include "runner/sink/http/HttpSinkWorker.h"
 
 namespace logtail {
 
+// Requests are distributed to a configurable number of workers, each with its own curl multi handle. Requests to the
+// same endpoint always go to the same worker so that keep-alive connections can be reused.
 class HttpSink : public Sink<HttpSinkRequest> {
 public:
     HttpSink(const HttpSink&) = delete;
@@ -39,29 +37,20 @@ public:
     bool Init() override;
     void Stop() override;
 
+    bool AddRequest(std::unique_ptr<HttpSinkRequest>&& request) override;
+    void AddRequests(std::vector<std::unique_ptr<HttpSinkRequest>>& requests) override;
+
+    size_t GetWorkerCnt() const { return mWorkers.size(); }
+
 private:
     HttpSink() = default;
     ~HttpSink() = default;
 
-    void Run();
-    bool AddRequestToClient(std::unique_ptr<HttpSinkRequest>&& request);
-    void DoRun();
-    void HandleCompletedRequests(int& runningHandlers);
-
-    CURLM* mClient = nullptr;
-
-    std::future<void> mThreadRes;
-    std::atomic_bool mIsFlush = false;
+    size_t GetWorkerIndex(const HttpSinkRequest& request) const;
+    // complete the request with a network error when there is no worker to send it
+    void FailRequest(std::unique_ptr<HttpSinkRequest>&& request);
 
-    mutable MetricsRecordRef mMetricsRecordRef;
-    CounterPtr mInItemsTotal;
-    CounterPtr mOutSuccessfulItemsTotal;
-    CounterPtr mOutFailedItemsTotal;
-    TimeCounterPtr mSuccessfulItemTotalResponseTimeMs;
-    TimeCounterPtr mFailedItemTotalResponseTimeMs;
-    IntGaugePtr mSendingItemsTotal;
-    IntGaugePtr mSendConcurrency;
-    IntGaugePtr mLastRunTime;
+    std::vector<std::unique_ptr<HttpSinkWorker>> mWorkers;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class FlusherRunnerUnittest;
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "curl/multi.h"
+
+#include "common/SafeQueue.h"
+#include "monitor/MetricManager.h"
+#include "runner/sink/http/HttpSinkRequest.h"
+
+namespace logtail {
+
+// A single http sink thread driving its own curl multi handle, and thus its own connection cache.
+class HttpSinkWorker {
+public:
+    explicit HttpSinkWorker(size_t id) : mId(id) {}
+    HttpSinkWorker(const HttpSinkWorker&) = delete;
+    HttpSinkWorker& operator=(const HttpSinkWorker&) = delete;
+
+    bool Init();
+    // only notifies the worker to exit once all requests are sent, use WaitForExit to wait for it
+    void Stop();
+    bool WaitForExit(std::chrono::steady_clock::time_point deadline);
+
+    void AddRequest(std::unique_ptr<HttpSinkRequest>&& request) { mQueue.Push(std::move(request)); }
+    void AddRequests(std::vector<std::unique_ptr<HttpSinkRequest>>& requests) { mQueue.PushAll(requests); }
+
+    size_t GetId() const { return mId; }
+
+private:
+    void Run();
+    bool AddRequestToClient(std::unique_ptr<HttpSinkRequest>&& request);
+    void OnRequestPopped(const HttpSinkRequest& request);
+    void DoRun();
+    void HandleCompletedRequests(int& runningHandlers);
+
+    size_t mId = 0;
+    CURLM* mClient = nullptr;
+    SafeQueue<std::unique_ptr<HttpSinkRequest>> mQueue;
+
+    std::future<void> mThreadRes;
+    std::atomic_bool mIsFlush = false;
+
+    mutable MetricsRecordRef mMetricsRecordRef;
+    CounterPtr mInItemsTotal;
+    TimeCounterPtr mTotalDelayMs;
+    CounterPtr mOutSuccessfulItemsTotal;
+    CounterPtr mOutFailedItemsTotal;
+    TimeCounterPtr mSuccessfulItemTotalResponseTimeMs;
+    TimeCounterPtr mFailedItemTotalResponseTimeMs;
+    IntGaugePtr mSendingItemsTotal;
+    IntGaugePtr mSendConcurrency;
+    IntGaugePtr mLastRunTime;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FlusherRunnerUnittest;
+#endif
+};
+
+} // namespace logtail
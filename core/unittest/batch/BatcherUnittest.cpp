@@ -13,10 +13,13 @@
 // limitations under the License.
 
 #include "collection_pipeline/batch/Batcher.h"
+#include "common/Flags.h"
 #include "common/JsonUtil.h"
 #include "unittest/Unittest.h"
 #include "unittest/plugin/PluginMock.h"
 
+DECLARE_FLAG_INT32(adaptive_batch_adjust_interval_secs);
+
 using namespace std;
 
 namespace logtail {
@@ -26,6 +29,8 @@ public:
     void TestParamInit();
     void TestInitWithoutGroupBatch();
     void TestInitWithGroupBatch();
+    void TestInitWithAdaptiveBatch();
+    void TestAdaptiveTimeoutRecord();
     void TestAddWithoutGroupBatch();
     void TestAddWithGroupBatch();
     void TestAddWithOversizedGroup();
@@ -141,6 +146,99 @@ void BatcherUnittest::TestInitWithGroupBatch() {
     APSARA_TEST_EQUAL(sFlusher.get(), batch.mFlusher);
 }
 
+void BatcherUnittest::TestInitWithAdaptiveBatch() {
+    DefaultFlushStrategyOptions strategy;
+    strategy.mMaxSizeBytes = 3000;
+    strategy.mMinSizeBytes = 1000;
+    strategy.mTimeoutSecs = 5;
+    {
+        // default limits
+        Json::Value configJson;
+        configJson["EnableAdaptive"] = true;
+        Batcher<> batch;
+        batch.Init(configJson, sFlusher.get(), strategy, true);
+        APSARA_TEST_TRUE(batch.mAdaptiveFlushStrategy);
+        APSARA_TEST_EQUAL(250U, batch.mAdaptiveFlushStrategy->mOptions.mMinSizeBytesLowerLimit);
+        APSARA_TEST_EQUAL(3000U, batch.mAdaptiveFlushStrategy->mOptions.mMinSizeBytesUpperLimit);
+        APSARA_TEST_EQUAL(1U, batch.mAdaptiveFlushStrategy->mOptions.mTimeoutSecsLowerLimit);
+        APSARA_TEST_EQUAL(10U, batch.mAdaptiveFlushStrategy->mOptions.mTimeoutSecsUpperLimit);
+        APSARA_TEST_EQUAL(1000U, batch.mEventFlushStrategy.GetMinSizeBytes());
+        APSARA_TEST_EQUAL(3U, batch.mEventFlushStrategy.GetTimeoutSecs());
+        APSARA_TEST_EQUAL(2U, batch.mGroupFlushStrategy->GetTimeoutSecs());
+        APSARA_TEST_EQUAL(1000U, batch.mMinSizeBytes->GetValue());
+        APSARA_TEST_EQUAL(5U, batch.mTimeoutSecs->GetValue());
+    }
+    {
+        // the initial params are kept within the limits
+        Json::Value configJson;
+        string configStr, errorMsg;
+        configStr = R"(
+            {
+                "EnableAdaptive": true,
+                "MinSizeBytesLowerLimit": 2000,
+                "MinSizeBytesUpperLimit": 4000,
+                "TimeoutSecsLowerLimit": 1,
+                "TimeoutSecsUpperLimit": 2
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        Batcher<> batch;
+        batch.Init(configJson, sFlusher.get(), strategy);
+        APSARA_TEST_TRUE(batch.mAdaptiveFlushStrategy);
+        APSARA_TEST_EQUAL(2000U, batch.mEventFlushStrategy.GetMinSizeBytes());
+        APSARA_TEST_EQUAL(2U, batch.mEventFlushStrategy.GetTimeoutSecs());
+    }
+    {
+        // invalid limits
+        Json::Value configJson;
+        configJson["EnableAdaptive"] = true;
+        configJson["TimeoutSecsLowerLimit"] = 10;
+        configJson["TimeoutSecsUpperLimit"] = 5;
+        Batcher<> batch;
+        batch.Init(configJson, sFlusher.get(), strategy);
+        APSARA_TEST_FALSE(batch.mAdaptiveFlushStrategy);
+        APSARA_TEST_EQUAL(1000U, batch.mEventFlushStrategy.GetMinSizeBytes());
+        APSARA_TEST_EQUAL(5U, batch.mEventFlushStrategy.GetTimeoutSecs());
+    }
+    {
+        // disabled by default
+        Batcher<> batch;
+        batch.Init(Json::Value(), sFlusher.get(), strategy);
+        APSARA_TEST_FALSE(batch.mAdaptiveFlushStrategy);
+    }
+}
+
+void BatcherUnittest::TestAdaptiveTimeoutRecord() {
+    DefaultFlushStrategyOptions strategy;
+    strategy.mMaxSizeBytes = 3000;
+    strategy.mMinSizeBytes = 1000;
+    strategy.mTimeoutSecs = 5;
+
+    Json::Value configJson;
+    configJson["EnableAdaptive"] = true;
+    Batcher<> batch;
+    batch.Init(configJson, sFlusher.get(), strategy);
+
+    PipelineEventGroup group1 = CreateEventGroup(2);
+    size_t key = group1.GetTagsHash();
+    vector<BatchedEventsList> res;
+    batch.Add(std::move(group1), res);
+    TimeoutRecord& record = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key));
+    APSARA_TEST_EQUAL(5U, record.mTimeoutSecs);
+
+    BatchedEventsList flushed;
+    batch.FlushQueue(key, flushed);
+    APSARA_TEST_EQUAL(1U, flushed.size());
+
+    // data arrives slowly, so the timeout is raised to the upper limit on the next adjustment
+    batch.mAdaptiveFlushStrategy->mLastAdjustTime
+        = chrono::steady_clock::now() - chrono::seconds(2 * INT32_FLAG(adaptive_batch_adjust_interval_secs));
+    batch.Add(CreateEventGroup(2), res);
+    APSARA_TEST_EQUAL(10U, batch.mEventFlushStrategy.GetTimeoutSecs());
+    APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
+    APSARA_TEST_EQUAL(10U, record.mTimeoutSecs);
+}
+
 void BatcherUnittest::TestAddWithoutGroupBatch() {
     DefaultFlushStrategyOptions strategy;
     strategy.mMinCnt = 3;
@@ -671,6 +769,8 @@ PipelineEventGroup BatcherUnittest::CreateEventGroup(size_t cnt) {
 UNIT_TEST_CASE(BatcherUnittest, TestParamInit)
 UNIT_TEST_CASE(BatcherUnittest, TestInitWithoutGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestInitWithGroupBatch)
+UNIT_TEST_CASE(BatcherUnittest, TestInitWithAdaptiveBatch)
+UNIT_TEST_CASE(BatcherUnittest, TestAdaptiveTimeoutRecord)
 UNIT_TEST_CASE(BatcherUnittest, TestAddWithOversizedGroup)
 UNIT_TEST_CASE(BatcherUnittest, TestAddWithoutGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestAddWithGroupBatch)
@@ -0,0 +1,128 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/batch/BatchItem.h"
+#include "collection_pipeline/batch/ColumnarLogs.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class ColumnarLogsUnittest : public ::testing::Test {
+public:
+    void TestBuild();
+    void TestBuildWithNonLogEvents();
+    void TestBuildOnFlush();
+};
+
+void ColumnarLogsUnittest::TestBuild() {
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    {
+        auto e = group.AddLogEvent();
+        e->SetContent(string("a"), string("1"));
+        e->SetContent(string("b"), string("2"));
+        e->SetTimestamp(1234567890, 1);
+    }
+    {
+        // keys in different order and deleted content
+        auto e = group.AddLogEvent();
+        e->SetContent(string("b"), string("3"));
+        e->SetContent(string("c"), string("4"));
+        e->SetContent(string("a"), string("5"));
+        e->DelContent("c");
+        e->SetTimestamp(1234567891);
+    }
+    {
+        auto e = group.AddLogEvent();
+        e->SetTimestamp(1234567892);
+    }
+
+    ColumnarLogs logs;
+    APSARA_TEST_TRUE(logs.Build(group.GetEvents()));
+    APSARA_TEST_EQUAL(3U, logs.GetLogCnt());
+    APSARA_TEST_EQUAL(2U, logs.GetKeys().size());
+    APSARA_TEST_EQUAL(4U, logs.GetValues().size());
+
+    APSARA_TEST_EQUAL(0U, logs.GetContentBegin(0));
+    APSARA_TEST_EQUAL(2U, logs.GetContentEnd(0));
+    APSARA_TEST_EQUAL("a", logs.GetKey(0).to_string());
+    APSARA_TEST_EQUAL("1", logs.GetValue(0).to_string());
+    APSARA_TEST_EQUAL("b", logs.GetKey(1).to_string());
+    APSARA_TEST_EQUAL("2", logs.GetValue(1).to_string());
+    APSARA_TEST_EQUAL(1234567890U, logs.GetTimestamp(0));
+    APSARA_TEST_TRUE(logs.HasTimestampNanosecond(0));
+    APSARA_TEST_EQUAL(1U, logs.GetTimestampNanosecond(0));
+
+    APSARA_TEST_EQUAL(2U, logs.GetContentBegin(1));
+    APSARA_TEST_EQUAL(4U, logs.GetContentEnd(1));
+    APSARA_TEST_EQUAL("b", logs.GetKey(2).to_string());
+    APSARA_TEST_EQUAL("3", logs.GetValue(2).to_string());
+    APSARA_TEST_EQUAL("a", logs.GetKey(3).to_string());
+    APSARA_TEST_EQUAL("5", logs.GetValue(3).to_string());
+    APSARA_TEST_EQUAL(logs.GetKeyIds()[0], logs.GetKeyIds()[3]);
+    APSARA_TEST_EQUAL(logs.GetKeyIds()[1], logs.GetKeyIds()[2]);
+    APSARA_TEST_EQUAL(1234567891U, logs.GetTimestamp(1));
+    APSARA_TEST_FALSE(logs.HasTimestampNanosecond(1));
+
+    APSARA_TEST_TRUE(logs.IsLogEmpty(2));
+    APSARA_TEST_EQUAL(1234567892U, logs.GetTimestamp(2));
+}
+
+void ColumnarLogsUnittest::TestBuildWithNonLogEvents() {
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.AddLogEvent()->SetContent(string("a"), string("1"));
+    group.AddMetricEvent();
+
+    ColumnarLogs logs;
+    APSARA_TEST_FALSE(logs.Build(group.GetEvents()));
+    APSARA_TEST_EQUAL(0U, logs.GetLogCnt());
+    APSARA_TEST_TRUE(logs.GetKeys().empty());
+}
+
+void ColumnarLogsUnittest::TestBuildOnFlush() {
+    EventBatchItem<> item;
+    auto sourceBuffer = make_shared<SourceBuffer>();
+    {
+        PipelineEventGroup group(sourceBuffer);
+        group.AddLogEvent()->SetContent(string("a"), string("1"));
+        item.Reset(group.GetSizedTags(), sourceBuffer, nullptr, StringView());
+        item.Add(std::move(group.MutableEvents()[0]));
+    }
+    BatchedEventsList res;
+    item.Flush(res);
+    APSARA_TEST_EQUAL(1U, res.size());
+    APSARA_TEST_TRUE(res[0].mColumnarLogs == nullptr);
+
+    item.SetBuildColumnarLogs(true);
+    {
+        PipelineEventGroup group(sourceBuffer);
+        group.AddLogEvent()->SetContent(string("a"), string("1"));
+        item.Reset(group.GetSizedTags(), sourceBuffer, nullptr, StringView());
+        item.Add(std::move(group.MutableEvents()[0]));
+    }
+    item.Flush(res);
+    APSARA_TEST_EQUAL(2U, res.size());
+    APSARA_TEST_TRUE(res[1].mColumnarLogs != nullptr);
+    APSARA_TEST_EQUAL(1U, res[1].mColumnarLogs->GetLogCnt());
+    APSARA_TEST_EQUAL("1", res[1].mColumnarLogs->GetValue(0).to_string());
+}
+
+UNIT_TEST_CASE(ColumnarLogsUnittest, TestBuild)
+UNIT_TEST_CASE(ColumnarLogsUnittest, TestBuildWithNonLogEvents)
+UNIT_TEST_CASE(ColumnarLogsUnittest, TestBuildOnFlush)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
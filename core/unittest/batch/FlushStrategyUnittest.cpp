@@ -17,8 +17,11 @@
 #include "PipelineEventPtr.h"
 #include "collection_pipeline/batch/BatchStatus.h"
 #include "collection_pipeline/batch/FlushStrategy.h"
+#include "common/Flags.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_INT32(adaptive_batch_adjust_interval_secs);
+
 using namespace std;
 
 namespace logtail {
@@ -162,6 +165,129 @@ void SLSEventFlushStrategyUnittest::TestNeedFlush() {
 
 UNIT_TEST_CASE(SLSEventFlushStrategyUnittest, TestNeedFlush)
 
+class AdaptiveFlushStrategyUnittest : public ::testing::Test {
+public:
+    void TestAdjustInterval();
+    void TestAdjustBySendLatency();
+    void TestAdjustByCompressRatio();
+    void TestAdjustByArrivalRate();
+
+protected:
+    void SetUp() override {
+        mOptions.mMinSizeBytesLowerLimit = 1000;
+        mOptions.mMinSizeBytesUpperLimit = 4000;
+        mOptions.mTimeoutSecsLowerLimit = 1;
+        mOptions.mTimeoutSecsUpperLimit = 10;
+    }
+
+private:
+    // the next time the strategy is adjusted
+    chrono::steady_clock::time_point NextAdjustTime(const AdaptiveFlushStrategy& strategy) {
+        return strategy.mLastAdjustTime + chrono::seconds(INT32_FLAG(adaptive_batch_adjust_interval_secs));
+    }
+
+    AdaptiveFlushStrategyOptions mOptions;
+};
+
+void AdaptiveFlushStrategyUnittest::TestAdjustInterval() {
+    AdaptiveFlushStrategy strategy(100, 20, mOptions);
+    APSARA_TEST_EQUAL(1000U, strategy.GetMinSizeBytes());
+    APSARA_TEST_EQUAL(10U, strategy.GetTimeoutSecs());
+
+    strategy.OnSendSucceeded(chrono::milliseconds(5000));
+    APSARA_TEST_FALSE(strategy.Adjust(strategy.mLastAdjustTime + chrono::seconds(1)));
+    APSARA_TEST_EQUAL(1000U, strategy.GetMinSizeBytes());
+    APSARA_TEST_TRUE(strategy.Adjust(NextAdjustTime(strategy)));
+    APSARA_TEST_EQUAL(1250U, strategy.GetMinSizeBytes());
+}
+
+void AdaptiveFlushStrategyUnittest::TestAdjustBySendLatency() {
+    AdaptiveFlushStrategy strategy(2000, 10, mOptions);
+    // slow sending makes batches larger up to the upper limit
+    strategy.OnSendSucceeded(chrono::milliseconds(5000));
+    APSARA_TEST_TRUE(strategy.Adjust(NextAdjustTime(strategy)));
+    APSARA_TEST_EQUAL(2500U, strategy.GetMinSizeBytes());
+    for (int i = 0; i < 10; ++i) {
+        strategy.Adjust(NextAdjustTime(strategy));
+    }
+    APSARA_TEST_EQUAL(4000U, strategy.GetMinSizeBytes());
+
+    // fast sending makes batches smaller down to the lower limit
+    for (int i = 0; i < 20; ++i) {
+        strategy.OnSendSucceeded(chrono::milliseconds(10));
+    }
+    for (int i = 0; i < 20; ++i) {
+        strategy.Adjust(NextAdjustTime(strategy));
+    }
+    APSARA_TEST_EQUAL(1000U, strategy.GetMinSizeBytes());
+
+    // nothing changes without feedback
+    AdaptiveFlushStrategy idle(2000, 10, mOptions);
+    APSARA_TEST_FALSE(idle.Adjust(NextAdjustTime(idle)));
+    APSARA_TEST_EQUAL(2000U, idle.GetMinSizeBytes());
+}
+
+void AdaptiveFlushStrategyUnittest::TestAdjustByCompressRatio() {
+    AdaptiveFlushStrategy strategy(2000, 10, mOptions);
+    strategy.OnSendSucceeded(chrono::milliseconds(10));
+    // poorly compressed, try larger batches
+    strategy.OnDataCompressed(1000, 500);
+    APSARA_TEST_TRUE(strategy.Adjust(NextAdjustTime(strategy)));
+    APSARA_TEST_EQUAL(2500U, strategy.GetMinSizeBytes());
+    // the ratio improves, keep growing
+    for (int i = 0; i < 10; ++i) {
+        strategy.OnDataCompressed(1000, 300);
+    }
+    APSARA_TEST_TRUE(strategy.Adjust(NextAdjustTime(strategy)));
+    APSARA_TEST_EQUAL(3125U, strategy.GetMinSizeBytes());
+    // no improvement any more, and sending is fast enough to shrink
+    APSARA_TEST_TRUE(strategy.Adjust(NextAdjustTime(strategy)));
+    APSARA_TEST_EQUAL(2500U, strategy.GetMinSizeBytes());
+    APSARA_TEST_TRUE(strategy.mCompressRatioBeforeGrowth > 0.0);
+
+    // the data compresses worse than before growth, forget the old ratio and probe again
+    for (int i = 0; i < 20; ++i) {
+        strategy.OnDataCompressed(1000, 800);
+    }
+    APSARA_TEST_TRUE(strategy.Adjust(NextAdjustTime(strategy)));
+    APSARA_TEST_EQUAL(2000U, strategy.GetMinSizeBytes());
+    APSARA_TEST_EQUAL(0.0, strategy.mCompressRatioBeforeGrowth);
+    APSARA_TEST_TRUE(strategy.Adjust(NextAdjustTime(strategy)));
+    APSARA_TEST_EQUAL(2500U, strategy.GetMinSizeBytes());
+
+    // well compressed and sent fast, shrink
+    for (int i = 0; i < 20; ++i) {
+        strategy.OnDataCompressed(1000, 100);
+    }
+    APSARA_TEST_TRUE(strategy.Adjust(NextAdjustTime(strategy)));
+    APSARA_TEST_EQUAL(2000U, strategy.GetMinSizeBytes());
+    APSARA_TEST_EQUAL(0.0, strategy.mCompressRatioBeforeGrowth);
+}
+
+void AdaptiveFlushStrategyUnittest::TestAdjustByArrivalRate() {
+    AdaptiveFlushStrategy strategy(2000, 5, mOptions);
+    // 500 bytes per second, 4 seconds to fill a batch
+    strategy.OnDataArrived(500 * INT32_FLAG(adaptive_batch_adjust_interval_secs));
+    APSARA_TEST_TRUE(strategy.Adjust(NextAdjustTime(strategy)));
+    APSARA_TEST_EQUAL(2000U, strategy.GetMinSizeBytes());
+    APSARA_TEST_EQUAL(4U, strategy.GetTimeoutSecs());
+
+    // data comes in slowly, wait as long as allowed
+    strategy.OnDataArrived(10);
+    APSARA_TEST_TRUE(strategy.Adjust(NextAdjustTime(strategy)));
+    APSARA_TEST_EQUAL(10U, strategy.GetTimeoutSecs());
+
+    // data comes in fast, do not wait
+    strategy.OnDataArrived(100000 * INT32_FLAG(adaptive_batch_adjust_interval_secs));
+    APSARA_TEST_TRUE(strategy.Adjust(NextAdjustTime(strategy)));
+    APSARA_TEST_EQUAL(1U, strategy.GetTimeoutSecs());
+}
+
+UNIT_TEST_CASE(AdaptiveFlushStrategyUnittest, TestAdjustInterval)
+UNIT_TEST_CASE(AdaptiveFlushStrategyUnittest, TestAdjustBySendLatency)
+UNIT_TEST_CASE(AdaptiveFlushStrategyUnittest, TestAdjustByCompressRatio)
+UNIT_TEST_CASE(AdaptiveFlushStrategyUnittest, TestAdjustByArrivalRate)
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
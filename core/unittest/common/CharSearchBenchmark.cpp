@@ -0,0 +1,105 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "common/CharSearch.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class CharSearchBenchmark : public testing::Test {
+public:
+    void TestSplitLines();
+    void TestReverseLastLine();
+
+protected:
+    void SetUp() override {
+        // 64MB of lines whose length is uniformly distributed in [16, 512)
+        mt19937 generator(0);
+        uniform_int_distribution<int> lenDist(16, 511);
+        mBuffer.reserve(64 * 1024 * 1024);
+        while (mBuffer.size() < 64 * 1024 * 1024) {
+            mBuffer.append(lenDist(generator), 'x');
+            mBuffer.push_back('\n');
+        }
+    }
+    void TearDown() override { SetCharSearchImpl(mOriginImpl); }
+
+private:
+    static const char* ImplName(CharSearchImpl impl) {
+        switch (impl) {
+            case CharSearchImpl::AVX2:
+                return "avx2";
+            case CharSearchImpl::SSE2:
+                return "sse2";
+            default:
+                return "scalar";
+        }
+    }
+
+    string mBuffer;
+    CharSearchImpl mOriginImpl = GetCharSearchImpl();
+};
+
+void CharSearchBenchmark::TestSplitLines() {
+    for (auto impl : {CharSearchImpl::SCALAR, CharSearchImpl::SSE2, CharSearchImpl::AVX2}) {
+        if (!SetCharSearchImpl(impl)) {
+            continue;
+        }
+        const char* end = mBuffer.data() + mBuffer.size();
+        size_t lines = 0;
+        auto start = chrono::high_resolution_clock::now();
+        for (int round = 0; round < 10; ++round) {
+            for (const char* p = mBuffer.data(); p < end; ++lines) {
+                p = FindFirstChar(p, end, '\n') + 1;
+            }
+        }
+        chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+        cout << "split lines " << ImplName(impl) << ": " << lines << " lines, "
+             << mBuffer.size() * 10 / 1024.0 / 1024.0 / elapsed.count() << " MB/s" << endl;
+    }
+}
+
+void CharSearchBenchmark::TestReverseLastLine() {
+    for (auto impl : {CharSearchImpl::SCALAR, CharSearchImpl::SSE2, CharSearchImpl::AVX2}) {
+        if (!SetCharSearchImpl(impl)) {
+            continue;
+        }
+        size_t lines = 0;
+        auto start = chrono::high_resolution_clock::now();
+        for (int round = 0; round < 10; ++round) {
+            const char* end = mBuffer.data() + mBuffer.size() - 1;
+            while (end != nullptr) {
+                end = FindLastChar(mBuffer.data(), end, '\n');
+                ++lines;
+            }
+        }
+        chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+        cout << "reverse last line " << ImplName(impl) << ": " << lines << " lines, "
+             << mBuffer.size() * 10 / 1024.0 / 1024.0 / elapsed.count() << " MB/s" << endl;
+    }
+}
+
+UNIT_TEST_CASE(CharSearchBenchmark, TestSplitLines)
+UNIT_TEST_CASE(CharSearchBenchmark, TestReverseLastLine)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
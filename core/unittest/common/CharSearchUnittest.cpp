@@ -0,0 +1,148 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "common/CharSearch.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class CharSearchUnittest : public ::testing::Test {
+public:
+    void TestFindFirstChar();
+    void TestFindFirstCharOf();
+    void TestFindLastChar();
+
+protected:
+    void TearDown() override { SetCharSearchImpl(mOriginImpl); }
+
+private:
+    // every implementation supported by the current cpu
+    vector<CharSearchImpl> GetSupportedImpls() {
+        vector<CharSearchImpl> res;
+        for (auto impl : {CharSearchImpl::SCALAR, CharSearchImpl::SSE2, CharSearchImpl::AVX2}) {
+            if (SetCharSearchImpl(impl)) {
+                res.push_back(impl);
+            }
+        }
+        return res;
+    }
+
+    CharSearchImpl mOriginImpl = GetCharSearchImpl();
+};
+
+void CharSearchUnittest::TestFindFirstChar() {
+    for (auto impl : GetSupportedImpls()) {
+        APSARA_TEST_TRUE(SetCharSearchImpl(impl));
+        // empty
+        {
+            string s;
+            APSARA_TEST_EQUAL(s.data(), FindFirstChar(s.data(), s.data(), '\n'));
+        }
+        // every length and every position across vector boundaries
+        for (size_t len = 1; len < 100; ++len) {
+            string s(len, 'a');
+            APSARA_TEST_EQUAL(s.data() + len, FindFirstChar(s.data(), s.data() + len, '\n'));
+            for (size_t pos = 0; pos < len; ++pos) {
+                s[pos] = '\n';
+                APSARA_TEST_EQUAL(s.data() + pos, FindFirstChar(s.data(), s.data() + len, '\n'));
+                // a later occurrence must not be reported
+                if (pos + 1 < len) {
+                    s[len - 1] = '\n';
+                    APSARA_TEST_EQUAL(s.data() + pos, FindFirstChar(s.data(), s.data() + len, '\n'));
+                    s[len - 1] = 'a';
+                }
+                s[pos] = 'a';
+            }
+        }
+        // unaligned start and non-ascii delimiter
+        {
+            string s(70, 'a');
+            s[65] = '\xff';
+            APSARA_TEST_EQUAL(s.data() + 65, FindFirstChar(s.data() + 3, s.data() + s.size(), '\xff'));
+            APSARA_TEST_EQUAL(s.data() + 65, FindFirstChar(s.data() + 3, s.data() + 65, 'b'));
+        }
+    }
+}
+
+void CharSearchUnittest::TestFindFirstCharOf() {
+    for (auto impl : GetSupportedImpls()) {
+        APSARA_TEST_TRUE(SetCharSearchImpl(impl));
+        {
+            string s;
+            APSARA_TEST_EQUAL(s.data(), FindFirstCharOf(s.data(), s.data(), '"', '\\'));
+        }
+        for (size_t len = 1; len < 100; ++len) {
+            string s(len, 'a');
+            APSARA_TEST_EQUAL(s.data() + len, FindFirstCharOf(s.data(), s.data() + len, '"', '\\'));
+            for (size_t pos = 0; pos < len; ++pos) {
+                // either of the chars is reported, whichever comes first
+                s[pos] = '\\';
+                APSARA_TEST_EQUAL(s.data() + pos, FindFirstCharOf(s.data(), s.data() + len, '"', '\\'));
+                if (pos + 1 < len) {
+                    s[len - 1] = '"';
+                    APSARA_TEST_EQUAL(s.data() + pos, FindFirstCharOf(s.data(), s.data() + len, '"', '\\'));
+                    s[len - 1] = 'a';
+                }
+                s[pos] = '"';
+                APSARA_TEST_EQUAL(s.data() + pos, FindFirstCharOf(s.data(), s.data() + len, '"', '\\'));
+                s[pos] = 'a';
+            }
+        }
+    }
+}
+
+void CharSearchUnittest::TestFindLastChar() {
+    for (auto impl : GetSupportedImpls()) {
+        APSARA_TEST_TRUE(SetCharSearchImpl(impl));
+        // empty
+        {
+            string s;
+            APSARA_TEST_EQUAL(nullptr, FindLastChar(s.data(), s.data(), '\n'));
+        }
+        for (size_t len = 1; len < 100; ++len) {
+            string s(len, 'a');
+            APSARA_TEST_EQUAL(nullptr, FindLastChar(s.data(), s.data() + len, '\n'));
+            for (size_t pos = 0; pos < len; ++pos) {
+                s[pos] = '\n';
+                APSARA_TEST_EQUAL(s.data() + pos, FindLastChar(s.data(), s.data() + len, '\n'));
+                // an earlier occurrence must not be reported
+                if (pos > 0) {
+                    s[0] = '\n';
+                    APSARA_TEST_EQUAL(s.data() + pos, FindLastChar(s.data(), s.data() + len, '\n'));
+                    s[0] = 'a';
+                }
+                s[pos] = 'a';
+            }
+        }
+        // the delimiter right at the end is out of range
+        {
+            string s(70, 'a');
+            s[69] = '\n';
+            APSARA_TEST_EQUAL(nullptr, FindLastChar(s.data() + 1, s.data() + 69, '\n'));
+        }
+    }
+}
+
+UNIT_TEST_CASE(CharSearchUnittest, TestFindFirstChar)
+UNIT_TEST_CASE(CharSearchUnittest, TestFindFirstCharOf)
+UNIT_TEST_CASE(CharSearchUnittest, TestFindLastChar)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,194 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+
+#include "common/memory/MemoryAccountant.h"
+#include "common/memory/SourceBuffer.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class MemoryAccountantUnittest : public ::testing::Test {
+public:
+    void TestMemoryCharge();
+    void TestBufferAllocator();
+    void TestPressureLevel();
+    void TestPressureLevelByRss();
+    void TestPipelineUsage();
+
+protected:
+    void TearDown() override {
+        mCharge.Reset();
+        MemoryAccountant::GetInstance()->UpdatePressureLevel(0);
+    }
+
+private:
+    static constexpr int64_t kBudget = 1024LL * 1024 * 1024;
+
+    // make the total usage reach the ratio of the budget
+    void SetUsageRatio(double ratio) {
+        int64_t target = static_cast<int64_t>(kBudget * ratio);
+        int64_t delta = target - MemoryAccountant::GetInstance()->GetTotalUsage();
+        if (delta > 0) {
+            mCharge.Add(delta);
+        } else {
+            mCharge.Sub(-delta);
+        }
+    }
+
+    MemoryCharge mCharge{MemoryCategory::SENDER_QUEUE, nullptr};
+};
+
+void MemoryAccountantUnittest::TestMemoryCharge() {
+    auto* accountant = MemoryAccountant::GetInstance();
+    int64_t base = accountant->GetUsage(MemoryCategory::PROCESS_QUEUE);
+    {
+        MemoryCharge charge(MemoryCategory::PROCESS_QUEUE, nullptr, 100);
+        APSARA_TEST_EQUAL(base + 100, accountant->GetUsage(MemoryCategory::PROCESS_QUEUE));
+        charge.Add(50);
+        charge.Sub(30);
+        APSARA_TEST_EQUAL(120, charge.GetBytes());
+        APSARA_TEST_EQUAL(base + 120, accountant->GetUsage(MemoryCategory::PROCESS_QUEUE));
+
+        // more than charged can not be discharged
+        charge.Sub(1000);
+        APSARA_TEST_EQUAL(0, charge.GetBytes());
+        APSARA_TEST_EQUAL(base, accountant->GetUsage(MemoryCategory::PROCESS_QUEUE));
+
+        charge.Add(10);
+        MemoryCharge moved(std::move(charge));
+        APSARA_TEST_EQUAL(0, charge.GetBytes());
+        APSARA_TEST_EQUAL(10, moved.GetBytes());
+        APSARA_TEST_EQUAL(base + 10, accountant->GetUsage(MemoryCategory::PROCESS_QUEUE));
+
+        // the charge replaced is discharged
+        moved = MemoryCharge(MemoryCategory::PROCESS_QUEUE, nullptr, 20);
+        APSARA_TEST_EQUAL(base + 20, accountant->GetUsage(MemoryCategory::PROCESS_QUEUE));
+    }
+    APSARA_TEST_EQUAL(base, accountant->GetUsage(MemoryCategory::PROCESS_QUEUE));
+}
+
+void MemoryAccountantUnittest::TestBufferAllocator() {
+    auto* accountant = MemoryAccountant::GetInstance();
+    int64_t base = accountant->GetUsage(MemoryCategory::SOURCE_BUFFER);
+    {
+        BufferAllocator allocator(1024, 4096);
+        APSARA_TEST_EQUAL(base + 1024, accountant->GetUsage(MemoryCategory::SOURCE_BUFFER));
+        // a new chunk of doubled size
+        allocator.Allocate(1000);
+        allocator.Allocate(100);
+        APSARA_TEST_EQUAL(base + 1024 + 2048, accountant->GetUsage(MemoryCategory::SOURCE_BUFFER));
+        // allocated directly
+        allocator.Allocate(8192);
+        APSARA_TEST_EQUAL(base + 1024 + 2048 + 8192, accountant->GetUsage(MemoryCategory::SOURCE_BUFFER));
+
+        // only the first chunk is kept
+        allocator.Reset();
+        APSARA_TEST_EQUAL(base + 1024, accountant->GetUsage(MemoryCategory::SOURCE_BUFFER));
+
+        BufferAllocator moved(std::move(allocator));
+        APSARA_TEST_EQUAL(0U, allocator.TotalAllocated());
+        APSARA_TEST_EQUAL(base + 1024, accountant->GetUsage(MemoryCategory::SOURCE_BUFFER));
+    }
+    APSARA_TEST_EQUAL(base, accountant->GetUsage(MemoryCategory::SOURCE_BUFFER));
+}
+
+void MemoryAccountantUnittest::TestPressureLevel() {
+    auto* accountant = MemoryAccountant::GetInstance();
+    SetUsageRatio(0.4);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::NONE, accountant->UpdatePressureLevel(kBudget));
+    APSARA_TEST_FALSE(accountant->IsInputPaused());
+
+    SetUsageRatio(0.55);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::PAUSE_INPUT, accountant->UpdatePressureLevel(kBudget));
+    APSARA_TEST_TRUE(accountant->IsInputPaused());
+    APSARA_TEST_FALSE(accountant->IsScrapePaused());
+
+    SetUsageRatio(0.85);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::SPILL, accountant->UpdatePressureLevel(kBudget));
+    APSARA_TEST_TRUE(accountant->IsInputPaused());
+    APSARA_TEST_TRUE(accountant->IsScrapePaused());
+    APSARA_TEST_TRUE(accountant->ShouldSpill());
+
+    // slightly below the threshold, the level is kept
+    SetUsageRatio(0.75);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::SPILL, accountant->UpdatePressureLevel(kBudget));
+
+    // clearly below the threshold
+    SetUsageRatio(0.7);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::PAUSE_SCRAPE, accountant->UpdatePressureLevel(kBudget));
+    SetUsageRatio(0.1);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::NONE, accountant->UpdatePressureLevel(kBudget));
+    APSARA_TEST_FALSE(accountant->IsInputPaused());
+
+    // no budget, no pressure
+    SetUsageRatio(0.9);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::NONE, accountant->UpdatePressureLevel(0));
+}
+
+void MemoryAccountantUnittest::TestPressureLevelByRss() {
+    static constexpr int64_t kMB = 1024 * 1024;
+    const int64_t limit = 2048 * kMB;
+    auto* accountant = MemoryAccountant::GetInstance();
+    mCharge.Add(100 * kMB - accountant->GetTotalUsage());
+
+    // no pressure, so there is nothing to rely on
+    APSARA_TEST_EQUAL(MemoryPressureLevel::NONE, accountant->UpdatePressureLevel(limit, 1000 * kMB));
+    APSARA_TEST_FALSE(accountant->IsRelievableByBackpressure(limit, 2100 * kMB));
+
+    // rss over the limit pauses inputs, and releasing the in-flight data is enough
+    APSARA_TEST_EQUAL(MemoryPressureLevel::PAUSE_INPUT, accountant->UpdatePressureLevel(limit, 2100 * kMB));
+    APSARA_TEST_TRUE(accountant->IsInputPaused());
+    APSARA_TEST_TRUE(accountant->IsRelievableByBackpressure(limit, 2100 * kMB));
+    // releasing the in-flight data is not enough
+    APSARA_TEST_FALSE(accountant->IsRelievableByBackpressure(limit, 2200 * kMB));
+
+    // slightly below the limit, the level is kept
+    APSARA_TEST_EQUAL(MemoryPressureLevel::PAUSE_INPUT, accountant->UpdatePressureLevel(limit, 2000 * kMB));
+    APSARA_TEST_EQUAL(MemoryPressureLevel::NONE, accountant->UpdatePressureLevel(limit, 1800 * kMB));
+
+    // everything possible is already done
+    mCharge.Add(1700 * kMB);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::SPILL, accountant->UpdatePressureLevel(limit, 2100 * kMB));
+    APSARA_TEST_FALSE(accountant->IsRelievableByBackpressure(limit, 2100 * kMB));
+}
+
+void MemoryAccountantUnittest::TestPipelineUsage() {
+    auto* accountant = MemoryAccountant::GetInstance();
+    auto usage = accountant->GetPipelineUsage("test_config_1");
+    APSARA_TEST_EQUAL(usage, accountant->GetPipelineUsage("test_config_1"));
+    {
+        auto other = accountant->GetPipelineUsage("test_config_2");
+        APSARA_TEST_NOT_EQUAL(usage, other);
+        MemoryCharge charge(MemoryCategory::BATCHER, other, 100);
+        APSARA_TEST_EQUAL(100, charge.GetBytes());
+    }
+    // the usage of the removed pipeline is cleaned up
+    accountant->GetPipelineUsage("test_config_1");
+    APSARA_TEST_EQUAL(1U, accountant->mPipelineUsages.count("test_config_1"));
+    APSARA_TEST_EQUAL(0U, accountant->mPipelineUsages.count("test_config_2"));
+}
+
+UNIT_TEST_CASE(MemoryAccountantUnittest, TestMemoryCharge)
+UNIT_TEST_CASE(MemoryAccountantUnittest, TestBufferAllocator)
+UNIT_TEST_CASE(MemoryAccountantUnittest, TestPressureLevel)
+UNIT_TEST_CASE(MemoryAccountantUnittest, TestPressureLevelByRss)
+UNIT_TEST_CASE(MemoryAccountantUnittest, TestPipelineUsage)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
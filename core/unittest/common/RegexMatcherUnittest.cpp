@@ -0,0 +1,238 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "boost/regex.hpp"
+
+#include "common/Flags.h"
+#include "common/regex/RegexMatcher.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_re2_regex_engine);
+
+using namespace std;
+
+namespace logtail {
+
+class RegexMatcherUnittest : public ::testing::Test {
+public:
+    void TestEngineSelection();
+    void TestSameResultAsBoost();
+    void TestAnchoredAtStart();
+    void TestExtractLiterals();
+    void TestRegexSetMatcher();
+    void TestDisableRE2();
+
+protected:
+    void TearDown() override { BOOL_FLAG(enable_re2_regex_engine) = true; }
+};
+
+void RegexMatcherUnittest::TestEngineSelection() {
+    {
+        RegexMatcher matcher("\\[\\d+-\\d+-\\d+\\s\\d+:\\d+:\\d+.*", RegexMatcher::Mode::PARTIAL_MATCH);
+        APSARA_TEST_TRUE(matcher.GetEngine() == RegexMatcher::Engine::RE2);
+        // re2 \s does not contain \v
+        APSARA_TEST_EQUAL("\\[\\d+-\\d+-\\d+[[:space:]]\\d+:\\d+:\\d+.*", matcher.GetRE2Pattern());
+    }
+    {
+        RegexMatcher matcher("^\\d+-\\d+-\\d+.*$", RegexMatcher::Mode::FULL_MATCH);
+        APSARA_TEST_TRUE(matcher.GetEngine() == RegexMatcher::Engine::RE2);
+        APSARA_TEST_EQUAL("\\d+-\\d+-\\d+.*", matcher.GetRE2Pattern());
+    }
+    // boost only features
+    vector<string> patterns = {"(\\d)\\1", "abc(?=d)", "(?i)abc", "a\\Z", "\\vx", "e{,3}", "[\\S]", "a^b", "(a$)"};
+    for (const auto& pattern : patterns) {
+        RegexMatcher matcher(pattern, RegexMatcher::Mode::FULL_MATCH);
+        APSARA_TEST_TRUE_DESC(matcher.GetEngine() == RegexMatcher::Engine::BOOST, pattern);
+    }
+    // ^ at the beginning is always satisfied, while $ in partial mode is the end of any line
+    APSARA_TEST_TRUE(RegexMatcher("^a|b", RegexMatcher::Mode::PARTIAL_MATCH).GetEngine()
+                     == RegexMatcher::Engine::RE2);
+    APSARA_TEST_TRUE(RegexMatcher("^a|b", RegexMatcher::Mode::FULL_MATCH).GetEngine() == RegexMatcher::Engine::RE2);
+    APSARA_TEST_TRUE(RegexMatcher("a$", RegexMatcher::Mode::PARTIAL_MATCH).GetEngine()
+                     == RegexMatcher::Engine::BOOST);
+    // escaped $ is a literal
+    APSARA_TEST_TRUE(RegexMatcher("a\\$", RegexMatcher::Mode::PARTIAL_MATCH).GetEngine()
+                     == RegexMatcher::Engine::RE2);
+}
+
+void RegexMatcherUnittest::TestSameResultAsBoost() {
+    vector<string> patterns = {"^\\d+-\\d+-\\d+.*",
+                               "\\[\\d+-\\d+-\\d+\\s\\d+:\\d+:\\d+.*",
+                               "\\s+at .*",
+                               "^Caused by:.*",
+                               "^$",
+                               "a{b",
+                               "a\\sb",
+                               "[^\\s]x",
+                               "^(a|b)c",
+                               "^a|b",
+                               "(?:ab)+c",
+                               "\\bfoo\\b",
+                               "a[]]b",
+                               "[[:alpha:]]+",
+                               "\\w+@\\w+",
+                               ".*ERROR.*",
+                               "ab?c",
+                               "ab+c",
+                               "a.*\\n.*b",
+                               "\\Aab",
+                               "^\\s*$"};
+    vector<string> texts = {"",
+                            "2024-01-01 00:00:00 INFO start",
+                            "[2024-01-01\v00:00:00] x",
+                            "[2024-01-01 00:00:00] x",
+                            "    at com.example.Foo(Foo.java:1)",
+                            "x\nCaused by: y",
+                            "a\n",
+                            "a\r\nb",
+                            "a\rb",
+                            "a\fb",
+                            "a\vb",
+                            "a{b",
+                            "a b",
+                            "a\vb",
+                            "\xe4\xb8\xad",
+                            "bc",
+                            "ababc",
+                            "a foo b",
+                            "a]b",
+                            "x@y",
+                            "an ERROR here",
+                            "ac",
+                            "abbc",
+                            "a\nb",
+                            "xab",
+                            " \t\v",
+                            "ab"};
+    for (const auto& pattern : patterns) {
+        boost::regex reg(pattern);
+        RegexMatcher fullMatcher(pattern, RegexMatcher::Mode::FULL_MATCH);
+        RegexMatcher partialMatcher(pattern, RegexMatcher::Mode::PARTIAL_MATCH);
+        for (const auto& text : texts) {
+            string exception;
+            bool expected = boost::regex_match(text.data(), text.data() + text.size(), reg);
+            APSARA_TEST_EQUAL_DESC(expected, fullMatcher.Match(text, exception), pattern + " " + text);
+            expected = boost::regex_search(text.data(), text.data() + text.size(), reg, boost::match_continuous);
+            APSARA_TEST_EQUAL_DESC(expected, partialMatcher.Match(text, exception), pattern + " " + text);
+        }
+    }
+}
+
+void RegexMatcherUnittest::TestAnchoredAtStart() {
+    // partial match only matches at the beginning of the text, with or without ^
+    for (const auto& pattern : {"^b", "b"}) {
+        RegexMatcher matcher(pattern, RegexMatcher::Mode::PARTIAL_MATCH);
+        APSARA_TEST_TRUE(matcher.GetEngine() == RegexMatcher::Engine::RE2);
+        string exception;
+        APSARA_TEST_TRUE_DESC(matcher.Match("b", exception), pattern);
+        APSARA_TEST_TRUE_DESC(matcher.Match("bc", exception), pattern);
+        APSARA_TEST_FALSE_DESC(matcher.Match("ab", exception), pattern);
+        APSARA_TEST_FALSE_DESC(matcher.Match("a\nb", exception), pattern);
+        APSARA_TEST_FALSE_DESC(matcher.Match("a\r\nb", exception), pattern);
+    }
+
+    string exception;
+    RegexMatcher end("^\\z", RegexMatcher::Mode::PARTIAL_MATCH);
+    APSARA_TEST_TRUE(end.GetEngine() == RegexMatcher::Engine::RE2);
+    APSARA_TEST_TRUE(end.Match("", exception));
+    APSARA_TEST_FALSE(end.Match("1\n", exception));
+    APSARA_TEST_FALSE(end.Match("1", exception));
+}
+
+void RegexMatcherUnittest::TestExtractLiterals() {
+    struct Case {
+        string pattern;
+        string required;
+        string prefix;
+    };
+    vector<Case> cases = {{"^Caused by:.*", "Caused by:", "Caused by:"},
+                          {"\\s+at .*", "at ", ""},
+                          {".*ERROR.*", "ERROR", ""},
+                          {"x\\.y", "x.y", "x.y"},
+                          // optional chars are excluded
+                          {"ab?c", "a", "a"},
+                          {"abcd*ef", "abc", "abc"},
+                          {"ab+c", "ab", "ab"},
+                          {"(?:INFO|WARN) .*", " ", ""},
+                          {"\\bfoo\\b", "foo", ""},
+                          // unsure cases
+                          {"a|b", "", ""},
+                          {"(?i)abc", "", ""},
+                          {"\\Qa.b\\E", "", ""},
+                          {"a{b", "", ""},
+                          {"(abc", "", ""}};
+    for (const auto& c : cases) {
+        string required, prefix;
+        RegexMatcher::ExtractLiterals(c.pattern, required, prefix);
+        APSARA_TEST_EQUAL_DESC(c.required, required, c.pattern);
+        APSARA_TEST_EQUAL_DESC(c.prefix, prefix, c.pattern);
+    }
+
+    RegexMatcher matcher(".*ERROR.*", RegexMatcher::Mode::FULL_MATCH);
+    APSARA_TEST_FALSE(matcher.MayMatch("an info message"));
+    APSARA_TEST_TRUE(matcher.MayMatch("an ERROR message"));
+    RegexMatcher prefixMatcher("Caused by:.*", RegexMatcher::Mode::FULL_MATCH);
+    APSARA_TEST_FALSE(prefixMatcher.MayMatch("x Caused by: y"));
+    APSARA_TEST_TRUE(prefixMatcher.MayMatch("Caused by: y"));
+}
+
+void RegexMatcherUnittest::TestRegexSetMatcher() {
+    string exception;
+    {
+        RegexSetMatcher matcher({"\\d+.*", ".*a.*", "[0-9a-z ]+"});
+        APSARA_TEST_TRUE(matcher.IsRE2Set());
+        APSARA_TEST_EQUAL(3U, matcher.Size());
+        APSARA_TEST_TRUE(matcher.MatchAll("1 a", exception));
+        APSARA_TEST_FALSE(matcher.MatchAll("1 b", exception));
+        APSARA_TEST_FALSE(matcher.MatchAll("a 1", exception));
+        APSARA_TEST_FALSE(matcher.MatchAll("1 A", exception));
+    }
+    {
+        // falls back to sequential matching
+        RegexSetMatcher matcher({"(\\d)\\1.*", ".*a.*"});
+        APSARA_TEST_FALSE(matcher.IsRE2Set());
+        APSARA_TEST_TRUE(matcher.MatchAll("11a", exception));
+        APSARA_TEST_FALSE(matcher.MatchAll("12a", exception));
+        APSARA_TEST_FALSE(matcher.MatchAll("11b", exception));
+    }
+    {
+        RegexSetMatcher matcher({"abc"});
+        APSARA_TEST_FALSE(matcher.IsRE2Set());
+        APSARA_TEST_TRUE(matcher.MatchAll("abc", exception));
+        APSARA_TEST_FALSE(matcher.MatchAll("abcd", exception));
+    }
+}
+
+void RegexMatcherUnittest::TestDisableRE2() {
+    BOOL_FLAG(enable_re2_regex_engine) = false;
+    RegexMatcher matcher("\\d+", RegexMatcher::Mode::FULL_MATCH);
+    APSARA_TEST_TRUE(matcher.GetEngine() == RegexMatcher::Engine::BOOST);
+    string exception;
+    APSARA_TEST_TRUE(matcher.Match("123", exception));
+    APSARA_TEST_FALSE(matcher.Match("12a", exception));
+}
+
+UNIT_TEST_CASE(RegexMatcherUnittest, TestEngineSelection)
+UNIT_TEST_CASE(RegexMatcherUnittest, TestSameResultAsBoost)
+UNIT_TEST_CASE(RegexMatcherUnittest, TestAnchoredAtStart)
+UNIT_TEST_CASE(RegexMatcherUnittest, TestExtractLiterals)
+UNIT_TEST_CASE(RegexMatcherUnittest, TestRegexSetMatcher)
+UNIT_TEST_CASE(RegexMatcherUnittest, TestDisableRE2)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -33,6 +33,18 @@ void SafeQueueUnittest::TestPush() {
 
     queue.Push(make_unique<int>(1));
     APSARA_TEST_EQUAL(1U, queue.Size());
+
+    vector<unique_ptr<int>> values;
+    values.emplace_back(make_unique<int>(2));
+    values.emplace_back(make_unique<int>(3));
+    queue.PushAll(values);
+    APSARA_TEST_TRUE(values.empty());
+    APSARA_TEST_EQUAL(3U, queue.Size());
+    unique_ptr<int> value;
+    for (int i = 1; i <= 3; ++i) {
+        APSARA_TEST_TRUE(queue.TryPop(value));
+        APSARA_TEST_EQUAL(i, *value);
+    }
 }
 
 void SafeQueueUnittest::TestPop() {
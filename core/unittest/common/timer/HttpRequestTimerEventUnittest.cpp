@@ -51,7 +51,11 @@ void HttpRequestTimerEventUnittest::TestExecute() {
     HttpRequestTimerEvent event(chrono::steady_clock::now(),
                                 make_unique<AsynHttpRequestMock>("", false, "", 80, "", "", map<string, string>(), ""));
     event.Execute();
-    APSARA_TEST_EQUAL(1U, AsynCurlRunner::GetInstance()->mQueue.Size());
+    size_t queueSize = 0;
+    for (const auto& worker : AsynCurlRunner::GetInstance()->mWorkers) {
+        queueSize += worker->mQueue.Size();
+    }
+    APSARA_TEST_EQUAL(1U, queueSize);
 }
 
 UNIT_TEST_CASE(HttpRequestTimerEventUnittest, TestValid)
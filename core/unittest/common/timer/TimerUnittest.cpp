@@ -34,6 +34,7 @@ class TimerUnittest : public ::testing::Test {
 public:
     void TestPushEvent();
     void TestPeriodicEvent();
+    void TestCancelEvent();
 
 private:
     std::vector<int> mVec;
@@ -47,16 +48,30 @@ void TimerUnittest::TestPushEvent() {
     timer.PushEvent(make_unique<TimerEventMock>(now + chrono::seconds(1)));
     timer.PushEvent(make_unique<TimerEventMock>(now + chrono::seconds(3)));
 
-    APSARA_TEST_EQUAL(3U, timer.mQueue.size());
-    APSARA_TEST_EQUAL(now + chrono::seconds(1), timer.mQueue.top()->GetExecTime());
-    timer.mQueue.pop();
-    APSARA_TEST_EQUAL(now + chrono::seconds(2), timer.mQueue.top()->GetExecTime());
-    timer.mQueue.pop();
-    APSARA_TEST_EQUAL(now + chrono::seconds(3), timer.mQueue.top()->GetExecTime());
-    timer.mQueue.pop();
+    APSARA_TEST_EQUAL(3U, timer.mQueue.Size());
+    APSARA_TEST_EQUAL(now + chrono::seconds(1), timer.mQueue.Top()->GetExecTime());
+    timer.mQueue.Pop();
+    APSARA_TEST_EQUAL(now + chrono::seconds(2), timer.mQueue.Top()->GetExecTime());
+    timer.mQueue.Pop();
+    APSARA_TEST_EQUAL(now + chrono::seconds(3), timer.mQueue.Top()->GetExecTime());
+    timer.mQueue.Pop();
+}
+
+void TimerUnittest::TestCancelEvent() {
+    auto now = chrono::steady_clock::now();
+    Timer timer;
+    auto id1 = timer.PushEvent(make_unique<TimerEventMock>(now + chrono::seconds(1)));
+    auto id2 = timer.PushEvent(make_unique<TimerEventMock>(now + chrono::seconds(2)));
+    APSARA_TEST_NOT_EQUAL(id1, id2);
+
+    APSARA_TEST_TRUE(timer.CancelEvent(id1));
+    APSARA_TEST_FALSE(timer.CancelEvent(id1));
+    APSARA_TEST_EQUAL(1U, timer.mQueue.Size());
+    APSARA_TEST_EQUAL(now + chrono::seconds(2), timer.mQueue.Top()->GetExecTime());
 }
 
 UNIT_TEST_CASE(TimerUnittest, TestPushEvent)
+UNIT_TEST_CASE(TimerUnittest, TestCancelEvent)
 
 
 } // namespace logtail
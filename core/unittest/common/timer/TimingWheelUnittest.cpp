@@ -0,0 +1,126 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "common/timer/TimingWheel.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+struct WheelEventMock : public TimerEvent {
+    WheelEventMock(const chrono::steady_clock::time_point& execTime, int id) : TimerEvent(execTime), mId(id) {}
+
+    bool IsValid() const override { return true; }
+    bool Execute() override { return true; }
+
+    int mId;
+};
+
+class TimingWheelUnittest : public ::testing::Test {
+public:
+    void TestAdvance();
+    void TestRemove();
+    void TestCascade();
+    void TestOutOfRange();
+
+protected:
+    void SetUp() override { mStart = chrono::steady_clock::now(); }
+
+    vector<int> Advance(TimingWheel& wheel, chrono::steady_clock::duration d) {
+        vector<unique_ptr<TimerEvent>> events;
+        wheel.Advance(mStart + d, events);
+        vector<int> res;
+        for (const auto& e : events) {
+            res.push_back(static_cast<WheelEventMock*>(e.get())->mId);
+        }
+        return res;
+    }
+
+    chrono::steady_clock::time_point mStart;
+};
+
+void TimingWheelUnittest::TestAdvance() {
+    TimingWheel wheel(mStart);
+    wheel.Add(make_unique<WheelEventMock>(mStart + chrono::milliseconds(20), 2));
+    wheel.Add(make_unique<WheelEventMock>(mStart + chrono::milliseconds(10), 1));
+    wheel.Add(make_unique<WheelEventMock>(mStart + chrono::microseconds(30500), 3));
+    APSARA_TEST_EQUAL(3U, wheel.Size());
+    APSARA_TEST_EQUAL(mStart + chrono::milliseconds(10), wheel.GetNextTickTime());
+
+    APSARA_TEST_TRUE(Advance(wheel, chrono::milliseconds(9)).empty());
+    APSARA_TEST_EQUAL(vector<int>({1, 2}), Advance(wheel, chrono::milliseconds(25)));
+    // should not be executed before exec time
+    APSARA_TEST_TRUE(Advance(wheel, chrono::milliseconds(30)).empty());
+    APSARA_TEST_EQUAL(vector<int>({3}), Advance(wheel, chrono::milliseconds(31)));
+    APSARA_TEST_TRUE(wheel.Empty());
+    APSARA_TEST_EQUAL(chrono::steady_clock::time_point::max(), wheel.GetNextTickTime());
+
+    // expired event is executed on next tick
+    wheel.Add(make_unique<WheelEventMock>(mStart, 4));
+    APSARA_TEST_EQUAL(mStart + chrono::milliseconds(32), wheel.GetNextTickTime());
+    APSARA_TEST_EQUAL(vector<int>({4}), Advance(wheel, chrono::milliseconds(32)));
+}
+
+void TimingWheelUnittest::TestRemove() {
+    TimingWheel wheel(mStart);
+    auto id1 = wheel.Add(make_unique<WheelEventMock>(mStart + chrono::milliseconds(10), 1));
+    auto id2 = wheel.Add(make_unique<WheelEventMock>(mStart + chrono::milliseconds(10), 2));
+    auto id3 = wheel.Add(make_unique<WheelEventMock>(mStart + chrono::seconds(15), 3));
+
+    auto e = wheel.Remove(id1);
+    APSARA_TEST_NOT_EQUAL(nullptr, e.get());
+    APSARA_TEST_EQUAL(1, static_cast<WheelEventMock*>(e.get())->mId);
+    APSARA_TEST_EQUAL(nullptr, wheel.Remove(id1).get());
+    APSARA_TEST_NOT_EQUAL(nullptr, wheel.Remove(id3).get());
+    APSARA_TEST_EQUAL(1U, wheel.Size());
+    APSARA_TEST_EQUAL(vector<int>({2}), Advance(wheel, chrono::seconds(20)));
+    APSARA_TEST_EQUAL(nullptr, wheel.Remove(id2).get());
+}
+
+void TimingWheelUnittest::TestCascade() {
+    TimingWheel wheel(mStart);
+    // events in different levels
+    wheel.Add(make_unique<WheelEventMock>(mStart + chrono::milliseconds(100), 1));
+    wheel.Add(make_unique<WheelEventMock>(mStart + chrono::seconds(15), 2));
+    wheel.Add(make_unique<WheelEventMock>(mStart + chrono::minutes(10), 3));
+    wheel.Add(make_unique<WheelEventMock>(mStart + chrono::hours(10), 4));
+
+    APSARA_TEST_EQUAL(vector<int>({1}), Advance(wheel, chrono::milliseconds(100)));
+    APSARA_TEST_TRUE(Advance(wheel, chrono::milliseconds(14999)).empty());
+    APSARA_TEST_EQUAL(vector<int>({2}), Advance(wheel, chrono::milliseconds(15000)));
+    APSARA_TEST_TRUE(Advance(wheel, chrono::minutes(10) - chrono::milliseconds(1)).empty());
+    APSARA_TEST_EQUAL(vector<int>({3}), Advance(wheel, chrono::minutes(10)));
+    APSARA_TEST_TRUE(Advance(wheel, chrono::hours(10) - chrono::milliseconds(1)).empty());
+    APSARA_TEST_EQUAL(vector<int>({4}), Advance(wheel, chrono::hours(10)));
+}
+
+void TimingWheelUnittest::TestOutOfRange() {
+    TimingWheel wheel(mStart);
+    wheel.Add(make_unique<WheelEventMock>(mStart + chrono::hours(24 * 30), 1));
+    APSARA_TEST_TRUE(Advance(wheel, chrono::hours(24 * 15)).empty());
+    APSARA_TEST_TRUE(Advance(wheel, chrono::hours(24 * 30) - chrono::milliseconds(1)).empty());
+    APSARA_TEST_EQUAL(vector<int>({1}), Advance(wheel, chrono::hours(24 * 30)));
+}
+
+UNIT_TEST_CASE(TimingWheelUnittest, TestAdvance)
+UNIT_TEST_CASE(TimingWheelUnittest, TestRemove)
+UNIT_TEST_CASE(TimingWheelUnittest, TestCascade)
+UNIT_TEST_CASE(TimingWheelUnittest, TestOutOfRange)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
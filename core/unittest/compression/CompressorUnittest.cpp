@@ -27,11 +27,11 @@ public:
     bool UnCompress(const std::string& input, std::string& output, std::string& errorMsg) override { return true; }
 
 private:
-    bool Compress(const std::string& input, std::string& output, std::string& errorMsg) override {
+    bool Compress(StringView input, std::string& output, std::string& errorMsg) override {
         if (input == "failed") {
             return false;
         }
-        output = input.substr(0, input.size() / 2);
+        output = input.substr(0, input.size() / 2).to_string();
         return true;
     }
 };
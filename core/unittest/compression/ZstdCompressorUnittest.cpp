@@ -12,6 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "zstd/zstd.h"
+
+#include "common/StringTools.h"
 #include "common/compression/ZstdCompressor.h"
 #include "unittest/Unittest.h"
 
@@ -22,6 +29,11 @@ namespace logtail {
 class ZstdCompressorUnittest : public ::testing::Test {
 public:
     void TestCompress();
+    void TestCompressMultiThread();
+    void TestCompressWithDictionary();
+
+private:
+    string GenerateInput(size_t idx) const;
 };
 
 void ZstdCompressorUnittest::TestCompress() {
@@ -36,7 +48,80 @@ void ZstdCompressorUnittest::TestCompress() {
     APSARA_TEST_EQUAL(input, decompressed);
 }
 
+void ZstdCompressorUnittest::TestCompressMultiThread() {
+    // contexts are kept per thread, and the compressor is shared by threads
+    ZstdCompressor compressor(CompressType::ZSTD);
+    vector<thread> threads;
+    atomic_int failedCnt(0);
+    for (size_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i]() {
+            for (size_t j = 0; j < 100; ++j) {
+                string input = GenerateInput(i * 100 + j), output, errorMsg;
+                string decompressed(input.size(), '\0');
+                if (!compressor.DoCompress(input, output, errorMsg)
+                    || !compressor.UnCompress(output, decompressed, errorMsg) || decompressed != input) {
+                    ++failedCnt;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    APSARA_TEST_EQUAL(0, failedCnt.load());
+}
+
+void ZstdCompressorUnittest::TestCompressWithDictionary() {
+    ZstdDictTrainer::Options options;
+    options.mDictSize = 4 * 1024;
+    options.mMaxSampleBytes = 64 * 1024;
+    options.mSampleRate = 1;
+    ZstdCompressor compressor(CompressType::ZSTD);
+    compressor.EnableDictionary(options);
+
+    string input = GenerateInput(0), output, errorMsg;
+    // compress part of the buffer only
+    APSARA_TEST_TRUE(compressor.DoCompress(StringView(input.data(), input.size() / 2), output, errorMsg));
+    size_t sizeWithoutDict = output.size();
+    APSARA_TEST_EQUAL(0U, ZSTD_getDictID_fromFrame(output.data(), output.size()));
+
+    for (size_t i = 1; i < 1000 && compressor.mDictTrainer->GetDictionary() == nullptr; ++i) {
+        string sample = GenerateInput(i);
+        APSARA_TEST_TRUE(compressor.DoCompress(sample, output, errorMsg));
+    }
+    auto dictionary = compressor.mDictTrainer->GetDictionary();
+    APSARA_TEST_TRUE(dictionary != nullptr);
+    APSARA_TEST_NOT_EQUAL(0U, dictionary->GetId());
+
+    APSARA_TEST_TRUE(compressor.DoCompress(StringView(input.data(), input.size() / 2), output, errorMsg));
+    APSARA_TEST_EQUAL(dictionary->GetId(), ZSTD_getDictID_fromFrame(output.data(), output.size()));
+    APSARA_TEST_TRUE(output.size() < sizeWithoutDict);
+    string decompressed(input.size() / 2, '\0');
+    APSARA_TEST_TRUE(compressor.UnCompress(output, decompressed, errorMsg));
+    APSARA_TEST_EQUAL(input.substr(0, input.size() / 2), decompressed);
+
+    // samples are started over when it is not the time to retrain
+    for (size_t i = 0; i < 200; ++i) {
+        string sample = GenerateInput(i);
+        APSARA_TEST_TRUE(compressor.DoCompress(sample, output, errorMsg));
+    }
+    APSARA_TEST_EQUAL(dictionary, compressor.mDictTrainer->GetDictionary());
+    APSARA_TEST_TRUE(compressor.mDictTrainer->mSamples.size() < options.mMaxSampleBytes);
+}
+
+string ZstdCompressorUnittest::GenerateInput(size_t idx) const {
+    string res;
+    for (size_t i = 0; i < 8; ++i) {
+        res += "__time__:" + ToString(1700000000 + idx * 8 + i)
+            + "\tlevel:INFO\tthread:worker-" + ToString(i % 4) + "\tfile:/var/log/app/service.log\tmsg:request "
+            + ToString(idx * 31 + i) + " handled by upstream server successfully\n";
+    }
+    return res;
+}
+
 UNIT_TEST_CASE(ZstdCompressorUnittest, TestCompress)
+UNIT_TEST_CASE(ZstdCompressorUnittest, TestCompressMultiThread)
+UNIT_TEST_CASE(ZstdCompressorUnittest, TestCompressWithDictionary)
 
 } // namespace logtail
 
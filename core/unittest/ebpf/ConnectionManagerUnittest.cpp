@@ -20,6 +20,7 @@
 
 #include "ebpf/plugin/network_observer/Connection.h"
 #include "ebpf/plugin/network_observer/ConnectionManager.h"
+#include "ebpf/protocol/redis/RedisParser.h"
 #include "unittest/Unittest.h"
 
 namespace logtail {
@@ -35,6 +36,7 @@ public:
     void TestProtocolDetection();
     void TestResourceManagement();
     void TestErrorHandling();
+    void TestReleaseStreamState();
 
 protected:
     void SetUp() override {}
@@ -243,6 +245,30 @@ void ConnectionManagerUnittest::TestErrorHandling() {
     manager->deleteConnection(connId);
 }
 
+void ConnectionManagerUnittest::TestReleaseStreamState() {
+    auto manager = CreateManager();
+    RedisProtocolParser parser;
+    std::weak_ptr<Connection> deleted;
+    std::weak_ptr<Connection> remained;
+    {
+        auto tracker = manager->getOrCreateConnection(CreateTestConnId(1));
+        // the request waits for its response, holding the connection
+        parser.ParseStream("*1\r\n$4\r\nPING\r\n", "", 0, 1, tracker, nullptr);
+        EXPECT_EQ(tracker->GetStreamState().mPendingRecords.size(), 1UL);
+        deleted = tracker;
+        manager->deleteConnection(CreateTestConnId(1));
+
+        tracker = manager->getOrCreateConnection(CreateTestConnId(2));
+        parser.ParseStream("*1\r\n$4\r\nPING\r\n", "", 0, 1, tracker, nullptr);
+        remained = tracker;
+    }
+    EXPECT_TRUE(deleted.expired());
+    EXPECT_FALSE(remained.expired());
+    // connections left on stop are released as well
+    manager.reset();
+    EXPECT_TRUE(remained.expired());
+}
+
 UNIT_TEST_CASE(ConnectionManagerUnittest, TestBasicOperations);
 UNIT_TEST_CASE(ConnectionManagerUnittest, TestEventHandling);
 UNIT_TEST_CASE(ConnectionManagerUnittest, TestTimeoutMechanism);
@@ -250,6 +276,7 @@ UNIT_TEST_CASE(ConnectionManagerUnittest, TestMetadataHandling);
 UNIT_TEST_CASE(ConnectionManagerUnittest, TestProtocolDetection);
 UNIT_TEST_CASE(ConnectionManagerUnittest, TestResourceManagement);
 UNIT_TEST_CASE(ConnectionManagerUnittest, TestErrorHandling);
+UNIT_TEST_CASE(ConnectionManagerUnittest, TestReleaseStreamState);
 
 } // namespace ebpf
 } // namespace logtail
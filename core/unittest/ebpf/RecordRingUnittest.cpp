@@ -0,0 +1,185 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "ebpf/type/NetworkObserverEvent.h"
+#include "ebpf/type/ProcessEvent.h"
+#include "ebpf/util/RecordRing.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+namespace ebpf {
+
+class RecordRingUnittest : public ::testing::Test {
+public:
+    void TestAcquireAndRelease();
+    void TestMakeShared();
+    void TestOverflowWhenFull();
+    void TestLargeRecord();
+    void TestSlotSize();
+    void TestAppRecord();
+    void TestConcurrentAcquireAndRelease();
+};
+
+void RecordRingUnittest::TestAcquireAndRelease() {
+    RecordRing ring(3);
+    APSARA_TEST_EQUAL(4U, ring.Capacity());
+    set<uint32_t> indexes;
+    for (int i = 0; i < 4; ++i) {
+        auto idx = ring.Acquire();
+        APSARA_TEST_NOT_EQUAL(RecordRing::kInvalidIndex, idx);
+        APSARA_TEST_EQUAL(idx, ring.IndexOf(ring.Data(idx)));
+        indexes.insert(idx);
+    }
+    APSARA_TEST_EQUAL(4U, indexes.size());
+    APSARA_TEST_EQUAL(4U, ring.Occupancy());
+    APSARA_TEST_EQUAL(RecordRing::kInvalidIndex, ring.Acquire());
+
+    ring.Release(*indexes.begin());
+    APSARA_TEST_EQUAL(3U, ring.Occupancy());
+    APSARA_TEST_EQUAL(*indexes.begin(), ring.Acquire());
+    for (auto idx : indexes) {
+        ring.Release(idx);
+    }
+    APSARA_TEST_EQUAL(0U, ring.Occupancy());
+
+    int local = 0;
+    APSARA_TEST_EQUAL(RecordRing::kInvalidIndex, ring.IndexOf(&local));
+}
+
+void RecordRingUnittest::TestMakeShared() {
+    RecordRing ring(16);
+    {
+        shared_ptr<CommonEvent> event
+            = ring.MakeShared<ProcessExitEvent>(1, 2, KernelEventType::PROCESS_EXIT_EVENT, 3, 4, 5);
+        APSARA_TEST_TRUE(event != nullptr);
+        APSARA_TEST_EQUAL(1U, ring.Occupancy());
+        APSARA_TEST_EQUAL(KernelEventType::PROCESS_EXIT_EVENT, event->GetKernelEventType());
+        APSARA_TEST_EQUAL(4U, static_cast<ProcessExitEvent*>(event.get())->mExitCode);
+
+        // the slot is held until the last reference is released
+        auto copy = event;
+        event.reset();
+        APSARA_TEST_EQUAL(1U, ring.Occupancy());
+    }
+    APSARA_TEST_EQUAL(0U, ring.Occupancy());
+}
+
+void RecordRingUnittest::TestOverflowWhenFull() {
+    RecordRing ring(2);
+    vector<shared_ptr<ProcessEvent>> events;
+    for (int i = 0; i < 5; ++i) {
+        auto event = ring.MakeShared<ProcessEvent>(i, i, KernelEventType::PROCESS_EXECVE_EVENT, i);
+        APSARA_TEST_TRUE(event != nullptr);
+        events.emplace_back(std::move(event));
+    }
+    // records beyond the capacity are allocated on the heap instead of being dropped
+    APSARA_TEST_EQUAL(2U, ring.Occupancy());
+    APSARA_TEST_EQUAL(3U, ring.TakeOverflowCount());
+    APSARA_TEST_EQUAL(0U, ring.TakeOverflowCount());
+    for (int i = 0; i < 5; ++i) {
+        APSARA_TEST_EQUAL(static_cast<uint32_t>(i), events[i]->mPid);
+    }
+
+    // slots are given back once the records in them are released
+    events.erase(events.begin());
+    APSARA_TEST_EQUAL(1U, ring.Occupancy());
+    events.clear();
+    APSARA_TEST_EQUAL(0U, ring.Occupancy());
+}
+
+void RecordRingUnittest::TestLargeRecord() {
+    RecordRing ring(2);
+    {
+        auto record = ring.MakeShared<array<char, RecordRing::kDefaultSlotSize * 2>>();
+        APSARA_TEST_TRUE(record != nullptr);
+        APSARA_TEST_EQUAL(RecordRing::kInvalidIndex, ring.IndexOf(record.get()));
+        // the slot acquired is given back when falling back to the heap
+        APSARA_TEST_EQUAL(0U, ring.Occupancy());
+    }
+    APSARA_TEST_EQUAL(0U, ring.Occupancy());
+    APSARA_TEST_EQUAL(1U, ring.TakeOverflowCount());
+}
+
+void RecordRingUnittest::TestSlotSize() {
+    RecordRing ring(2, RecordRing::SlotSizeOf<array<char, 1000>>());
+    APSARA_TEST_TRUE(ring.SlotSize() >= 1000U);
+    APSARA_TEST_EQUAL(0U, ring.SlotSize() % alignof(max_align_t));
+    auto idx = ring.Acquire();
+    APSARA_TEST_EQUAL(idx, ring.IndexOf(ring.Data(idx)));
+    ring.Release(idx);
+    {
+        auto record = ring.MakeShared<array<char, 1000>>();
+        APSARA_TEST_EQUAL(1U, ring.Occupancy());
+    }
+    APSARA_TEST_EQUAL(0U, ring.Occupancy());
+}
+
+void RecordRingUnittest::TestAppRecord() {
+    auto& ring = GetAppRecordRing();
+    auto conn = make_shared<Connection>(ConnId(1, 1000, 123456));
+    auto occupancy = ring.Occupancy();
+    {
+        // records of all protocols fit into a slot
+        auto http = ring.MakeShared<HttpRecord>(conn);
+        auto redis = ring.MakeShared<RedisRecord>(conn);
+        auto mysql = ring.MakeShared<MySQLRecord>(conn);
+        APSARA_TEST_EQUAL(occupancy + 3, ring.Occupancy());
+        APSARA_TEST_TRUE(http->GetConnection() == conn);
+    }
+    APSARA_TEST_EQUAL(occupancy, ring.Occupancy());
+}
+
+void RecordRingUnittest::TestConcurrentAcquireAndRelease() {
+    RecordRing ring(64);
+    atomic_bool failed = false;
+    vector<thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 100000; ++i) {
+                auto event = ring.MakeShared<ProcessEvent>(i, i, KernelEventType::PROCESS_EXECVE_EVENT, i);
+                if (event->mPid != static_cast<uint32_t>(i)) {
+                    failed = true;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    APSARA_TEST_FALSE(failed.load());
+    APSARA_TEST_EQUAL(0U, ring.Occupancy());
+    APSARA_TEST_EQUAL(0U, ring.TakeOverflowCount());
+}
+
+UNIT_TEST_CASE(RecordRingUnittest, TestAcquireAndRelease);
+UNIT_TEST_CASE(RecordRingUnittest, TestMakeShared);
+UNIT_TEST_CASE(RecordRingUnittest, TestOverflowWhenFull);
+UNIT_TEST_CASE(RecordRingUnittest, TestLargeRecord);
+UNIT_TEST_CASE(RecordRingUnittest, TestSlotSize);
+UNIT_TEST_CASE(RecordRingUnittest, TestAppRecord);
+UNIT_TEST_CASE(RecordRingUnittest, TestConcurrentAcquireAndRelease);
+
+} // namespace ebpf
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,497 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ebpf/plugin/network_observer/Connection.h"
+#include "ebpf/protocol/mysql/MySQLParser.h"
+#include "ebpf/protocol/redis/RedisParser.h"
+#include "ebpf/util/sampler/Sampler.h"
+#include "unittest/Unittest.h"
+
+namespace logtail::ebpf {
+
+class StreamProtocolParserUnittest : public testing::Test {
+public:
+    void TestParseRedisCommand();
+    void TestParseRedisReply();
+    void TestRedisPipeline();
+    void TestRedisSplitAcrossEvents();
+    void TestRedisTruncatedEvent();
+    void TestRedisError();
+    void TestRedisInvalidData();
+    void TestParseMySQLCommand();
+    void TestMySQLQuery();
+    void TestMySQLError();
+    void TestMySQLNoResponse();
+    void TestMySQLConnectionPhase();
+    void TestSampling();
+
+    void RedisThroughputBenchmark();
+    void MySQLThroughputBenchmark();
+
+protected:
+    void SetUp() override {
+        mConn = std::make_shared<Connection>(ConnId(1, 1000, 123456));
+        mSampler = std::make_shared<HashRatioSampler>(1.0);
+    }
+    void TearDown() override { mConn->ResetStreamState(); }
+
+private:
+    static std::string RedisCommand(const std::vector<std::string>& args) {
+        std::string res = "*" + std::to_string(args.size()) + "\r\n";
+        for (const auto& arg : args) {
+            res += "$" + std::to_string(arg.size()) + "\r\n" + arg + "\r\n";
+        }
+        return res;
+    }
+
+    static std::string MySQLPacket(uint8_t seq, const std::string& payload) {
+        std::string res;
+        res.push_back(static_cast<char>(payload.size() & 0xff));
+        res.push_back(static_cast<char>((payload.size() >> 8) & 0xff));
+        res.push_back(static_cast<char>((payload.size() >> 16) & 0xff));
+        res.push_back(static_cast<char>(seq));
+        return res + payload;
+    }
+
+    static std::string MySQLQuery(const std::string& sql) { return MySQLPacket(0, std::string(1, '\x03') + sql); }
+
+    static std::string MySQLOk() { return MySQLPacket(1, std::string("\x00\x00\x00\x02\x00\x00\x00", 7)); }
+
+    static std::string MySQLErr(uint16_t code, const std::string& state, const std::string& msg) {
+        std::string payload("\xff", 1);
+        payload.push_back(static_cast<char>(code & 0xff));
+        payload.push_back(static_cast<char>(code >> 8));
+        return MySQLPacket(1, payload + "#" + state + msg);
+    }
+
+    // a result set of one column and one row, ended by an EOF packet
+    static std::string MySQLResultSet() {
+        return MySQLPacket(1, "\x01") + MySQLPacket(2, std::string("\x03" "def\x00\x00\x00\x01" "a\x00\x0c", 11))
+            + MySQLPacket(3, std::string("\xfe\x00\x00\x02\x00", 5)) + MySQLPacket(4, "\x01" "1")
+            + MySQLPacket(5, std::string("\xfe\x00\x00\x02\x00", 5));
+    }
+
+    // replay the requests and then the responses of a connection, in events of at most segment bytes
+    std::vector<std::shared_ptr<AbstractRecord>> Replay(AbstractStreamProtocolParser& parser,
+                                                        std::string_view req,
+                                                        std::string_view resp,
+                                                        size_t segment) {
+        std::vector<std::shared_ptr<AbstractRecord>> records;
+        for (size_t off = 0; off < req.size(); off += segment) {
+            auto res = parser.ParseStream(req.substr(off, segment), "", off, off, mConn, mSampler);
+            records.insert(records.end(), res.begin(), res.end());
+        }
+        for (size_t off = 0; off < resp.size(); off += segment) {
+            auto ts = req.size() + off;
+            auto res = parser.ParseStream("", resp.substr(off, segment), ts, ts, mConn, mSampler);
+            records.insert(records.end(), res.begin(), res.end());
+        }
+        return records;
+    }
+
+    static AbstractDBRecord* AsDB(const std::shared_ptr<AbstractRecord>& record) {
+        return static_cast<AbstractDBRecord*>(record.get());
+    }
+
+    std::shared_ptr<Connection> mConn;
+    std::shared_ptr<Sampler> mSampler;
+};
+
+void StreamProtocolParserUnittest::TestParseRedisCommand() {
+    std::string input = RedisCommand({"set", "key", "value"}) + "GET key\r\n";
+    std::string_view buf(input);
+    redis::RedisCommand cmd;
+    APSARA_TEST_EQUAL(redis::ParseCommand(buf, cmd), ParseState::kSuccess);
+    APSARA_TEST_EQUAL(cmd.mName, "set");
+    APSARA_TEST_EQUAL(cmd.mArgNum, 2UL);
+    APSARA_TEST_EQUAL(cmd.mArgs[1], "value");
+    APSARA_TEST_EQUAL(redis::FormatCommand(cmd, 256), "SET key value");
+    APSARA_TEST_EQUAL(redis::FormatCommand(cmd, 5), "SET k");
+    // inline command
+    APSARA_TEST_EQUAL(redis::ParseCommand(buf, cmd), ParseState::kSuccess);
+    APSARA_TEST_EQUAL(cmd.mName, "GET");
+    APSARA_TEST_EQUAL(cmd.mArgs[0], "key");
+    APSARA_TEST_TRUE(buf.empty());
+
+    // arguments beyond the kept ones are only counted
+    std::vector<std::string> args{"MSET"};
+    for (int i = 0; i < 20; ++i) {
+        args.emplace_back("k" + std::to_string(i));
+    }
+    input = RedisCommand(args);
+    buf = input;
+    APSARA_TEST_EQUAL(redis::ParseCommand(buf, cmd), ParseState::kSuccess);
+    APSARA_TEST_EQUAL(cmd.mArgNum, redis::kMaxKeptArgs);
+    APSARA_TEST_EQUAL(cmd.mTotalArgNum, 20UL);
+
+    // every prefix of a command needs more data
+    input = RedisCommand({"HSET", "hash", "field", "value"});
+    for (size_t i = 1; i < input.size(); ++i) {
+        std::string_view part(input.data(), i);
+        APSARA_TEST_EQUAL(redis::ParseCommand(part, cmd), ParseState::kNeedsMoreData);
+        APSARA_TEST_EQUAL(part.size(), i);
+    }
+}
+
+void StreamProtocolParserUnittest::TestParseRedisReply() {
+    std::vector<std::string> replies{
+        "+OK\r\n",
+        ":1000\r\n",
+        "$5\r\nhello\r\n",
+        "$-1\r\n",
+        "*-1\r\n",
+        "*2\r\n$3\r\nfoo\r\n$-1\r\n",
+        "*2\r\n*2\r\n:1\r\n:2\r\n*1\r\n+a\r\n",
+        // RESP3 types
+        "%2\r\n+first\r\n:1\r\n+second\r\n*2\r\n_\r\n,1.5\r\n",
+        "~2\r\n#t\r\n(3492890328409238509324850943850943825024385\r\n",
+        "|1\r\n+ttl\r\n:3600\r\n$2\r\nok\r\n",
+        "=15\r\ntxt:Some string\r\n",
+        ">2\r\n+message\r\n$2\r\nhi\r\n",
+    };
+    for (const auto& reply : replies) {
+        std::string input = reply + "+NEXT\r\n";
+        std::string_view buf(input);
+        redis::RedisReply result;
+        APSARA_TEST_EQUAL_DESC(redis::ParseReply(buf, result), ParseState::kSuccess, reply);
+        APSARA_TEST_FALSE(result.mIsError);
+        APSARA_TEST_EQUAL_DESC(buf, "+NEXT\r\n", reply);
+        for (size_t i = 1; i < reply.size(); ++i) {
+            std::string_view part(reply.data(), i);
+            APSARA_TEST_EQUAL_DESC(redis::ParseReply(part, result), ParseState::kNeedsMoreData, reply);
+        }
+    }
+
+    std::string input = "-ERR unknown command 'foo'\r\n";
+    std::string_view buf(input);
+    redis::RedisReply result;
+    APSARA_TEST_EQUAL(redis::ParseReply(buf, result), ParseState::kSuccess);
+    APSARA_TEST_TRUE(result.mIsError);
+    APSARA_TEST_EQUAL(result.mErrMsg, "ERR unknown command 'foo'");
+
+    input = "!21\r\nSYNTAX invalid syntax\r\n";
+    buf = input;
+    APSARA_TEST_EQUAL(redis::ParseReply(buf, result), ParseState::kSuccess);
+    APSARA_TEST_TRUE(result.mIsError);
+    APSARA_TEST_EQUAL(result.mErrMsg, "SYNTAX invalid syntax");
+
+    // errors nested in aggregates, e.g., the replies of EXEC, do not fail the command
+    input = "*2\r\n+OK\r\n-ERR wrong type\r\n";
+    buf = input;
+    APSARA_TEST_EQUAL(redis::ParseReply(buf, result), ParseState::kSuccess);
+    APSARA_TEST_FALSE(result.mIsError);
+
+    input = "?unknown\r\n";
+    buf = input;
+    APSARA_TEST_EQUAL(redis::ParseReply(buf, result), ParseState::kInvalid);
+}
+
+void StreamProtocolParserUnittest::TestRedisPipeline() {
+    RedisProtocolParser parser;
+    std::string req;
+    std::string resp;
+    for (int i = 0; i < 10; ++i) {
+        req += RedisCommand({"INCR", "counter"});
+        resp += ":" + std::to_string(i + 1) + "\r\n";
+    }
+    auto records = parser.ParseStream(req, resp, 100, 200, mConn, mSampler);
+    APSARA_TEST_EQUAL(records.size(), 10UL);
+    for (const auto& record : records) {
+        APSARA_TEST_EQUAL(AsDB(record)->GetSpanName(), "INCR");
+        APSARA_TEST_EQUAL(AsDB(record)->GetReqBody(), "INCR counter");
+        APSARA_TEST_EQUAL(AsDB(record)->GetReqBodySize(), RedisCommand({"INCR", "counter"}).size());
+        APSARA_TEST_FALSE(AsDB(record)->IsError());
+        APSARA_TEST_FALSE(AsDB(record)->HasStatusCode());
+        APSARA_TEST_EQUAL(AsDB(record)->GetLatencyNs(), 100.0);
+    }
+    APSARA_TEST_TRUE(mConn->GetStreamState().mPendingRecords.empty());
+    APSARA_TEST_TRUE(mConn->GetStreamState().mReqBuffer.Empty());
+    APSARA_TEST_TRUE(mConn->GetStreamState().mRespBuffer.Empty());
+}
+
+void StreamProtocolParserUnittest::TestRedisSplitAcrossEvents() {
+    RedisProtocolParser parser;
+    std::string req = RedisCommand({"SET", "key", std::string(100, 'v')}) + RedisCommand({"GET", "key"});
+    std::string resp = "+OK\r\n$100\r\n" + std::string(100, 'v') + "\r\n";
+    // replay the captured stream in segments of various sizes
+    for (size_t segment = 1; segment <= req.size(); segment += 7) {
+        auto records = Replay(parser, req, resp, segment);
+        APSARA_TEST_EQUAL_DESC(records.size(), 2UL, segment);
+        if (records.size() == 2UL) {
+            APSARA_TEST_EQUAL(AsDB(records[0])->GetSpanName(), "SET");
+            APSARA_TEST_EQUAL(AsDB(records[1])->GetSpanName(), "GET");
+            APSARA_TEST_EQUAL(AsDB(records[1])->GetRespBodySize(), resp.size() - 5);
+        }
+        APSARA_TEST_TRUE(mConn->GetStreamState().mPendingRecords.empty());
+    }
+}
+
+void StreamProtocolParserUnittest::TestRedisTruncatedEvent() {
+    RedisProtocolParser parser;
+    std::string set = RedisCommand({"SET", "key", std::string(100, 'v')});
+    // the tail of a truncated request is dropped instead of being joined with the next event
+    auto records = parser.ParseStream(
+        RedisCommand({"PING"}) + set.substr(0, 50), "+PONG\r\n+OK\r\n", 0, 1, mConn, nullptr, true, false);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    APSARA_TEST_TRUE(mConn->GetStreamState().mReqBuffer.Empty());
+    APSARA_TEST_TRUE(mConn->GetStreamState().mRespBuffer.Empty());
+    APSARA_TEST_TRUE(mConn->GetStreamState().mPendingRecords.empty());
+
+    // so is the tail of a truncated response, along with the requests waiting for the lost responses
+    std::string value = "$100\r\n" + std::string(100, 'v') + "\r\n";
+    records = parser.ParseStream(
+        RedisCommand({"GET", "key"}) + RedisCommand({"PING"}), value.substr(0, 50), 0, 1, mConn, nullptr, false, true);
+    APSARA_TEST_TRUE(records.empty());
+    APSARA_TEST_TRUE(mConn->GetStreamState().mRespBuffer.Empty());
+    APSARA_TEST_TRUE(mConn->GetStreamState().mPendingRecords.empty());
+
+    // the following events are parsed in alignment
+    records = parser.ParseStream(RedisCommand({"GET", "key"}), value, 0, 1, mConn, nullptr);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    if (records.size() == 1UL) {
+        APSARA_TEST_EQUAL(AsDB(records[0])->GetSpanName(), "GET");
+        APSARA_TEST_EQUAL(AsDB(records[0])->GetRespBodySize(), value.size());
+    }
+}
+
+void StreamProtocolParserUnittest::TestRedisError() {
+    RedisProtocolParser parser;
+    auto records = parser.ParseStream(RedisCommand({"LPUSH", "key", "v"}) + RedisCommand({"GET", "key"}),
+                                      ":1\r\n-WRONGTYPE Operation against a key holding the wrong kind of value\r\n",
+                                      100,
+                                      200,
+                                      mConn,
+                                      nullptr);
+    APSARA_TEST_EQUAL(records.size(), 2UL);
+    APSARA_TEST_FALSE(AsDB(records[0])->IsError());
+    APSARA_TEST_FALSE(records[0]->ShouldSample());
+    APSARA_TEST_TRUE(AsDB(records[1])->IsError());
+    // errors are always sampled, without statements since they are not sampled when the requests are parsed
+    APSARA_TEST_TRUE(records[1]->ShouldSample());
+    APSARA_TEST_EQUAL(AsDB(records[1])->GetReqBody(), "");
+    APSARA_TEST_EQUAL(AsDB(records[1])->GetRespBody(),
+                      "WRONGTYPE Operation against a key holding the wrong kind of value");
+}
+
+void StreamProtocolParserUnittest::TestRedisInvalidData() {
+    RedisProtocolParser parser;
+    // not redis at all
+    auto records = parser.ParseStream("\x16\x03\x01\x02\xfc\x03\x03\n", "\x16\x03\x03", 0, 1, mConn, nullptr);
+    APSARA_TEST_TRUE(records.empty());
+    APSARA_TEST_TRUE(mConn->GetStreamState().mReqBuffer.Empty());
+    APSARA_TEST_TRUE(mConn->GetStreamState().mPendingRecords.empty());
+
+    // an invalid response drops waiting requests, and the parser recovers from the next event
+    records = parser.ParseStream(RedisCommand({"PING"}), "?garbage\r\n", 0, 1, mConn, nullptr);
+    APSARA_TEST_TRUE(records.empty());
+    APSARA_TEST_TRUE(mConn->GetStreamState().mPendingRecords.empty());
+    records = parser.ParseStream(RedisCommand({"PING"}), "+PONG\r\n", 0, 1, mConn, nullptr);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+
+    // responses without requests are discarded
+    records = parser.ParseStream("", "+OK\r\n+OK\r\n", 0, 1, mConn, nullptr);
+    APSARA_TEST_TRUE(records.empty());
+    APSARA_TEST_TRUE(mConn->GetStreamState().mRespBuffer.Empty());
+
+    // the number of waiting requests is bounded
+    std::string req;
+    for (size_t i = 0; i < AbstractStreamProtocolParser::kMaxPendingRecords * 2; ++i) {
+        req += RedisCommand({"PING"});
+    }
+    records = parser.ParseStream(req, "", 0, 1, mConn, nullptr);
+    APSARA_TEST_TRUE(records.empty());
+    APSARA_TEST_EQUAL(mConn->GetStreamState().mPendingRecords.size(), AbstractStreamProtocolParser::kMaxPendingRecords);
+}
+
+void StreamProtocolParserUnittest::TestParseMySQLCommand() {
+    std::string input = MySQLQuery(" /* hint */ select * from t where id = 1") + MySQLQuery("\n-- c\nInsert into t");
+    std::string_view buf(input);
+    mysql::MySQLCommand cmd;
+    APSARA_TEST_EQUAL(mysql::ParseCommand(buf, cmd), ParseState::kSuccess);
+    APSARA_TEST_EQUAL(cmd.mSQL, " /* hint */ select * from t where id = 1");
+    APSARA_TEST_EQUAL(mysql::GetCommandName(cmd), "SELECT");
+    APSARA_TEST_EQUAL(mysql::ParseCommand(buf, cmd), ParseState::kSuccess);
+    APSARA_TEST_EQUAL(mysql::GetCommandName(cmd), "INSERT");
+    APSARA_TEST_TRUE(buf.empty());
+
+    input = MySQLPacket(0, "\x0e");
+    buf = input;
+    APSARA_TEST_EQUAL(mysql::ParseCommand(buf, cmd), ParseState::kSuccess);
+    APSARA_TEST_EQUAL(mysql::GetCommandName(cmd), "COM_PING");
+
+    input = MySQLQuery("SELECT 1");
+    for (size_t i = 0; i < input.size(); ++i) {
+        std::string_view part(input.data(), i);
+        APSARA_TEST_EQUAL(mysql::ParseCommand(part, cmd), ParseState::kNeedsMoreData);
+    }
+
+    input = MySQLPacket(0, "\x7f");
+    buf = input;
+    APSARA_TEST_EQUAL(mysql::ParseCommand(buf, cmd), ParseState::kInvalid);
+}
+
+void StreamProtocolParserUnittest::TestMySQLQuery() {
+    MySQLProtocolParser parser;
+    auto records = parser.ParseStream(MySQLQuery("SELECT a FROM t"), MySQLResultSet(), 100, 300, mConn, mSampler);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    APSARA_TEST_EQUAL(AsDB(records[0])->GetSpanName(), "SELECT");
+    APSARA_TEST_EQUAL(AsDB(records[0])->GetReqBody(), "SELECT a FROM t");
+    APSARA_TEST_EQUAL(AsDB(records[0])->GetRespBodySize(), MySQLResultSet().size());
+    APSARA_TEST_FALSE(AsDB(records[0])->IsError());
+    APSARA_TEST_TRUE(records[0]->ShouldSample());
+
+    records = parser.ParseStream(MySQLQuery("UPDATE t SET a = 1"), MySQLOk(), 100, 300, mConn, mSampler);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    APSARA_TEST_EQUAL(AsDB(records[0])->GetSpanName(), "UPDATE");
+
+    // a response split across events
+    std::string resp = MySQLErr(1064, "42000", "You have an error in your SQL syntax");
+    records = parser.ParseStream(MySQLQuery("SELEC 1"), std::string_view(resp).substr(0, 10), 100, 300, mConn, nullptr);
+    APSARA_TEST_TRUE(records.empty());
+    records = parser.ParseStream("", std::string_view(resp).substr(10), 100, 400, mConn, mSampler);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    APSARA_TEST_TRUE(AsDB(records[0])->IsError());
+    APSARA_TEST_EQUAL(AsDB(records[0])->GetLatencyNs(), 300.0);
+}
+
+void StreamProtocolParserUnittest::TestMySQLError() {
+    MySQLProtocolParser parser;
+    auto records = parser.ParseStream(MySQLQuery("SELECT * FROM missing"),
+                                      MySQLErr(1146, "42S02", "Table 'db.missing' doesn't exist"),
+                                      100,
+                                      300,
+                                      mConn,
+                                      nullptr);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    auto* record = static_cast<MySQLRecord*>(records[0].get());
+    APSARA_TEST_TRUE(record->IsError());
+    APSARA_TEST_TRUE(record->ShouldSample());
+    APSARA_TEST_EQUAL(record->mErrCode, 1146);
+    APSARA_TEST_EQUAL(record->GetRespBody(), "Table 'db.missing' doesn't exist");
+}
+
+void StreamProtocolParserUnittest::TestMySQLNoResponse() {
+    MySQLProtocolParser parser;
+    std::string closeStmt = MySQLPacket(0, std::string("\x19\x01\x00\x00\x00", 5));
+    auto records = parser.ParseStream(closeStmt + MySQLQuery("COMMIT"), MySQLOk(), 100, 300, mConn, nullptr);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    APSARA_TEST_EQUAL(AsDB(records[0])->GetSpanName(), "COMMIT");
+
+    records = parser.ParseStream(MySQLPacket(0, "\x01"), "", 100, 300, mConn, nullptr);
+    APSARA_TEST_TRUE(records.empty());
+    APSARA_TEST_TRUE(mConn->GetStreamState().mPendingRecords.empty());
+}
+
+void StreamProtocolParserUnittest::TestMySQLConnectionPhase() {
+    MySQLProtocolParser parser;
+    // the greeting of the server, the handshake response of the client and the result of the authentication
+    std::string greeting = MySQLPacket(0, std::string("\x0a" "8.0.32\x00", 8) + std::string(40, 'g'));
+    std::string login = MySQLPacket(1, std::string(60, 'l'));
+    auto records = parser.ParseStream("", greeting, 0, 1, mConn, nullptr);
+    APSARA_TEST_TRUE(records.empty());
+    records = parser.ParseStream(login, MySQLOk(), 0, 1, mConn, nullptr);
+    APSARA_TEST_TRUE(records.empty());
+    APSARA_TEST_TRUE(mConn->GetStreamState().mPendingRecords.empty());
+
+    records = parser.ParseStream(MySQLQuery("SELECT 1"), MySQLResultSet(), 0, 1, mConn, nullptr);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+}
+
+void StreamProtocolParserUnittest::TestSampling() {
+    RedisProtocolParser parser;
+    auto records = parser.ParseStream(RedisCommand({"GET", "k"}), "$-1\r\n", 0, 1, mConn, mSampler);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    APSARA_TEST_TRUE(records[0]->ShouldSample());
+    APSARA_TEST_TRUE(AsDB(records[0])->mTraceId != (std::array<uint64_t, 4>{}));
+    APSARA_TEST_TRUE(AsDB(records[0])->mSpanId != (std::array<uint64_t, 2>{}));
+
+    auto never = std::make_shared<HashRatioSampler>(0.0);
+    records = parser.ParseStream(RedisCommand({"GET", "k"}), "$-1\r\n", 0, 1, mConn, never);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    APSARA_TEST_FALSE(records[0]->ShouldSample());
+    APSARA_TEST_EQUAL(AsDB(records[0])->GetReqBody(), "");
+
+    // slow requests are always sampled
+    records = parser.ParseStream(RedisCommand({"KEYS", "*"}), "*0\r\n", 0, 1000000000, mConn, never);
+    APSARA_TEST_EQUAL(records.size(), 1UL);
+    APSARA_TEST_TRUE(records[0]->ShouldSample());
+}
+
+void StreamProtocolParserUnittest::RedisThroughputBenchmark() {
+    // a captured pipeline of 16 commands, replayed in events of 1460 bytes as segmented by tcp
+    std::string req;
+    std::string resp;
+    for (int i = 0; i < 16; ++i) {
+        req += RedisCommand({"SET", "user:" + std::to_string(i), std::string(64, 'x')});
+        resp += "+OK\r\n";
+        req += RedisCommand({"GET", "user:" + std::to_string(i)});
+        resp += "$64\r\n" + std::string(64, 'x') + "\r\n";
+    }
+    RedisProtocolParser parser;
+    size_t bytes = 0;
+    size_t recordNum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < 20000; i++) {
+        recordNum += Replay(parser, req, resp, 1460).size();
+        bytes += req.size() + resp.size();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    APSARA_TEST_EQUAL(recordNum, 20000UL * 32);
+    std::cout << "[redis] elapsed: " << elapsed.count() << " seconds, throughput: " << bytes / elapsed.count() / 1e6
+              << " MB/s, records: " << recordNum / elapsed.count() << "/s" << std::endl;
+}
+
+void StreamProtocolParserUnittest::MySQLThroughputBenchmark() {
+    std::string req = MySQLQuery("SELECT id, name, email FROM users WHERE id = 42 /* app */");
+    std::string resp = MySQLResultSet();
+    MySQLProtocolParser parser;
+    size_t bytes = 0;
+    size_t recordNum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < 500000; i++) {
+        recordNum += parser.ParseStream(req, resp, 0, 1, mConn, nullptr).size();
+        bytes += req.size() + resp.size();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    APSARA_TEST_EQUAL(recordNum, 500000UL);
+    std::cout << "[mysql] elapsed: " << elapsed.count() << " seconds, throughput: " << bytes / elapsed.count() / 1e6
+              << " MB/s, records: " << recordNum / elapsed.count() << "/s" << std::endl;
+}
+
+UNIT_TEST_CASE(StreamProtocolParserUnittest, TestParseRedisCommand);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, TestParseRedisReply);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, TestRedisPipeline);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, TestRedisSplitAcrossEvents);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, TestRedisTruncatedEvent);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, TestRedisError);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, TestRedisInvalidData);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, TestParseMySQLCommand);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, TestMySQLQuery);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, TestMySQLError);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, TestMySQLNoResponse);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, TestMySQLConnectionPhase);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, TestSampling);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, RedisThroughputBenchmark);
+UNIT_TEST_CASE(StreamProtocolParserUnittest, MySQLThroughputBenchmark);
+
+} // namespace logtail::ebpf
+
+UNIT_TEST_MAIN
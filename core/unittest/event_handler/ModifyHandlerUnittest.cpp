@@ -28,6 +28,7 @@
 #include "file_server/FileServer.h"
 #include "file_server/event/Event.h"
 #include "file_server/event_handler/EventHandler.h"
+#include "file_server/event_handler/FileReadWorkerPool.h"
 #include "file_server/reader/LogFileReader.h"
 #include "unittest/Unittest.h"
 
@@ -50,6 +51,8 @@ public:
     void TestHandleModifyEventWhenContainerRestartCase5();
     void TestHandleModifyEventWhenContainerRestartCase6();
     void TestHandleModifyEvnetWhenContainerStopTwice();
+    void TestReadInWorker();
+    void TestReadInWorkerWhenHandlerReleased();
 
 protected:
     static void SetUpTestCase() {
@@ -229,6 +232,8 @@ UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleModifyEventWhenContainerRestartC
 UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleModifyEventWhenContainerRestartCase5);
 UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleModifyEventWhenContainerRestartCase6);
 UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleModifyEvnetWhenContainerStopTwice);
+UNIT_TEST_CASE(ModifyHandlerUnittest, TestReadInWorker);
+UNIT_TEST_CASE(ModifyHandlerUnittest, TestReadInWorkerWhenHandlerReleased);
 
 void ModifyHandlerUnittest::TestHandleContainerStoppedEventWhenReadToEnd() {
     LOG_INFO(sLogger, ("TestHandleContainerStoppedEventWhenReadToEnd() begin", time(NULL)));
@@ -531,6 +536,45 @@ void ModifyHandlerUnittest::TestHandleModifyEvnetWhenContainerStopTwice() {
     APSARA_TEST_EQUAL_FATAL(mReaderPtr->mContainerID, "2");
 }
 
+void ModifyHandlerUnittest::TestReadInWorker() {
+    LOG_INFO(sLogger, ("TestReadInWorker() begin", time(NULL)));
+    auto pool = FileReadWorkerPool::GetInstance();
+    pool->Start(2);
+    auto readerArray = &mHandlerPtr->mNameReaderMap[gLogName];
+
+    Event event(gRootDir, gLogName, EVENT_MODIFY, 0, 0, mReaderPtr->mDevInode.dev, mReaderPtr->mDevInode.inode);
+    mHandlerPtr->Handle(event);
+    APSARA_TEST_TRUE(mHandlerPtr->IsReading(readerArray));
+    APSARA_TEST_FALSE(mHandlerPtr->IsAllFileRead());
+
+    // events of the reader queue being read are deferred
+    Event deleteEvent(gRootDir, gLogName, EVENT_DELETE, 0);
+    mHandlerPtr->Handle(deleteEvent);
+    mHandlerPtr->Handle(event);
+    APSARA_TEST_FALSE(mReaderPtr->IsFileDeleted());
+    APSARA_TEST_EQUAL(2U, mHandlerPtr->mReaderArraysInReading[readerArray].size());
+
+    pool->WaitAllTasksFinished();
+    APSARA_TEST_FALSE(mHandlerPtr->IsReading(readerArray));
+    APSARA_TEST_TRUE(mReaderPtr->IsReadToEnd());
+    APSARA_TEST_FALSE(ProcessQueueManager::GetInstance()->IsAllQueueEmpty());
+    pool->Stop();
+}
+
+void ModifyHandlerUnittest::TestReadInWorkerWhenHandlerReleased() {
+    LOG_INFO(sLogger, ("TestReadInWorkerWhenHandlerReleased() begin", time(NULL)));
+    auto pool = FileReadWorkerPool::GetInstance();
+    pool->Start(1);
+
+    Event event(gRootDir, gLogName, EVENT_MODIFY, 0, 0, mReaderPtr->mDevInode.dev, mReaderPtr->mDevInode.inode);
+    mHandlerPtr->Handle(event);
+    mHandlerPtr.reset();
+    // the result is discarded
+    pool->WaitAllTasksFinished();
+    APSARA_TEST_TRUE(mReaderPtr->IsReadToEnd());
+    pool->Stop();
+}
+
 } // end of namespace logtail
 
 int main(int argc, char** argv) {
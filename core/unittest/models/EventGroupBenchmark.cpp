@@ -35,6 +35,8 @@ class EventGroupBenchmark {
 public:
     void TestEraseInLoop();
     void TestWriteIndexInLoop();
+    void TestParseThenSerialize(size_t fieldCnt);
+    void TestRouteToFlushers(size_t flusherCnt);
 };
 
 void EraseInLoop(PipelineEventGroup& logGroup) {
@@ -102,15 +104,130 @@ void EventGroupBenchmark::TestWriteIndexInLoop() {
     printf("%s costs %lums\n", __func__, timeelapsed);
 }
 
+void EventGroupBenchmark::TestParseThenSerialize(size_t fieldCnt) {
+    // SetUp
+    std::vector<std::string> keys;
+    std::vector<std::string> values;
+    for (size_t i = 0; i < fieldCnt; ++i) {
+        keys.emplace_back("field_key_" + std::to_string(i));
+        values.emplace_back("field_value_" + std::to_string(i));
+    }
+    std::vector<PipelineEventGroup> eventGroups;
+    for (int i = 0; i < 100; ++i) {
+        eventGroups.emplace_back(std::make_shared<SourceBuffer>());
+    }
+    // Test
+    size_t totalBytes = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (auto& group : eventGroups) {
+        for (int i = 0; i < 1000; ++i) {
+            auto* event = group.AddLogEvent();
+            // parse: set every field, then look up a few of them as downstream processors would do
+            for (size_t j = 0; j < fieldCnt; ++j) {
+                event->SetContentNoCopy(StringView(keys[j]), StringView(values[j]));
+            }
+            for (size_t j = 0; j < fieldCnt; j += 4) {
+                event->GetContent(StringView(keys[j]));
+            }
+            event->DelContent(StringView(keys[0]));
+        }
+        // serialize: iterate over contents in order
+        std::string buffer;
+        for (const auto& e : group.GetEvents()) {
+            for (const auto& kv : e.Cast<LogEvent>()) {
+                buffer.append(kv.first.data(), kv.first.size());
+                buffer.append(kv.second.data(), kv.second.size());
+            }
+        }
+        totalBytes += buffer.size();
+    }
+    uint64_t timeelapsed = GetCurrentTimeInMilliSeconds() - starttime;
+    printf("%s with %zu fields costs %lums, %.2f MB/s\n",
+           __func__,
+           fieldCnt,
+           timeelapsed,
+           timeelapsed == 0 ? 0.0 : totalBytes / 1024.0 / 1024.0 * 1000 / timeelapsed);
+}
+
+static size_t SerializeGroup(const PipelineEventGroup& group) {
+    size_t size = 0;
+    for (const auto& e : group.GetEvents()) {
+        for (const auto& kv : e.Cast<LogEvent>()) {
+            size += kv.first.size() + kv.second.size();
+        }
+    }
+    return size;
+}
+
+void EventGroupBenchmark::TestRouteToFlushers(size_t flusherCnt) {
+    // SetUp
+    auto prepare = []() {
+        std::vector<PipelineEventGroup> eventGroups;
+        for (int i = 0; i < 100; ++i) {
+            auto& group = eventGroups.emplace_back(std::make_shared<SourceBuffer>());
+            group.SetTag(std::string("tag_key"), std::string("tag_value"));
+            for (int j = 0; j < 1000; ++j) {
+                auto* event = group.AddLogEvent();
+                for (int k = 0; k < 8; ++k) {
+                    event->SetContent("field_key_" + std::to_string(k), "field_value_" + std::to_string(k));
+                }
+            }
+        }
+        return eventGroups;
+    };
+    // Test: deep copy for each extra flusher, which is how groups were routed before
+    size_t totalBytes = 0;
+    auto eventGroups = prepare();
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (auto& group : eventGroups) {
+        std::vector<PipelineEventGroup> res;
+        for (size_t i = 1; i < flusherCnt; ++i) {
+            res.emplace_back(group.Copy());
+        }
+        res.emplace_back(std::move(group));
+        for (const auto& g : res) {
+            totalBytes += SerializeGroup(g);
+        }
+    }
+    uint64_t copyElapsed = GetCurrentTimeInMilliSeconds() - starttime;
+
+    // Test: share events among flushers
+    eventGroups = prepare();
+    starttime = GetCurrentTimeInMilliSeconds();
+    for (auto& group : eventGroups) {
+        auto res = PipelineEventGroup::Share(std::move(group), flusherCnt);
+        for (const auto& g : res) {
+            totalBytes += SerializeGroup(g);
+        }
+    }
+    uint64_t shareElapsed = GetCurrentTimeInMilliSeconds() - starttime;
+    printf("%s with %zu flushers: copy costs %lums, share costs %lums, %zu bytes serialized\n",
+           __func__,
+           flusherCnt,
+           copyElapsed,
+           shareElapsed,
+           totalBytes);
+}
+
 } // namespace logtail
 
 int main(int argc, char* argv[]) {
     logtail::EventGroupBenchmark benchmark;
     benchmark.TestEraseInLoop();
     benchmark.TestWriteIndexInLoop();
-    /* Result:
-       TestEraseInLoop costs 453ms
-       TestWriteIndexInLoop costs 22ms
+    benchmark.TestParseThenSerialize(8);
+    benchmark.TestParseThenSerialize(32);
+    benchmark.TestRouteToFlushers(1);
+    benchmark.TestRouteToFlushers(2);
+    benchmark.TestRouteToFlushers(4);
+    /* Result (-O2, 1 vCPU, median of 4 runs; before: std::map content index, after: flat content index):
+       TestEraseInLoop costs 979ms before, 1238ms after
+       TestWriteIndexInLoop costs 42ms before, 40ms after
+       TestParseThenSerialize with 8 fields costs 193ms before, 111ms after
+       TestParseThenSerialize with 32 fields costs 877ms before, 477ms after
+       TestRouteToFlushers with 1 flushers: copy costs 18ms, share costs 18ms
+       TestRouteToFlushers with 2 flushers: copy costs 39ms, share costs 35ms
+       TestRouteToFlushers with 4 flushers: copy costs 94ms, share costs 40ms
      */
     return 0;
 }
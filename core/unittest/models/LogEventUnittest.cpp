@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "common/JsonUtil.h"
+#include "common/StringTools.h"
 #include "models/LogEvent.h"
 #include "models/PipelineEventGroup.h"
 #include "unittest/Unittest.h"
@@ -33,6 +34,7 @@ public:
     void TestReset();
     void TestFromJsonToJson();
     void TestLevel();
+    void TestManyContents();
 
 protected:
     void SetUp() override {
@@ -222,6 +224,42 @@ void LogEventUnittest::TestLevel() {
     APSARA_TEST_EQUAL("level", mLogEvent->GetLevel().to_string());
 }
 
+void LogEventUnittest::TestManyContents() {
+    // exceed the linear scan threshold so that the hashed index is used
+    const size_t cnt = LogContentIndex::kLinearScanThreshold * 4;
+    for (size_t i = 0; i < cnt; ++i) {
+        mLogEvent->SetContent("key" + ToString(i), "value" + ToString(i));
+    }
+    APSARA_TEST_EQUAL(cnt, mLogEvent->Size());
+    for (size_t i = 0; i < cnt; ++i) {
+        APSARA_TEST_EQUAL("value" + ToString(i), mLogEvent->GetContent("key" + ToString(i)).to_string());
+    }
+    APSARA_TEST_FALSE(mLogEvent->HasContent("key" + ToString(cnt)));
+
+    // overwrite keeps the original order
+    mLogEvent->SetContent(string("key3"), string("new_value"));
+    APSARA_TEST_EQUAL(cnt, mLogEvent->Size());
+    APSARA_TEST_EQUAL("new_value", mLogEvent->GetContent("key3").to_string());
+
+    // delete every other key
+    for (size_t i = 0; i < cnt; i += 2) {
+        mLogEvent->DelContent("key" + ToString(i));
+    }
+    APSARA_TEST_EQUAL(cnt / 2, mLogEvent->Size());
+    for (size_t i = 0; i < cnt; ++i) {
+        APSARA_TEST_EQUAL(i % 2 == 1, mLogEvent->HasContent("key" + ToString(i)));
+    }
+    size_t idx = 1;
+    for (const auto& kv : *mLogEvent) {
+        APSARA_TEST_EQUAL("key" + ToString(idx), kv.first.to_string());
+        idx += 2;
+    }
+
+    mLogEvent->Reset();
+    APSARA_TEST_TRUE(mLogEvent->Empty());
+    APSARA_TEST_FALSE(mLogEvent->HasContent("key1"));
+}
+
 UNIT_TEST_CASE(LogEventUnittest, TestTimestampOp)
 UNIT_TEST_CASE(LogEventUnittest, TestSetContent)
 UNIT_TEST_CASE(LogEventUnittest, TestDelContent)
@@ -232,6 +270,7 @@ UNIT_TEST_CASE(LogEventUnittest, TestSize)
 UNIT_TEST_CASE(LogEventUnittest, TestReset)
 UNIT_TEST_CASE(LogEventUnittest, TestFromJsonToJson)
 UNIT_TEST_CASE(LogEventUnittest, TestLevel)
+UNIT_TEST_CASE(LogEventUnittest, TestManyContents)
 
 } // namespace logtail
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <cstdlib>
+#include <utility>
 
 #include "common/JsonUtil.h"
 #include "models/EventPool.h"
@@ -31,9 +32,11 @@ public:
     void TestSwapEvents();
     void TestReserveEvents();
     void TestCopy();
+    void TestShare();
     void TestDestructor();
     void TestSetMetadata();
     void TestDelMetadata();
+    void TestGetTagsHash();
     void TestFromJsonToJson();
 
 protected:
@@ -215,6 +218,56 @@ void PipelineEventGroupUnittest::TestCopy() {
     APSARA_TEST_EQUAL(3U, res.GetSourceBuffer().use_count());
 }
 
+void PipelineEventGroupUnittest::TestShare() {
+    mEventGroup->SetTag(string("key"), string("value"));
+    auto* log = mEventGroup->AddLogEvent(true);
+    log->SetContent(string("content"), string("value"));
+    mEventGroup->AddLogEvent(true);
+    {
+        auto res = PipelineEventGroup::Share(std::move(*mEventGroup), 1);
+        APSARA_TEST_EQUAL(1U, res.size());
+        APSARA_TEST_FALSE(res[0].GetEvents()[0].IsShared());
+        *mEventGroup = std::move(res[0]);
+    }
+    {
+        auto res = PipelineEventGroup::Share(std::move(*mEventGroup), 3);
+        APSARA_TEST_EQUAL(3U, res.size());
+        for (auto& g : res) {
+            APSARA_TEST_EQUAL(2U, g.GetEvents().size());
+            APSARA_TEST_TRUE(g.GetEvents()[0].IsShared());
+            APSARA_TEST_EQUAL(log, &g.GetEvents()[0].Cast<LogEvent>());
+            APSARA_TEST_EQUAL(mSourceBuffer, g.GetSourceBuffer());
+            APSARA_TEST_EQUAL("value", g.GetTag("key").to_string());
+        }
+        // tags are owned by each group
+        res[1].DelTag(StringView("key"));
+        APSARA_TEST_FALSE(res[1].HasTag("key"));
+        APSARA_TEST_TRUE(res[0].HasTag("key"));
+
+        // only the modified event is copied
+        auto& modified = res[1].MutableEvents()[0].Cast<LogEvent>();
+        APSARA_TEST_NOT_EQUAL(log, &modified);
+        modified.SetContent(string("content"), string("modified"));
+        APSARA_TEST_EQUAL("modified", modified.GetContent("content").to_string());
+        APSARA_TEST_EQUAL("value", res[0].GetEvents()[0].Cast<LogEvent>().GetContent("content").to_string());
+        APSARA_TEST_EQUAL("value", res[2].GetEvents()[0].Cast<LogEvent>().GetContent("content").to_string());
+        APSARA_TEST_EQUAL(res[0].GetEvents()[1].Get<LogEvent>(), res[1].GetEvents()[1].Get<LogEvent>());
+
+        // events moved out of groups, e.g., into batches, are still shared
+        PipelineEventPtr moved = std::move(res[2].MutableEvents()[0]);
+        res.pop_back();
+        res.erase(res.begin());
+        APSARA_TEST_EQUAL(0U, gThreadedEventPool.mLogEventPool.size());
+        APSARA_TEST_TRUE(moved.IsShared());
+        APSARA_TEST_EQUAL(log, std::as_const(moved).Get<LogEvent>());
+        APSARA_TEST_EQUAL("value", std::as_const(moved).Cast<LogEvent>().GetContent("content").to_string());
+        res.clear();
+        // the second event is returned to the pool by its last owner
+        APSARA_TEST_EQUAL(1U, gThreadedEventPool.mLogEventPool.size());
+        APSARA_TEST_FALSE(moved.IsShared());
+    }
+}
+
 void PipelineEventGroupUnittest::TestSetMetadata() {
     { // string copy, let kv out of scope
         mEventGroup->SetMetadata(EventGroupMetaKey::LOG_FORMAT, std::string("value1"));
@@ -253,6 +306,49 @@ void PipelineEventGroupUnittest::TestDelMetadata() {
     APSARA_TEST_FALSE_FATAL(mEventGroup->HasMetadata(EventGroupMetaKey::LOG_FILE_PATH_RESOLVED));
 }
 
+void PipelineEventGroupUnittest::TestGetTagsHash() {
+    mEventGroup->SetTag(string("key1"), string("value1"));
+    mEventGroup->SetTag(string("key2"), string("value2"));
+    size_t hash = mEventGroup->GetTagsHash();
+    APSARA_TEST_EQUAL(hash, mEventGroup->GetTagsHash());
+    {
+        // independent of the insertion order
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        group.SetTag(string("key2"), string("value2"));
+        group.SetTag(string("key1"), string("value1"));
+        APSARA_TEST_EQUAL(hash, group.GetTagsHash());
+    }
+
+    // tag changes invalidate the cached value
+    mEventGroup->SetTag(string("key1"), string("value11"));
+    size_t newHash = mEventGroup->GetTagsHash();
+    APSARA_TEST_NOT_EQUAL(hash, newHash);
+    mEventGroup->SetTag(string("key1"), string("value1"));
+    APSARA_TEST_EQUAL(hash, mEventGroup->GetTagsHash());
+    mEventGroup->DelTag("key2");
+    APSARA_TEST_NOT_EQUAL(hash, mEventGroup->GetTagsHash());
+    mEventGroup->GetSizedTags().Insert("key2", "value2");
+    APSARA_TEST_EQUAL(hash, mEventGroup->GetTagsHash());
+
+    // source id takes part in the hash
+    mEventGroup->SetMetadata(EventGroupMetaKey::SOURCE_ID, string("source"));
+    newHash = mEventGroup->GetTagsHash();
+    APSARA_TEST_NOT_EQUAL(hash, newHash);
+    mEventGroup->SetMetadata(EventGroupMetaKey::LOG_FORMAT, string("format"));
+    APSARA_TEST_EQUAL(newHash, mEventGroup->GetTagsHash());
+    mEventGroup->DelMetadata(EventGroupMetaKey::SOURCE_ID);
+    APSARA_TEST_EQUAL(hash, mEventGroup->GetTagsHash());
+
+    // the cached value follows the group when copied or moved
+    auto copied = mEventGroup->Copy();
+    APSARA_TEST_EQUAL(hash, copied.GetTagsHash());
+    PipelineEventGroup moved(std::move(copied));
+    APSARA_TEST_EQUAL(hash, moved.GetTagsHash());
+    moved.SetTag(string("key3"), string("value3"));
+    APSARA_TEST_NOT_EQUAL(hash, moved.GetTagsHash());
+    APSARA_TEST_EQUAL(hash, mEventGroup->GetTagsHash());
+}
+
 void PipelineEventGroupUnittest::TestFromJsonToJson() {
     std::string inJson = R"({
         "events" :
@@ -299,9 +395,11 @@ UNIT_TEST_CASE(PipelineEventGroupUnittest, TestAddEvent)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSwapEvents)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestReserveEvents)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestCopy)
+UNIT_TEST_CASE(PipelineEventGroupUnittest, TestShare)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDestructor)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSetMetadata)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDelMetadata)
+UNIT_TEST_CASE(PipelineEventGroupUnittest, TestGetTagsHash)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestFromJsonToJson)
 
 } // namespace logtail
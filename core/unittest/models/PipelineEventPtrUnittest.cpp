@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <cstdlib>
+#include <utility>
 
 #include "models/PipelineEventGroup.h"
 #include "models/PipelineEventPtr.h"
@@ -27,6 +28,7 @@ public:
     void TestCast();
     void TestRelease();
     void TestCopy();
+    void TestShare();
 
 protected:
     void SetUp() override {
@@ -126,11 +128,48 @@ void PipelineEventPtrUnittest::TestCopy() {
     }
 }
 
+void PipelineEventPtrUnittest::TestShare() {
+    auto logUPtr = mEventGroup->CreateLogEvent();
+    auto* addr = logUPtr.get();
+    PipelineEventPtr origin(std::move(logUPtr), false, nullptr);
+    APSARA_TEST_FALSE(origin.IsShared());
+    {
+        auto shared = origin.Share();
+        APSARA_TEST_TRUE(origin.IsShared());
+        APSARA_TEST_TRUE(shared.IsShared());
+        APSARA_TEST_EQUAL(addr, &std::as_const(shared).Cast<LogEvent>());
+        APSARA_TEST_EQUAL(PipelineEvent::Type::LOG, std::as_const(shared)->GetType());
+        APSARA_TEST_TRUE(shared.IsShared());
+        // non-const access copies the event
+        shared->SetTimestamp(12345678901);
+        APSARA_TEST_FALSE(shared.IsShared());
+        APSARA_TEST_FALSE(origin.IsShared());
+        APSARA_TEST_NOT_EQUAL(addr, shared.Get<LogEvent>());
+        APSARA_TEST_EQUAL(0, origin->GetTimestamp());
+        APSARA_TEST_EQUAL(addr, origin.Get<LogEvent>());
+    }
+    {
+        auto shared = origin.Share();
+        // only the last owner gets the event
+        APSARA_TEST_EQUAL(nullptr, shared.Release());
+        APSARA_TEST_FALSE(origin.IsShared());
+        APSARA_TEST_EQUAL(addr, &origin.Cast<LogEvent>());
+    }
+    {
+        auto shared = origin.Share();
+        APSARA_TEST_EQUAL(nullptr, origin.Release());
+        APSARA_TEST_FALSE(shared.IsShared());
+        APSARA_TEST_EQUAL(addr, shared.Release());
+        delete addr;
+    }
+}
+
 UNIT_TEST_CASE(PipelineEventPtrUnittest, TestIs)
 UNIT_TEST_CASE(PipelineEventPtrUnittest, TestGet)
 UNIT_TEST_CASE(PipelineEventPtrUnittest, TestCast)
 UNIT_TEST_CASE(PipelineEventPtrUnittest, TestRelease)
 UNIT_TEST_CASE(PipelineEventPtrUnittest, TestCopy)
+UNIT_TEST_CASE(PipelineEventPtrUnittest, TestShare)
 
 } // namespace logtail
 
@@ -25,6 +25,7 @@ namespace logtail {
 class SizedContainerUnittest : public ::testing::Test {
 public:
     void TestInsertAndErase();
+    void TestFlatTagMap();
 
 protected:
 private:
@@ -124,8 +125,42 @@ void SizedContainerUnittest::TestInsertAndErase() {
     }
 }
 
+void SizedContainerUnittest::TestFlatTagMap() {
+    SizedFlatTagMap tags;
+    auto basicSize = sizeof(FlatTagMap);
+    tags.Insert("key3", "value3");
+    tags.Insert("key1", "value1");
+    tags.Insert("key2", "value2");
+    APSARA_TEST_EQUAL(3U, tags.mInner.size());
+    APSARA_TEST_EQUAL(basicSize + 30, tags.DataSize());
+    // kept sorted by key regardless of the insertion order
+    vector<string> keys;
+    for (const auto& item : tags.mInner) {
+        keys.emplace_back(item.first.to_string());
+    }
+    APSARA_TEST_EQUAL(vector<string>({"key1", "key2", "key3"}), keys);
+    APSARA_TEST_EQUAL("value2", tags.mInner.find("key2")->second.to_string());
+    APSARA_TEST_TRUE(tags.mInner.find("key4") == tags.mInner.end());
+    APSARA_TEST_EQUAL(0U, tags.mInner.count("key4"));
+
+    tags.Insert("key2", "value22");
+    APSARA_TEST_EQUAL(3U, tags.mInner.size());
+    APSARA_TEST_EQUAL(basicSize + 31, tags.DataSize());
+    APSARA_TEST_EQUAL("value22", tags.mInner["key2"].to_string());
+
+    tags.Erase("key1");
+    tags.Erase("key1");
+    APSARA_TEST_EQUAL(2U, tags.mInner.size());
+    APSARA_TEST_EQUAL(basicSize + 21, tags.DataSize());
+    APSARA_TEST_EQUAL("key2", tags.mInner.begin()->first.to_string());
+
+    tags.Clear();
+    APSARA_TEST_TRUE(tags.mInner.empty());
+    APSARA_TEST_EQUAL(basicSize, tags.DataSize());
+}
 
 UNIT_TEST_CASE(SizedContainerUnittest, TestInsertAndErase)
+UNIT_TEST_CASE(SizedContainerUnittest, TestFlatTagMap)
 
 } // namespace logtail
 
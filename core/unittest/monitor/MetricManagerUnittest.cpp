@@ -41,11 +41,13 @@ public:
     void TestCreateMetricAutoDelete();
     void TestCreateMetricAutoDeleteMultiThread();
     void TestCreateAndDeleteMetric();
+    void TestShardedCounter();
 };
 
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateMetricAutoDelete, 0);
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateMetricAutoDeleteMultiThread, 1);
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateAndDeleteMetric, 2);
+APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestShardedCounter, 3);
 
 
 void MetricManagerUnittest::TestCreateMetricAutoDelete() {
@@ -329,6 +331,45 @@ void MetricManagerUnittest::TestCreateAndDeleteMetric() {
     delete fileMetric1;
 }
 
+void MetricManagerUnittest::TestShardedCounter() {
+    MetricsRecordRef fileMetric;
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(fileMetric, MetricCategory::METRIC_CATEGORY_UNKNOWN, {});
+    CounterPtr counter = fileMetric.CreateCounter("counter");
+    ShardedCounterPtr shardedCounter = fileMetric.CreateShardedCounter("sharded_counter");
+    ShardedTimeCounterPtr shardedTimeCounter = fileMetric.CreateShardedTimeCounter("sharded_time_counter");
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 8; ++i) {
+        threads.emplace_back([&]() {
+            for (size_t j = 0; j < 1000; ++j) {
+                ADD_COUNTER(shardedCounter, 1);
+                ADD_COUNTER(shardedTimeCounter, std::chrono::milliseconds(1));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    ADD_COUNTER(counter, 1);
+    APSARA_TEST_EQUAL(8000U, shardedCounter->GetValue());
+    APSARA_TEST_EQUAL(8000U, shardedTimeCounter->GetValue());
+
+    // sharded counters are merged into the plain counters of the snapshot
+    ReadMetrics::GetInstance()->UpdateMetrics();
+    MetricsRecord* tmp = ReadMetrics::GetInstance()->GetHead();
+    APSARA_TEST_TRUE(tmp != nullptr);
+    APSARA_TEST_EQUAL(2U, tmp->GetCounters().size());
+    APSARA_TEST_EQUAL("counter", tmp->GetCounters()[0]->GetName());
+    APSARA_TEST_EQUAL(1U, tmp->GetCounters()[0]->GetValue());
+    APSARA_TEST_EQUAL("sharded_counter", tmp->GetCounters()[1]->GetName());
+    APSARA_TEST_EQUAL(8000U, tmp->GetCounters()[1]->GetValue());
+    APSARA_TEST_EQUAL(1U, tmp->GetTimeCounters().size());
+    APSARA_TEST_EQUAL("sharded_time_counter", tmp->GetTimeCounters()[0]->GetName());
+    APSARA_TEST_EQUAL(8000U, tmp->GetTimeCounters()[0]->GetValue());
+    APSARA_TEST_EQUAL(0U, shardedCounter->GetValue());
+    APSARA_TEST_EQUAL(0U, shardedTimeCounter->GetValue());
+}
+
 } // namespace logtail
 
 int main(int argc, char** argv) {
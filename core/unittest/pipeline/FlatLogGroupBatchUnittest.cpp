@@ -0,0 +1,157 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/Flags.h"
+#include "common/HashUtil.h"
+#include "common/StringTools.h"
+#include "constants/TagConstants.h"
+#include "go_pipeline/FlatLogGroupBatch.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(max_send_log_group_size);
+
+using namespace std;
+
+namespace logtail {
+
+class FlatLogGroupBatchUnittest : public ::testing::Test {
+public:
+    void TestAdd();
+    void TestAddUnsupportedGroup();
+    void TestAddOversizedGroup();
+
+private:
+    PipelineEventGroup CreateLogEventGroup(const string& packId, size_t eventCnt, bool enableNanosecond);
+    string GetString(const FlatLogGroupBatch& batch, size_t idx) const;
+};
+
+void FlatLogGroupBatchUnittest::TestAdd() {
+    FlatLogGroupBatch batch;
+    string errorMsg;
+    APSARA_TEST_TRUE(batch.Add(CreateLogEventGroup("pack1", 2, true), true, "logstore", "pack1", errorMsg));
+    APSARA_TEST_TRUE(batch.Add(CreateLogEventGroup("pack2", 1, false), false, "logstore", "pack2", errorMsg));
+    APSARA_TEST_EQUAL(2U, batch.GetGroupCnt());
+    APSARA_TEST_EQUAL(3U, batch.GetLogCnt());
+    batch.Finalize();
+
+    const auto& meta = batch.GetMeta();
+    APSARA_TEST_EQUAL(batch.GetDataSize(), meta.size() * sizeof(uint32_t) + batch.GetArena().size());
+    APSARA_TEST_EQUAL(FlatLogGroupBatch::kMagic, meta[0]);
+    APSARA_TEST_EQUAL(FlatLogGroupBatch::kVersion, meta[1]);
+    APSARA_TEST_EQUAL(2U, meta[2]);
+    APSARA_TEST_EQUAL(3U, meta[3]);
+    // 1 tag for each group, and 2 contents for each log
+    APSARA_TEST_EQUAL(8U, meta[4]);
+
+    size_t groupBase = FlatLogGroupBatch::kHeaderWords;
+    size_t logBase = groupBase + 2 * FlatLogGroupBatch::kGroupWords;
+    size_t pairBase = logBase + 3 * FlatLogGroupBatch::kLogWords;
+    APSARA_TEST_EQUAL(pairBase + 8 * FlatLogGroupBatch::kPairWords, meta.size());
+    {
+        size_t idx = groupBase;
+        APSARA_TEST_EQUAL(ToHexString(HashString("pack1")), GetString(batch, idx));
+        APSARA_TEST_EQUAL("topic", GetString(batch, idx + 2));
+        APSARA_TEST_EQUAL("logstore", GetString(batch, idx + 4));
+        APSARA_TEST_EQUAL(0U, meta[idx + 6]);
+        APSARA_TEST_EQUAL(1U, meta[idx + 7]);
+        APSARA_TEST_EQUAL(0U, meta[idx + 8]);
+        APSARA_TEST_EQUAL(2U, meta[idx + 9]);
+        APSARA_TEST_EQUAL("tag_key", GetString(batch, pairBase));
+        APSARA_TEST_EQUAL("tag_value", GetString(batch, pairBase + 2));
+
+        idx = logBase + FlatLogGroupBatch::kLogWords;
+        APSARA_TEST_EQUAL(1234567891U, meta[idx]);
+        APSARA_TEST_EQUAL(1U, meta[idx + 1]);
+        APSARA_TEST_EQUAL(1U, meta[idx + 2]);
+        APSARA_TEST_EQUAL(3U, meta[idx + 3]);
+        APSARA_TEST_EQUAL(2U, meta[idx + 4]);
+        idx = pairBase + 3 * FlatLogGroupBatch::kPairWords;
+        APSARA_TEST_EQUAL("content", GetString(batch, idx));
+        APSARA_TEST_EQUAL("value1", GetString(batch, idx + 2));
+        APSARA_TEST_EQUAL("level", GetString(batch, idx + 4));
+        APSARA_TEST_EQUAL("INFO", GetString(batch, idx + 6));
+    }
+    {
+        size_t idx = groupBase + FlatLogGroupBatch::kGroupWords;
+        APSARA_TEST_EQUAL(ToHexString(HashString("pack2")), GetString(batch, idx));
+        APSARA_TEST_EQUAL(5U, meta[idx + 6]);
+        APSARA_TEST_EQUAL(1U, meta[idx + 7]);
+        APSARA_TEST_EQUAL(2U, meta[idx + 8]);
+        APSARA_TEST_EQUAL(1U, meta[idx + 9]);
+
+        // nanosecond is disabled
+        idx = logBase + 2 * FlatLogGroupBatch::kLogWords;
+        APSARA_TEST_EQUAL(1234567890U, meta[idx]);
+        APSARA_TEST_EQUAL(0U, meta[idx + 2]);
+    }
+
+    batch.Clear();
+    APSARA_TEST_TRUE(batch.IsEmpty());
+    APSARA_TEST_TRUE(batch.GetArena().empty());
+}
+
+void FlatLogGroupBatchUnittest::TestAddUnsupportedGroup() {
+    FlatLogGroupBatch batch;
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.AddMetricEvent();
+    string errorMsg;
+    APSARA_TEST_FALSE(batch.Add(group, false, "logstore", "pack", errorMsg));
+    APSARA_TEST_FALSE(errorMsg.empty());
+    APSARA_TEST_TRUE(batch.IsEmpty());
+}
+
+void FlatLogGroupBatchUnittest::TestAddOversizedGroup() {
+    FlatLogGroupBatch batch;
+    string errorMsg;
+    APSARA_TEST_TRUE(batch.Add(CreateLogEventGroup("pack1", 1, false), false, "logstore", "pack1", errorMsg));
+    auto dataSize = batch.GetDataSize();
+
+    INT32_FLAG(max_send_log_group_size) = 100;
+    APSARA_TEST_FALSE(batch.Add(CreateLogEventGroup("pack2", 10, false), false, "logstore", "pack2", errorMsg));
+    INT32_FLAG(max_send_log_group_size) = 10 * 1024 * 1024;
+    // the previous group is not affected
+    APSARA_TEST_EQUAL(1U, batch.GetGroupCnt());
+    APSARA_TEST_EQUAL(1U, batch.GetLogCnt());
+    APSARA_TEST_EQUAL(dataSize, batch.GetDataSize());
+}
+
+PipelineEventGroup
+FlatLogGroupBatchUnittest::CreateLogEventGroup(const string& packId, size_t eventCnt, bool enableNanosecond) {
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(LOG_RESERVED_KEY_TOPIC, "topic");
+    group.SetTag(string("tag_key"), string("tag_value"));
+    for (size_t i = 0; i < eventCnt; ++i) {
+        LogEvent* e = group.AddLogEvent();
+        e->SetContent(string("content"), string("value") + ToString(i));
+        e->SetContent(string("level"), string("INFO"));
+        if (enableNanosecond) {
+            e->SetTimestamp(1234567890 + i, i);
+        } else {
+            e->SetTimestamp(1234567890 + i);
+        }
+    }
+    return group;
+}
+
+string FlatLogGroupBatchUnittest::GetString(const FlatLogGroupBatch& batch, size_t idx) const {
+    return batch.GetArena().substr(batch.GetMeta()[idx], batch.GetMeta()[idx + 1]);
+}
+
+UNIT_TEST_CASE(FlatLogGroupBatchUnittest, TestAdd)
+UNIT_TEST_CASE(FlatLogGroupBatchUnittest, TestAddUnsupportedGroup)
+UNIT_TEST_CASE(FlatLogGroupBatchUnittest, TestAddOversizedGroup)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
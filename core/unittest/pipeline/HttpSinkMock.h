@@ -55,6 +55,14 @@ public:
         ClearRequests();
     }
 
+    bool AddRequest(std::unique_ptr<HttpSinkRequest>&& request) override {
+        return Sink<HttpSinkRequest>::AddRequest(std::move(request));
+    }
+
+    void AddRequests(std::vector<std::unique_ptr<HttpSinkRequest>>& requests) override {
+        Sink<HttpSinkRequest>::AddRequests(requests);
+    }
+
     void Run() {
         LOG_INFO(sLogger, ("http sink mock", "started"));
         while (true) {
@@ -94,6 +102,7 @@ private:
     HttpSinkMock() = default;
     ~HttpSinkMock() = default;
 
+    std::future<void> mThreadRes;
     std::atomic_bool mIsFlush = false;
     mutable std::mutex mMutex;
     std::vector<SenderQueueItem> mRequests;
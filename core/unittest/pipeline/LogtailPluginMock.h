@@ -81,13 +81,25 @@ public:
                                                                                           logGroup)("packId", packId));
     }
 
+    void ProcessLogGroups(const std::string& configName, const logtail::FlatLogGroupBatch& batch) {
+        while (processBlockFlag) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        processedGroupCnt += batch.GetGroupCnt();
+        LOG_INFO(sLogger,
+                 ("LogtailPluginMock process log groups", "success")("config", configName)("group cnt",
+                                                                                           batch.GetGroupCnt()));
+    }
+
     bool IsStarted() const { return startFlag; }
+    size_t GetProcessedGroupCnt() const { return processedGroupCnt; }
 
 private:
     std::atomic_bool startBlockFlag = false;
     std::atomic_bool processBlockFlag = false;
     std::atomic_bool stopBlockFlag = false;
     std::atomic_bool startFlag = false;
+    std::atomic_size_t processedGroupCnt = 0;
 };
 
 } // namespace logtail
@@ -2750,13 +2750,13 @@ void PipelineUnittest::TestProcess() const {
     WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
         pipeline.mMetricsRecordRef, MetricCategory::METRIC_CATEGORY_UNKNOWN, {});
     pipeline.mProcessorsInEventsTotal
-        = pipeline.mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENTS_TOTAL);
+        = pipeline.mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENTS_TOTAL);
     pipeline.mProcessorsInGroupsTotal
-        = pipeline.mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENT_GROUPS_TOTAL);
+        = pipeline.mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENT_GROUPS_TOTAL);
     pipeline.mProcessorsInSizeBytes
-        = pipeline.mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES);
+        = pipeline.mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES);
     pipeline.mProcessorsTotalProcessTimeMs
-        = pipeline.mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS);
+        = pipeline.mMetricsRecordRef.CreateShardedTimeCounter(METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS);
 
     vector<PipelineEventGroup> groups;
     groups.emplace_back(make_shared<SourceBuffer>());
@@ -2799,13 +2799,13 @@ void PipelineUnittest::TestSend() const {
         WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
             pipeline.mMetricsRecordRef, MetricCategory::METRIC_CATEGORY_UNKNOWN, {});
         pipeline.mFlushersInGroupsTotal
-            = pipeline.mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL);
+            = pipeline.mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL);
         pipeline.mFlushersInEventsTotal
-            = pipeline.mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL);
+            = pipeline.mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL);
         pipeline.mFlushersInSizeBytes
-            = pipeline.mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES);
+            = pipeline.mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES);
         pipeline.mFlushersTotalPackageTimeMs
-            = pipeline.mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS);
+            = pipeline.mMetricsRecordRef.CreateShardedTimeCounter(METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS);
         {
             // all valid
             vector<PipelineEventGroup> group;
@@ -2866,13 +2866,13 @@ void PipelineUnittest::TestSend() const {
         WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
             pipeline.mMetricsRecordRef, MetricCategory::METRIC_CATEGORY_UNKNOWN, {});
         pipeline.mFlushersInGroupsTotal
-            = pipeline.mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL);
+            = pipeline.mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL);
         pipeline.mFlushersInEventsTotal
-            = pipeline.mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL);
+            = pipeline.mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL);
         pipeline.mFlushersInSizeBytes
-            = pipeline.mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES);
+            = pipeline.mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES);
         pipeline.mFlushersTotalPackageTimeMs
-            = pipeline.mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS);
+            = pipeline.mMetricsRecordRef.CreateShardedTimeCounter(METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS);
 
         {
             vector<PipelineEventGroup> group;
@@ -0,0 +1,182 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "collection_pipeline/plugin/instance/ProcessorProfiler.h"
+#include "common/Flags.h"
+#include "unittest/Unittest.h"
+#include "unittest/plugin/PluginMock.h"
+
+DECLARE_FLAG_DOUBLE(processor_profile_sample_rate);
+DECLARE_FLAG_INT32(processor_profile_publish_interval_sec);
+
+using namespace std;
+
+namespace logtail {
+
+class ProcessorProfilerUnittest : public testing::Test {
+public:
+    void TestHistogramBucket() const;
+    void TestHistogramQuantile() const;
+    void TestShouldSample() const;
+    void TestProcess() const;
+    void TestDumpFoldedStacks() const;
+
+protected:
+    void TearDown() override {
+        DOUBLE_FLAG(processor_profile_sample_rate) = 0.0;
+        INT32_FLAG(processor_profile_publish_interval_sec) = 60;
+    }
+};
+
+void ProcessorProfilerUnittest::TestHistogramBucket() const {
+    // exact below the number of sub buckets
+    for (uint64_t i = 0; i < LatencyHistogram::kSubBuckets; ++i) {
+        APSARA_TEST_EQUAL(i, LatencyHistogram::GetBucketIndex(i));
+        APSARA_TEST_EQUAL(i, LatencyHistogram::GetBucketUpperBound(i));
+    }
+    // every value falls into a bucket whose bounds contain it, with relative error below 1 / kSubBuckets
+    vector<uint64_t> values = {8, 9, 15, 16, 17, 100, 1000, 123456, 1ULL << 40, UINT64_MAX};
+    for (uint64_t value : values) {
+        size_t index = LatencyHistogram::GetBucketIndex(value);
+        APSARA_TEST_TRUE(index < LatencyHistogram::kBucketCnt);
+        uint64_t upper = LatencyHistogram::GetBucketUpperBound(index);
+        APSARA_TEST_TRUE(value <= upper);
+        APSARA_TEST_TRUE((upper - value) <= value / LatencyHistogram::kSubBuckets);
+        APSARA_TEST_TRUE(index == 0 || LatencyHistogram::GetBucketUpperBound(index - 1) < value);
+    }
+    APSARA_TEST_EQUAL(LatencyHistogram::kBucketCnt - 1, LatencyHistogram::GetBucketIndex(UINT64_MAX));
+}
+
+void ProcessorProfilerUnittest::TestHistogramQuantile() const {
+    LatencyHistogram histogram;
+    APSARA_TEST_EQUAL(0U, histogram.GetValueAtQuantile(0.5));
+    APSARA_TEST_EQUAL(0U, histogram.GetMax());
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        histogram.Record(i);
+    }
+    APSARA_TEST_EQUAL(1000U, histogram.GetCount());
+    uint64_t p50 = histogram.GetValueAtQuantile(0.5);
+    APSARA_TEST_TRUE(p50 >= 500 && p50 < 500 + 500 / LatencyHistogram::kSubBuckets);
+    uint64_t p99 = histogram.GetValueAtQuantile(0.99);
+    APSARA_TEST_TRUE(p99 >= 990 && p99 < 990 + 990 / LatencyHistogram::kSubBuckets);
+    uint64_t max = histogram.GetMax();
+    APSARA_TEST_TRUE(max >= 1000 && max < 1000 + 1000 / LatencyHistogram::kSubBuckets);
+    APSARA_TEST_EQUAL(1U, histogram.GetValueAtQuantile(0.0));
+
+    histogram.Reset();
+    APSARA_TEST_EQUAL(0U, histogram.GetCount());
+    APSARA_TEST_EQUAL(0U, histogram.GetValueAtQuantile(0.99));
+}
+
+void ProcessorProfilerUnittest::TestShouldSample() const {
+    DOUBLE_FLAG(processor_profile_sample_rate) = 0.0;
+    APSARA_TEST_FALSE(ProcessorProfiler::IsEnabled());
+    APSARA_TEST_FALSE(ProcessorProfiler::ShouldSample());
+
+    DOUBLE_FLAG(processor_profile_sample_rate) = 1.0;
+    APSARA_TEST_TRUE(ProcessorProfiler::ShouldSample());
+
+    DOUBLE_FLAG(processor_profile_sample_rate) = 0.1;
+    size_t sampled = 0;
+    for (size_t i = 0; i < 100000; ++i) {
+        if (ProcessorProfiler::ShouldSample()) {
+            ++sampled;
+        }
+    }
+    APSARA_TEST_TRUE(sampled > 9000 && sampled < 11000);
+}
+
+void ProcessorProfilerUnittest::TestProcess() const {
+    DOUBLE_FLAG(processor_profile_sample_rate) = 1.0;
+    INT32_FLAG(processor_profile_publish_interval_sec) = 0;
+    unique_ptr<ProcessorInstance> processor
+        = make_unique<ProcessorInstance>(new ProcessorMock(), PluginInstance::PluginMeta("0"));
+    Json::Value config;
+    CollectionPipelineContext context;
+    context.SetConfigName("test_config");
+    APSARA_TEST_TRUE(processor->Init(config, context));
+    APSARA_TEST_NOT_EQUAL(nullptr, processor->mProfiler);
+
+    vector<PipelineEventGroup> groups;
+    groups.emplace_back(make_shared<SourceBuffer>());
+    groups[0].AddLogEvent();
+    groups[0].AddLogEvent();
+
+    // not sampled
+    processor->Process(groups);
+    APSARA_TEST_EQUAL(0U, processor->mProfiler->mSampledEventGroupsTotal->GetValue());
+
+    processor->Process(groups, true);
+    auto& profiler = *processor->mProfiler;
+    APSARA_TEST_EQUAL(1U, profiler.mSampledEventGroupsTotal->GetValue());
+    APSARA_TEST_EQUAL(2U, profiler.mInEventsTotal->GetValue());
+    APSARA_TEST_EQUAL(2U, profiler.mOutEventsTotal->GetValue());
+    // the histogram is reset once the quantiles are published
+    APSARA_TEST_EQUAL(0U, profiler.mLatencyUs.GetCount());
+
+    // disabled on init
+    DOUBLE_FLAG(processor_profile_sample_rate) = 0.0;
+    processor = make_unique<ProcessorInstance>(new ProcessorMock(), PluginInstance::PluginMeta("1"));
+    APSARA_TEST_TRUE(processor->Init(config, context));
+    APSARA_TEST_EQUAL(nullptr, processor->mProfiler);
+    processor->Process(groups, true);
+    APSARA_TEST_EQUAL(1U, static_cast<ProcessorMock*>(processor->mPlugin.get())->mCnt);
+}
+
+void ProcessorProfilerUnittest::TestDumpFoldedStacks() const {
+    MetricsRecordRef ref1;
+    MetricsRecordRef ref2;
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(ref1, MetricCategory::METRIC_CATEGORY_PLUGIN, {});
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(ref2, MetricCategory::METRIC_CATEGORY_PLUGIN, {});
+    auto profiler1 = make_unique<ProcessorProfiler>("config;processor_a/1", ref1);
+    auto profiler2 = make_unique<ProcessorProfiler>("config;processor_b/2", ref2);
+    ProcessorProfiler::Sample sample;
+    sample.mCpuTimeUs = 100;
+    profiler1->Record(sample);
+    profiler1->Record(sample);
+
+    filesystem::path path = filesystem::temp_directory_path() / "processor_profile_unittest.folded";
+    APSARA_TEST_TRUE(ProcessorProfiler::DumpFoldedStacks(path.string()));
+    {
+        ifstream fin(path);
+        string content((istreambuf_iterator<char>(fin)), istreambuf_iterator<char>());
+        // processors without any cpu time are omitted
+        APSARA_TEST_EQUAL("config;processor_a/1 200\n", content);
+    }
+
+    // destroyed profilers are no longer dumped
+    profiler1.reset();
+    APSARA_TEST_TRUE(ProcessorProfiler::DumpFoldedStacks(path.string()));
+    {
+        ifstream fin(path);
+        string content((istreambuf_iterator<char>(fin)), istreambuf_iterator<char>());
+        APSARA_TEST_EQUAL("", content);
+    }
+    filesystem::remove(path);
+}
+
+UNIT_TEST_CASE(ProcessorProfilerUnittest, TestHistogramBucket)
+UNIT_TEST_CASE(ProcessorProfilerUnittest, TestHistogramQuantile)
+UNIT_TEST_CASE(ProcessorProfilerUnittest, TestShouldSample)
+UNIT_TEST_CASE(ProcessorProfilerUnittest, TestProcess)
+UNIT_TEST_CASE(ProcessorProfilerUnittest, TestDumpFoldedStacks)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
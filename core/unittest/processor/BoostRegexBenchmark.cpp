@@ -15,11 +15,14 @@
 #include <cstdlib>
 #include <cstring>
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include "boost/regex.hpp"
 
+#include "common/regex/RegexMatcher.h"
 #include "unittest/Unittest.h"
 
 
@@ -96,6 +99,61 @@ static void BM_Regex_Search(int size, int batchSize) {
     }
 }
 
+// start pattern of a typical java multiline config, matched against the lines of a stack trace
+static void BM_Multiline_Start_Pattern(int batchSize) {
+    std::string regStr = "\\[\\d+-\\d+-\\d+\\s\\d+:\\d+:\\d+.*";
+    std::vector<std::string> lines = {
+        "[2024-01-01 00:00:00.000] ERROR [main] com.example.Service - request failed",
+        "java.lang.IllegalStateException: connection refused",
+        "    at com.example.client.Connection.open(Connection.java:120)",
+        "    at com.example.client.Pool.borrow(Pool.java:64)",
+        "    at com.example.Service.handle(Service.java:42)",
+        "Caused by: java.net.ConnectException: Connection refused (Connection refused)",
+        "    at java.net.PlainSocketImpl.socketConnect(Native Method)",
+        "    ... 12 more",
+    };
+    boost::regex reg(regStr);
+    RegexMatcher matcher(regStr, RegexMatcher::Mode::PARTIAL_MATCH);
+    std::cout << "engine: " << (matcher.GetEngine() == RegexMatcher::Engine::RE2 ? "re2" : "boost") << std::endl;
+
+    uint64_t bytes = 0;
+    for (const auto& line : lines) {
+        bytes += line.size();
+    }
+    bytes *= batchSize;
+
+    size_t boostMatched = 0;
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < batchSize; i++) {
+        for (const auto& line : lines) {
+            if (boost::regex_search(line, reg)) {
+                ++boostMatched;
+            }
+        }
+    }
+    uint64_t boostDurationTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    size_t matcherMatched = 0;
+    std::string exception;
+    startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < batchSize; i++) {
+        for (const auto& line : lines) {
+            if (matcher.Match(line, exception)) {
+                ++matcherMatched;
+            }
+        }
+    }
+    uint64_t matcherDurationTime = GetCurrentTimeInMicroSeconds() - startTime;
+
+    if (boostMatched != matcherMatched) {
+        std::cout << "error" << std::endl;
+    }
+    std::cout << "boost::regex_search durationTime: " << boostDurationTime
+              << "\tprocess: " << formatSize(bytes * 1000000 / std::max<uint64_t>(boostDurationTime, 1)) << std::endl;
+    std::cout << "RegexMatcher durationTime: " << matcherDurationTime
+              << "\tprocess: " << formatSize(bytes * 1000000 / std::max<uint64_t>(matcherDurationTime, 1)) << std::endl;
+}
+
 int main(int argc, char** argv) {
     logtail::Logger::Instance().InitGlobalLoggers();
 #ifdef NDEBUG
@@ -107,5 +165,7 @@ int main(int argc, char** argv) {
     BM_Regex_Match(100, 10000);
     std::cout << "BM_Regex_Search" << std::endl;
     BM_Regex_Search(100, 10000);
+    std::cout << "BM_Multiline_Start_Pattern" << std::endl;
+    BM_Multiline_Start_Pattern(100000);
     return 0;
 }
@@ -17,6 +17,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
 #include "config/CollectionConfig.h"
@@ -267,6 +268,56 @@ static void BM_ContainerdText(int size, int batchSize) {
     }
 }
 
+// lines of docker's own shape are parsed by the fast path, the reordered ones by the generic parser
+static void BM_DockerJsonShape(const std::vector<std::string>& lines, int size, int batchSize) {
+    CollectionPipelineContext mContext;
+    mContext.SetConfigName("project##config_0");
+
+    Json::Value config;
+    config["IgnoringStdout"] = false;
+    config["IgnoringStderr"] = false;
+    ProcessorParseContainerLogNative processor;
+    processor.SetContext(mContext);
+    processor.SetMetricsRecordRef(ProcessorParseContainerLogNative::sName, "1");
+    if (!processor.Init(config)) {
+        return;
+    }
+
+    uint64_t linesSize = 0;
+    Json::Value events;
+    for (int i = 0; i < size; i++) {
+        for (const auto& line : lines) {
+            Json::Value event;
+            event["type"] = 1;
+            event["timestamp"] = 1234567890;
+            event["timestampNanosecond"] = 0;
+            event["contents"]["content"] = line;
+            events.append(event);
+            linesSize += line.size();
+        }
+    }
+    Json::Value root;
+    root["events"] = events;
+    Json::StreamWriterBuilder builder;
+    builder["commentStyle"] = "None";
+    builder["indentation"] = "";
+    std::string inJson = Json::writeString(builder, root);
+
+    uint64_t durationTime = 0;
+    for (int i = 0; i < batchSize; i++) {
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        eventGroup.SetMetadata(EventGroupMetaKey::LOG_FORMAT, ProcessorParseContainerLogNative::DOCKER_JSON_FILE);
+        eventGroup.FromJsonString(inJson);
+
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        processor.Process(eventGroup);
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+    std::cout << "durationTime: " << durationTime << std::endl;
+    std::cout << "process: " << formatSize(linesSize * batchSize * 1000000 / durationTime) << std::endl;
+}
+
 int main(int argc, char** argv) {
     logtail::Logger::Instance().InitGlobalLoggers();
 #ifdef NDEBUG
@@ -278,5 +329,18 @@ int main(int argc, char** argv) {
     BM_DockerJson(512, 100);
     std::cout << "containerdText" << std::endl;
     BM_ContainerdText(512, 100);
+
+    std::string log(1024, 'a');
+    for (size_t i = 64; i < log.size(); i += 128) {
+        log.replace(i, 2, "\\t");
+    }
+    std::cout << "docker json of default shape" << std::endl;
+    BM_DockerJsonShape({R"({"log":")" + log + R"(\n","stream":"stdout","time":"2024-04-07T08:02:40.873971412Z"})"},
+                       2048,
+                       100);
+    std::cout << "docker json of other shape" << std::endl;
+    BM_DockerJsonShape({R"({"stream":"stdout","time":"2024-04-07T08:02:40.873971412Z","log":")" + log + R"(\n"})"},
+                       2048,
+                       100);
     return 0;
 }
@@ -54,6 +54,7 @@ public:
     void TestDockerJsonLogLineParser();
     void TestKeepingSourceWhenParseFail();
     void TestParseDockerLog();
+    void TestParseDockerLogOfDefaultShape();
 
     CollectionPipelineContext mContext;
 };
@@ -66,6 +67,7 @@ UNIT_TEST_CASE(ProcessorParseContainerLogNativeUnittest, TestDockerJsonLogLinePa
 UNIT_TEST_CASE(ProcessorParseContainerLogNativeUnittest, TestDockerJsonLogLineParser);
 UNIT_TEST_CASE(ProcessorParseContainerLogNativeUnittest, TestKeepingSourceWhenParseFail);
 UNIT_TEST_CASE(ProcessorParseContainerLogNativeUnittest, TestParseDockerLog);
+UNIT_TEST_CASE(ProcessorParseContainerLogNativeUnittest, TestParseDockerLogOfDefaultShape);
 // UNIT_TEST_CASE(ProcessorParseContainerLogNativeUnittest, TestFindAndSearchPerformance);
 
 // 生成一个随机字符串
@@ -2260,6 +2262,70 @@ void ProcessorParseContainerLogNativeUnittest::TestParseDockerLog() {
     }
 }
 
+void ProcessorParseContainerLogNativeUnittest::TestParseDockerLogOfDefaultShape() {
+    auto parse = [](std::string str, DockerLog& dockerLog, std::string& buffer) {
+        buffer = std::move(str);
+        return ProcessorParseContainerLogNative::ParseDockerLog(
+            const_cast<char*>(buffer.data()), buffer.size(), dockerLog);
+    };
+    std::string buffer;
+    // escapes across the whole log, including the field names of docker
+    {
+        DockerLog dockerLog;
+        APSARA_TEST_TRUE(parse(
+            R"({"log":"\"a\",\"stream\":\"stderr\",\"time\":\"x\" \\ 你 b\n","stream":"stderr","time":"2021"})",
+            dockerLog,
+            buffer));
+        APSARA_TEST_EQUAL(R"("a","stream":"stderr","time":"x" \ 你 b)"
+                          "\n",
+                          dockerLog.log.to_string());
+        APSARA_TEST_EQUAL("stderr", dockerLog.stream);
+        APSARA_TEST_EQUAL("2021", dockerLog.time);
+    }
+    // empty values
+    {
+        DockerLog dockerLog;
+        APSARA_TEST_TRUE(parse(R"({"log":"","stream":"","time":""})", dockerLog, buffer));
+        APSARA_TEST_TRUE(dockerLog.log.empty());
+        APSARA_TEST_TRUE(dockerLog.stream.empty());
+        APSARA_TEST_TRUE(dockerLog.time.empty());
+    }
+    // other shapes are left to the generic parser
+    {
+        DockerLog dockerLog;
+        APSARA_TEST_TRUE(
+            parse(R"({"stream":"stdout","time":"2021-12-01T00:00:00.000Z","log":"a\tb"})", dockerLog, buffer));
+        APSARA_TEST_EQUAL("a\tb", dockerLog.log.to_string());
+        APSARA_TEST_EQUAL("stdout", dockerLog.stream);
+        APSARA_TEST_EQUAL("2021-12-01T00:00:00.000Z", dockerLog.time);
+    }
+    {
+        DockerLog dockerLog;
+        APSARA_TEST_TRUE(
+            parse(R"({"log": "a\"b", "stream": "stdout", "time": "2021-12-01T00:00:00.000Z" })", dockerLog, buffer));
+        APSARA_TEST_EQUAL("a\"b", dockerLog.log.to_string());
+        APSARA_TEST_EQUAL("stdout", dockerLog.stream);
+        APSARA_TEST_EQUAL("2021-12-01T00:00:00.000Z", dockerLog.time);
+    }
+    // the tail matches, but there are more than 3 fields
+    {
+        DockerLog dockerLog;
+        APSARA_TEST_FALSE(
+            parse(R"({"log":"a","time":"b","stream":"stdout","time":"2021-12-01T00:00:00.000Z"})", dockerLog, buffer));
+    }
+    // escapes out of the log
+    {
+        DockerLog dockerLog;
+        APSARA_TEST_FALSE(parse(R"({"log":"a","stream":"stdout","time":"2021\n"})", dockerLog, buffer));
+        APSARA_TEST_FALSE(parse(R"({"log":"a","stream":"std\tout","time":"2021"})", dockerLog, buffer));
+    }
+    // the closing quote of the log is escaped
+    {
+        DockerLog dockerLog;
+        APSARA_TEST_FALSE(parse(R"({"log":"a\","stream":"stdout","time":"2021"})", dockerLog, buffer));
+    }
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <json/json.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/JsonUtil.h"
+#include "models/PipelineEventGroup.h"
+#include "prometheus/labels/Relabel.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+// metric relabel rules of a typical kube-state-metrics job
+static const char* sRelabelConfigs = R"JSON(
+[
+    {"action": "drop", "regex": "kube_(replicaset|endpoint|lease)_.*", "source_labels": ["__name__"]},
+    {"action": "keep", "regex": "kube_.*", "source_labels": ["__name__"]},
+    {"action": "dropmetric", "match_list": ["kube_pod_tolerations", "kube_pod_annotations"]},
+    {"action": "drop", "regex": "kube-system;.*", "source_labels": ["namespace", "pod"]},
+    {"action": "replace", "regex": "kube_([a-z]+)_.*", "replacement": "${1}", "source_labels": ["__name__"],
+     "target_label": "resource"},
+    {"action": "replace", "regex": "(.+);(.+)", "replacement": "${1}/${2}", "source_labels": ["namespace", "pod"],
+     "target_label": "workload"},
+    {"action": "replace", "regex": "(.*)-[a-z0-9]+-[a-z0-9]+", "replacement": "${1}", "source_labels": ["pod"],
+     "target_label": "deployment"},
+    {"action": "replace", "regex": "ip-(\\d+)-(\\d+)-(\\d+)-(\\d+).*", "replacement": "${1}.${2}.${3}.${4}",
+     "source_labels": ["node"], "target_label": "node_ip"},
+    {"action": "labelmap", "regex": "label_(.+)", "replacement": "k8s_${1}"},
+    {"action": "labeldrop", "regex": "label_.*"},
+    {"action": "labeldrop", "regex": "uid|container_id"},
+    {"action": "lowercase", "source_labels": ["phase"], "target_label": "phase"},
+    {"action": "hashmod", "modulus": 8, "source_labels": ["pod"], "target_label": "shard"},
+    {"action": "replace", "regex": "(.*)", "replacement": "prod", "target_label": "env"},
+    {"action": "drop", "regex": "Succeeded|Failed", "source_labels": ["phase"]}
+]
+)JSON";
+
+class RelabelBenchmark : public testing::Test {
+public:
+    void TestProcess1M();
+
+protected:
+    void SetUp() override {
+        Json::Value config;
+        string errorMsg;
+        APSARA_TEST_TRUE(ParseJsonTable(sRelabelConfigs, config, errorMsg));
+        APSARA_TEST_TRUE(mConfigList.Init(config));
+    }
+
+private:
+    static void FillEvent(MetricEvent& event, size_t i) {
+        static const vector<string> sNames
+            = {"kube_pod_info", "kube_pod_status_phase", "kube_deployment_replicas", "kube_replicaset_owner"};
+        static const vector<string> sPhases = {"Running", "Pending", "Succeeded"};
+        auto pod = "nginx-" + to_string(i % 200) + "-7f9c6b-x" + to_string(i % 7);
+        event.SetName(sNames[i % sNames.size()]);
+        event.SetTag(string("namespace"), string(i % 10 == 0 ? "kube-system" : "default"));
+        event.SetTag(string("pod"), pod);
+        event.SetTag(string("uid"), "0f9c6b1e-" + to_string(i % 200));
+        event.SetTag(string("node"), "ip-10-0-" + to_string(i % 16) + "-1.ec2.internal");
+        event.SetTag(string("phase"), sPhases[i % sPhases.size()]);
+        event.SetTag(string("label_app"), string("nginx"));
+        event.SetTag(string("label_team"), string("infra"));
+        event.SetTag(string("container_id"), "containerd://" + to_string(i % 200));
+    }
+
+    RelabelConfigList mConfigList;
+};
+
+void RelabelBenchmark::TestProcess1M() {
+    // events are filled in both runs, so that the difference is in relabeling only
+    auto run = [this](bool useProgram) {
+        size_t kept = 0;
+        auto start = chrono::high_resolution_clock::now();
+        for (size_t batch = 0; batch < 1000; ++batch) {
+            PipelineEventGroup group(make_shared<SourceBuffer>());
+            for (size_t i = 0; i < 1000; ++i) {
+                auto* e = group.AddMetricEvent();
+                FillEvent(*e, i);
+                if (useProgram) {
+                    kept += mConfigList.Process(*e) ? 1 : 0;
+                } else {
+                    // each rule runs over Labels, which is the way before rules are compiled
+                    Labels labels;
+                    labels.Reset(e);
+                    kept += mConfigList.Process(labels) ? 1 : 0;
+                }
+            }
+        }
+        auto end = chrono::high_resolution_clock::now();
+        cout << (useProgram ? "program" : "legacy") << ": " << chrono::duration<double>(end - start).count()
+             << " seconds, kept " << kept << " of 1000000 samples" << endl;
+        return kept;
+    };
+    APSARA_TEST_EQUAL(run(false), run(true));
+}
+
+UNIT_TEST_CASE(RelabelBenchmark, TestProcess1M)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -20,7 +20,10 @@
 #include <string>
 
 #include "common/JsonUtil.h"
+#include "models/PipelineEventGroup.h"
+#include "prometheus/Constants.h"
 #include "prometheus/labels/Relabel.h"
+#include "prometheus/labels/RelabelProgram.h"
 #include "unittest/Unittest.h"
 
 using namespace std;
@@ -49,6 +52,8 @@ public:
     void TestLowerCase();
     void TestUpperCase();
     void TestMultiRelabel();
+    void TestProcessMetricEvent();
+    void TestCompileProgram();
 };
 
 
@@ -512,6 +517,120 @@ void RelabelConfigUnittest::TestMultiRelabel() {
     APSARA_TEST_TRUE(configList.Process(result));
 }
 
+void RelabelConfigUnittest::TestProcessMetricEvent() {
+    Json::Value configJson;
+    string errorMsg;
+    string configStr = R"JSON(
+        [{
+                "action": "keep",
+                "regex": "kube_.*",
+                "source_labels": ["__name__"]
+        },{
+                "action": "replace",
+                "regex": "kube_([a-z]+)_.*",
+                "replacement": "${1}",
+                "source_labels": ["__name__"],
+                "target_label": "resource"
+        },{
+                "action": "replace",
+                "regex": "(.*);(.*)",
+                "replacement": "${1}/${2}",
+                "source_labels": ["namespace", "pod"],
+                "target_label": "workload"
+        },{
+                "action": "labelmap",
+                "regex": "label_(.+)",
+                "replacement": "k8s_${1}"
+        },{
+                "action": "labeldrop",
+                "regex": "label_.*"
+        },{
+                "action": "uppercase",
+                "source_labels": ["resource"],
+                "target_label": "resource_upper"
+        },{
+                "action": "hashmod",
+                "modulus": 4,
+                "source_labels": ["pod"],
+                "target_label": "shard"
+        },{
+                "action": "drop",
+                "regex": "kube-system",
+                "source_labels": ["namespace"]
+        }]
+    )JSON";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    RelabelConfigList configList;
+    APSARA_TEST_TRUE(configList.Init(configJson));
+    APSARA_TEST_EQUAL(8U, configList.mProgram->mInstructions.size());
+
+    auto check = [&](const string& name, const vector<pair<string, string>>& tags) {
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        auto* event = group.AddMetricEvent();
+        event->SetName(name);
+        Labels labels;
+        labels.Set(prometheus::NAME, name);
+        for (const auto& [k, v] : tags) {
+            event->SetTag(k, v);
+            labels.Set(k, v);
+        }
+        // the result of the compiled program should be the same as running each config over labels
+        bool expected = configList.Process(labels);
+        APSARA_TEST_EQUAL(expected, configList.Process(*event));
+        if (!expected) {
+            return expected;
+        }
+        APSARA_TEST_EQUAL(labels.Size(), event->TagsSize());
+        labels.Range([&](const string& k, const string& v) { APSARA_TEST_EQUAL(v, event->GetTag(k).to_string()); });
+        return expected;
+    };
+    // twice to hit the regex cache
+    for (int i = 0; i < 2; ++i) {
+        APSARA_TEST_TRUE(check("kube_pod_info",
+                               {{"namespace", "default"}, {"pod", "nginx-0"}, {"label_app", "nginx"}, {"node", "n1"}}));
+        APSARA_TEST_TRUE(check("kube_node_info", {{"node", "n1"}, {"label_zone", "z1"}}));
+        APSARA_TEST_FALSE(check("kube_pod_info", {{"namespace", "kube-system"}, {"pod", "coredns-0"}}));
+        APSARA_TEST_FALSE(check("go_goroutines", {{"namespace", "default"}}));
+    }
+}
+
+void RelabelConfigUnittest::TestCompileProgram() {
+    Json::Value configJson;
+    string errorMsg;
+    string configStr = R"JSON(
+        [{
+                "action": "keep",
+                "regex": ".*",
+                "source_labels": ["__name__"]
+        },{
+                "action": "lowercase",
+                "source_labels": ["__name__"],
+                "target_label": "name"
+        },{
+                "action": "drop",
+                "regex": "(.*)",
+                "source_labels": ["__name__"]
+        },{
+                "action": "uppercase",
+                "source_labels": ["__name__"],
+                "target_label": "name"
+        }]
+    )JSON";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    RelabelConfigList configList;
+    APSARA_TEST_TRUE(configList.Init(configJson));
+    // keep all is removed, and rules after drop all are never reached
+    const auto& instructions = configList.mProgram->mInstructions;
+    APSARA_TEST_EQUAL(2U, instructions.size());
+    APSARA_TEST_EQUAL(Action::LOWERCASE, instructions[0].mAction);
+    APSARA_TEST_EQUAL(Action::DROP, instructions[1].mAction);
+
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    auto* event = group.AddMetricEvent();
+    event->SetName("test");
+    APSARA_TEST_FALSE(configList.Process(*event));
+}
+
 UNIT_TEST_CASE(ActionConverterUnittest, TestStringToAction)
 UNIT_TEST_CASE(ActionConverterUnittest, TestActionToString)
 
@@ -529,6 +648,8 @@ UNIT_TEST_CASE(RelabelConfigUnittest, TestKeepEqual)
 UNIT_TEST_CASE(RelabelConfigUnittest, TestLowerCase)
 UNIT_TEST_CASE(RelabelConfigUnittest, TestUpperCase)
 UNIT_TEST_CASE(RelabelConfigUnittest, TestMultiRelabel)
+UNIT_TEST_CASE(RelabelConfigUnittest, TestProcessMetricEvent)
+UNIT_TEST_CASE(RelabelConfigUnittest, TestCompileProgram)
 
 } // namespace logtail
 
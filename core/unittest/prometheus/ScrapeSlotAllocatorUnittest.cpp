@@ -0,0 +1,90 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "prometheus/Utils.h"
+#include "prometheus/schedulers/ScrapeSlotAllocator.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class ScrapeSlotAllocatorUnittest : public ::testing::Test {
+public:
+    void TestAllocate();
+    void TestEvenSpread();
+    void TestRelease();
+
+protected:
+    void TearDown() override {
+        auto* allocator = ScrapeSlotAllocator::GetInstance();
+        allocator->mAssignments.clear();
+        allocator->mWheels.clear();
+    }
+};
+
+void ScrapeSlotAllocatorUnittest::TestAllocate() {
+    auto* allocator = ScrapeSlotAllocator::GetInstance();
+    auto offset = allocator->Allocate("job/target", 15);
+    APSARA_TEST_TRUE(offset < 15000U);
+    // idempotent
+    APSARA_TEST_EQUAL(offset, allocator->Allocate("job/target", 15));
+    APSARA_TEST_EQUAL(1U, allocator->mAssignments.size());
+
+    // interval changed
+    APSARA_TEST_TRUE(allocator->Allocate("job/target", 1) < 1000U);
+    APSARA_TEST_EQUAL(1U, allocator->mAssignments.size());
+    APSARA_TEST_EQUAL(1U, allocator->mWheels.size());
+    APSARA_TEST_EQUAL(1000U, allocator->mWheels.begin()->first);
+
+    APSARA_TEST_EQUAL(offset, GetSleepMilliSecToOffset(offset, 15, 30000));
+    APSARA_TEST_EQUAL(15000U - 1, GetSleepMilliSecToOffset(offset, 15, 30000 + offset + 1));
+}
+
+void ScrapeSlotAllocatorUnittest::TestEvenSpread() {
+    auto* allocator = ScrapeSlotAllocator::GetInstance();
+    // 150 slots of 100ms
+    for (int i = 0; i < 600; ++i) {
+        allocator->Allocate("job/target-" + to_string(i), 15);
+    }
+    const auto& loads = allocator->mWheels[15000].mLoads;
+    APSARA_TEST_EQUAL(150U, loads.size());
+    // at most 1.25 times the average
+    APSARA_TEST_TRUE(*max_element(loads.begin(), loads.end()) <= 5U);
+}
+
+void ScrapeSlotAllocatorUnittest::TestRelease() {
+    auto* allocator = ScrapeSlotAllocator::GetInstance();
+    allocator->Allocate("job/target-1", 15);
+    allocator->Allocate("job/target-2", 15);
+    allocator->Release("job/target-1");
+    allocator->Release("job/target-unknown");
+    APSARA_TEST_EQUAL(1U, allocator->mAssignments.size());
+    APSARA_TEST_EQUAL(1U, allocator->mWheels[15000].mTargetCnt);
+    allocator->Release("job/target-2");
+    APSARA_TEST_TRUE(allocator->mAssignments.empty());
+    APSARA_TEST_TRUE(allocator->mWheels.empty());
+}
+
+UNIT_TEST_CASE(ScrapeSlotAllocatorUnittest, TestAllocate)
+UNIT_TEST_CASE(ScrapeSlotAllocatorUnittest, TestEvenSpread)
+UNIT_TEST_CASE(ScrapeSlotAllocatorUnittest, TestRelease)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
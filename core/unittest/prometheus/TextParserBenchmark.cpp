@@ -14,19 +14,42 @@
  * limitations under the License.
  */
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
 #include <string>
 
+#include "prometheus/Utils.h"
 #include "prometheus/labels/TextParser.h"
 #include "unittest/Unittest.h"
 
 using namespace std;
 
+static atomic_size_t sAllocCnt{0};
+
+void* operator new(size_t size) {
+    sAllocCnt.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
 namespace logtail {
 
 class TextParserBenchmark : public testing::Test {
 public:
     void TestParse100M() const;
     void TestParse1000M() const;
+    void TestParseLine100M() const;
 
 protected:
     void SetUp() override {
@@ -47,6 +70,13 @@ protected:
     }
 
 private:
+    static void PrintResult(size_t dataSize, size_t sampleCnt, size_t allocCnt, chrono::duration<double> elapsed) {
+        cout << "elapsed: " << elapsed.count() << " seconds" << endl;
+        cout << "throughput: " << dataSize / 1024.0 / 1024.0 / elapsed.count() << " MB/s" << endl;
+        cout << "samples: " << sampleCnt << ", allocations per sample: " << static_cast<double>(allocCnt) / sampleCnt
+             << endl;
+    }
+
     std::string mRawData = R"""(
 test_metric1{k1="v1", k2="v2"} 2.0 1234567890
 test_metric2{k1="v1",k2="v2"} 9.9410452992e+10
@@ -63,32 +93,54 @@ test_metric8{k1="v1", k2="v2", } 9.9410452992e+10 1715829785083
 
 void TextParserBenchmark::TestParse100M() const {
     auto start = std::chrono::high_resolution_clock::now();
+    size_t allocCnt = sAllocCnt.load();
 
     TextParser parser;
     auto res = parser.Parse(m100MData, 0, 0);
 
     auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> elapsed = end - start;
-    cout << "elapsed: " << elapsed.count() << " seconds" << endl;
-    // elapsed: 1.53s in release mode
-    // elapsed: 551MB in release mode
+    PrintResult(m100MData.size(), res.GetEvents().size(), sAllocCnt.load() - allocCnt, end - start);
 }
 
 void TextParserBenchmark::TestParse1000M() const {
     auto start = std::chrono::high_resolution_clock::now();
+    size_t allocCnt = sAllocCnt.load();
 
     TextParser parser;
     auto res = parser.Parse(m1000MData, 0, 0);
 
     auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> elapsed = end - start;
-    cout << "elapsed: " << elapsed.count() << " seconds" << endl;
-    // elapsed: 15.4s in release mode
-    // elapsed: 4960MB in release mode
+    PrintResult(m1000MData.size(), res.GetEvents().size(), sAllocCnt.load() - allocCnt, end - start);
+}
+
+// same as ProcessorPromParseMetricNative, where each line is a raw event and metric events are reused from the pool
+void TextParserBenchmark::TestParseLine100M() const {
+    vector<StringView> lines;
+    SplitStringView(m100MData, '\n', lines);
+    PipelineEventGroup eGroup(make_shared<SourceBuffer>());
+    auto metricEvent = eGroup.CreateMetricEvent();
+    size_t sampleCnt = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t allocCnt = sAllocCnt.load();
+
+    TextParser parser;
+    for (const auto& line : lines) {
+        if (!IsValidMetric(line)) {
+            continue;
+        }
+        if (parser.ParseLine(line, *metricEvent)) {
+            ++sampleCnt;
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    PrintResult(m100MData.size(), sampleCnt, sAllocCnt.load() - allocCnt, end - start);
 }
 
 UNIT_TEST_CASE(TextParserBenchmark, TestParse100M)
 UNIT_TEST_CASE(TextParserBenchmark, TestParse1000M)
+UNIT_TEST_CASE(TextParserBenchmark, TestParseLine100M)
 
 } // namespace logtail
 
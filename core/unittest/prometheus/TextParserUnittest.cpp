@@ -14,7 +14,12 @@
  * limitations under the License.
  */
 
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
 #include <string>
+#include <vector>
 
 #include "MetricEvent.h"
 #include "models/PipelineEventGroup.h"
@@ -40,6 +45,8 @@ public:
     void TestParseSuccess();
 
     void TestHonorTimestamps();
+    void TestParseEscapedLabelValue();
+    void TestParseSampleValue();
 };
 
 void TextParserUnittest::TestParseMultipleLines() const {
@@ -63,8 +70,84 @@ test_metric8{k1="v1", k2="v2", } 9.9410452992e+10 1715829785083
     const auto& events = &eGroup.GetEvents();
     APSARA_TEST_EQUAL(7UL, events->size());
 }
+
 UNIT_TEST_CASE(TextParserUnittest, TestParseMultipleLines)
 
+void TextParserUnittest::TestParseEscapedLabelValue() {
+    TextParser parser;
+    string rawData = R"(foo{a="x\ny",b="\"q\"",c="\\",d="p\tq",e="plain"} 1)";
+    auto res = parser.Parse(rawData, 0, 0);
+    APSARA_TEST_EQUAL(1U, res.GetEvents().size());
+    const auto& event = res.GetEvents().back().Cast<MetricEvent>();
+    APSARA_TEST_EQUAL("x\ny", event.GetTag("a").to_string());
+    APSARA_TEST_EQUAL("\"q\"", event.GetTag("b").to_string());
+    APSARA_TEST_EQUAL("\\", event.GetTag("c").to_string());
+    APSARA_TEST_EQUAL("p\\tq", event.GetTag("d").to_string());
+    APSARA_TEST_EQUAL("plain", event.GetTag("e").to_string());
+    // unescaped values are stored in the source buffer, while the others refer to the raw data
+    APSARA_TEST_TRUE(event.GetTag("e").data() >= rawData.data()
+                     && event.GetTag("e").data() < rawData.data() + rawData.size());
+    APSARA_TEST_FALSE(event.GetTag("a").data() >= rawData.data()
+                      && event.GetTag("a").data() < rawData.data() + rawData.size());
+
+    // backslash at the end
+    rawData = R"(foo{a="x\)";
+    res = parser.Parse(rawData, 0, 0);
+    APSARA_TEST_EQUAL(0U, res.GetEvents().size());
+}
+
+UNIT_TEST_CASE(TextParserUnittest, TestParseEscapedLabelValue)
+
+void TextParserUnittest::TestParseSampleValue() {
+    TextParser parser;
+    vector<string> values = {"0",
+                             "-0",
+                             "1",
+                             "+1",
+                             "-1.5",
+                             "1.",
+                             ".5",
+                             "0.000112326",
+                             "1.5531e-05",
+                             "9.9410452992e+10",
+                             "6.742688e+06",
+                             "1E3",
+                             "123456789012345678",
+                             "9007199254740993",
+                             "12345678901234567890123",
+                             "1.7976931348623157e308",
+                             "2.2250738585072014e-308",
+                             "0.1e-22",
+                             "3e22",
+                             "3e23",
+                             "0x10",
+                             "+Inf",
+                             "-Inf"};
+    for (const auto& value : values) {
+        string rawData = "foo " + value;
+        auto res = parser.Parse(rawData, 0, 0);
+        APSARA_TEST_EQUAL_DESC(1U, res.GetEvents().size(), value);
+        if (res.GetEvents().empty()) {
+            continue;
+        }
+        double expected = strtod(value.c_str(), nullptr);
+        double actual = res.GetEvents().back().Cast<MetricEvent>().GetValue<UntypedSingleValue>()->mValue;
+        APSARA_TEST_TRUE_DESC(memcmp(&expected, &actual, sizeof(double)) == 0, value);
+    }
+    string nanData = "foo NaN";
+    auto res = parser.Parse(nanData, 0, 0);
+    APSARA_TEST_TRUE(std::isnan(res.GetEvents().back().Cast<MetricEvent>().GetValue<UntypedSingleValue>()->mValue));
+
+    vector<string> invalidValues = {"1e", "1.2.3", "-", ".", "1e-400", "e5"};
+    for (const auto& value : invalidValues) {
+        string rawData = "foo " + value;
+        res = parser.Parse(rawData, 0, 0);
+        APSARA_TEST_EQUAL_DESC(0U, res.GetEvents().size(), value);
+    }
+}
+
+UNIT_TEST_CASE(TextParserUnittest, TestParseSampleValue)
+
 void TextParserUnittest::TestParseMetricWithTagsAndTimestamp() const {
     auto parser = TextParser();
     string rawData = R"""(
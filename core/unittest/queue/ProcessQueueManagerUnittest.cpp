@@ -34,6 +34,7 @@ public:
     void TestSetQueueUpstreamAndDownStream();
     void TestPushQueue();
     void TestPopItem();
+    void TestPopItemFromShards();
     void TestIsAllQueueEmpty();
     void OnPipelineUpdate();
 
@@ -323,6 +324,85 @@ void ProcessQueueManagerUnittest::TestPopItem() {
     APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key1].first);
 }
 
+void ProcessQueueManagerUnittest::TestPopItemFromShards() {
+    sProcessQueueManager->InitShards(2);
+    APSARA_TEST_EQUAL(2U, sProcessQueueManager->mShards.size());
+
+    unique_ptr<ProcessQueueItem> item;
+    string configName;
+    CollectionPipelineContext ctx;
+
+    ctx.SetConfigName("test_config_1");
+    QueueKey key1 = QueueKeyManager::GetInstance()->GetKey("test_config_1");
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key1, 1, ctx);
+    sProcessQueueManager->EnablePop("test_config_1");
+    ctx.SetConfigName("test_config_2");
+    QueueKey key2 = QueueKeyManager::GetInstance()->GetKey("test_config_2");
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key2, 0, ctx);
+    sProcessQueueManager->EnablePop("test_config_2");
+    ctx.SetConfigName("test_config_3");
+    QueueKey key3 = QueueKeyManager::GetInstance()->GetKey("test_config_3");
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key3, 1, ctx);
+    sProcessQueueManager->EnablePop("test_config_3");
+
+    // queues are placed in shards according to their keys
+    auto& shard1 = *sProcessQueueManager->mShards[key1 % 2];
+    auto& shard2 = *sProcessQueueManager->mShards[key2 % 2];
+    APSARA_TEST_NOT_EQUAL(&shard1, &shard2);
+    APSARA_TEST_TRUE(sProcessQueueManager->mPriorityQueue[0].empty());
+    APSARA_TEST_TRUE(sProcessQueueManager->mPriorityQueue[1].empty());
+    APSARA_TEST_EQUAL(2U, shard1.mPriorityQueue[1].size());
+    APSARA_TEST_EQUAL(1U, shard2.mPriorityQueue[0].size());
+    APSARA_TEST_TRUE(sProcessQueueManager->mQueues[key1].first == shard1.mPriorityQueue[1].begin());
+    APSARA_TEST_TRUE(shard1.mCurrentQueueIndex.second == shard1.mPriorityQueue[0].begin());
+
+    // priority change moves the queue within its shard
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key3, 2, ctx);
+    APSARA_TEST_EQUAL(1U, shard1.mPriorityQueue[1].size());
+    APSARA_TEST_EQUAL(1U, shard1.mPriorityQueue[2].size());
+
+    // the item comes from own shard
+    sProcessQueueManager->PushQueue(key1, GenerateItem());
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(key1 % 2, item, configName));
+    APSARA_TEST_EQUAL("test_config_1", configName);
+    APSARA_TEST_EQUAL(0U, shard1.mStolenItemsCnt->GetValue());
+
+    // higher priority item in other shard is stolen before lower priority item in own shard
+    sProcessQueueManager->PushQueue(key1, GenerateItem());
+    sProcessQueueManager->PushQueue(key2, GenerateItem());
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(key1 % 2, item, configName));
+    APSARA_TEST_EQUAL("test_config_2", configName);
+    APSARA_TEST_EQUAL(1U, shard1.mStolenItemsCnt->GetValue());
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(key1 % 2, item, configName));
+    APSARA_TEST_EQUAL("test_config_1", configName);
+    APSARA_TEST_EQUAL(1U, shard1.mStolenItemsCnt->GetValue());
+
+    // items in own shard can be stolen by the other thread as well
+    sProcessQueueManager->PushQueue(key3, GenerateItem());
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(key2 % 2, item, configName));
+    APSARA_TEST_EQUAL("test_config_3", configName);
+    APSARA_TEST_EQUAL(1U, shard2.mStolenItemsCnt->GetValue());
+
+    // disabled queue cannot be popped from any thread
+    sProcessQueueManager->PushQueue(key2, GenerateItem());
+    sProcessQueueManager->DisablePop("test_config_2", false);
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItem(key1 % 2, item, configName));
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItem(key2 % 2, item, configName));
+    APSARA_TEST_EQUAL(1U, shard1.mIdlePopsCnt->GetValue());
+    APSARA_TEST_EQUAL(1U, shard2.mIdlePopsCnt->GetValue());
+    sProcessQueueManager->EnablePop("test_config_2");
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(key2 % 2, item, configName));
+    APSARA_TEST_EQUAL("test_config_2", configName);
+
+    // delete queue
+    APSARA_TEST_TRUE(sProcessQueueManager->DeleteQueue(key2));
+    APSARA_TEST_TRUE(shard2.mPriorityQueue[0].empty());
+    APSARA_TEST_TRUE(shard2.mCurrentQueueIndex.second == shard2.mPriorityQueue[0].end());
+
+    sProcessQueueManager->Clear();
+    sProcessQueueManager->InitShards(0);
+}
+
 void ProcessQueueManagerUnittest::TestIsAllQueueEmpty() {
     CollectionPipelineContext ctx;
     ctx.SetConfigName("test_config_1");
@@ -475,6 +555,7 @@ UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestDeleteQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestSetQueueUpstreamAndDownStream)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPushQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPopItem)
+UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPopItemFromShards)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestIsAllQueueEmpty)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, OnPipelineUpdate)
 
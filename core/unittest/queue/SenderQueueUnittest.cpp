@@ -13,9 +13,13 @@
 // limitations under the License.
 
 #include "collection_pipeline/queue/SenderQueue.h"
+#include "common/Flags.h"
+#include "common/StringTools.h"
 #include "unittest/Unittest.h"
 #include "unittest/queue/FeedbackInterfaceMock.h"
 
+DECLARE_FLAG_INT64(sender_queue_spill_threshold_bytes);
+
 using namespace std;
 
 namespace logtail {
@@ -26,6 +30,7 @@ public:
     void TestRemove();
     void TestGetAvailableItems();
     void TestMetric();
+    void TestSpill();
 
 protected:
     static void SetUpTestCase() {
@@ -222,6 +227,49 @@ void SenderQueueUnittest::TestMetric() {
     APSARA_TEST_EQUAL(1U, mQueue->mValidToPushFlag->GetValue());
 }
 
+void SenderQueueUnittest::TestSpill() {
+    auto threshold = INT64_FLAG(sender_queue_spill_threshold_bytes);
+    INT64_FLAG(sender_queue_spill_threshold_bytes) = 8;
+
+    vector<SenderQueueItem*> items;
+    for (size_t i = 0; i < 5; ++i) {
+        auto item = make_unique<SenderQueueItem>("content" + ToString(i), sDataSize, nullptr, sKey);
+        items.emplace_back(item.get());
+        mQueue->Push(std::move(item));
+    }
+    // the first overflowing item is kept in memory, and the rest are spilled once the threshold is exceeded
+    APSARA_TEST_EQUAL(3U, mQueue->mExtraBuffer.size());
+    APSARA_TEST_FALSE(mQueue->mExtraBuffer[0]->mSpillRecord.has_value());
+    APSARA_TEST_TRUE(mQueue->mExtraBuffer[1]->mSpillRecord.has_value());
+    APSARA_TEST_TRUE(mQueue->mExtraBuffer[1]->mData.empty());
+    APSARA_TEST_TRUE(mQueue->mExtraBuffer[2]->mSpillRecord.has_value());
+    APSARA_TEST_EQUAL(3U, mQueue->mExtraBufferSize->GetValue());
+    APSARA_TEST_EQUAL(8U, mQueue->mExtraBufferDataSizeBytes->GetValue());
+    APSARA_TEST_EQUAL(2U, mQueue->mSpilledItemsTotal->GetValue());
+    APSARA_TEST_EQUAL(16U, mQueue->mSpilledDataSizeBytes->GetValue());
+
+    // items enter the queue in order, with the data read back by the flusher runner
+    for (size_t i = 0; i < 5; ++i) {
+        APSARA_TEST_TRUE(items[i]->LoadSpilledData());
+        APSARA_TEST_EQUAL("content" + ToString(i), items[i]->mData);
+        APSARA_TEST_FALSE(items[i]->mSpillRecord.has_value());
+        APSARA_TEST_TRUE(items[i]->mSpillLog == nullptr);
+        APSARA_TEST_TRUE(mQueue->Remove(items[i]));
+        if (i + 2 < 5) {
+            APSARA_TEST_EQUAL(2U, mQueue->Size());
+        }
+    }
+    APSARA_TEST_TRUE(mQueue->Empty());
+    APSARA_TEST_EQUAL(0U, mQueue->mExtraBufferDataSizeBytes->GetValue());
+    APSARA_TEST_EQUAL(0U, mQueue->mSpilledItemsTotal->GetValue());
+    APSARA_TEST_EQUAL(0U, mQueue->mSpilledDataSizeBytes->GetValue());
+    APSARA_TEST_EQUAL(0U, mQueue->mQueueDataSizeByte->GetValue());
+    // the log is dropped once the extra buffer drains
+    APSARA_TEST_TRUE(mQueue->mSpillLog == nullptr);
+
+    INT64_FLAG(sender_queue_spill_threshold_bytes) = threshold;
+}
+
 unique_ptr<SenderQueueItem> SenderQueueUnittest::GenerateItem() {
     return make_unique<SenderQueueItem>("content", sDataSize, nullptr, sKey);
 }
@@ -230,6 +278,7 @@ UNIT_TEST_CASE(SenderQueueUnittest, TestPush)
 UNIT_TEST_CASE(SenderQueueUnittest, TestRemove)
 UNIT_TEST_CASE(SenderQueueUnittest, TestGetAvailableItems)
 UNIT_TEST_CASE(SenderQueueUnittest, TestMetric)
+UNIT_TEST_CASE(SenderQueueUnittest, TestSpill)
 
 } // namespace logtail
 
@@ -0,0 +1,205 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "collection_pipeline/queue/SpillLog.h"
+#include "common/Flags.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(spill_log_segment_size_bytes);
+
+using namespace std;
+
+namespace logtail {
+
+class SpillLogUnittest : public ::testing::Test {
+public:
+    void TestAppendAndRead();
+    void TestSegmentRotation();
+    void TestRelease();
+    void TestCorruption();
+    void TestStaleFiles();
+
+protected:
+    static void SetUpTestCase() { sSegmentSize = INT32_FLAG(spill_log_segment_size_bytes); }
+
+    void SetUp() override {
+        mDir = (filesystem::temp_directory_path() / "spill_log_unittest").string();
+        INT32_FLAG(spill_log_segment_size_bytes) = 4096;
+    }
+
+    void TearDown() override {
+        INT32_FLAG(spill_log_segment_size_bytes) = sSegmentSize;
+        error_code ec;
+        filesystem::remove_all(mDir, ec);
+    }
+
+private:
+    static int32_t sSegmentSize;
+
+    string mDir;
+};
+
+int32_t SpillLogUnittest::sSegmentSize = 0;
+
+void SpillLogUnittest::TestAppendAndRead() {
+    SpillLog log(mDir);
+    vector<string> contents = {"hello", "", "world"};
+    vector<SpillRecord> records(3);
+    for (size_t i = 0; i < records.size(); ++i) {
+        string data = contents[i];
+        APSARA_TEST_TRUE(log.Append(data, records[i]));
+        APSARA_TEST_TRUE(data.empty());
+        APSARA_TEST_EQUAL(i + 1, records[i].mSeq);
+    }
+    APSARA_TEST_EQUAL(1U, log.GetSegmentCnt());
+    APSARA_TEST_EQUAL(4096U, log.GetDiskSize());
+
+    // records may be read before they are written
+    string data;
+    APSARA_TEST_TRUE(log.Read(records[0], data));
+    APSARA_TEST_EQUAL(contents[0], data);
+    log.Sync();
+    APSARA_TEST_TRUE(log.mPending.empty());
+    for (size_t i = 1; i < records.size(); ++i) {
+        APSARA_TEST_TRUE(log.Read(records[i], data));
+        APSARA_TEST_EQUAL(contents[i], data);
+    }
+
+    // the segment is reused once everything has been read
+    log.Sync();
+    SpillRecord record;
+    data = "again";
+    APSARA_TEST_TRUE(log.Append(data, record));
+    APSARA_TEST_EQUAL(0U, record.mOffset);
+    APSARA_TEST_EQUAL(1U, log.GetSegmentCnt());
+    APSARA_TEST_TRUE(log.Read(record, data));
+    APSARA_TEST_EQUAL("again", data);
+}
+
+void SpillLogUnittest::TestSegmentRotation() {
+    SpillLog log(mDir);
+    vector<SpillRecord> records(5);
+    vector<string> contents;
+    for (size_t i = 0; i < records.size(); ++i) {
+        contents.emplace_back(1500, static_cast<char>('a' + i));
+        string data = contents[i];
+        APSARA_TEST_TRUE(log.Append(data, records[i]));
+    }
+    // 2 records fit in a segment
+    APSARA_TEST_EQUAL(3U, log.GetSegmentCnt());
+    APSARA_TEST_EQUAL(1U, records[2].mSegmentId);
+
+    // a record larger than a segment gets a segment of its own
+    SpillRecord large;
+    string largeContent(10000, 'x');
+    string data = largeContent;
+    APSARA_TEST_TRUE(log.Append(data, large));
+    APSARA_TEST_EQUAL(4U, log.GetSegmentCnt());
+    // the next segment has been created ahead of time, since the last one is more than half used
+    log.Sync();
+    APSARA_TEST_TRUE(log.mSpareFile.mAddr != nullptr);
+    APSARA_TEST_EQUAL(4096U * 4 + 12288U, log.GetDiskSize());
+
+    APSARA_TEST_TRUE(log.Read(records[0], data));
+    APSARA_TEST_EQUAL(contents[0], data);
+    log.Sync();
+    APSARA_TEST_EQUAL(4U, log.GetSegmentCnt());
+    // segments are removed once all their records have been read
+    APSARA_TEST_TRUE(log.Read(records[1], data));
+    APSARA_TEST_EQUAL(contents[1], data);
+    log.Sync();
+    APSARA_TEST_EQUAL(3U, log.GetSegmentCnt());
+    APSARA_TEST_FALSE(filesystem::exists(filesystem::path(mDir) / "0.seg"));
+    for (size_t i = 2; i < records.size(); ++i) {
+        APSARA_TEST_TRUE(log.Read(records[i], data));
+        APSARA_TEST_EQUAL(contents[i], data);
+    }
+    log.Sync();
+    APSARA_TEST_EQUAL(1U, log.GetSegmentCnt());
+    APSARA_TEST_TRUE(log.Read(large, data));
+    APSARA_TEST_EQUAL(largeContent, data);
+}
+
+void SpillLogUnittest::TestRelease() {
+    SpillLog log(mDir);
+    vector<SpillRecord> records(3);
+    for (size_t i = 0; i < records.size(); ++i) {
+        string data(3000, 'a');
+        APSARA_TEST_TRUE(log.Append(data, records[i]));
+    }
+    APSARA_TEST_EQUAL(3U, log.GetSegmentCnt());
+
+    // records given up count as done
+    log.Release(records[0]);
+    log.Release(records[1]);
+    log.Sync();
+    APSARA_TEST_EQUAL(1U, log.GetSegmentCnt());
+    string data;
+    APSARA_TEST_TRUE(log.Read(records[2], data));
+    APSARA_TEST_EQUAL(string(3000, 'a'), data);
+}
+
+void SpillLogUnittest::TestCorruption() {
+    SpillLog log(mDir);
+    SpillRecord record1, record2;
+    string data = "hello";
+    APSARA_TEST_TRUE(log.Append(data, record1));
+    data = "world";
+    APSARA_TEST_TRUE(log.Append(data, record2));
+    log.Sync();
+
+    // flip a byte of the data
+    log.mSegments.begin()->second->mFile.mAddr[record1.mOffset + 3 * sizeof(uint32_t)] ^= 0x1;
+    APSARA_TEST_FALSE(log.Read(record1, data));
+    APSARA_TEST_TRUE(log.Read(record2, data));
+    APSARA_TEST_EQUAL("world", data);
+
+    // out of range
+    SpillRecord invalid;
+    invalid.mSegmentId = 100;
+    APSARA_TEST_FALSE(log.Read(invalid, data));
+}
+
+void SpillLogUnittest::TestStaleFiles() {
+    filesystem::create_directories(mDir);
+    auto stale = filesystem::path(mDir) / "0.seg";
+    { ofstream(stale) << "stale"; }
+    {
+        SpillLog log(mDir);
+        log.Sync();
+        APSARA_TEST_FALSE(filesystem::exists(stale));
+        SpillRecord record;
+        string data = "hello";
+        APSARA_TEST_TRUE(log.Append(data, record));
+        log.Sync();
+        APSARA_TEST_TRUE(filesystem::exists(stale));
+        APSARA_TEST_TRUE(log.Read(record, data));
+    }
+    APSARA_TEST_FALSE(filesystem::exists(mDir));
+}
+
+UNIT_TEST_CASE(SpillLogUnittest, TestAppendAndRead)
+UNIT_TEST_CASE(SpillLogUnittest, TestSegmentRotation)
+UNIT_TEST_CASE(SpillLogUnittest, TestRelease)
+UNIT_TEST_CASE(SpillLogUnittest, TestCorruption)
+UNIT_TEST_CASE(SpillLogUnittest, TestStaleFiles)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
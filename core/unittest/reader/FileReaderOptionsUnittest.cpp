@@ -61,6 +61,7 @@ void FileReaderOptionsUnittest::OnSuccessfulInit() const {
     APSARA_TEST_EQUAL(static_cast<uint32_t>(INT32_FLAG(reader_close_unused_file_time)),
                       config->mCloseUnusedReaderIntervalSec);
     APSARA_TEST_EQUAL(static_cast<uint32_t>(INT32_FLAG(logreader_max_rotate_queue_size)), config->mRotatorQueueSize);
+    APSARA_TEST_FALSE(config->mEnableMmapRead);
 
     // valid optional param
     configStr = R"(
@@ -72,7 +73,8 @@ void FileReaderOptionsUnittest::OnSuccessfulInit() const {
             "ReadDelaySkipThresholdBytes": 1000,
             "ReadDelayAlertThresholdBytes": 100,
             "CloseUnusedReaderIntervalSec": 10,
-            "RotatorQueueSize": 15
+            "RotatorQueueSize": 15,
+            "EnableMmapRead": true
         }
     )";
     APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
@@ -86,6 +88,7 @@ void FileReaderOptionsUnittest::OnSuccessfulInit() const {
     APSARA_TEST_EQUAL(100U, config->mReadDelayAlertThresholdBytes);
     APSARA_TEST_EQUAL(10U, config->mCloseUnusedReaderIntervalSec);
     APSARA_TEST_EQUAL(15U, config->mRotatorQueueSize);
+    APSARA_TEST_TRUE(config->mEnableMmapRead);
 
     // invalid optional param (except for FileEcoding)
     configStr = R"(
@@ -97,7 +100,8 @@ void FileReaderOptionsUnittest::OnSuccessfulInit() const {
             "ReadDelaySkipThresholdBytes": "1000",
             "ReadDelayAlertThresholdBytes": "100",
             "CloseUnusedReaderIntervalSec": "10",
-            "RotatorQueueSize": "15"
+            "RotatorQueueSize": "15",
+            "EnableMmapRead": "true"
         }
     )";
     APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
@@ -112,6 +116,7 @@ void FileReaderOptionsUnittest::OnSuccessfulInit() const {
     APSARA_TEST_EQUAL(static_cast<uint32_t>(INT32_FLAG(reader_close_unused_file_time)),
                       config->mCloseUnusedReaderIntervalSec);
     APSARA_TEST_EQUAL(static_cast<uint32_t>(INT32_FLAG(logreader_max_rotate_queue_size)), config->mRotatorQueueSize);
+    APSARA_TEST_FALSE(config->mEnableMmapRead);
 
     // FileEncoding
     configStr = R"(
@@ -26,6 +26,7 @@
 #include "unittest/Unittest.h"
 
 DECLARE_FLAG_INT32(force_release_deleted_file_fd_timeout);
+DECLARE_FLAG_INT32(mmap_read_min_bytes);
 
 namespace logtail {
 
@@ -70,6 +71,7 @@ public:
     }
     void TestReadGBK();
     void TestReadUTF8();
+    void TestReadUTF8ByMmap();
 
     std::unique_ptr<char[]> expectedContent;
     static std::string logPathDir;
@@ -83,6 +85,7 @@ public:
 
 UNIT_TEST_CASE(LogFileReaderUnittest, TestReadGBK);
 UNIT_TEST_CASE(LogFileReaderUnittest, TestReadUTF8);
+UNIT_TEST_CASE(LogFileReaderUnittest, TestReadUTF8ByMmap);
 
 std::string LogFileReaderUnittest::logPathDir;
 std::string LogFileReaderUnittest::gbkFile;
@@ -571,6 +574,83 @@ void LogFileReaderUnittest::TestReadUTF8() {
     }
 }
 
+void LogFileReaderUnittest::TestReadUTF8ByMmap() {
+    int32_t minBytes = INT32_FLAG(mmap_read_min_bytes);
+    INT32_FLAG(mmap_read_min_bytes) = 0;
+    { // read twice, multiline, cache should be verified against the mapping
+        Json::Value config;
+        config["StartPattern"] = "iLogtail.*";
+        MultilineOptions multilineOpts;
+        multilineOpts.Init(config, ctx, "");
+        FileReaderOptions readerOpts;
+        readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+        readerOpts.mEnableMmapRead = true;
+        LogFileReader reader(logPathDir,
+                             utf8File,
+                             DevInode(),
+                             std::make_pair(&readerOpts, &ctx),
+                             std::make_pair(&multilineOpts, &ctx),
+                             std::make_pair(&fileTagOpts, &ctx));
+        reader.UpdateReaderManual();
+        reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+        int64_t fileSize = reader.mLogFileOp.GetFileSize();
+        reader.CheckFileSignatureAndOffset(true);
+        LogFileReader::BUFFER_SIZE = fileSize - 13;
+        bool moreData = false;
+        // first read
+        LogBuffer logBuffer;
+        reader.ReadUTF8(logBuffer, fileSize, moreData);
+        APSARA_TEST_TRUE_FATAL(moreData);
+        APSARA_TEST_EQUAL_FATAL(1UL, logBuffer.sourcebuffer->mMappedRegions.size());
+        std::string expectedPart(expectedContent.get());
+        expectedPart.resize(expectedPart.rfind("iLogtail") - 1);
+        APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer.rawBuffer.data());
+        APSARA_TEST_GT_FATAL(reader.mCache.size(), 0UL);
+        // second read, end of second part cannot be determined, nothing read
+        auto lastFilePos = reader.mLastFilePos;
+        LogBuffer logBuffer2;
+        reader.ReadUTF8(logBuffer2, fileSize, moreData);
+        APSARA_TEST_FALSE_FATAL(moreData);
+        APSARA_TEST_EQUAL_FATAL(lastFilePos, reader.mLastFilePos);
+        APSARA_TEST_STREQ_FATAL(NULL, logBuffer2.rawBuffer.data());
+        // third read, force read the cached part directly from the mapping
+        LogBuffer logBuffer3;
+        reader.ReadUTF8(logBuffer3, fileSize, moreData, false);
+        APSARA_TEST_FALSE_FATAL(moreData);
+        APSARA_TEST_EQUAL_FATAL(1UL, logBuffer3.sourcebuffer->mMappedRegions.size());
+        expectedPart = expectedContent.get();
+        expectedPart = expectedPart.substr(expectedPart.rfind("iLogtail"));
+        APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer3.rawBuffer.data());
+        APSARA_TEST_EQUAL_FATAL(0UL, reader.mCache.size());
+        APSARA_TEST_EQUAL_FATAL(fileSize, reader.mLastFilePos);
+        APSARA_TEST_FALSE_FATAL(reader.mMmapReadDisabled);
+    }
+    { // mmap read disabled after truncation, fall back to pread
+        MultilineOptions multilineOpts;
+        FileReaderOptions readerOpts;
+        readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+        readerOpts.mEnableMmapRead = true;
+        LogFileReader reader(logPathDir,
+                             utf8File,
+                             DevInode(),
+                             std::make_pair(&readerOpts, &ctx),
+                             std::make_pair(&multilineOpts, &ctx),
+                             std::make_pair(&fileTagOpts, &ctx));
+        reader.UpdateReaderManual();
+        reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+        int64_t fileSize = reader.mLogFileOp.GetFileSize();
+        reader.CheckFileSignatureAndOffset(true);
+        reader.mMmapReadDisabled = true;
+        LogBuffer logBuffer;
+        bool moreData = false;
+        reader.ReadUTF8(logBuffer, fileSize, moreData);
+        APSARA_TEST_FALSE_FATAL(moreData);
+        APSARA_TEST_TRUE_FATAL(logBuffer.sourcebuffer->mMappedRegions.empty());
+        APSARA_TEST_STREQ_FATAL(expectedContent.get(), logBuffer.rawBuffer.data());
+    }
+    INT32_FLAG(mmap_read_min_bytes) = minBytes;
+}
+
 class LogMultiBytesUnittest : public ::testing::Test {
 public:
     static void SetUpTestCase() {
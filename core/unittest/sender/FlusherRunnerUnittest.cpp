@@ -30,6 +30,8 @@ class FlusherRunnerUnittest : public ::testing::Test {
 public:
     void TestDispatch();
     void TestPushToHttpSink();
+    void TestBatchedDispatch();
+    void TestHttpSinkWorkerRouting();
 
 protected:
     static void SetUpTestCase() { AppConfig::GetInstance()->mSendRequestGlobalConcurrency = 10; }
@@ -139,8 +141,78 @@ void FlusherRunnerUnittest::TestPushToHttpSink() {
     }
 }
 
+void FlusherRunnerUnittest::TestBatchedDispatch() {
+    auto flusher = make_unique<FlusherHttpMock>();
+    Json::Value tmp;
+    CollectionPipelineContext ctx;
+    flusher->SetContext(ctx);
+    flusher->SetMetricsRecordRef("name", "1");
+    flusher->Init(Json::Value(), tmp);
+
+    vector<SenderQueueItem*> realItems;
+    for (size_t i = 0; i < 3; ++i) {
+        auto item = make_unique<SenderQueueItem>("content", 10, flusher.get(), flusher->GetQueueKey());
+        realItems.push_back(item.get());
+        flusher->PushToQueue(std::move(item));
+    }
+
+    vector<unique_ptr<HttpSinkRequest>> requests;
+    for (auto item : realItems) {
+        FlusherRunner::GetInstance()->Dispatch(item, requests);
+    }
+    APSARA_TEST_EQUAL(3U, requests.size());
+    APSARA_TEST_TRUE(HttpSink::GetInstance()->mQueue.Empty());
+
+    FlusherRunner::GetInstance()->FlushHttpSinkRequests(requests);
+    APSARA_TEST_TRUE(requests.empty());
+    for (auto item : realItems) {
+        unique_ptr<HttpSinkRequest> req;
+        APSARA_TEST_TRUE(HttpSinkMock::GetInstance()->mQueue.TryPop(req));
+        APSARA_TEST_EQUAL(item, req->mItem);
+    }
+    APSARA_TEST_TRUE(HttpSink::GetInstance()->mQueue.Empty());
+    FlusherRunner::GetInstance()->mHttpSendingCnt = 0;
+}
+
+void FlusherRunnerUnittest::TestHttpSinkWorkerRouting() {
+    // the mock uses its own queue, so the routing of the real sink is called explicitly
+    HttpSink* sink = HttpSink::GetInstance();
+    auto& workers = sink->mWorkers;
+    for (size_t i = 0; i < 4; ++i) {
+        workers.emplace_back(make_unique<HttpSinkWorker>(i));
+    }
+
+    auto createRequest = [](const string& host) {
+        return make_unique<HttpSinkRequest>("POST", false, host, 80, "/", "", map<string, string>(), "", nullptr);
+    };
+    vector<unique_ptr<HttpSinkRequest>> requests;
+    for (size_t i = 0; i < 10; ++i) {
+        requests.emplace_back(createRequest("host_" + ToString(i)));
+        requests.emplace_back(createRequest("host_" + ToString(i)));
+    }
+    sink->HttpSink::AddRequests(requests);
+    APSARA_TEST_TRUE(requests.empty());
+    sink->HttpSink::AddRequest(createRequest("host_0"));
+
+    size_t total = 0;
+    map<string, size_t> hostToWorker;
+    for (auto& worker : workers) {
+        unique_ptr<HttpSinkRequest> req;
+        while (worker->mQueue.TryPop(req)) {
+            ++total;
+            auto res = hostToWorker.emplace(req->mHost, worker->GetId());
+            APSARA_TEST_EQUAL(res.first->second, worker->GetId());
+        }
+    }
+    APSARA_TEST_EQUAL(21U, total);
+    APSARA_TEST_EQUAL(10U, hostToWorker.size());
+    workers.clear();
+}
+
 UNIT_TEST_CASE(FlusherRunnerUnittest, TestDispatch)
 UNIT_TEST_CASE(FlusherRunnerUnittest, TestPushToHttpSink)
+UNIT_TEST_CASE(FlusherRunnerUnittest, TestBatchedDispatch)
+UNIT_TEST_CASE(FlusherRunnerUnittest, TestHttpSinkWorkerRouting)
 
 } // namespace logtail
 
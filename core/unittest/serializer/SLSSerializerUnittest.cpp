@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "collection_pipeline/serializer/SLSSerializer.h"
+#include "common/JsonUtil.h"
 #include "plugin/flusher/sls/FlusherSLS.h"
 #include "unittest/Unittest.h"
 
@@ -26,6 +27,7 @@ class SLSSerializerUnittest : public ::testing::Test {
 public:
     void TestSerializeEventGroup();
     void TestSerializeEventGroupList();
+    void TestSerializeColumnarLogs();
 
 protected:
     static void SetUpTestCase() { sFlusher = make_unique<FlusherSLS>(); }
@@ -224,6 +226,21 @@ void SLSSerializerUnittest::TestSerializeEventGroup() {
             APSARA_TEST_STREQ("source", logGroup.source().c_str());
             APSARA_TEST_STREQ("topic", logGroup.topic().c_str());
         }
+        {
+            // unsorted tags of a shared event are written in order without modifying the event
+            string res, errorMsg;
+            auto batch = CreateBatchedMetricEvents(false, 0, false, true);
+            batch.mEvents[0].Cast<MetricEvent>().SetTag(string("key0"), string("value0"));
+            PipelineEventPtr shared = batch.mEvents[0].Share();
+            APSARA_TEST_TRUE(serializer.DoSerialize(std::move(batch), res, errorMsg));
+            sls_logs::LogGroup logGroup;
+            APSARA_TEST_TRUE(logGroup.ParseFromString(res));
+            APSARA_TEST_EQUAL(1, logGroup.logs_size());
+            APSARA_TEST_EQUAL(logGroup.logs(0).contents(0).key(), "__labels__");
+            APSARA_TEST_EQUAL(logGroup.logs(0).contents(0).value(), "key0#$#value0|key1#$#value1");
+            APSARA_TEST_TRUE(shared.IsShared());
+            APSARA_TEST_EQUAL("key1", string(as_const(shared).Cast<MetricEvent>().TagsBegin()->first));
+        }
         {
             // timestamp invalid
             string res, errorMsg;
@@ -320,6 +337,31 @@ void SLSSerializerUnittest::TestSerializeEventGroup() {
         APSARA_TEST_EQUAL(logGroup.logs(0).contents(12).key(), "duration");
         APSARA_TEST_EQUAL(logGroup.logs(0).contents(12).value(), "1000");
     }
+    {
+        // span with json special characters and scope tag overriding tag
+        string res, errorMsg;
+        auto events = CreateBatchedSpanEvents();
+        auto& spanEvent = events.mEvents[0].Cast<SpanEvent>();
+        spanEvent.SetTag(string("key\"with\\quote"), string("line1\nline2\t\x01"));
+        spanEvent.SetScopeTag(string("rpcType"), string("scope-rpc-type"));
+        spanEvent.SetStartTimeNs(1234567890123456789ULL);
+        spanEvent.SetEndTimeNs(1234567890123456789ULL);
+        APSARA_TEST_TRUE(serializer.DoSerialize(std::move(events), res, errorMsg));
+        sls_logs::LogGroup logGroup;
+        APSARA_TEST_TRUE(logGroup.ParseFromString(res));
+        APSARA_TEST_EQUAL(1, logGroup.logs_size());
+        APSARA_TEST_EQUAL(13, logGroup.logs(0).contents_size());
+
+        Json::Value jsonVal;
+        APSARA_TEST_TRUE(ParseJsonTable(logGroup.logs(0).contents(7).value(), jsonVal, errorMsg));
+        APSARA_TEST_EQUAL(11U, jsonVal.size());
+        APSARA_TEST_EQUAL("line1\nline2\t\x01", jsonVal["key\"with\\quote"].asString());
+        APSARA_TEST_EQUAL("scope-rpc-type", jsonVal["rpcType"].asString());
+
+        APSARA_TEST_EQUAL("1234567890123456789", logGroup.logs(0).contents(10).value());
+        APSARA_TEST_EQUAL("1234567890123456789", logGroup.logs(0).contents(11).value());
+        APSARA_TEST_EQUAL("0", logGroup.logs(0).contents(12).value());
+    }
     { // raw
         { // nano second disabled, and set
             string res, errorMsg;
@@ -439,6 +481,31 @@ void SLSSerializerUnittest::TestSerializeEventGroupList() {
     APSARA_TEST_EQUAL(sls_logs::SlsCompressType::SLS_CMP_NONE, logPackageList.packages(0).compress_type());
 }
 
+void SLSSerializerUnittest::TestSerializeColumnarLogs() {
+    SLSEventGroupSerializer serializer(sFlusher.get());
+    for (bool enableNs : {false, true}) {
+        const_cast<GlobalConfig&>(mCtx.GetGlobalConfig()).mEnableTimestampNanosecond = enableNs;
+        for (bool withEmptyContent : {false, true}) {
+            string expected, res, errorMsg;
+            APSARA_TEST_TRUE(
+                serializer.DoSerialize(CreateBatchedLogEvents(enableNs, withEmptyContent), expected, errorMsg));
+
+            auto batch = CreateBatchedLogEvents(enableNs, withEmptyContent);
+            batch.BuildColumnarLogs();
+            APSARA_TEST_TRUE(batch.mColumnarLogs != nullptr);
+            APSARA_TEST_TRUE(serializer.DoSerialize(std::move(batch), res, errorMsg));
+            APSARA_TEST_EQUAL(expected, res);
+        }
+    }
+    const_cast<GlobalConfig&>(mCtx.GetGlobalConfig()).mEnableTimestampNanosecond = false;
+    {
+        // only empty event
+        auto batch = CreateBatchedLogEvents(false, true, false);
+        batch.BuildColumnarLogs();
+        string res, errorMsg;
+        APSARA_TEST_FALSE(serializer.DoSerialize(std::move(batch), res, errorMsg));
+    }
+}
 
 BatchedEvents
 SLSSerializerUnittest::CreateBatchedLogEvents(bool enableNanosecond, bool withEmptyContent, bool withNonEmptyContent) {
@@ -603,6 +670,7 @@ BatchedEvents SLSSerializerUnittest::CreateBatchedSpanEvents() {
 
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeEventGroup)
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeEventGroupList)
+UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeColumnarLogs)
 
 } // namespace logtail
 
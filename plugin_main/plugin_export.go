@@ -199,6 +199,18 @@ func ProcessLogGroup(configName string, logBytes []byte, packID string) int {
 	return config.ProcessLogGroup(logBytes, util.StringDeepCopy(packID))
 }
 
+//export ProcessLogGroups
+func ProcessLogGroups(configName string, meta []byte, arena []byte) int {
+	pluginmanager.LogtailConfigLock.RLock()
+	config, flag := pluginmanager.LogtailConfig[configName]
+	pluginmanager.LogtailConfigLock.RUnlock()
+	if !flag {
+		logger.Error(context.Background(), "PLUGIN_ALARM", "config not found", configName)
+		return -1
+	}
+	return config.ProcessLogGroups(meta, arena)
+}
+
 //export StopAllPipelines
 func StopAllPipelines(withInputFlag int) {
 	logger.Info(context.Background(), "Stop all", "start", "with input", withInputFlag)
@@ -0,0 +1,148 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package pluginmanager
+
+import (
+	"encoding/binary"
+	"fmt"
+
+	"github.com/alibaba/ilogtail/pkg/protocol"
+	"github.com/alibaba/ilogtail/pkg/util"
+)
+
+// Layout of log groups passed by core in one ProcessLogGroups call, see FlatLogGroupBatch in core for details.
+// meta is a sequence of little-endian uint32 words made up of a header and the group, log and pair tables, and
+// strings in the tables are referenced by (offset, length) in arena.
+const (
+	flatLogGroupMagic   = 0x474C4C46
+	flatLogGroupVersion = 1
+
+	flatHeaderWords = 5
+	flatGroupWords  = 10
+	flatLogWords    = 5
+	flatPairWords   = 4
+)
+
+type flatLogGroup struct {
+	logGroup *protocol.LogGroup
+	packID   string
+}
+
+type flatLogGroupDecoder struct {
+	meta  []byte
+	arena []byte
+	err   error
+}
+
+func (d *flatLogGroupDecoder) word(idx int) uint32 {
+	return binary.LittleEndian.Uint32(d.meta[idx*4:])
+}
+
+func (d *flatLogGroupDecoder) str(idx int) string {
+	offset, length := uint64(d.word(idx)), uint64(d.word(idx+1))
+	if offset+length > uint64(len(d.arena)) {
+		if d.err == nil {
+			d.err = fmt.Errorf("string out of range, offset: %d, length: %d, arena size: %d", offset, length, len(d.arena))
+		}
+		return ""
+	}
+	return util.ZeroCopyBytesToString(d.arena[offset : offset+length])
+}
+
+func checkFlatRange(name string, begin, cnt uint32, total int) error {
+	if uint64(begin)+uint64(cnt) > uint64(total) {
+		return fmt.Errorf("%s out of range, begin: %d, cnt: %d, total: %d", name, begin, cnt, total)
+	}
+	return nil
+}
+
+// decodeFlatLogGroups decodes the log groups passed by core without unmarshalling protobuf.
+// meta and arena are owned by core and only valid during the cgo call, so arena is copied once and all strings in the
+// returned log groups refer to the copy, while meta is not referenced after return.
+func decodeFlatLogGroups(meta, arena []byte) ([]flatLogGroup, error) {
+	if len(meta) < flatHeaderWords*4 || len(meta)%4 != 0 {
+		return nil, fmt.Errorf("invalid meta size: %d", len(meta))
+	}
+	d := &flatLogGroupDecoder{meta: meta}
+	if magic := d.word(0); magic != flatLogGroupMagic {
+		return nil, fmt.Errorf("invalid magic: %x", magic)
+	}
+	if version := d.word(1); version != flatLogGroupVersion {
+		return nil, fmt.Errorf("unsupported version: %d", version)
+	}
+	groupCnt, logCnt, pairCnt := int(d.word(2)), int(d.word(3)), int(d.word(4))
+	groupBase := flatHeaderWords
+	logBase := groupBase + groupCnt*flatGroupWords
+	pairBase := logBase + logCnt*flatLogWords
+	if (pairBase+pairCnt*flatPairWords)*4 != len(meta) {
+		return nil, fmt.Errorf("meta size mismatch, group cnt: %d, log cnt: %d, pair cnt: %d, meta size: %d",
+			groupCnt, logCnt, pairCnt, len(meta))
+	}
+	d.arena = make([]byte, len(arena))
+	copy(d.arena, arena)
+
+	// allocate all logs, contents and tags at once instead of one by one
+	logs := make([]protocol.Log, logCnt)
+	logPtrs := make([]*protocol.Log, logCnt)
+	timeNs := make([]uint32, logCnt)
+	pairs := make([]protocol.Log_Content, pairCnt)
+	pairPtrs := make([]*protocol.Log_Content, pairCnt)
+	for i := range pairs {
+		pairs[i].Key = d.str(pairBase + i*flatPairWords)
+		pairs[i].Value = d.str(pairBase + i*flatPairWords + 2)
+		pairPtrs[i] = &pairs[i]
+	}
+	for i := range logs {
+		idx := logBase + i*flatLogWords
+		logs[i].Time = d.word(idx)
+		if d.word(idx+2) != 0 {
+			timeNs[i] = d.word(idx + 1)
+			logs[i].TimeNs = &timeNs[i]
+		}
+		contentBegin, contentCnt := d.word(idx+3), d.word(idx+4)
+		if err := checkFlatRange("contents", contentBegin, contentCnt, pairCnt); err != nil {
+			return nil, err
+		}
+		logs[i].Contents = pairPtrs[contentBegin : contentBegin+contentCnt : contentBegin+contentCnt]
+		logPtrs[i] = &logs[i]
+	}
+
+	res := make([]flatLogGroup, groupCnt)
+	for i := range res {
+		idx := groupBase + i*flatGroupWords
+		tagBegin, tagCnt := d.word(idx+6), d.word(idx+7)
+		if err := checkFlatRange("tags", tagBegin, tagCnt, pairCnt); err != nil {
+			return nil, err
+		}
+		logBegin, groupLogCnt := d.word(idx+8), d.word(idx+9)
+		if err := checkFlatRange("logs", logBegin, groupLogCnt, logCnt); err != nil {
+			return nil, err
+		}
+		logGroup := &protocol.LogGroup{
+			Topic:    d.str(idx + 2),
+			Category: d.str(idx + 4),
+			Logs:     logPtrs[logBegin : logBegin+groupLogCnt : logBegin+groupLogCnt],
+			LogTags:  make([]*protocol.LogTag, 0, tagCnt),
+		}
+		for j := tagBegin; j < tagBegin+tagCnt; j++ {
+			logGroup.LogTags = append(logGroup.LogTags, &protocol.LogTag{Key: pairs[j].Key, Value: pairs[j].Value})
+		}
+		res[i] = flatLogGroup{logGroup: logGroup, packID: d.str(idx)}
+	}
+	if d.err != nil {
+		return nil, d.err
+	}
+	return res, nil
+}
@@ -0,0 +1,128 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package pluginmanager
+
+import (
+	"encoding/binary"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+// flatLogGroupEncoder mirrors FlatLogGroupBatch in core
+type flatLogGroupEncoder struct {
+	groups, logs, pairs []uint32
+	arena               []byte
+}
+
+func (e *flatLogGroupEncoder) str(s string) []uint32 {
+	res := []uint32{uint32(len(e.arena)), uint32(len(s))}
+	e.arena = append(e.arena, s...)
+	return res
+}
+
+func (e *flatLogGroupEncoder) addGroup(packID, topic, category string, tags [][2]string, logs [][][2]string) {
+	e.groups = append(e.groups, e.str(packID)...)
+	e.groups = append(e.groups, e.str(topic)...)
+	e.groups = append(e.groups, e.str(category)...)
+	e.groups = append(e.groups, uint32(len(e.pairs)/flatPairWords), uint32(len(tags)))
+	for _, tag := range tags {
+		e.pairs = append(e.pairs, e.str(tag[0])...)
+		e.pairs = append(e.pairs, e.str(tag[1])...)
+	}
+	e.groups = append(e.groups, uint32(len(e.logs)/flatLogWords), uint32(len(logs)))
+	for i, contents := range logs {
+		e.logs = append(e.logs, uint32(1700000000+i), uint32(i), uint32(i%2), uint32(len(e.pairs)/flatPairWords),
+			uint32(len(contents)))
+		for _, kv := range contents {
+			e.pairs = append(e.pairs, e.str(kv[0])...)
+			e.pairs = append(e.pairs, e.str(kv[1])...)
+		}
+	}
+}
+
+func (e *flatLogGroupEncoder) meta() []byte {
+	words := []uint32{flatLogGroupMagic, flatLogGroupVersion, uint32(len(e.groups) / flatGroupWords),
+		uint32(len(e.logs) / flatLogWords), uint32(len(e.pairs) / flatPairWords)}
+	words = append(words, e.groups...)
+	words = append(words, e.logs...)
+	words = append(words, e.pairs...)
+	res := make([]byte, len(words)*4)
+	for i, w := range words {
+		binary.LittleEndian.PutUint32(res[i*4:], w)
+	}
+	return res
+}
+
+func TestDecodeFlatLogGroups(t *testing.T) {
+	e := &flatLogGroupEncoder{}
+	e.addGroup("pack1", "topic1", "logstore", [][2]string{{"__path__", "/var/log/a.log"}},
+		[][][2]string{{{"content", "line1"}}, {{"content", "line2"}, {"level", "INFO"}}})
+	e.addGroup("pack2", "", "logstore", nil, [][][2]string{{{"content", "line3"}}})
+	arena := append([]byte{}, e.arena...)
+
+	groups, err := decodeFlatLogGroups(e.meta(), arena)
+	require.NoError(t, err)
+	require.Len(t, groups, 2)
+	// strings should not refer to the buffer passed in
+	for i := range arena {
+		arena[i] = 0
+	}
+
+	g := groups[0]
+	assert.Equal(t, "pack1", g.packID)
+	assert.Equal(t, "topic1", g.logGroup.Topic)
+	assert.Equal(t, "logstore", g.logGroup.Category)
+	require.Len(t, g.logGroup.LogTags, 1)
+	assert.Equal(t, "__path__", g.logGroup.LogTags[0].Key)
+	assert.Equal(t, "/var/log/a.log", g.logGroup.LogTags[0].Value)
+	require.Len(t, g.logGroup.Logs, 2)
+	assert.Equal(t, uint32(1700000000), g.logGroup.Logs[0].Time)
+	assert.Nil(t, g.logGroup.Logs[0].TimeNs)
+	require.Len(t, g.logGroup.Logs[0].Contents, 1)
+	assert.Equal(t, "line1", g.logGroup.Logs[0].Contents[0].Value)
+	require.NotNil(t, g.logGroup.Logs[1].TimeNs)
+	assert.Equal(t, uint32(1), *g.logGroup.Logs[1].TimeNs)
+	require.Len(t, g.logGroup.Logs[1].Contents, 2)
+	assert.Equal(t, "level", g.logGroup.Logs[1].Contents[1].Key)
+	assert.Equal(t, "INFO", g.logGroup.Logs[1].Contents[1].Value)
+
+	// appending to a log should not overwrite the contents of the next one
+	g.logGroup.Logs[0].Contents = append(g.logGroup.Logs[0].Contents, g.logGroup.Logs[1].Contents[1])
+	assert.Equal(t, "content", g.logGroup.Logs[1].Contents[0].Key)
+
+	g = groups[1]
+	assert.Equal(t, "pack2", g.packID)
+	assert.Empty(t, g.logGroup.Topic)
+	assert.Empty(t, g.logGroup.LogTags)
+	require.Len(t, g.logGroup.Logs, 1)
+	assert.Equal(t, "line3", g.logGroup.Logs[0].Contents[0].Value)
+}
+
+func TestDecodeInvalidFlatLogGroups(t *testing.T) {
+	e := &flatLogGroupEncoder{}
+	e.addGroup("pack", "topic", "logstore", nil, [][][2]string{{{"content", "line"}}})
+	meta := e.meta()
+
+	_, err := decodeFlatLogGroups(meta[:len(meta)-4], e.arena)
+	assert.Error(t, err)
+	_, err = decodeFlatLogGroups(meta, e.arena[:len(e.arena)-1])
+	assert.Error(t, err)
+	invalidMagic := append([]byte{}, meta...)
+	invalidMagic[0] = 0
+	_, err = decodeFlatLogGroups(invalidMagic, e.arena)
+	assert.Error(t, err)
+}
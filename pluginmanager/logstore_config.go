@@ -273,6 +273,23 @@ func (lc *LogstoreConfig) ProcessLogGroup(logByte []byte, packID string) int {
 	return 0
 }
 
+// ProcessLogGroups receives log groups in flat layout passed by core, which are batched in one call.
+func (lc *LogstoreConfig) ProcessLogGroups(meta []byte, arena []byte) int {
+	groups, err := decodeFlatLogGroups(meta, arena)
+	if err != nil {
+		logger.Error(lc.Context.GetRuntimeContext(), "WRONG_PROTOBUF_ALARM",
+			"cannot process flat log groups passed by core, err", err)
+		return -1
+	}
+	for _, g := range groups {
+		lc.PluginRunner.ReceiveLogGroup(pipeline.LogGroupWithContext{
+			LogGroup: g.logGroup,
+			Context:  map[string]interface{}{ctxKeySource: g.packID}},
+		)
+	}
+	return 0
+}
+
 func hasDockerStdoutInput(plugins map[string]interface{}) bool {
 	inputs, exists := plugins["inputs"]
 	if !exists {